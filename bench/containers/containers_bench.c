@@ -0,0 +1,577 @@
+/**
+ * @file containers_bench.c
+ *
+ * Microbenchmark of core containers: Hashmap_t, Vector_t, Queue_t, DynamicStack_t and EHash_hash.
+ * Insert, find and iterate throughput, allocations and heap bytes per element are measured
+ * at sizes growing by 10x and written as JSON.
+ *
+ * Allocations are counted by wrapping malloc family at link time (-Wl,--wrap), so only calls
+ * made from benchmark and container objects are seen, libc internals are not.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-13
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <argp.h>
+#include <malloc.h>
+#include <vector.h>
+#include <hashmap.h>
+#include <queue.h>
+#include <dstack.h>
+#include "../../utility/hash/hash.h"
+
+////////////////////////////////
+// DEFINES
+
+#define MIN_SIZE_DEFAULT            10
+#define MAX_SIZE_DEFAULT            10000000
+#define OPERATIONS_DEFAULT          1000000
+#define KEY_LENGTH                  24
+#define EHASH_OUTPUT_SIZE           16
+#define NANOSECONDS_IN_SECOND       1e9
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+enum
+{
+    OPTION_MIN_SIZE = 0x100,
+    OPTION_MAX_SIZE,
+    OPTION_OPERATIONS
+};
+
+static struct argp_option options[] = {
+    { "output", 'o', "FILE", 0, "Write JSON to FILE instead of stdout" },
+    { "min-size", OPTION_MIN_SIZE, "N", 0, "Smallest container size (default: 10)" },
+    { "max-size", OPTION_MAX_SIZE, "N", 0, "Largest container size (default: 10000000)" },
+    { "operations", OPTION_OPERATIONS, "N", 0, "Small sizes are repeated until N operations are done (default: 1000000)" },
+    { 0 }
+};
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef struct
+{
+    const char* outputPath;
+    size_t minSize;
+    size_t maxSize;
+    size_t operations;
+}BenchOptions_t;
+
+typedef struct
+{
+    uint64_t allocations;
+    int64_t liveBytes;
+}AllocStats_t;
+
+// Totals of one operation over all rounds
+typedef struct
+{
+    double seconds;
+    uint64_t allocations;
+}Measure_t;
+
+typedef struct
+{
+    double start;
+    uint64_t allocations;
+}Span_t;
+
+// Preformatted keys, so formatting is never measured
+typedef struct
+{
+    char* hits;
+    char* misses;
+    uint8_t* lengths;
+}Keys_t;
+
+typedef bool (*ContainerBench_t)(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes);
+
+typedef struct
+{
+    const char* container;
+    ContainerBench_t run;
+    const char* operations[4];
+}ContainerEntry_t;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static error_t parseOption_(int key, char *arg, struct argp_state *state);
+static bool createKeys_(Keys_t* keys, const size_t count);
+static inline const char* keyAt_(const char* keys, const size_t idx);
+static bool benchHashmap_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes);
+static bool benchVector_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes);
+static bool benchQueue_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes);
+static bool benchStack_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes);
+static bool benchEHash_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes);
+static int countIteratorCallback_(void *key, int count, void* value, void *user);
+static inline void spanBegin_(Span_t* span);
+static inline void spanEnd_(const Span_t* span, Measure_t* measure);
+static double now_(void);
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+void __real_free(void* pointer);
+
+////////////////////////////////
+// PRIVATE VARIABLES
+
+static AllocStats_t allocStats_ = {0};
+
+// Keeps results of measured loops alive
+static volatile uintptr_t sink_ = 0;
+
+static const ContainerEntry_t containers_[] =
+{
+    {"hashmap", benchHashmap_,  {"insert", "find", "find_miss", "iterate"}},
+    {"vector",  benchVector_,   {"append", "iterate", "pop", NULL}},
+    {"queue",   benchQueue_,    {"enqueue", "iterate", "dequeue", NULL}},
+    {"stack",   benchStack_,    {"push", "iterate", "pop", NULL}},
+    {"ehash",   benchEHash_,    {"hash", NULL, NULL, NULL}}
+};
+
+////////////////////////////////
+// IMPLEMENTATION
+
+int main(int argc, char **argv)
+{
+    BenchOptions_t bench = {NULL, MIN_SIZE_DEFAULT, MAX_SIZE_DEFAULT, OPERATIONS_DEFAULT};
+    struct argp argp = { options, parseOption_, 0, "Iguana core containers microbenchmark", 0, 0, 0 };
+    const size_t containersCount = sizeof(containers_) / sizeof(ContainerEntry_t);
+    bool isFirstResult = true;
+    Keys_t keys;
+    FILE* output = stdout;
+
+    argp_parse(&argp, argc, argv, 0, 0, &bench);
+
+    if((bench.minSize == 0) || (bench.maxSize < bench.minSize))
+    {
+        fprintf(stderr, "Error: invalid size range %zu..%zu\n", bench.minSize, bench.maxSize);
+        return EXIT_FAILURE;
+    }
+
+    if(!createKeys_(&keys, bench.maxSize))
+    {
+        fprintf(stderr, "Error: failed to allocate %zu keys\n", bench.maxSize);
+        return EXIT_FAILURE;
+    }
+
+    if((bench.outputPath != NULL) && ((output = fopen(bench.outputPath, "w")) == NULL))
+    {
+        fprintf(stderr, "Error: failed to open %s\n", bench.outputPath);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(output, "{\n  \"suite\": \"containers\",\n  \"operations\": %zu,\n  \"results\": [", bench.operations);
+
+    for(size_t containerIdx = 0; containerIdx < containersCount; containerIdx++)
+    {
+        const ContainerEntry_t* entry = &containers_[containerIdx];
+
+        for(size_t size = bench.minSize; size <= bench.maxSize; size *= 10)
+        {
+            const size_t rounds = (size < bench.operations) ? (bench.operations / size) : 1;
+            Measure_t measures[4] = {{0}};
+            int64_t bytes = 0;
+
+            if(!entry->run(&keys, size, rounds, measures, &bytes))
+            {
+                fprintf(stderr, "Error: %s benchmark failed at size %zu\n", entry->container, size);
+                return EXIT_FAILURE;
+            }
+
+            for(size_t operationIdx = 0; (operationIdx < 4) && (entry->operations[operationIdx] != NULL); operationIdx++)
+            {
+                const double operationsDone = (double) size * rounds;
+                const Measure_t* measure = &measures[operationIdx];
+
+                fprintf(output, "%s\n    {\"container\": \"%s\", \"operation\": \"%s\", \"size\": %zu, \"rounds\": %zu, "
+                    "\"ns_per_op\": %.2f, \"ops_per_s\": %.0f, \"allocations_per_element\": %.3f, \"bytes_per_element\": %.2f}",
+                    isFirstResult ? "" : ",",
+                    entry->container, entry->operations[operationIdx], size, rounds,
+                    measure->seconds * NANOSECONDS_IN_SECOND / operationsDone,
+                    (measure->seconds > 0) ? (operationsDone / measure->seconds) : 0,
+                    measure->allocations / operationsDone,
+                    (double) bytes / size);
+
+                isFirstResult = false;
+            }
+
+            fflush(output);
+        }
+    }
+
+    fprintf(output, "\n  ]\n}\n");
+
+    if(output != stdout)
+    {
+        fclose(output);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static error_t parseOption_(int key, char *arg, struct argp_state *state)
+{
+    BenchOptions_t* bench = state->input;
+
+    switch (key)
+    {
+        case 'o':                   bench->outputPath = arg; break;
+        case OPTION_MIN_SIZE:       bench->minSize = strtoull(arg, NULL, 10); break;
+        case OPTION_MAX_SIZE:       bench->maxSize = strtoull(arg, NULL, 10); break;
+        case OPTION_OPERATIONS:     bench->operations = strtoull(arg, NULL, 10); break;
+
+        default: return ARGP_ERR_UNKNOWN;
+    }
+
+    return 0;
+}
+
+static bool createKeys_(Keys_t* keys, const size_t count)
+{
+    keys->hits = malloc(count * KEY_LENGTH);
+    keys->misses = malloc(count * KEY_LENGTH);
+    keys->lengths = malloc(count);
+
+    if((keys->hits == NULL) || (keys->misses == NULL) || (keys->lengths == NULL))
+    {
+        return false;
+    }
+
+    for(size_t keyIdx = 0; keyIdx < count; keyIdx++)
+    {
+        keys->lengths[keyIdx] = snprintf(keys->hits + keyIdx * KEY_LENGTH, KEY_LENGTH, "k%zu", keyIdx);
+        snprintf(keys->misses + keyIdx * KEY_LENGTH, KEY_LENGTH, "m%zu", keyIdx);
+    }
+
+    return true;
+}
+
+static inline const char* keyAt_(const char* keys, const size_t idx)
+{
+    return keys + idx * KEY_LENGTH;
+}
+
+static bool benchHashmap_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes)
+{
+    for(size_t roundIdx = 0; roundIdx < rounds; roundIdx++)
+    {
+        const int64_t liveBytes = allocStats_.liveBytes;
+        HashmapHandle_t map;
+        uint64_t found = 0;
+        Span_t span;
+
+        // Created same as in compiler, with default initial size
+        spanBegin_(&span);
+        map = malloc(sizeof(Hashmap_t));
+
+        if((map == NULL) || !Hashmap_new(map, 0))
+        {
+            return false;
+        }
+
+        for(size_t keyIdx = 0; keyIdx < size; keyIdx++)
+        {
+            Hashmap_set(map, keyAt_(keys->hits, keyIdx), (void*) keyAt_(keys->hits, keyIdx));
+        }
+
+        spanEnd_(&span, &measures[0]);
+        *bytes = allocStats_.liveBytes - liveBytes;
+
+        spanBegin_(&span);
+
+        for(size_t keyIdx = 0; keyIdx < size; keyIdx++)
+        {
+            found += Hashmap_find(map, keyAt_(keys->hits, keyIdx), keys->lengths[keyIdx]);
+        }
+
+        spanEnd_(&span, &measures[1]);
+        spanBegin_(&span);
+
+        for(size_t keyIdx = 0; keyIdx < size; keyIdx++)
+        {
+            found += Hashmap_find(map, keyAt_(keys->misses, keyIdx), keys->lengths[keyIdx]);
+        }
+
+        spanEnd_(&span, &measures[2]);
+        spanBegin_(&span);
+        Hashmap_forEach(map, countIteratorCallback_, &found);
+        spanEnd_(&span, &measures[3]);
+
+        if(found != 2 * size)
+        {
+            return false;
+        }
+
+        Hashmap_delete(map);
+    }
+
+    return true;
+}
+
+static bool benchVector_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes)
+{
+    for(size_t roundIdx = 0; roundIdx < rounds; roundIdx++)
+    {
+        const int64_t liveBytes = allocStats_.liveBytes;
+        Vector_t vector = {0};
+        uintptr_t sum = 0;
+        Span_t span;
+
+        spanBegin_(&span);
+
+        if(!Vector_create(&vector, NULL))
+        {
+            return false;
+        }
+
+        for(size_t itemIdx = 0; itemIdx < size; itemIdx++)
+        {
+            if(!Vector_append(&vector, keyAt_(keys->hits, itemIdx)))
+            {
+                return false;
+            }
+        }
+
+        spanEnd_(&span, &measures[0]);
+        *bytes = allocStats_.liveBytes - liveBytes;
+
+        spanBegin_(&span);
+
+        for(size_t itemIdx = 0; itemIdx < vector.currentSize; itemIdx++)
+        {
+            sum += (uintptr_t) vector.expandable[itemIdx];
+        }
+
+        spanEnd_(&span, &measures[1]);
+        spanBegin_(&span);
+
+        while(vector.currentSize > 0)
+        {
+            sum ^= (uintptr_t) Vector_popLast(&vector);
+        }
+
+        spanEnd_(&span, &measures[2]);
+
+        sink_ = sum;
+        Vector_destroy(&vector);
+    }
+
+    return true;
+}
+
+static bool benchQueue_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes)
+{
+    for(size_t roundIdx = 0; roundIdx < rounds; roundIdx++)
+    {
+        const int64_t liveBytes = allocStats_.liveBytes;
+        Queue_t queue;
+        uintptr_t sum = 0;
+        Span_t span;
+
+        spanBegin_(&span);
+        Queue_create(&queue);
+
+        for(size_t itemIdx = 0; itemIdx < size; itemIdx++)
+        {
+            Queue_enqueue(&queue, (void*) keyAt_(keys->hits, itemIdx));
+        }
+
+        spanEnd_(&span, &measures[0]);
+        *bytes = allocStats_.liveBytes - liveBytes;
+
+        spanBegin_(&span);
+
+        for(QNodeHandle_t node = queue.front; node != NULL; node = node->next)
+        {
+            sum += (uintptr_t) node->data;
+        }
+
+        spanEnd_(&span, &measures[1]);
+        spanBegin_(&span);
+
+        while(queue.count > 0)
+        {
+            sum ^= (uintptr_t) Queue_dequeue(&queue);
+        }
+
+        spanEnd_(&span, &measures[2]);
+
+        sink_ = sum;
+        Queue_destroy(&queue);
+    }
+
+    return true;
+}
+
+static bool benchStack_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes)
+{
+    for(size_t roundIdx = 0; roundIdx < rounds; roundIdx++)
+    {
+        const int64_t liveBytes = allocStats_.liveBytes;
+        DynamicStack_t stack;
+        uintptr_t sum = 0;
+        Span_t span;
+
+        spanBegin_(&span);
+
+        if(!Stack_create(&stack))
+        {
+            return false;
+        }
+
+        for(size_t itemIdx = 0; itemIdx < size; itemIdx++)
+        {
+            if(!Stack_push(&stack, (void*) keyAt_(keys->hits, itemIdx)))
+            {
+                return false;
+            }
+        }
+
+        spanEnd_(&span, &measures[0]);
+        *bytes = allocStats_.liveBytes - liveBytes;
+
+        spanBegin_(&span);
+
+        for(size_t itemIdx = 0; itemIdx < stack.size; itemIdx++)
+        {
+            sum += (uintptr_t) stack.data[itemIdx];
+        }
+
+        spanEnd_(&span, &measures[1]);
+        spanBegin_(&span);
+
+        while(!Stack_isEmpty(&stack))
+        {
+            sum ^= (uintptr_t) Stack_pop(&stack);
+        }
+
+        spanEnd_(&span, &measures[2]);
+
+        sink_ = sum;
+        Stack_destroy(&stack);
+    }
+
+    return true;
+}
+
+static bool benchEHash_(const Keys_t* keys, const size_t size, const size_t rounds, Measure_t* measures, int64_t* bytes)
+{
+    char output[EHASH_OUTPUT_SIZE];
+
+    for(size_t roundIdx = 0; roundIdx < rounds; roundIdx++)
+    {
+        Span_t span;
+
+        spanBegin_(&span);
+
+        for(size_t keyIdx = 0; keyIdx < size; keyIdx++)
+        {
+            memset(output, 0, sizeof(output));
+
+            if(!EHash_hash(keyAt_(keys->hits, keyIdx), keys->lengths[keyIdx], output, sizeof(output)))
+            {
+                return false;
+            }
+
+            sink_ ^= (uint8_t) output[0];
+        }
+
+        spanEnd_(&span, &measures[0]);
+    }
+
+    *bytes = 0;
+
+    return true;
+}
+
+static int countIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    *(uint64_t*) user += (value != NULL);
+
+    return true;
+}
+
+static inline void spanBegin_(Span_t* span)
+{
+    span->allocations = allocStats_.allocations;
+    span->start = now_();
+}
+
+static inline void spanEnd_(const Span_t* span, Measure_t* measure)
+{
+    measure->seconds += now_() - span->start;
+    measure->allocations += allocStats_.allocations - span->allocations;
+}
+
+static double now_(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec + time.tv_nsec / NANOSECONDS_IN_SECOND;
+}
+
+void* __wrap_malloc(size_t size)
+{
+    void* pointer = __real_malloc(size);
+
+    if(pointer != NULL)
+    {
+        allocStats_.allocations++;
+        allocStats_.liveBytes += malloc_usable_size(pointer);
+    }
+
+    return pointer;
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    void* pointer = __real_calloc(count, size);
+
+    if(pointer != NULL)
+    {
+        allocStats_.allocations++;
+        allocStats_.liveBytes += malloc_usable_size(pointer);
+    }
+
+    return pointer;
+}
+
+void* __wrap_realloc(void* pointer, size_t size)
+{
+    const size_t oldSize = (pointer != NULL) ? malloc_usable_size(pointer) : 0;
+    void* resized = __real_realloc(pointer, size);
+
+    if(resized != NULL)
+    {
+        allocStats_.allocations++;
+        allocStats_.liveBytes += (int64_t) malloc_usable_size(resized) - (int64_t) oldSize;
+    }
+
+    return resized;
+}
+
+void __wrap_free(void* pointer)
+{
+    if(pointer != NULL)
+    {
+        allocStats_.liveBytes -= malloc_usable_size(pointer);
+    }
+
+    __real_free(pointer);
+}
@@ -0,0 +1,293 @@
+/**
+ * @file corpus_generator.c
+ *
+ * Synthetic Iguana corpus for benchmarks. Writes main.i and unit objects with configurable
+ * counts of fields, methods, statements, expression depth and calls per method.
+ *
+ * Every file is valid program part on its own: methods call only earlier methods of same object
+ * with arguments of exactly parameter sizes, so corpus compiles, links and terminates.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-11
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <argp.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+////////////////////////////////
+// DEFINES
+
+#define PARAM_BITS          16
+#define LOCAL_BITS          16
+#define RETURN_BITS         32
+#define PARAMS_COUNT        2
+#define LOCALS_COUNT        4
+#define FIELD_MAX_BITS      63
+#define CONSTANT_MAX        1000
+#define PATH_LENGTH         4096
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+static const char* const OPERATORS[] = {"+", "-", "*", "&", "|", "^"};
+
+#define OPERATORS_COUNT     (sizeof(OPERATORS) / sizeof(OPERATORS[0]))
+
+enum
+{
+    OPTION_FILES = 0x100,
+    OPTION_FIELDS,
+    OPTION_METHODS,
+    OPTION_STATEMENTS,
+    OPTION_DEPTH,
+    OPTION_CALLS,
+    OPTION_SEED
+};
+
+static struct argp_option options[] = {
+    { "output", 'o', "DIR", 0, "Corpus directory, created when missing (default: corpus)" },
+    { "files", OPTION_FILES, "N", 0, "Files in corpus, main.i included (default: 8)" },
+    { "fields", OPTION_FIELDS, "N", 0, "Fields of each object (default: 16)" },
+    { "methods", OPTION_METHODS, "N", 0, "Methods of each object (default: 16)" },
+    { "statements", OPTION_STATEMENTS, "N", 0, "Assignment statements of each method (default: 8)" },
+    { "depth", OPTION_DEPTH, "N", 0, "Depth of binary expression trees (default: 3)" },
+    { "calls", OPTION_CALLS, "N", 0, "Calls of earlier methods in each method (default: 2)" },
+    { "seed", OPTION_SEED, "N", 0, "Random seed, same seed gives same corpus (default: 1)" },
+    { 0 }
+};
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef struct
+{
+    const char* outputDir;
+    uint32_t files;
+    uint32_t fields;
+    uint32_t methods;
+    uint32_t statements;
+    uint32_t depth;
+    uint32_t calls;
+    uint64_t seed;
+}CorpusOptions_t;
+
+static uint64_t randomState_;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static error_t parseOption_(int key, char *arg, struct argp_state *state);
+static bool writeObject_(const CorpusOptions_t* corpus, const char* objectName, const bool isMain);
+static void writeMethod_(FILE* file, const CorpusOptions_t* corpus, const uint32_t fields, const uint32_t methodIdx);
+static void writeExpression_(FILE* file, const uint32_t fields, const uint32_t depth);
+static void writeOperand_(FILE* file, const uint32_t fields);
+static uint32_t random_(const uint32_t bound);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+int main(int argc, char **argv)
+{
+    CorpusOptions_t corpus = {"corpus", 8, 16, 16, 8, 3, 2, 1};
+    struct argp argp = { options, parseOption_, 0, "Synthetic Iguana corpus generator", 0, 0, 0 };
+    char objectName[PATH_LENGTH];
+
+    argp_parse(&argp, argc, argv, 0, 0, &corpus);
+
+    randomState_ = corpus.seed;
+
+    if((mkdir(corpus.outputDir, 0755) != 0) && (access(corpus.outputDir, F_OK) != 0))
+    {
+        fprintf(stderr, "Error: failed to create corpus directory %s\n", corpus.outputDir);
+        return EXIT_FAILURE;
+    }
+
+    for(uint32_t fileIdx = 0; fileIdx < corpus.files; fileIdx++)
+    {
+        snprintf(objectName, sizeof(objectName), (fileIdx == 0) ? "main" : "unit%u", fileIdx);
+
+        if(!writeObject_(&corpus, objectName, fileIdx == 0))
+        {
+            fprintf(stderr, "Error: failed to write %s/%s.i\n", corpus.outputDir, objectName);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static error_t parseOption_(int key, char *arg, struct argp_state *state)
+{
+    CorpusOptions_t* corpus = state->input;
+
+    switch (key)
+    {
+        case 'o':               corpus->outputDir = arg; break;
+        case OPTION_FILES:      corpus->files = strtoul(arg, NULL, 10); break;
+        case OPTION_FIELDS:     corpus->fields = strtoul(arg, NULL, 10); break;
+        case OPTION_METHODS:    corpus->methods = strtoul(arg, NULL, 10); break;
+        case OPTION_STATEMENTS: corpus->statements = strtoul(arg, NULL, 10); break;
+        case OPTION_DEPTH:      corpus->depth = strtoul(arg, NULL, 10); break;
+        case OPTION_CALLS:      corpus->calls = strtoul(arg, NULL, 10); break;
+        case OPTION_SEED:       corpus->seed = strtoull(arg, NULL, 10); break;
+        default:                return ARGP_ERR_UNKNOWN;
+    }
+
+    return 0;
+}
+
+static bool writeObject_(const CorpusOptions_t* corpus, const char* objectName, const bool isMain)
+{
+    char path[PATH_LENGTH * 2];
+    FILE* file;
+
+    // Entry point calls main object of zero size, so it has no fields
+    const uint32_t fields = isMain ? 0 : corpus->fields;
+
+    snprintf(path, sizeof(path), "%s/%s.i", corpus->outputDir, objectName);
+    file = fopen(path, "w");
+
+    if(file == NULL)
+    {
+        return false;
+    }
+
+    for(uint32_t fieldIdx = 0; fieldIdx < fields; fieldIdx++)
+    {
+        fprintf(file, "bit:%u f%u;\n", 1 + random_(FIELD_MAX_BITS), fieldIdx);
+    }
+
+    fprintf(file, "\n");
+
+    for(uint32_t methodIdx = 0; methodIdx < corpus->methods; methodIdx++)
+    {
+        writeMethod_(file, corpus, fields, methodIdx);
+    }
+
+    // Entry calls every method once, so runtime benchmarks execute whole object
+    if(isMain)
+    {
+        fprintf(file, "bit:0 main()\n{\n");
+
+        for(uint32_t localIdx = 0; localIdx < PARAMS_COUNT; localIdx++)
+        {
+            fprintf(file, "    bit:%u l%u = %u;\n", LOCAL_BITS, localIdx, 1 + random_(CONSTANT_MAX));
+        }
+
+        fprintf(file, "    bit:%u r = 0;\n", RETURN_BITS);
+
+        for(uint32_t methodIdx = 0; methodIdx < corpus->methods; methodIdx++)
+        {
+            fprintf(file, "    r = r ^ %u:m%u(l0, l1);\n", RETURN_BITS, methodIdx);
+        }
+
+        fprintf(file, "    print(r);\n}\n");
+    }
+
+    return fclose(file) == 0;
+}
+
+static void writeMethod_(FILE* file, const CorpusOptions_t* corpus, const uint32_t fields, const uint32_t methodIdx)
+{
+    fprintf(file, "bit:%u m%u(bit:%u p0, bit:%u p1)\n{\n", RETURN_BITS, methodIdx, PARAM_BITS, PARAM_BITS);
+
+    for(uint32_t localIdx = 0; localIdx < LOCALS_COUNT; localIdx++)
+    {
+        fprintf(file, "    bit:%u l%u = %u;\n", LOCAL_BITS, localIdx, 1 + random_(CONSTANT_MAX));
+    }
+
+    fprintf(file, "    bit:%u r = 0;\n", RETURN_BITS);
+
+    for(uint32_t statementIdx = 0; statementIdx < corpus->statements; statementIdx++)
+    {
+        const uint32_t target = random_(LOCALS_COUNT + ((fields > 0) ? 1 : 0));
+
+        // Fields are written too, so objects carry state between calls
+        if(target == LOCALS_COUNT)
+        {
+            fprintf(file, "    f%u = ", random_(fields));
+        }else
+        {
+            fprintf(file, "    l%u = ", target);
+        }
+
+        writeExpression_(file, fields, corpus->depth);
+        fprintf(file, ";\n");
+    }
+
+    for(uint32_t callIdx = 0; (callIdx < corpus->calls) && (methodIdx > 0); callIdx++)
+    {
+        fprintf(file, "    r = r + %u:m%u(l%u, l%u);\n", RETURN_BITS, random_(methodIdx), random_(LOCALS_COUNT), random_(LOCALS_COUNT));
+    }
+
+    fprintf(file, "    ret r + l0 + p0 + p1;\n}\n\n");
+}
+
+static void writeExpression_(FILE* file, const uint32_t fields, const uint32_t depth)
+{
+    if(depth == 0)
+    {
+        writeOperand_(file, fields);
+        return;
+    }
+
+    fprintf(file, "(");
+    writeExpression_(file, fields, depth - 1);
+    fprintf(file, " %s ", OPERATORS[random_(OPERATORS_COUNT)]);
+    writeExpression_(file, fields, depth - 1);
+    fprintf(file, ")");
+}
+
+static void writeOperand_(FILE* file, const uint32_t fields)
+{
+    switch (random_(4))
+    {
+        case 0:
+        {
+            fprintf(file, "%u", 1 + random_(CONSTANT_MAX));
+        }break;
+
+        case 1:
+        {
+            fprintf(file, "p%u", random_(PARAMS_COUNT));
+        }break;
+
+        case 2:
+        {
+            // Objects without fields read locals instead
+            if(fields > 0)
+            {
+                fprintf(file, "f%u", random_(fields));
+                break;
+            }
+        }
+        /* fallthrough */
+
+        default:
+        {
+            fprintf(file, "l%u", random_(LOCALS_COUNT));
+        }break;
+    }
+}
+
+/**
+ * @brief Private method for xorshift random number, corpus is same for same seed on every platform
+ */
+static uint32_t random_(const uint32_t bound)
+{
+    randomState_ ^= randomState_ << 13;
+    randomState_ ^= randomState_ >> 7;
+    randomState_ ^= randomState_ << 17;
+
+    return (uint32_t) (randomState_ % bound);
+}
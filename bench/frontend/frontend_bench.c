@@ -0,0 +1,516 @@
+/**
+ * @file frontend_bench.c
+ *
+ * Frontend throughput benchmark. Every file is lexed, parsed and lowered to C in memory,
+ * each phase is timed on its own and best of repeated runs is compared with stored baseline.
+ *
+ * Metrics: lexer tokens/s and lines/s, parser AST nodes/s, generator C bytes/s and whole
+ * frontend lines/s. Files are read before timing, so disk is never measured.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-11
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <argp.h>
+#include <dirent.h>
+#include <libgen.h>
+#include <sys/stat.h>
+#include "../../utility/compiler/compiler.h"
+#include "../../utility/separator/separator.h"
+#include "../../utility/file_reader/file_reader.h"
+#include "../../utility/parser/parser.h"
+#include "../../utility/generator/generator.h"
+#include "../../utility/parser/parser_utilities/compiler_messages.h"
+#include "../../utility/parser/structures/expression/expressions.h"
+
+////////////////////////////////
+// DEFINES
+
+#define REPEAT_DEFAULT          5
+#define PATH_LENGTH             4096
+#define METRIC_KEY_LENGTH       64
+#define NANOSECONDS_IN_SECOND   1e9
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+enum
+{
+    OPTION_REPEAT = 0x100,
+    OPTION_BASELINE,
+    OPTION_UPDATE_BASELINE,
+    OPTION_CHECK
+};
+
+static struct argp_option options[] = {
+    { "repeat", OPTION_REPEAT, "N", 0, "Runs over whole corpus, best one is reported (default: 5)" },
+    { "baseline", OPTION_BASELINE, "FILE", 0, "Baseline to compare with" },
+    { "update-baseline", OPTION_UPDATE_BASELINE, 0, 0, "Write measured throughput to baseline file" },
+    { "check", OPTION_CHECK, "PERCENT", 0, "Fail when any metric is more than PERCENT below baseline" },
+    { 0 }
+};
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef struct
+{
+    const char* baselinePath;
+    bool updateBaseline;
+    double checkPercent;
+    uint32_t repeat;
+    Vector_t paths;
+}BenchOptions_t;
+
+typedef struct
+{
+    char* path;
+    char* code;
+    size_t length;
+}SourceFile_t;
+
+// Work counts are same for every run, times are best ones
+typedef struct
+{
+    uint64_t lines;
+    uint64_t tokens;
+    uint64_t nodes;
+    uint64_t generatedBytes;
+    double lexSeconds;
+    double parseSeconds;
+    double generateSeconds;
+}PhaseTotals_t;
+
+typedef struct
+{
+    const char* key;
+    const char* phase;
+    const char* unit;
+    double value;
+    double baseline;
+}Metric_t;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static error_t parseOption_(int key, char *arg, struct argp_state *state);
+static bool collectPath_(BenchOptions_t* bench, const char* path);
+static int comparePaths_(const void* left, const void* right);
+static bool runCorpus_(const SourceFile_t* files, const size_t filesCount, PhaseTotals_t* totals);
+static bool runFile_(const SourceFile_t* file, const bool isFirstFile, char* scratch, PhaseTotals_t* totals);
+static int methodNodesIteratorCallback_(void *key, int count, void* value, void *user);
+static uint64_t countMethodNodes_(const MethodObjectHandle_t method);
+static uint64_t countExpressionNodes_(const ExpHandle_t expression);
+static bool loadBaseline_(const char* path, Metric_t* metrics, const size_t metricsCount);
+static bool storeBaseline_(const char* path, const Metric_t* metrics, const size_t metricsCount);
+static double now_(void);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+int main(int argc, char **argv)
+{
+    BenchOptions_t bench = {NULL, false, -1.0, REPEAT_DEFAULT};
+    struct argp argp = { options, parseOption_, "[FILES | DIRS]...", "Iguana frontend throughput benchmark", 0, 0, 0 };
+    PhaseTotals_t best = {0};
+    SourceFile_t* files;
+    size_t filesCount;
+    int status = EXIT_SUCCESS;
+
+    if(!Vector_create(&bench.paths, NULL))
+    {
+        return EXIT_FAILURE;
+    }
+
+    argp_parse(&argp, argc, argv, 0, 0, &bench);
+
+    filesCount = bench.paths.currentSize;
+
+    if(filesCount == 0)
+    {
+        fprintf(stderr, "Error: no Iguana files to benchmark\n");
+        return EXIT_FAILURE;
+    }
+
+    // Object with entry point goes first, like in compiler invocation
+    qsort(bench.paths.expandable, filesCount, sizeof(void*), comparePaths_);
+
+    files = calloc(filesCount, sizeof(SourceFile_t));
+
+    for(size_t fileIdx = 0; fileIdx < filesCount; fileIdx++)
+    {
+        files[fileIdx].path = bench.paths.expandable[fileIdx];
+        files[fileIdx].length = FileReader_readToBuffer(files[fileIdx].path, &files[fileIdx].code);
+
+        if(files[fileIdx].length == (size_t) -1)
+        {
+            fprintf(stderr, "Error: failed to read %s\n", files[fileIdx].path);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for(uint32_t runIdx = 0; runIdx < bench.repeat; runIdx++)
+    {
+        PhaseTotals_t run = {0};
+
+        if(!runCorpus_(files, filesCount, &run))
+        {
+            return EXIT_FAILURE;
+        }
+
+        if((runIdx == 0) || (run.lexSeconds < best.lexSeconds))             best.lexSeconds = run.lexSeconds;
+        if((runIdx == 0) || (run.parseSeconds < best.parseSeconds))         best.parseSeconds = run.parseSeconds;
+        if((runIdx == 0) || (run.generateSeconds < best.generateSeconds))   best.generateSeconds = run.generateSeconds;
+
+        best.lines = run.lines;
+        best.tokens = run.tokens;
+        best.nodes = run.nodes;
+        best.generatedBytes = run.generatedBytes;
+    }
+
+    const double totalSeconds = best.lexSeconds + best.parseSeconds + best.generateSeconds;
+
+    Metric_t metrics[] =
+    {
+        {"lex_tokens_per_s",        "lex",      "tokens/s", best.tokens / best.lexSeconds, 0},
+        {"lex_lines_per_s",         "lex",      "lines/s",  best.lines / best.lexSeconds, 0},
+        {"parse_nodes_per_s",       "parse",    "nodes/s",  best.nodes / best.parseSeconds, 0},
+        {"generate_bytes_per_s",    "generate", "C B/s",    best.generatedBytes / best.generateSeconds, 0},
+        {"total_lines_per_s",       "total",    "lines/s",  best.lines / totalSeconds, 0}
+    };
+    const size_t metricsCount = sizeof(metrics) / sizeof(Metric_t);
+
+    if((bench.baselinePath != NULL) && !bench.updateBaseline && !loadBaseline_(bench.baselinePath, metrics, metricsCount))
+    {
+        fprintf(stderr, "Warning: no baseline in %s\n", bench.baselinePath);
+    }
+
+    printf("Frontend: %zu files, %lu lines, %lu tokens, %lu AST nodes, %lu C bytes, best of %u runs\n",
+        filesCount, best.lines, best.tokens, best.nodes, best.generatedBytes, bench.repeat);
+    printf("%-10s %12s %16s %-10s %16s %9s\n", "phase", "seconds", "throughput", "", "baseline", "change");
+
+    for(size_t metricIdx = 0; metricIdx < metricsCount; metricIdx++)
+    {
+        const Metric_t* metric = &metrics[metricIdx];
+        const double seconds = (strcmp(metric->phase, "lex") == 0) ? best.lexSeconds :
+                               (strcmp(metric->phase, "parse") == 0) ? best.parseSeconds :
+                               (strcmp(metric->phase, "generate") == 0) ? best.generateSeconds : totalSeconds;
+
+        printf("%-10s %12.6f %16.0f %-10s", metric->phase, seconds, metric->value, metric->unit);
+
+        if(metric->baseline > 0)
+        {
+            const double change = (metric->value / metric->baseline - 1.0) * 100.0;
+
+            printf(" %16.0f %+8.1f%%", metric->baseline, change);
+
+            if((bench.checkPercent >= 0) && (-change > bench.checkPercent))
+            {
+                printf("  REGRESSION");
+                status = EXIT_FAILURE;
+            }
+        }
+
+        printf("\n");
+    }
+
+    if(bench.updateBaseline)
+    {
+        if((bench.baselinePath == NULL) || !storeBaseline_(bench.baselinePath, metrics, metricsCount))
+        {
+            fprintf(stderr, "Error: failed to write baseline\n");
+            return EXIT_FAILURE;
+        }
+
+        printf("Baseline written to %s\n", bench.baselinePath);
+    }
+
+    return status;
+}
+
+static error_t parseOption_(int key, char *arg, struct argp_state *state)
+{
+    BenchOptions_t* bench = state->input;
+
+    switch (key)
+    {
+        case OPTION_REPEAT:             bench->repeat = strtoul(arg, NULL, 10); break;
+        case OPTION_BASELINE:           bench->baselinePath = arg; break;
+        case OPTION_UPDATE_BASELINE:    bench->updateBaseline = true; break;
+        case OPTION_CHECK:              bench->checkPercent = strtod(arg, NULL); break;
+
+        case ARGP_KEY_ARG:
+        {
+            if(!collectPath_(bench, arg))
+            {
+                argp_error(state, "cannot read '%s'", arg);
+            }
+        }break;
+
+        default: return ARGP_ERR_UNKNOWN;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Private method for adding Iguana file, or every Iguana file of directory
+ */
+static bool collectPath_(BenchOptions_t* bench, const char* path)
+{
+    struct stat pathStat;
+    struct dirent* entry;
+    DIR* directory;
+
+    if(stat(path, &pathStat) != 0)
+    {
+        return false;
+    }
+
+    if(!S_ISDIR(pathStat.st_mode))
+    {
+        return Vector_append(&bench->paths, strdup(path));
+    }
+
+    directory = opendir(path);
+
+    if(directory == NULL)
+    {
+        return false;
+    }
+
+    while((entry = readdir(directory)) != NULL)
+    {
+        const size_t nameLength = strlen(entry->d_name);
+        char* filePath;
+
+        if((nameLength < 3) || (strcmp(entry->d_name + nameLength - 2, ".i") != 0))
+        {
+            continue;
+        }
+
+        filePath = malloc(strlen(path) + nameLength + 2);
+        sprintf(filePath, "%s/%s", path, entry->d_name);
+
+        if(!Vector_append(&bench->paths, filePath))
+        {
+            closedir(directory);
+            return false;
+        }
+    }
+
+    closedir(directory);
+
+    return true;
+}
+
+static int comparePaths_(const void* left, const void* right)
+{
+    const char* leftPath = *(const char* const*) left;
+    const char* rightPath = *(const char* const*) right;
+    const bool isLeftMain = (strcmp(basename((char*) leftPath), "main.i") == 0);
+    const bool isRightMain = (strcmp(basename((char*) rightPath), "main.i") == 0);
+
+    if(isLeftMain != isRightMain)
+    {
+        return isLeftMain ? -1 : 1;
+    }
+
+    return strcmp(leftPath, rightPath);
+}
+
+static bool runCorpus_(const SourceFile_t* files, const size_t filesCount, PhaseTotals_t* totals)
+{
+    size_t longest = 0;
+    char* scratch;
+    bool status = true;
+
+    for(size_t fileIdx = 0; fileIdx < filesCount; fileIdx++)
+    {
+        longest = (files[fileIdx].length > longest) ? files[fileIdx].length : longest;
+    }
+
+    scratch = malloc(longest + 1);
+
+    for(size_t fileIdx = 0; (fileIdx < filesCount) && status; fileIdx++)
+    {
+        status = runFile_(&files[fileIdx], fileIdx == 0, scratch, totals);
+    }
+
+    free(scratch);
+
+    return status;
+}
+
+static bool runFile_(const SourceFile_t* file, const bool isFirstFile, char* scratch, PhaseTotals_t* totals)
+{
+    char cFilename[MAX_FILENAME_LENGTH + sizeof(".c")];
+    MainFrame_t root;
+    Vector_t tokens;
+    Parser_t parser;
+    const char* generatedCode;
+    size_t generatedLength;
+    double start;
+
+    // Lexer may write into buffer, every run gets fresh copy
+    memcpy(scratch, file->code, file->length);
+    scratch[file->length] = '\0';
+
+    Compiler_removeExtensionFromFilenameWithCopy_(root.iguanaObjectName, basename(file->path));
+    snprintf(cFilename, sizeof(cFilename), "%s.c", root.iguanaObjectName);
+    Shouter_resetErrorCount();
+
+    start = now_();
+
+    if(!Separator_getSeparatedWords(scratch, file->length, &tokens, file->path))
+    {
+        fprintf(stderr, "Error: failed to lex %s\n", file->path);
+        return false;
+    }
+
+    Vector_fit(&tokens);
+    totals->lexSeconds += now_() - start;
+
+    start = now_();
+
+    if(!Parser_initialize(&parser) || !Parser_parseTokens(&parser, &root, &tokens) || (Shouter_getErrorCount() != 0))
+    {
+        fprintf(stderr, "Error: failed to parse %s\n", file->path);
+        return false;
+    }
+
+    totals->parseSeconds += now_() - start;
+
+    start = now_();
+
+    if(!Generator_generateCode(&root, cFilename, isFirstFile))
+    {
+        fprintf(stderr, "Error: failed to generate C of %s\n", file->path);
+        return false;
+    }
+
+    totals->generateSeconds += now_() - start;
+
+    Generator_getCode(&generatedCode, &generatedLength);
+
+    for(size_t charIdx = 0; charIdx < file->length; charIdx++)
+    {
+        totals->lines += (file->code[charIdx] == '\n');
+    }
+
+    totals->tokens += tokens.currentSize;
+    totals->generatedBytes += generatedLength;
+    totals->nodes += Hashmap_size(&root.classVariables) + Hashmap_size(&root.methods);
+
+    Hashmap_forEach(&root.methods, methodNodesIteratorCallback_, &totals->nodes);
+
+    // AST is left alive same as in compiler, generated code may still point into it
+    Parser_destroy(&parser);
+    Vector_destroy(&tokens);
+
+    return true;
+}
+
+static int methodNodesIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    *(uint64_t*) user += countMethodNodes_(value);
+
+    return SUCCESS;
+}
+
+static uint64_t countMethodNodes_(const MethodObjectHandle_t method)
+{
+    uint64_t nodes = method->parameters->currentSize + Hashmap_size(&method->body.localVariables);
+
+    for(size_t elementIdx = 0; elementIdx < method->body.scopeElementsList.currentSize; elementIdx++)
+    {
+        nodes += countExpressionNodes_(method->body.scopeElementsList.expandable[elementIdx]);
+    }
+
+    return nodes;
+}
+
+static uint64_t countExpressionNodes_(const ExpHandle_t expression)
+{
+    uint64_t nodes = 1;
+
+    for(ExpIterator_t iterator = Expression_iteratorFirst(expression); iterator < Expression_iteratorLast(expression); iterator++)
+    {
+        nodes++;
+
+        // Arguments of calls are expressions of their own
+        if(ExpElement_getType(*iterator) == EXP_METHOD_CALL)
+        {
+            const ExMethodCallHandle_t call = ExpElement_getObject(*iterator);
+
+            for(size_t paramIdx = 0; paramIdx < call->parameters.currentSize; paramIdx++)
+            {
+                nodes += countExpressionNodes_(call->parameters.expandable[paramIdx]);
+            }
+        }
+    }
+
+    return nodes;
+}
+
+static bool loadBaseline_(const char* path, Metric_t* metrics, const size_t metricsCount)
+{
+    char key[METRIC_KEY_LENGTH];
+    double value;
+    FILE* file = fopen(path, "r");
+
+    if(file == NULL)
+    {
+        return false;
+    }
+
+    while(fscanf(file, " %63s %lf", key, &value) == 2)
+    {
+        for(size_t metricIdx = 0; metricIdx < metricsCount; metricIdx++)
+        {
+            if(strcmp(metrics[metricIdx].key, key) == 0)
+            {
+                metrics[metricIdx].baseline = value;
+            }
+        }
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+static bool storeBaseline_(const char* path, const Metric_t* metrics, const size_t metricsCount)
+{
+    FILE* file = fopen(path, "w");
+
+    if(file == NULL)
+    {
+        return false;
+    }
+
+    for(size_t metricIdx = 0; metricIdx < metricsCount; metricIdx++)
+    {
+        fprintf(file, "%s %.0f\n", metrics[metricIdx].key, metrics[metricIdx].value);
+    }
+
+    return fclose(file) == 0;
+}
+
+static double now_(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec + time.tv_nsec / NANOSECONDS_IN_SECOND;
+}
@@ -0,0 +1,151 @@
+bit:16 f0(bit:16 x)
+{
+    ret x * 3 + 1;
+}
+
+bit:16 f1(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f0(a) ^ 16:f0(b);
+}
+
+bit:16 f2(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f1(a) ^ 16:f1(b);
+}
+
+bit:16 f3(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f2(a) ^ 16:f2(b);
+}
+
+bit:16 f4(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f3(a) ^ 16:f3(b);
+}
+
+bit:16 f5(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f4(a) ^ 16:f4(b);
+}
+
+bit:16 f6(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f5(a) ^ 16:f5(b);
+}
+
+bit:16 f7(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f6(a) ^ 16:f6(b);
+}
+
+bit:16 f8(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f7(a) ^ 16:f7(b);
+}
+
+bit:16 f9(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f8(a) ^ 16:f8(b);
+}
+
+bit:16 f10(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f9(a) ^ 16:f9(b);
+}
+
+bit:16 f11(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f10(a) ^ 16:f10(b);
+}
+
+bit:16 f12(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f11(a) ^ 16:f11(b);
+}
+
+bit:16 f13(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f12(a) ^ 16:f12(b);
+}
+
+bit:16 f14(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f13(a) ^ 16:f13(b);
+}
+
+bit:16 f15(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f14(a) ^ 16:f14(b);
+}
+
+bit:16 f16(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f15(a) ^ 16:f15(b);
+}
+
+bit:16 f17(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f16(a) ^ 16:f16(b);
+}
+
+bit:16 f18(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f17(a) ^ 16:f17(b);
+}
+
+bit:16 f19(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f18(a) ^ 16:f18(b);
+}
+
+bit:16 f20(bit:16 x)
+{
+    bit:16 a = x + 1;
+    bit:16 b = x * 5;
+    ret 16:f19(a) ^ 16:f19(b);
+}
+
+bit:0 main()
+{
+    bit:16 x = 7;
+    bit:16 r = 16:f20(x);
+    print(r);
+}
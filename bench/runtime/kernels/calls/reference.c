@@ -0,0 +1,40 @@
+/**
+ * @file reference.c
+ *
+ * Hand written C of calls kernel, binary call tree of depth 20 as plain recursion
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-15
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define DEPTH           20
+
+// Not known at compile time, so recursion cannot be folded away
+static volatile unsigned depth = DEPTH;
+
+static uint16_t f_(const unsigned level, const uint16_t x)
+{
+    if(level == 0)
+    {
+        return x * 3 + 1;
+    }
+
+    const uint16_t a = x + 1;
+    const uint16_t b = x * 5;
+
+    return f_(level - 1, a) ^ f_(level - 1, b);
+}
+
+int main(void)
+{
+    printf("%u\n", (unsigned) f_(depth, 7));
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+bit:16 seed;
+bit:8 data;
+bit:8 sum1;
+bit:8 sum2;
+
+bit:1 reset()
+{
+    seed = 1;
+    data = 0;
+    sum1 = 0;
+    sum2 = 0;
+    ret 0;
+}
+
+bit:1 step()
+{
+    seed = seed * 25173 + 13849;
+    data = seed / 256;
+    sum1 = (sum1 + data) % 255;
+    sum2 = (sum2 + sum1) % 255;
+    ret 0;
+}
+
+bit:1 l1()
+{
+    bit:1 d = 1:step() + 1:step() + 1:step() + 1:step();
+    ret d;
+}
+
+bit:1 l2()
+{
+    bit:1 d = 1:l1() + 1:l1() + 1:l1() + 1:l1();
+    ret d;
+}
+
+bit:1 l3()
+{
+    bit:1 d = 1:l2() + 1:l2() + 1:l2() + 1:l2();
+    ret d;
+}
+
+bit:1 l4()
+{
+    bit:1 d = 1:l3() + 1:l3() + 1:l3() + 1:l3();
+    ret d;
+}
+
+bit:1 l5()
+{
+    bit:1 d = 1:l4() + 1:l4() + 1:l4() + 1:l4();
+    ret d;
+}
+
+bit:1 l6()
+{
+    bit:1 d = 1:l5() + 1:l5() + 1:l5() + 1:l5();
+    ret d;
+}
+
+bit:1 l7()
+{
+    bit:1 d = 1:l6() + 1:l6() + 1:l6() + 1:l6();
+    ret d;
+}
+
+bit:1 l8()
+{
+    bit:1 d = 1:l7() + 1:l7() + 1:l7() + 1:l7();
+    ret d;
+}
+
+bit:1 l9()
+{
+    bit:1 d = 1:l8() + 1:l8() + 1:l8() + 1:l8();
+    ret d;
+}
+
+bit:1 l10()
+{
+    bit:1 d = 1:l9() + 1:l9() + 1:l9() + 1:l9();
+    ret d;
+}
+
+bit:16 result()
+{
+    ret sum2 * 256 + sum1;
+}
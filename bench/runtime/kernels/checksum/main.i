@@ -0,0 +1,8 @@
+bit:0 main()
+{
+    bit:40<checksum> k;
+    bit:1 z = 1:k.reset();
+    bit:1 d = 1:k.l10();
+    bit:16 r = 16:k.result();
+    print(r);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file reference.c
+ *
+ * Hand written C of checksum kernel, Fletcher-16 of pseudo random bytes in plain loop
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-15
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define OPERATIONS      1048576UL
+
+struct
+{
+    unsigned seed : 16;
+    unsigned data : 8;
+    unsigned sum1 : 8;
+    unsigned sum2 : 8;
+}state = {1, 0, 0, 0};
+
+// Not known at compile time, so loop cannot be folded away
+static volatile unsigned long operations = OPERATIONS;
+
+static void step_(void)
+{
+    state.seed = state.seed * 25173 + 13849;
+    state.data = state.seed / 256;
+    state.sum1 = (state.sum1 + state.data) % 255;
+    state.sum2 = (state.sum2 + state.sum1) % 255;
+}
+
+int main(void)
+{
+    const unsigned long count = operations;
+
+    for(unsigned long operationIdx = 0; operationIdx < count; operationIdx++)
+    {
+        step_();
+    }
+
+    printf("%u\n", (unsigned) ((state.sum2 * 256 + state.sum1) & 0xFFFF));
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+bit:3 a;
+bit:4 b;
+bit:7 c;
+bit:10 d;
+bit:16 sum;
+
+bit:1 reset()
+{
+    a = 0;
+    b = 0;
+    c = 0;
+    d = 0;
+    sum = 0;
+    ret 0;
+}
+
+bit:1 step()
+{
+    a = (a + 1) % 6;
+    b = (b + 1) % 10;
+    c = (c + 3) % 100;
+    d = (d + 7) % 1000;
+    sum = sum + a + b + c + d;
+    ret 0;
+}
+
+bit:1 l1()
+{
+    bit:1 d = 1:step() + 1:step() + 1:step() + 1:step();
+    ret d;
+}
+
+bit:1 l2()
+{
+    bit:1 d = 1:l1() + 1:l1() + 1:l1() + 1:l1();
+    ret d;
+}
+
+bit:1 l3()
+{
+    bit:1 d = 1:l2() + 1:l2() + 1:l2() + 1:l2();
+    ret d;
+}
+
+bit:1 l4()
+{
+    bit:1 d = 1:l3() + 1:l3() + 1:l3() + 1:l3();
+    ret d;
+}
+
+bit:1 l5()
+{
+    bit:1 d = 1:l4() + 1:l4() + 1:l4() + 1:l4();
+    ret d;
+}
+
+bit:1 l6()
+{
+    bit:1 d = 1:l5() + 1:l5() + 1:l5() + 1:l5();
+    ret d;
+}
+
+bit:1 l7()
+{
+    bit:1 d = 1:l6() + 1:l6() + 1:l6() + 1:l6();
+    ret d;
+}
+
+bit:1 l8()
+{
+    bit:1 d = 1:l7() + 1:l7() + 1:l7() + 1:l7();
+    ret d;
+}
+
+bit:1 l9()
+{
+    bit:1 d = 1:l8() + 1:l8() + 1:l8() + 1:l8();
+    ret d;
+}
+
+bit:1 l10()
+{
+    bit:1 d = 1:l9() + 1:l9() + 1:l9() + 1:l9();
+    ret d;
+}
+
+bit:16 result()
+{
+    ret sum;
+}
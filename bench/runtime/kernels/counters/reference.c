@@ -0,0 +1,52 @@
+/**
+ * @file reference.c
+ *
+ * Hand written C of counters kernel, same packed counters stepped in plain loop
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-15
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define OPERATIONS      1048576UL
+
+struct
+{
+    unsigned a : 3;
+    unsigned b : 4;
+    unsigned c : 7;
+    unsigned d : 10;
+    unsigned sum : 16;
+}state;
+
+// Not known at compile time, so loop cannot be folded away
+static volatile unsigned long operations = OPERATIONS;
+
+static void step_(void)
+{
+    state.a = (state.a + 1) % 6;
+    state.b = (state.b + 1) % 10;
+    state.c = (state.c + 3) % 100;
+    state.d = (state.d + 7) % 1000;
+    state.sum = state.sum + state.a + state.b + state.c + state.d;
+}
+
+int main(void)
+{
+    const unsigned long count = operations;
+
+    for(unsigned long operationIdx = 0; operationIdx < count; operationIdx++)
+    {
+        step_();
+    }
+
+    printf("%u\n", (unsigned) state.sum);
+
+    return 0;
+}
@@ -0,0 +1,5 @@
+bit:0 main()
+{
+    bit:1 r = 0;
+    print(r);
+}
@@ -0,0 +1,22 @@
+/**
+ * @file reference.c
+ *
+ * Empty program, its run time is process startup which is subtracted from other kernels
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-15
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+int main(void)
+{
+    printf("0\n");
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+bit:32 balance;
+bit:32 ops;
+bit:48 created;
+bit:16 flags;
+
+bit:1 reset()
+{
+    balance = 7;
+    ops = 0;
+    created = 123456789012;
+    flags = 42405;
+    ret 0;
+}
+
+bit:1 step()
+{
+    ops = ops + 1;
+    balance = balance * 5 + ops;
+    ret 0;
+}
+
+bit:1 l1()
+{
+    bit:1 d = 1:step() + 1:step() + 1:step() + 1:step();
+    ret d;
+}
+
+bit:1 l2()
+{
+    bit:1 d = 1:l1() + 1:l1() + 1:l1() + 1:l1();
+    ret d;
+}
+
+bit:1 l3()
+{
+    bit:1 d = 1:l2() + 1:l2() + 1:l2() + 1:l2();
+    ret d;
+}
+
+bit:1 l4()
+{
+    bit:1 d = 1:l3() + 1:l3() + 1:l3() + 1:l3();
+    ret d;
+}
+
+bit:1 l5()
+{
+    bit:1 d = 1:l4() + 1:l4() + 1:l4() + 1:l4();
+    ret d;
+}
+
+bit:1 l6()
+{
+    bit:1 d = 1:l5() + 1:l5() + 1:l5() + 1:l5();
+    ret d;
+}
+
+bit:1 l7()
+{
+    bit:1 d = 1:l6() + 1:l6() + 1:l6() + 1:l6();
+    ret d;
+}
+
+bit:1 l8()
+{
+    bit:1 d = 1:l7() + 1:l7() + 1:l7() + 1:l7();
+    ret d;
+}
+
+bit:1 l9()
+{
+    bit:1 d = 1:l8() + 1:l8() + 1:l8() + 1:l8();
+    ret d;
+}
+
+bit:1 l10()
+{
+    bit:1 d = 1:l9() + 1:l9() + 1:l9() + 1:l9();
+    ret d;
+}
+
+bit:32 result()
+{
+    ret balance;
+}
+
+bit:32 counted()
+{
+    ret ops;
+}
+
+bit:48 createdAt()
+{
+    ret created;
+}
+
+bit:16 flagged()
+{
+    ret flags;
+}
@@ -0,0 +1,11 @@
+bit:0 main()
+{
+    bit:128<account> k;
+    bit:1 z = 1:k.reset();
+    bit:1 d = 1:k.l10();
+    bit:32 r = 32:k.result();
+    bit:32 n = 32:k.counted();
+    bit:48 c = 48:k.createdAt();
+    bit:16 f = 16:k.flagged();
+    print(r, n, c, f);
+}
@@ -0,0 +1,48 @@
+/**
+ * @file reference.c
+ *
+ * Hand written C of hot/cold kernel, frequently stepped fields next to rarely read ones
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-28
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define OPERATIONS      1048576UL
+
+struct
+{
+    uint32_t balance;
+    uint32_t ops;
+    uint64_t created : 48;
+    uint64_t flags : 16;
+}state = {7, 0, 123456789012ULL, 42405};
+
+// Not known at compile time, so loop cannot be folded away
+static volatile unsigned long operations = OPERATIONS;
+
+static void step_(void)
+{
+    state.ops = state.ops + 1;
+    state.balance = state.balance * 5 + state.ops;
+}
+
+int main(void)
+{
+    const unsigned long count = operations;
+
+    for(unsigned long operationIdx = 0; operationIdx < count; operationIdx++)
+    {
+        step_();
+    }
+
+    printf("%u %u %lu %u\n", state.balance, state.ops, (unsigned long) state.created, (unsigned) state.flags);
+
+    return 0;
+}
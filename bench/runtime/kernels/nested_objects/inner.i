@@ -0,0 +1,30 @@
+bit:12 a;
+bit:12 b;
+bit:12 c;
+bit:12 d;
+bit:12 e;
+
+bit:1 reset()
+{
+    a = 1;
+    b = 2;
+    c = 3;
+    d = 4;
+    e = 0;
+    ret 0;
+}
+
+bit:1 step()
+{
+    a = (a + 1) % 4000;
+    b = (b + 7) % 3001;
+    c = (c + 13) % 2003;
+    d = (d + 5) % 1021;
+    e = e + (a ^ d) + b + c;
+    ret 0;
+}
+
+bit:12 result()
+{
+    ret e;
+}
@@ -0,0 +1,10 @@
+bit:0 main()
+{
+    bit:82<outer> o;
+    bit:1 z = 1:o.reset();
+    bit:1 d = 1:o.l10();
+    bit:12 r = 12:o.result();
+    bit:11 n = 11:o.counted();
+    bit:7 t = 7:o.tagged();
+    print(r, n, t);
+}
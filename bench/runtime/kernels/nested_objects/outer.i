@@ -0,0 +1,94 @@
+bit:60<inner> in;
+bit:11 count;
+bit:7 tag;
+
+bit:1 reset()
+{
+    count = 0;
+    tag = 5;
+    bit:1 z = 1:in.reset();
+    ret 0;
+}
+
+bit:1 step()
+{
+    bit:1 z = 1:in.step();
+    count = count + 1;
+    tag = tag * 3 + 1;
+    ret 0;
+}
+
+bit:1 l1()
+{
+    bit:1 d = 1:step() + 1:step() + 1:step() + 1:step();
+    ret d;
+}
+
+bit:1 l2()
+{
+    bit:1 d = 1:l1() + 1:l1() + 1:l1() + 1:l1();
+    ret d;
+}
+
+bit:1 l3()
+{
+    bit:1 d = 1:l2() + 1:l2() + 1:l2() + 1:l2();
+    ret d;
+}
+
+bit:1 l4()
+{
+    bit:1 d = 1:l3() + 1:l3() + 1:l3() + 1:l3();
+    ret d;
+}
+
+bit:1 l5()
+{
+    bit:1 d = 1:l4() + 1:l4() + 1:l4() + 1:l4();
+    ret d;
+}
+
+bit:1 l6()
+{
+    bit:1 d = 1:l5() + 1:l5() + 1:l5() + 1:l5();
+    ret d;
+}
+
+bit:1 l7()
+{
+    bit:1 d = 1:l6() + 1:l6() + 1:l6() + 1:l6();
+    ret d;
+}
+
+bit:1 l8()
+{
+    bit:1 d = 1:l7() + 1:l7() + 1:l7() + 1:l7();
+    ret d;
+}
+
+bit:1 l9()
+{
+    bit:1 d = 1:l8() + 1:l8() + 1:l8() + 1:l8();
+    ret d;
+}
+
+bit:1 l10()
+{
+    bit:1 d = 1:l9() + 1:l9() + 1:l9() + 1:l9();
+    ret d;
+}
+
+bit:12 result()
+{
+    ret 12:in.result();
+}
+
+bit:11 counted()
+{
+    ret count;
+}
+
+bit:7 tagged()
+{
+    ret tag;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file reference.c
+ *
+ * Hand written C of nested objects kernel, outer object stepping object held inside it
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-28
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define OPERATIONS      1048576UL
+
+struct
+{
+    struct
+    {
+        unsigned a : 12;
+        unsigned b : 12;
+        unsigned c : 12;
+        unsigned d : 12;
+        unsigned e : 12;
+    }in;
+    unsigned count : 11;
+    unsigned tag : 7;
+}state = {{1, 2, 3, 4, 0}, 0, 5};
+
+// Not known at compile time, so loop cannot be folded away
+static volatile unsigned long operations = OPERATIONS;
+
+static void step_(void)
+{
+    state.in.a = (state.in.a + 1) % 4000;
+    state.in.b = (state.in.b + 7) % 3001;
+    state.in.c = (state.in.c + 13) % 2003;
+    state.in.d = (state.in.d + 5) % 1021;
+    state.in.e = state.in.e + (state.in.a ^ state.in.d) + state.in.b + state.in.c;
+    state.count = state.count + 1;
+    state.tag = state.tag * 3 + 1;
+}
+
+int main(void)
+{
+    const unsigned long count = operations;
+
+    for(unsigned long operationIdx = 0; operationIdx < count; operationIdx++)
+    {
+        step_();
+    }
+
+    printf("%u %u %u\n", (unsigned) state.in.e, (unsigned) state.count, (unsigned) state.tag);
+
+    return 0;
+}
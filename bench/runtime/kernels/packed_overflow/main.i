@@ -0,0 +1,11 @@
+bit:0 main()
+{
+    bit:32<packed> k;
+    bit:1 z = 1:k.reset();
+    bit:1 d = 1:k.l10();
+    bit:4 l = 4:k.lowed();
+    bit:4 h = 4:k.highed();
+    bit:8 m = 8:k.mixing();
+    bit:16 n = 16:k.counted();
+    print(l, h, m, n);
+}
@@ -0,0 +1,102 @@
+bit:4 low;
+bit:4 high;
+bit:8 mixed;
+bit:16 steps;
+
+bit:1 reset()
+{
+    low = 3;
+    high = 9;
+    mixed = 77;
+    steps = 1234;
+    ret 0;
+}
+
+bit:1 step()
+{
+    low = low * 3 + 7;
+    high = high + (5 ^ 3) + low;
+    mixed = mixed * mixed + low + high + 200;
+    steps = steps * 5 + mixed;
+    ret 0;
+}
+
+bit:1 l1()
+{
+    bit:1 d = 1:step() + 1:step() + 1:step() + 1:step();
+    ret d;
+}
+
+bit:1 l2()
+{
+    bit:1 d = 1:l1() + 1:l1() + 1:l1() + 1:l1();
+    ret d;
+}
+
+bit:1 l3()
+{
+    bit:1 d = 1:l2() + 1:l2() + 1:l2() + 1:l2();
+    ret d;
+}
+
+bit:1 l4()
+{
+    bit:1 d = 1:l3() + 1:l3() + 1:l3() + 1:l3();
+    ret d;
+}
+
+bit:1 l5()
+{
+    bit:1 d = 1:l4() + 1:l4() + 1:l4() + 1:l4();
+    ret d;
+}
+
+bit:1 l6()
+{
+    bit:1 d = 1:l5() + 1:l5() + 1:l5() + 1:l5();
+    ret d;
+}
+
+bit:1 l7()
+{
+    bit:1 d = 1:l6() + 1:l6() + 1:l6() + 1:l6();
+    ret d;
+}
+
+bit:1 l8()
+{
+    bit:1 d = 1:l7() + 1:l7() + 1:l7() + 1:l7();
+    ret d;
+}
+
+bit:1 l9()
+{
+    bit:1 d = 1:l8() + 1:l8() + 1:l8() + 1:l8();
+    ret d;
+}
+
+bit:1 l10()
+{
+    bit:1 d = 1:l9() + 1:l9() + 1:l9() + 1:l9();
+    ret d;
+}
+
+bit:4 lowed()
+{
+    ret low;
+}
+
+bit:4 highed()
+{
+    ret high;
+}
+
+bit:8 mixing()
+{
+    ret mixed;
+}
+
+bit:16 counted()
+{
+    ret steps;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file reference.c
+ *
+ * Hand written C of packed overflow kernel, results wrap inside their own fields
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-28
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define OPERATIONS      1048576UL
+
+struct
+{
+    unsigned low : 4;
+    unsigned high : 4;
+    unsigned mixed : 8;
+    unsigned steps : 16;
+}state = {3, 9, 77, 1234};
+
+// Not known at compile time, so loop cannot be folded away
+static volatile unsigned long operations = OPERATIONS;
+
+static void step_(void)
+{
+    state.low = state.low * 3 + 7;
+    state.high = state.high + (5 ^ 3) + state.low;
+    state.mixed = state.mixed * state.mixed + state.low + state.high + 200;
+    state.steps = state.steps * 5 + state.mixed;
+}
+
+int main(void)
+{
+    const unsigned long count = operations;
+
+    for(unsigned long operationIdx = 0; operationIdx < count; operationIdx++)
+    {
+        step_();
+    }
+
+    printf("%u %u %u %u\n", (unsigned) state.low, (unsigned) state.high, (unsigned) state.mixed, (unsigned) state.steps);
+
+    return 0;
+}
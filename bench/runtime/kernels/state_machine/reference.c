@@ -0,0 +1,50 @@
+/**
+ * @file reference.c
+ *
+ * Hand written C of state machine kernel, same packed state stepped in plain loop
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-15
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define OPERATIONS      1048576UL
+
+struct
+{
+    unsigned state : 2;
+    unsigned seed : 16;
+    unsigned visits : 8;
+    unsigned trace : 12;
+}state = {0, 1, 0, 0};
+
+// Not known at compile time, so loop cannot be folded away
+static volatile unsigned long operations = OPERATIONS;
+
+static void step_(void)
+{
+    state.seed = state.seed * 75 + 74;
+    state.state = state.state * 3 + state.seed / 16384;
+    state.visits = state.visits + state.state;
+    state.trace = state.trace * 4 + state.state;
+}
+
+int main(void)
+{
+    const unsigned long count = operations;
+
+    for(unsigned long operationIdx = 0; operationIdx < count; operationIdx++)
+    {
+        step_();
+    }
+
+    printf("%u\n", (unsigned) ((state.visits * 4096 + state.trace) & 0xFFFFF));
+
+    return 0;
+}
@@ -0,0 +1,8 @@
+bit:0 main()
+{
+    bit:256<product> k;
+    bit:1 z = 1:k.reset();
+    bit:1 d = 1:k.l10();
+    bit:128 r = 128:k.result();
+    print(r);
+}
@@ -0,0 +1,65 @@
+/**
+ * @file reference.c
+ *
+ * Hand written C of wide product kernel, 64 bit fields multiplied into 128 bit sum
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-28
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define OPERATIONS      1048576UL
+#define DECIMAL_DIGITS  40
+
+struct
+{
+    uint64_t x;
+    uint64_t y;
+    unsigned __int128 total;
+}state = {88172645463325252ULL, 0, 0};
+
+// Not known at compile time, so loop cannot be folded away
+static volatile unsigned long operations = OPERATIONS;
+
+static void step_(void)
+{
+    state.x = state.x * 6364136223846793005ULL + 1442695040888963407ULL;
+    state.y = state.y + state.x;
+    state.total = state.total + (unsigned __int128) state.x * state.y - state.y;
+}
+
+static void print128_(unsigned __int128 value)
+{
+    char digits[DECIMAL_DIGITS + 1];
+    size_t digitIdx = DECIMAL_DIGITS;
+
+    digits[DECIMAL_DIGITS] = '\0';
+
+    do
+    {
+        digits[--digitIdx] = (char) ('0' + (unsigned) (value % 10));
+        value /= 10;
+    }while(value != 0);
+
+    printf("%s\n", &digits[digitIdx]);
+}
+
+int main(void)
+{
+    const unsigned long count = operations;
+
+    for(unsigned long operationIdx = 0; operationIdx < count; operationIdx++)
+    {
+        step_();
+    }
+
+    print128_(state.total);
+
+    return 0;
+}
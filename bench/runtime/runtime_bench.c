@@ -0,0 +1,935 @@
+/**
+ * @file runtime_bench.c
+ *
+ * Runtime benchmark of generated code. Every kernel is built from Iguana sources with C and
+ * assembly backends and from its hand written C reference, all of them are run, outputs are
+ * checked against reference and ns per operation, code size and state size are reported.
+ *
+ * Kernel is directory with main.i (entry), other Iguana objects, reference.c and kernel.conf
+ * of "key value" lines: description, operations done by one run, object holding kernel state and
+ * compiler options of kernel. Kernel named "empty" measures process startup, which is subtracted
+ * from every other kernel.
+ *
+ * Object sizes depend on compiler options, so bit:N<Object> declarations of kernel sources are
+ * rewritten to sizes objects get with options of this run before kernel is built.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-15
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <argp.h>
+#include <dirent.h>
+#include <elf.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+////////////////////////////////
+// DEFINES
+
+#define REPEAT_DEFAULT          5
+#define MAX_KERNELS             64
+#define PATH_LENGTH             4096
+#define EXECUTABLE_LENGTH       (2 * PATH_LENGTH)
+#define COMMAND_LENGTH          (8 * PATH_LENGTH)
+#define CONF_VALUE_LENGTH       256
+#define OUTPUT_LENGTH           4096
+#define NANOSECONDS_IN_SECOND   1e9
+
+#define STARTUP_KERNEL_NAME     "empty"
+#define KERNEL_CONF_NAME        "kernel.conf"
+#define KERNEL_ENTRY_NAME       "main.i"
+#define KERNEL_REFERENCE_NAME   "reference.c"
+#define REFERENCE_STATE_SYMBOL  "state"
+#define IGUANA_OUTPUT_NAME      "output.out"
+#define KERNEL_SOURCES_NAME     "sources"
+#define SOURCE_EXTENSION        ".i"
+#define MAX_KERNEL_OBJECTS      16
+#define SIZEOF_NOTERM(TEXT)     (sizeof(TEXT) - 1)
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+enum
+{
+    OPTION_IGUANA = 0x100,
+    OPTION_CC,
+    OPTION_CFLAGS,
+    OPTION_REPEAT,
+    OPTION_WORK,
+    OPTION_IGUANA_OPTIONS
+};
+
+static struct argp_option options[] = {
+    { "iguana", OPTION_IGUANA, "PATH", 0, "Iguana compiler executable" },
+    { "cc", OPTION_CC, "CC", 0, "C compiler of references (default: gcc)" },
+    { "cflags", OPTION_CFLAGS, "FLAGS", 0, "Flags of references (default: -O2)" },
+    { "repeat", OPTION_REPEAT, "N", 0, "Runs of every program, best one is reported (default: 5)" },
+    { "work", OPTION_WORK, "DIR", 0, "Directory for built programs (default: runtime_work)" },
+    { "iguana-options", OPTION_IGUANA_OPTIONS, "OPTIONS", 0, "Options of every Iguana build, ex: \"--layout=hot-cold --word-bits=32\"" },
+    { 0 }
+};
+
+typedef enum
+{
+    VARIANT_IGUANA_C,
+    VARIANT_IGUANA_ASM,
+    VARIANT_REFERENCE,
+
+    VARIANTS_COUNT
+}Variant_t;
+
+static const char* VARIANT_NAMES[VARIANTS_COUNT] = {"iguana-c", "iguana-asm", "c"};
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef struct
+{
+    const char* iguanaPath;
+    const char* cc;
+    const char* cflags;
+    const char* workDir;
+    const char* kernelsDir;
+    const char* iguanaOptions;
+    uint32_t repeat;
+}BenchOptions_t;
+
+typedef struct
+{
+    char name[CONF_VALUE_LENGTH];
+    char description[CONF_VALUE_LENGTH];
+    char object[CONF_VALUE_LENGTH];
+    char options[CONF_VALUE_LENGTH];
+    uint64_t operations;
+}Kernel_t;
+
+typedef struct
+{
+    char name[CONF_VALUE_LENGTH];
+    uint64_t bits;
+}ObjectSize_t;
+
+typedef struct
+{
+    bool isBuilt;
+    double seconds;
+    uint64_t textBytes;
+    uint64_t stateBits;
+    char output[OUTPUT_LENGTH];
+}RunResult_t;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static error_t parseOption_(int key, char *arg, struct argp_state *state);
+static size_t collectKernels_(const char* kernelsDir, Kernel_t* kernels);
+static int compareKernels_(const void* left, const void* right);
+static bool readKernelConf_(const char* kernelsDir, Kernel_t* kernel);
+static bool prepareSources_(const BenchOptions_t* bench, const Kernel_t* kernel);
+static bool measureObjectSize_(const BenchOptions_t* bench, const Kernel_t* kernel, const char* sourcesDir, ObjectSize_t* objectSize);
+static bool isSourceName_(const char* name);
+static bool rewriteDeclaredSizes_(const char* fromPath, const char* toPath, const ObjectSize_t* objectSizes, const size_t objectsCount);
+static char* readFile_(const char* path, long* size);
+static bool buildVariant_(const BenchOptions_t* bench, const Kernel_t* kernel, const Variant_t variant, char* executable);
+static bool runBest_(const char* executable, const uint32_t repeat, RunResult_t* result);
+static bool runOnce_(const char* executable, double* seconds, char* output);
+static bool inspectElf_(const char* path, const char* object, const Variant_t variant, RunResult_t* result);
+static bool stateBitsOfSymbol_(const char* symbol, const char* object, uint64_t* bits);
+static bool isSameOutput_(const char* left, const char* right);
+static double now_(void);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+int main(int argc, char **argv)
+{
+    BenchOptions_t bench = {NULL, "gcc", "-O2", "runtime_work", NULL, "", REPEAT_DEFAULT};
+    struct argp argp = { options, parseOption_, "KERNELS_DIR", "Iguana generated code runtime benchmark", 0, 0, 0 };
+    static Kernel_t kernels[MAX_KERNELS];
+    double startupSeconds[VARIANTS_COUNT] = {0};
+    size_t kernelsCount;
+    int status = EXIT_SUCCESS;
+
+    argp_parse(&argp, argc, argv, 0, 0, &bench);
+
+    if((bench.iguanaPath == NULL) || (bench.kernelsDir == NULL))
+    {
+        fprintf(stderr, "Error: --iguana and kernels directory are required\n");
+        return EXIT_FAILURE;
+    }
+
+    if((mkdir(bench.workDir, 0755) != 0) && (errno != EEXIST))
+    {
+        fprintf(stderr, "Error: failed to create %s\n", bench.workDir);
+        return EXIT_FAILURE;
+    }
+
+    kernelsCount = collectKernels_(bench.kernelsDir, kernels);
+
+    if(kernelsCount == 0)
+    {
+        fprintf(stderr, "Error: no kernels in %s\n", bench.kernelsDir);
+        return EXIT_FAILURE;
+    }
+
+    printf("Runtime: %zu kernels, Iguana options '%s', references built with %s %s, best of %u runs, startup subtracted\n",
+        kernelsCount, bench.iguanaOptions, bench.cc, bench.cflags, bench.repeat);
+    printf("%-16s %-12s %12s %10s %10s %8s  %s\n", "kernel", "variant", "ns/op", "vs c", "text B", "state b", "output");
+
+    for(size_t kernelIdx = 0; kernelIdx < kernelsCount; kernelIdx++)
+    {
+        const Kernel_t* kernel = &kernels[kernelIdx];
+        const bool isStartup = (strcmp(kernel->name, STARTUP_KERNEL_NAME) == 0);
+        const bool isPrepared = prepareSources_(&bench, kernel);
+        RunResult_t results[VARIANTS_COUNT];
+
+        for(Variant_t variant = 0; variant < VARIANTS_COUNT; variant++)
+        {
+            char executable[EXECUTABLE_LENGTH];
+            RunResult_t* result = &results[variant];
+
+            memset(result, 0, sizeof(RunResult_t));
+
+            result->isBuilt = (isPrepared || (variant == VARIANT_REFERENCE)) &&
+                              buildVariant_(&bench, kernel, variant, executable) &&
+                              runBest_(executable, bench.repeat, result) &&
+                              inspectElf_(executable, kernel->object, variant, result);
+
+            if(isStartup && result->isBuilt)
+            {
+                startupSeconds[variant] = result->seconds;
+            }
+        }
+
+        for(Variant_t variant = 0; variant < VARIANTS_COUNT; variant++)
+        {
+            const RunResult_t* result = &results[variant];
+            const RunResult_t* reference = &results[VARIANT_REFERENCE];
+
+            if(!result->isBuilt)
+            {
+                printf("%-16s %-12s %12s %10s %10s %8s  %s\n", kernel->name, VARIANT_NAMES[variant], "-", "-", "-", "-", "FAILED");
+                status = EXIT_FAILURE;
+                continue;
+            }
+
+            const bool isMatching = !reference->isBuilt || isSameOutput_(result->output, reference->output);
+            const double nsPerOperation = (kernel->operations == 0) ? (result->seconds * NANOSECONDS_IN_SECOND) :
+                ((result->seconds - startupSeconds[variant]) * NANOSECONDS_IN_SECOND / kernel->operations);
+            const double referenceNs = (kernel->operations == 0) ? (reference->seconds * NANOSECONDS_IN_SECOND) :
+                ((reference->seconds - startupSeconds[VARIANT_REFERENCE]) * NANOSECONDS_IN_SECOND / kernel->operations);
+            char stateBits[32] = "-";
+
+            if(result->stateBits != 0)
+            {
+                snprintf(stateBits, sizeof(stateBits), "%lu", result->stateBits);
+            }
+
+            printf("%-16s %-12s %12.3f", kernel->name, VARIANT_NAMES[variant], nsPerOperation);
+
+            if(reference->isBuilt && (referenceNs > 0))
+            {
+                printf(" %9.2fx", nsPerOperation / referenceNs);
+            }else
+            {
+                printf(" %10s", "-");
+            }
+
+            printf(" %10lu %8s  %s\n", result->textBytes, stateBits, isMatching ? "ok" : "MISMATCH");
+
+            if(!isMatching)
+            {
+                status = EXIT_FAILURE;
+            }
+        }
+    }
+
+    return status;
+}
+
+static error_t parseOption_(int key, char *arg, struct argp_state *state)
+{
+    BenchOptions_t* bench = state->input;
+
+    switch (key)
+    {
+        case OPTION_IGUANA:     bench->iguanaPath = arg; break;
+        case OPTION_CC:         bench->cc = arg; break;
+        case OPTION_CFLAGS:     bench->cflags = arg; break;
+        case OPTION_REPEAT:     bench->repeat = strtoul(arg, NULL, 10); break;
+        case OPTION_WORK:       bench->workDir = arg; break;
+        case OPTION_IGUANA_OPTIONS: bench->iguanaOptions = arg; break;
+
+        case ARGP_KEY_ARG:
+        {
+            if(bench->kernelsDir != NULL)
+            {
+                argp_error(state, "only one kernels directory is expected");
+            }
+
+            bench->kernelsDir = arg;
+        }break;
+
+        default: return ARGP_ERR_UNKNOWN;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Private method for collecting kernels, startup kernel is always first so it is
+ * measured before kernels which subtract it
+ */
+static size_t collectKernels_(const char* kernelsDir, Kernel_t* kernels)
+{
+    DIR* directory = opendir(kernelsDir);
+    struct dirent* entry;
+    size_t kernelsCount = 0;
+
+    if(directory == NULL)
+    {
+        return 0;
+    }
+
+    while(((entry = readdir(directory)) != NULL) && (kernelsCount < MAX_KERNELS))
+    {
+        Kernel_t* kernel = &kernels[kernelsCount];
+
+        if((entry->d_name[0] == '.') || (strlen(entry->d_name) >= sizeof(kernel->name)))
+        {
+            continue;
+        }
+
+        strcpy(kernel->name, entry->d_name);
+
+        if(readKernelConf_(kernelsDir, kernel))
+        {
+            kernelsCount++;
+        }
+    }
+
+    closedir(directory);
+
+    qsort(kernels, kernelsCount, sizeof(Kernel_t), compareKernels_);
+
+    return kernelsCount;
+}
+
+static int compareKernels_(const void* left, const void* right)
+{
+    const Kernel_t* leftKernel = left;
+    const Kernel_t* rightKernel = right;
+    const bool isLeftStartup = (strcmp(leftKernel->name, STARTUP_KERNEL_NAME) == 0);
+    const bool isRightStartup = (strcmp(rightKernel->name, STARTUP_KERNEL_NAME) == 0);
+
+    if(isLeftStartup != isRightStartup)
+    {
+        return isLeftStartup ? -1 : 1;
+    }
+
+    return strcmp(leftKernel->name, rightKernel->name);
+}
+
+static bool readKernelConf_(const char* kernelsDir, Kernel_t* kernel)
+{
+    char path[PATH_LENGTH];
+    char line[CONF_VALUE_LENGTH * 2];
+    FILE* file;
+
+    snprintf(path, sizeof(path), "%s/%s/" KERNEL_CONF_NAME, kernelsDir, kernel->name);
+    file = fopen(path, "r");
+
+    if(file == NULL)
+    {
+        return false;
+    }
+
+    strcpy(kernel->object, "-");
+    kernel->options[0] = '\0';
+    kernel->description[0] = '\0';
+    kernel->operations = 0;
+
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        char* value = strchr(line, ' ');
+
+        if(value == NULL)
+        {
+            continue;
+        }
+
+        *value++ = '\0';
+        value[strcspn(value, "\n")] = '\0';
+
+        if(strcmp(line, "description") == 0)
+        {
+            snprintf(kernel->description, sizeof(kernel->description), "%s", value);
+        }else if(strcmp(line, "operations") == 0)
+        {
+            kernel->operations = strtoull(value, NULL, 10);
+        }else if(strcmp(line, "object") == 0)
+        {
+            snprintf(kernel->object, sizeof(kernel->object), "%s", value);
+        }else if(strcmp(line, "options") == 0)
+        {
+            snprintf(kernel->options, sizeof(kernel->options), "%s", value);
+        }
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+/**
+ * @brief Private method for copying Iguana sources of kernel to its build directory, bit:N<Object>
+ * declarations get sizes which objects of kernel have with options of this run. Object may hold
+ * other objects, so sizes are measured from copies again until none of them changes.
+ */
+static bool prepareSources_(const BenchOptions_t* bench, const Kernel_t* kernel)
+{
+    static ObjectSize_t objectSizes[MAX_KERNEL_OBJECTS];
+    char kernelDir[PATH_LENGTH];
+    char sourcesDir[PATH_LENGTH];
+    char* kernelPath;
+    struct dirent* entry;
+    size_t objectsCount = 0;
+    DIR* directory;
+    bool isChanged = true;
+    bool status = true;
+
+    snprintf(kernelDir, sizeof(kernelDir), "%s/%s", bench->kernelsDir, kernel->name);
+    snprintf(sourcesDir, sizeof(sourcesDir), "%s/%s", bench->workDir, kernel->name);
+
+    if((mkdir(sourcesDir, 0755) != 0) && (errno != EEXIST))
+    {
+        return false;
+    }
+
+    snprintf(sourcesDir, sizeof(sourcesDir), "%s/%s/" KERNEL_SOURCES_NAME, bench->workDir, kernel->name);
+
+    if(((mkdir(sourcesDir, 0755) != 0) && (errno != EEXIST)) || ((kernelPath = realpath(kernelDir, NULL)) == NULL))
+    {
+        return false;
+    }
+
+    directory = opendir(kernelPath);
+
+    if(directory == NULL)
+    {
+        free(kernelPath);
+        return false;
+    }
+
+    // Entry object is not declared by others, every other one is compiled alone to learn its size
+    while((entry = readdir(directory)) != NULL)
+    {
+        const size_t nameLength = strlen(entry->d_name);
+
+        if(!isSourceName_(entry->d_name) || (strcmp(entry->d_name, KERNEL_ENTRY_NAME) == 0))
+        {
+            continue;
+        }
+
+        if((objectsCount == MAX_KERNEL_OBJECTS) || (nameLength >= sizeof(objectSizes[0].name)))
+        {
+            fprintf(stderr, "Error: too many or too long objects in kernel %s\n", kernel->name);
+            status = false;
+            break;
+        }
+
+        snprintf(objectSizes[objectsCount].name, sizeof(objectSizes[0].name), "%.*s", (int) (nameLength - SIZEOF_NOTERM(SOURCE_EXTENSION)), entry->d_name);
+        objectSizes[objectsCount].bits = 0;
+        objectsCount++;
+    }
+
+    // Every pass settles at least one more level of nesting
+    for(size_t passIdx = 0; status && isChanged && (passIdx <= objectsCount); passIdx++)
+    {
+        isChanged = false;
+        rewinddir(directory);
+
+        while(status && ((entry = readdir(directory)) != NULL))
+        {
+            char fromPath[PATH_LENGTH];
+            char toPath[EXECUTABLE_LENGTH];
+
+            if(!isSourceName_(entry->d_name))
+            {
+                continue;
+            }
+
+            snprintf(fromPath, sizeof(fromPath), "%s/%s", kernelPath, entry->d_name);
+            snprintf(toPath, sizeof(toPath), "%s/%s", sourcesDir, entry->d_name);
+
+            status = rewriteDeclaredSizes_(fromPath, toPath, objectSizes, objectsCount);
+        }
+
+        for(size_t objectIdx = 0; status && (objectIdx < objectsCount); objectIdx++)
+        {
+            const uint64_t previousBits = objectSizes[objectIdx].bits;
+
+            status = measureObjectSize_(bench, kernel, sourcesDir, &objectSizes[objectIdx]);
+            isChanged |= (objectSizes[objectIdx].bits != previousBits);
+        }
+    }
+
+    closedir(directory);
+    free(kernelPath);
+
+    if(status && isChanged)
+    {
+        fprintf(stderr, "Error: sizes of objects of %s do not settle, objects hold each other\n", kernel->name);
+        status = false;
+    }
+
+    if(!status)
+    {
+        fprintf(stderr, "Error: failed to prepare sources of %s, see %s\n", kernel->name, sourcesDir);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Private method for compiling object alone to C and taking its size from mangled names
+ */
+static bool measureObjectSize_(const BenchOptions_t* bench, const Kernel_t* kernel, const char* sourcesDir, ObjectSize_t* objectSize)
+{
+    char command[COMMAND_LENGTH];
+    char generatedPath[EXECUTABLE_LENGTH];
+    char* generated;
+    char* iguanaPath = realpath(bench->iguanaPath, NULL);
+    bool isFound = false;
+    long size;
+    int length;
+
+    if(iguanaPath == NULL)
+    {
+        return false;
+    }
+
+    length = snprintf(command, sizeof(command), "cd '%s' && '%s' %s %s --backend=c -c '%s" SOURCE_EXTENSION "' > '%s.log' 2>&1",
+        sourcesDir, iguanaPath, bench->iguanaOptions, kernel->options, objectSize->name, objectSize->name);
+    free(iguanaPath);
+
+    if((length < 0) || (length >= (int) sizeof(command)) || (system(command) != 0))
+    {
+        fprintf(stderr, "Error: failed to compile object %s of %s\n", objectSize->name, kernel->name);
+        return false;
+    }
+
+    snprintf(generatedPath, sizeof(generatedPath), "%s/%s.c", sourcesDir, objectSize->name);
+    generated = readFile_(generatedPath, &size);
+
+    if(generated == NULL)
+    {
+        return false;
+    }
+
+    for(const char* symbol = strstr(generated, "_ZN"); (symbol != NULL) && !isFound; symbol = strstr(symbol + 1, "_ZN"))
+    {
+        isFound = stateBitsOfSymbol_(symbol, objectSize->name, &objectSize->bits);
+    }
+
+    free(generated);
+
+    if(!isFound)
+    {
+        fprintf(stderr, "Error: no methods of object %s in %s\n", objectSize->name, generatedPath);
+    }
+
+    return isFound;
+}
+
+/**
+ * @brief Private method for copying Iguana source with bit:N<Object> of known objects set to their size
+ */
+static bool rewriteDeclaredSizes_(const char* fromPath, const char* toPath, const ObjectSize_t* objectSizes, const size_t objectsCount)
+{
+    char* source;
+    const char* cursor;
+    FILE* file;
+    long size;
+
+    source = readFile_(fromPath, &size);
+
+    if(source == NULL)
+    {
+        return false;
+    }
+
+    file = fopen(toPath, "w");
+
+    if(file == NULL)
+    {
+        free(source);
+        return false;
+    }
+
+    cursor = source;
+
+    for(const char* declaration = strstr(cursor, "bit:"); declaration != NULL; declaration = strstr(cursor, "bit:"))
+    {
+        const char* sizeEnd = declaration + 4;
+        const ObjectSize_t* declared = NULL;
+
+        while((*sizeEnd >= '0') && (*sizeEnd <= '9'))
+        {
+            sizeEnd++;
+        }
+
+        if(*sizeEnd == '<')
+        {
+            const size_t nameLength = strcspn(sizeEnd + 1, ">");
+
+            for(size_t objectIdx = 0; objectIdx < objectsCount; objectIdx++)
+            {
+                if((strlen(objectSizes[objectIdx].name) == nameLength) && (strncmp(sizeEnd + 1, objectSizes[objectIdx].name, nameLength) == 0))
+                {
+                    declared = &objectSizes[objectIdx];
+                }
+            }
+        }
+
+        if((declared == NULL) || (declared->bits == 0))
+        {
+            fwrite(cursor, 1, sizeEnd - cursor, file);
+        }else
+        {
+            fwrite(cursor, 1, declaration - cursor, file);
+            fprintf(file, "bit:%lu", declared->bits);
+        }
+
+        cursor = sizeEnd;
+    }
+
+    fputs(cursor, file);
+    free(source);
+
+    return (fclose(file) == 0);
+}
+
+static bool isSourceName_(const char* name)
+{
+    const size_t nameLength = strlen(name);
+
+    return (nameLength > SIZEOF_NOTERM(SOURCE_EXTENSION)) && (strcmp(name + nameLength - SIZEOF_NOTERM(SOURCE_EXTENSION), SOURCE_EXTENSION) == 0);
+}
+
+/**
+ * @brief Private method for reading whole file, null terminated
+ */
+static char* readFile_(const char* path, long* size)
+{
+    FILE* file = fopen(path, "rb");
+    char* content;
+
+    if(file == NULL)
+    {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    rewind(file);
+    content = malloc(*size + 1);
+
+    if((content == NULL) || (fread(content, 1, *size, file) != (size_t) *size))
+    {
+        free(content);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    content[*size] = '\0';
+
+    return content;
+}
+
+/**
+ * @brief Private method for building one variant of kernel, Iguana always links to output.out
+ * in working directory, so it is built in its own directory and renamed
+ */
+static bool buildVariant_(const BenchOptions_t* bench, const Kernel_t* kernel, const Variant_t variant, char* executable)
+{
+    char command[COMMAND_LENGTH];
+    char kernelDir[PATH_LENGTH];
+    char buildDir[PATH_LENGTH];
+    int length;
+
+    snprintf(kernelDir, sizeof(kernelDir), "%s/%s", bench->kernelsDir, kernel->name);
+    snprintf(buildDir, sizeof(buildDir), "%s/%s", bench->workDir, kernel->name);
+    snprintf(executable, EXECUTABLE_LENGTH, "%s/%s", buildDir, VARIANT_NAMES[variant]);
+
+    if((mkdir(buildDir, 0755) != 0) && (errno != EEXIST))
+    {
+        return false;
+    }
+
+    if(variant == VARIANT_REFERENCE)
+    {
+        length = snprintf(command, sizeof(command), "%s %s -o '%s' '%s/" KERNEL_REFERENCE_NAME "' > '%s.log' 2>&1",
+            bench->cc, bench->cflags, executable, kernelDir, executable);
+    }else
+    {
+        char* kernelPath;
+        char* iguanaPath = realpath(bench->iguanaPath, NULL);
+
+        // Sources with declared sizes of this run are built instead of kernel ones
+        snprintf(kernelDir, sizeof(kernelDir), "%s/%s/" KERNEL_SOURCES_NAME, bench->workDir, kernel->name);
+        kernelPath = realpath(kernelDir, NULL);
+
+        if((kernelPath == NULL) || (iguanaPath == NULL))
+        {
+            free(kernelPath);
+            free(iguanaPath);
+            return false;
+        }
+
+        // Entry object goes first, rest of objects are taken by shell glob
+        length = snprintf(command, sizeof(command),
+            "cd '%s' && '%s' %s %s --backend=%s '%s/" KERNEL_ENTRY_NAME "' $(ls '%s'/*.i | grep -v '/" KERNEL_ENTRY_NAME "$') > '%s.log' 2>&1 && mv " IGUANA_OUTPUT_NAME " '%s'",
+            buildDir, iguanaPath, bench->iguanaOptions, kernel->options, (variant == VARIANT_IGUANA_ASM) ? "asm" : "c", kernelPath, kernelPath, VARIANT_NAMES[variant], VARIANT_NAMES[variant]);
+
+        free(kernelPath);
+        free(iguanaPath);
+    }
+
+    if((length < 0) || (length >= (int) sizeof(command)))
+    {
+        return false;
+    }
+
+    if(system(command) != 0)
+    {
+        fprintf(stderr, "Error: failed to build %s of %s, see %s.log\n", VARIANT_NAMES[variant], kernel->name, executable);
+        return false;
+    }
+
+    return true;
+}
+
+static bool runBest_(const char* executable, const uint32_t repeat, RunResult_t* result)
+{
+    for(uint32_t runIdx = 0; runIdx < repeat; runIdx++)
+    {
+        double seconds;
+
+        if(!runOnce_(executable, &seconds, result->output))
+        {
+            fprintf(stderr, "Error: %s failed\n", executable);
+            return false;
+        }
+
+        if((runIdx == 0) || (seconds < result->seconds))
+        {
+            result->seconds = seconds;
+        }
+    }
+
+    return true;
+}
+
+static bool runOnce_(const char* executable, double* seconds, char* output)
+{
+    int outputPipe[2];
+    size_t outputLength = 0;
+    ssize_t readLength;
+    int childStatus;
+    double start;
+    pid_t child;
+
+    if(pipe(outputPipe) != 0)
+    {
+        return false;
+    }
+
+    start = now_();
+    child = fork();
+
+    if(child < 0)
+    {
+        close(outputPipe[0]);
+        close(outputPipe[1]);
+        return false;
+    }
+
+    if(child == 0)
+    {
+        dup2(outputPipe[1], STDOUT_FILENO);
+        close(outputPipe[0]);
+        close(outputPipe[1]);
+        execl(executable, executable, (char*) NULL);
+        _exit(127);
+    }
+
+    close(outputPipe[1]);
+
+    while((readLength = read(outputPipe[0], output + outputLength, OUTPUT_LENGTH - 1 - outputLength)) > 0)
+    {
+        outputLength += readLength;
+    }
+
+    close(outputPipe[0]);
+    waitpid(child, &childStatus, 0);
+    *seconds = now_() - start;
+    output[outputLength] = '\0';
+
+    return WIFEXITED(childStatus) && (WEXITSTATUS(childStatus) == 0);
+}
+
+/**
+ * @brief Private method for reading .text size and size of state object from executable,
+ * reference keeps state in "state" symbol, Iguana object size is part of its mangled names
+ */
+static bool inspectElf_(const char* path, const char* object, const Variant_t variant, RunResult_t* result)
+{
+    FILE* file = fopen(path, "rb");
+    uint8_t* image;
+    long size;
+
+    if(file == NULL)
+    {
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    rewind(file);
+    image = malloc(size);
+
+    if((image == NULL) || (fread(image, 1, size, file) != (size_t) size))
+    {
+        free(image);
+        fclose(file);
+        return false;
+    }
+
+    fclose(file);
+
+    const Elf64_Ehdr* header = (const Elf64_Ehdr*) image;
+    const Elf64_Shdr* sections = (const Elf64_Shdr*) (image + header->e_shoff);
+    const char* sectionNames = (const char*) (image + sections[header->e_shstrndx].sh_offset);
+
+    for(uint32_t sectionIdx = 0; sectionIdx < header->e_shnum; sectionIdx++)
+    {
+        const Elf64_Shdr* section = &sections[sectionIdx];
+
+        if(strcmp(sectionNames + section->sh_name, ".text") == 0)
+        {
+            result->textBytes = section->sh_size;
+        }
+
+        if((section->sh_type != SHT_SYMTAB) || (strcmp(object, "-") == 0))
+        {
+            continue;
+        }
+
+        const Elf64_Sym* symbols = (const Elf64_Sym*) (image + section->sh_offset);
+        const char* symbolNames = (const char*) (image + sections[section->sh_link].sh_offset);
+
+        for(uint64_t symbolIdx = 0; symbolIdx < section->sh_size / sizeof(Elf64_Sym); symbolIdx++)
+        {
+            const char* symbolName = symbolNames + symbols[symbolIdx].st_name;
+
+            if(variant == VARIANT_REFERENCE)
+            {
+                if(strcmp(symbolName, REFERENCE_STATE_SYMBOL) == 0)
+                {
+                    result->stateBits = symbols[symbolIdx].st_size * 8;
+                }
+            }else if(stateBitsOfSymbol_(symbolName, object, &result->stateBits))
+            {
+                break;
+            }
+        }
+    }
+
+    free(image);
+
+    return true;
+}
+
+/**
+ * @brief Private method for taking object size from mangled method name, ex: _ZN13bit38_machine...
+ */
+static bool stateBitsOfSymbol_(const char* symbol, const char* object, uint64_t* bits)
+{
+    const size_t objectLength = strlen(object);
+    char* end;
+
+    if(strncmp(symbol, "_ZN", 3) != 0)
+    {
+        return false;
+    }
+
+    strtoul(symbol + 3, &end, 10);
+
+    if(strncmp(end, "bit", 3) != 0)
+    {
+        return false;
+    }
+
+    const uint64_t objectBits = strtoull(end + 3, &end, 10);
+
+    if((*end != '_') || (strncmp(end + 1, object, objectLength) != 0) ||
+       ((end[1 + objectLength] < '0') || (end[1 + objectLength] > '9')))
+    {
+        return false;
+    }
+
+    *bits = objectBits;
+
+    return true;
+}
+
+/**
+ * @brief Private method for comparing printed values, spacing of Iguana print differs from printf
+ */
+static bool isSameOutput_(const char* left, const char* right)
+{
+    while(true)
+    {
+        left += strspn(left, " \t\n");
+        right += strspn(right, " \t\n");
+
+        const size_t leftLength = strcspn(left, " \t\n");
+        const size_t rightLength = strcspn(right, " \t\n");
+
+        if((leftLength != rightLength) || (strncmp(left, right, leftLength) != 0))
+        {
+            return false;
+        }
+
+        if(leftLength == 0)
+        {
+            return true;
+        }
+
+        left += leftLength;
+        right += rightLength;
+    }
+}
+
+static double now_(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec + time.tv_nsec / NANOSECONDS_IN_SECOND;
+}
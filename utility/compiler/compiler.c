@@ -15,14 +15,25 @@
 #include "../file_reader/file_reader.h"
 #include "../parser/parser.h"
 #include "../generator/generator.h"
+#include "../generator/asm_generator.h"
 #include "compiler.h"
 #include "string.h"
 #include "../parser/parser_utilities/compiler_messages.h"
+#include "../parser/parser_utilities/post_parsing_utility/object_layout.h"
+#include "../parser/parser_utilities/post_parsing_utility/object_sizes.h"
+#include <compiler_options.h>
 #include <errno.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#include <unistd.h>
 
 ////////////////////////////////
 // DEFINES
 
+#define CODE_CACHE_INITIAL_SIZE     64
+#define CODE_CACHE_MAX_ENTRIES      4096
+#define CODE_CACHE_KEY_LENGTH       255     // longest hashmap key
+#define OPTIONS_KEY_LENGTH          128
 
 ////////////////////////////////
 // PRIVATE CONSTANTS
@@ -31,11 +42,37 @@ static const char* TAG = "COMPILER";
 ////////////////////////////////
 // PRIVATE TYPES
 
+typedef struct
+{
+    char* code;
+    size_t length;
+}CachedCode_t;
+
+typedef CachedCode_t* CachedCodeHandle_t;
+
+// Exported cache entry is header followed by key and code
+typedef struct
+{
+    uint32_t keyLength;
+    uint32_t codeLength;
+}ExportedCodeHeader_t;
+
+// Generated code of unchanged files, kept by compile server between jobs
+static HashmapHandle_t codeCache_ = NULL;
+
+// Compile server job process passes new entries to server through this descriptor instead of keeping them
+static int codeCacheExportFd_ = -1;
+
 // static bool cleanTempFilePaths_();
 // static bool cleanTempCFile_(ImportObjectHandle_t currentImport);
 ////////////////////////////////
 // PRIVATE METHODS
 
+static bool codeCacheKey_(const char* iguanaFilePath, const char* objectName, const bool isFirstFile, char* key);
+static bool codeCacheStore_(const char* key);
+static bool codeCacheInsert_(const char* key, const char* code, const size_t length);
+static bool codeCacheExport_(const char* key, const char* code, const size_t length);
+static int codeCacheFreeIteratorCallback_(void *key, int count, void* value, void *user);
 
 ////////////////////////////////
 // IMPLEMENTATION
@@ -58,7 +95,7 @@ void Compiler_removeExtensionFromFilenameWithCopy_(char* filename, const char* c
 
 static int cfilenameOfObject_(char* cfilename, const char* objectName)
 {
-    return sprintf(cfilename, "%s.c", objectName);
+    return sprintf(cfilename, (CompilerOptions_get()->backend == BACKEND_ASM) ? "%s.s" : "%s.c", objectName);
 }
 
 /**
@@ -79,9 +116,32 @@ bool Compiler_compileIguana(const char* iguanaFilePath, const bool isFirstFile)
     char* codeString;
     size_t length;
 
+    char cacheKey[CODE_CACHE_KEY_LENGTH + 1];
+    bool isCacheable = false;
+
     // Setting a name for currently compile object
     Compiler_removeExtensionFromFilenameWithCopy_(root.iguanaObjectName, basename((char*) iguanaFilePath));
     cfilenameOfObject_(filenameGenerate, root.iguanaObjectName);
+
+    // Same unchanged file with same options generates same code, so it is not compiled again
+    if((codeCache_ != NULL) && codeCacheKey_(iguanaFilePath, root.iguanaObjectName, isFirstFile, cacheKey))
+    {
+        if(Hashmap_find(codeCache_, cacheKey, strlen(cacheKey)))
+        {
+            const CachedCodeHandle_t cached = *(codeCache_->value);
+
+            Log_i(TAG, "Reusing generated code of unchanged %s", iguanaFilePath);
+
+            if(CompilerOptions_get()->backend == BACKEND_ASM)
+            {
+                return AsmGenerator_loadCode(cached->code, cached->length, filenameGenerate);
+            }
+
+            return Generator_loadCode(cached->code, cached->length, filenameGenerate);
+        }
+
+        isCacheable = true;
+    }
     
     // TODO: tokenize directly from file
     length = FileReader_readToBuffer(iguanaFilePath, &codeString);
@@ -118,13 +178,36 @@ bool Compiler_compileIguana(const char* iguanaFilePath, const bool isFirstFile)
 
     if(Shouter_getErrorCount() == NO_ERROR)
     {
+        bool isLowered = false;
+
+        if(CompilerOptions_get()->backend == BACKEND_ASM)
+        {
+            if(!AsmGenerator_generateCode(&root, filenameGenerate, isFirstFile, &isLowered))
+            {
+                Log_e(TAG, "Failed to generate assembly for Iguana file %s", iguanaFilePath);
+                return ERROR;
+            }
+
+            // Whole program goes through C then, caller sees backend changed and compiles again
+            if(!isLowered)
+            {
+                Log_w(TAG, "Iguana file %s cannot be lowered to assembly, falling back to C backend", iguanaFilePath);
+                CompilerOptions_get()->backend = BACKEND_C;
+                isCacheable = false;
+            }
+
         // Generator generates code out of AST(Abstract syntax tree)
-        if(!Generator_generateCode(&root, filenameGenerate, isFirstFile))
+        }else if(!Generator_generateCode(&root, filenameGenerate, isFirstFile))
         {
             Log_e(TAG, "Failed to generate c language code for Iguana file %s", iguanaFilePath);
             return ERROR;
         }
 
+        if(isCacheable && !codeCacheStore_(cacheKey))
+        {
+            Log_w(TAG, "Failed to cache generated code of %s", iguanaFilePath);
+        }
+
     }else
     {
         Shouter_shoutError(NULL, "Compiling completed with %d errors", Shouter_getErrorCount());
@@ -157,3 +240,258 @@ bool Compiler_compileIguana(const char* iguanaFilePath, const bool isFirstFile)
     
     return SUCCESS;
 }
+
+/**
+ * @brief Public method for getting C or assembly code generated from last compiled Iguana file
+ *
+ * @param[out] code         generated code, valid until next file is compiled
+ * @param[out] length       generated code length in bytes
+ *
+ * @return bool             - Success state
+ */
+bool Compiler_getGeneratedCode(const char** code, size_t* length)
+{
+    if(CompilerOptions_get()->backend == BACKEND_ASM)
+    {
+        return AsmGenerator_getCode(code, length);
+    }
+
+    return Generator_getCode(code, length);
+}
+
+/**
+ * @brief Public method for keeping generated code of compiled files in memory, so unchanged
+ * files are not compiled again by later runs of same process
+ *
+ * @return bool             - Success state
+ */
+bool Compiler_enableCodeCache(void)
+{
+    if(codeCache_ != NULL)
+    {
+        return SUCCESS;
+    }
+
+    ALLOC_CHECK(codeCache_, sizeof(Hashmap_t), ERROR);
+
+    if(!Hashmap_new(codeCache_, CODE_CACHE_INITIAL_SIZE))
+    {
+        Log_e(TAG, "Failed to create generated code cache");
+        free(codeCache_);
+        codeCache_ = NULL;
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for sending newly generated code to descriptor instead of caching it,
+ * used by compile server job process whose own cache ends with it
+ *
+ * @param[in] exportFd      descriptor receiving entries, negative stops exporting
+ */
+void Compiler_exportCodeCache(const int exportFd)
+{
+    codeCacheExportFd_ = exportFd;
+}
+
+/**
+ * @brief Public method for adding entries exported by other process to cache, incomplete last entry is dropped
+ *
+ * @param[in] exported      entries written by Compiler_exportCodeCache
+ * @param[in] length        exported bytes count
+ *
+ * @return bool             - Success state
+ */
+bool Compiler_importCodeCache(const char* exported, const size_t length)
+{
+    const char* cursor = exported;
+    const char* const exportedEnd = exported + length;
+    char key[CODE_CACHE_KEY_LENGTH + 1];
+
+    if(codeCache_ == NULL)
+    {
+        return ERROR;
+    }
+
+    while((size_t) (exportedEnd - cursor) >= sizeof(ExportedCodeHeader_t))
+    {
+        ExportedCodeHeader_t header;
+
+        memcpy(&header, cursor, sizeof(header));
+        cursor += sizeof(header);
+
+        if((header.keyLength > CODE_CACHE_KEY_LENGTH) || ((size_t) (exportedEnd - cursor) < (size_t) header.keyLength + header.codeLength))
+        {
+            break;
+        }
+
+        memcpy(key, cursor, header.keyLength);
+        key[header.keyLength] = '\0';
+        cursor += header.keyLength;
+
+        // Other job may have compiled same file meanwhile
+        if(!Hashmap_find(codeCache_, key, header.keyLength) && !codeCacheInsert_(key, cursor, header.codeLength))
+        {
+            return ERROR;
+        }
+
+        cursor += header.codeLength;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for resetting state left by previous compiler run in same process
+ */
+void Compiler_resetState(void)
+{
+    Shouter_resetErrorCount();
+    ObjectLayout_resetReport();
+    ObjectSizes_reset();
+}
+
+/**
+ * @brief Private method for making cache key from file identity, modification time and options
+ *
+ * @param[in] iguanaFilePath    Iguana file path
+ * @param[in] objectName        object name, mangled names depend on it
+ * @param[in] isFirstFile       first file gets entry point
+ * @param[out] key              cache key, CODE_CACHE_KEY_LENGTH + 1 bytes
+ *
+ * @return bool                 - false if file output cannot be cached
+ */
+static bool codeCacheKey_(const char* iguanaFilePath, const char* objectName, const bool isFirstFile, char* key)
+{
+    struct stat fileStat;
+    char optionsKey[OPTIONS_KEY_LENGTH];
+    int keyLength;
+
+    if(stat(iguanaFilePath, &fileStat) || !CompilerOptions_getCodegenKey(optionsKey, sizeof(optionsKey)))
+    {
+        return false;
+    }
+
+    keyLength = snprintf(key, CODE_CACHE_KEY_LENGTH + 1, "%lx:%lx:%ld.%09ld:%ld:%d:%s:%s",
+        (unsigned long) fileStat.st_dev, (unsigned long) fileStat.st_ino, (long) fileStat.st_mtim.tv_sec, (long) fileStat.st_mtim.tv_nsec,
+        (long) fileStat.st_size, isFirstFile, objectName, optionsKey);
+
+    return (keyLength > 0) && (keyLength <= CODE_CACHE_KEY_LENGTH);
+}
+
+/**
+ * @brief Private method for caching last generated code, or passing it to compile server from job process
+ *
+ * @param[in] key           cache key
+ *
+ * @return bool             - Success state
+ */
+static bool codeCacheStore_(const char* key)
+{
+    const char* code;
+    size_t length;
+
+    if(!Compiler_getGeneratedCode(&code, &length))
+    {
+        return ERROR;
+    }
+
+    if(codeCacheExportFd_ >= 0)
+    {
+        return codeCacheExport_(key, code, length);
+    }
+
+    return codeCacheInsert_(key, code, length);
+}
+
+/**
+ * @brief Private method for storing copy of code under key, whole cache is dropped when it grows too big
+ *
+ * @param[in] key           cache key
+ * @param[in] code          generated code
+ * @param[in] length        code length in bytes
+ *
+ * @return bool             - Success state
+ */
+static bool codeCacheInsert_(const char* key, const char* code, const size_t length)
+{
+    CachedCodeHandle_t cached;
+
+    // Edited files leave their old versions behind, dropping everything is simplest bound
+    if(Hashmap_size(codeCache_) >= CODE_CACHE_MAX_ENTRIES)
+    {
+        Hashmap_forEach(codeCache_, codeCacheFreeIteratorCallback_, NULL);
+        Hashmap_delete(codeCache_);
+        codeCache_ = NULL;
+
+        if(!Compiler_enableCodeCache())
+        {
+            return ERROR;
+        }
+    }
+
+    ALLOC_CHECK(cached, sizeof(CachedCode_t), ERROR);
+    ALLOC_CHECK(cached->code, length, ERROR);
+
+    memcpy(cached->code, code, length);
+    cached->length = length;
+
+    Hashmap_set(codeCache_, key, cached);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Private method for writing cache entry to export descriptor
+ *
+ * @param[in] key           cache key
+ * @param[in] code          generated code
+ * @param[in] length        code length in bytes
+ *
+ * @return bool             - Success state
+ */
+static bool codeCacheExport_(const char* key, const char* code, const size_t length)
+{
+    const ExportedCodeHeader_t header = {(uint32_t) strlen(key), (uint32_t) length};
+    const void* parts[] = {&header, key, code};
+    const size_t partLengths[] = {sizeof(header), header.keyLength, length};
+
+    if(length > UINT32_MAX)
+    {
+        return ERROR;
+    }
+
+    for(size_t partIdx = 0; partIdx < sizeof(parts) / sizeof(parts[0]); partIdx++)
+    {
+        const char* cursor = parts[partIdx];
+        size_t remaining = partLengths[partIdx];
+
+        while(remaining > 0)
+        {
+            const ssize_t written = write(codeCacheExportFd_, cursor, remaining);
+
+            if(written <= 0)
+            {
+                Log_w(TAG, "Failed to export generated code to compile server");
+                return ERROR;
+            }
+
+            cursor += written;
+            remaining -= (size_t) written;
+        }
+    }
+
+    return SUCCESS;
+}
+
+static int codeCacheFreeIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    const CachedCodeHandle_t cached = value;
+
+    free(cached->code);
+    free(cached);
+
+    return 1;
+}
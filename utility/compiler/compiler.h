@@ -24,6 +24,11 @@
 #include <libgen.h>
 
 bool Compiler_compileIguana(const char* iguanaFilePath, const bool isFirstFile);
+bool Compiler_getGeneratedCode(const char** code, size_t* length);
+bool Compiler_enableCodeCache(void);
+void Compiler_exportCodeCache(const int exportFd);
+bool Compiler_importCodeCache(const char* exported, const size_t length);
+void Compiler_resetState(void);
 bool Compiler_initialize(const char* mainFilePath);
 
 void Compiler_removeExtensionFromFilenameWithCopy_(char* filename, const char* const filenameWithExtension);
@@ -0,0 +1,498 @@
+/**
+ * @file emitter.c
+ *
+ * Append only growable text buffer for generated sources, whole buffer is written to file at once
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-07-14
+ */
+
+#include "emitter.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <logger.h>
+#include "../misc/platform_specific.h"
+
+////////////////////////////////
+// DEFINES
+
+#define TEMPLATE_CACHE_SIZE         256     // should be power of 2
+#define TEMPLATE_MAX_SEGMENTS       20
+#define U64_MAX_DIGITS              20
+#define U64_MAX_HEX_DIGITS          16
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+static const char* TAG = "EMITTER";
+
+static const char hexDigits_[] = "0123456789abcdef";
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef enum
+{
+    SEGMENT_LITERAL,
+    SEGMENT_STRING,         // %s
+    SEGMENT_INT,            // %d
+    SEGMENT_UNSIGNED,       // %u
+    SEGMENT_LONG,           // %ld
+    SEGMENT_UNSIGNED_LONG,  // %lu
+    SEGMENT_HEX_LONG        // %lx
+}SegmentType_t;
+
+typedef struct
+{
+    SegmentType_t type;
+    uint32_t length;
+    const char* literal;
+}Segment_t;
+
+// Format string split to literal and argument segments, parsed once per format string
+typedef struct
+{
+    const char* format;
+    bool isPrintfOnly;
+    uint8_t segmentsCount;
+    Segment_t segments[TEMPLATE_MAX_SEGMENTS];
+}FormatTemplate_t;
+
+static FormatTemplate_t templates_[TEMPLATE_CACHE_SIZE];
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static FormatTemplate_t* findTemplate_(const char* format);
+static void compileTemplate_(FormatTemplate_t* template, const char* format);
+static bool appendSegment_(FormatTemplate_t* template, const SegmentType_t type, const char* literal, const uint32_t length);
+static int formatVariadic_(EmitterHandle_t emitter, const char* format, va_list args);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for initializing emitter buffer
+ *
+ * @param[out] emitter          emitter object
+ * @param[in] initialCapacity   bytes allocated upfront, 0 for default
+ *
+ * @return                      Success state
+ */
+bool Emitter_create(EmitterHandle_t emitter, const size_t initialCapacity)
+{
+    NULL_GUARD(emitter, ERROR, Log_e(TAG, "Null emitter passed"));
+
+    emitter->capacity = (initialCapacity > 0) ? initialCapacity : EMITTER_INITIAL_CAPACITY_DEFAULT;
+    emitter->length = 0;
+
+    ALLOC_CHECK(emitter->data, emitter->capacity, ERROR);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for making sure buffer can take more bytes without reallocation
+ *
+ * @param[in/out] emitter       emitter object
+ * @param[in] additionalLength  bytes going to be appended
+ *
+ * @return                      Success state
+ */
+bool Emitter_reserve(EmitterHandle_t emitter, const size_t additionalLength)
+{
+    size_t capacity = emitter->capacity;
+
+    if(emitter->length + additionalLength <= capacity)
+    {
+        return SUCCESS;
+    }
+
+    while(emitter->length + additionalLength > capacity)
+    {
+        capacity *= 2;
+    }
+
+    REALLOC_CHECK(emitter->data, capacity, ERROR);
+    emitter->capacity = capacity;
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for appending raw bytes
+ *
+ * @param[in/out] emitter       emitter object
+ * @param[in] data              bytes to append
+ * @param[in] length            bytes count
+ *
+ * @return                      Success state
+ */
+bool Emitter_append(EmitterHandle_t emitter, const char* data, const size_t length)
+{
+    if(!Emitter_reserve(emitter, length))
+    {
+        return ERROR;
+    }
+
+    memcpy(emitter->data + emitter->length, data, length);
+    emitter->length += length;
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for appending null terminated identifier or string
+ *
+ * @param[in/out] emitter       emitter object
+ * @param[in] string            null terminated string
+ *
+ * @return                      Success state
+ */
+bool Emitter_appendString(EmitterHandle_t emitter, const char* string)
+{
+    return Emitter_append(emitter, string, strlen(string));
+}
+
+/**
+ * @brief Public method for appending unsigned integer in decimal
+ *
+ * @param[in/out] emitter       emitter object
+ * @param[in] value             value to append
+ *
+ * @return                      Success state
+ */
+bool Emitter_appendUnsigned(EmitterHandle_t emitter, uint64_t value)
+{
+    char digits[U64_MAX_DIGITS];
+    char* digitsStart = digits + U64_MAX_DIGITS;
+
+    do
+    {
+        *(--digitsStart) = (char) ('0' + (value % 10));
+        value /= 10;
+    }while(value > 0);
+
+    return Emitter_append(emitter, digitsStart, (size_t) (digits + U64_MAX_DIGITS - digitsStart));
+}
+
+/**
+ * @brief Public method for appending signed integer in decimal
+ *
+ * @param[in/out] emitter       emitter object
+ * @param[in] value             value to append
+ *
+ * @return                      Success state
+ */
+bool Emitter_appendSigned(EmitterHandle_t emitter, const int64_t value)
+{
+    if(value < 0)
+    {
+        if(!Emitter_append(emitter, "-", 1))
+        {
+            return ERROR;
+        }
+
+        return Emitter_appendUnsigned(emitter, (uint64_t) 0 - (uint64_t) value);
+    }
+
+    return Emitter_appendUnsigned(emitter, (uint64_t) value);
+}
+
+/**
+ * @brief Public method for appending unsigned integer in lowercase hexadecimal without prefix
+ *
+ * @param[in/out] emitter       emitter object
+ * @param[in] value             value to append
+ *
+ * @return                      Success state
+ */
+bool Emitter_appendHex(EmitterHandle_t emitter, uint64_t value)
+{
+    char digits[U64_MAX_HEX_DIGITS];
+    char* digitsStart = digits + U64_MAX_HEX_DIGITS;
+
+    do
+    {
+        *(--digitsStart) = hexDigits_[value & 0xF];
+        value >>= 4;
+    }while(value > 0);
+
+    return Emitter_append(emitter, digitsStart, (size_t) (digits + U64_MAX_HEX_DIGITS - digitsStart));
+}
+
+/**
+ * @brief Public method for appending printf styled text, format is split to segments
+ * only first time it is seen, so format string should be literal
+ *
+ * @param[in/out] emitter       emitter object
+ * @param[in] format            format string, supports %s %d %u %ld %lu %lx %% without flags
+ *
+ * @return                      Appended bytes count, negative on failure same as fprintf
+ */
+int Emitter_format(EmitterHandle_t emitter, const char* format, ...)
+{
+    va_list args;
+    FormatTemplate_t* template;
+    const size_t startLength = emitter->length;
+    bool status = SUCCESS;
+
+    template = findTemplate_(format);
+
+    va_start(args, format);
+
+    if((template == NULL) || template->isPrintfOnly)
+    {
+        const int written = formatVariadic_(emitter, format, args);
+        va_end(args);
+        return written;
+    }
+
+    for(uint8_t segmentIdx = 0; status && (segmentIdx < template->segmentsCount); segmentIdx++)
+    {
+        const Segment_t* segment = &template->segments[segmentIdx];
+
+        switch(segment->type)
+        {
+            case SEGMENT_LITERAL:       status = Emitter_append(emitter, segment->literal, segment->length);break;
+            case SEGMENT_STRING:        status = Emitter_appendString(emitter, va_arg(args, const char*));break;
+            case SEGMENT_INT:           status = Emitter_appendSigned(emitter, va_arg(args, int));break;
+            case SEGMENT_UNSIGNED:      status = Emitter_appendUnsigned(emitter, va_arg(args, unsigned int));break;
+            case SEGMENT_LONG:          status = Emitter_appendSigned(emitter, va_arg(args, long));break;
+            case SEGMENT_UNSIGNED_LONG: status = Emitter_appendUnsigned(emitter, va_arg(args, unsigned long));break;
+            case SEGMENT_HEX_LONG:      status = Emitter_appendHex(emitter, va_arg(args, unsigned long));break;
+        }
+    }
+
+    va_end(args);
+
+    if(!status)
+    {
+        Log_e(TAG, "Failed to append formatted \"%s\"", format);
+        return -1;
+    }
+
+    return (int) (emitter->length - startLength);
+}
+
+/**
+ * @brief Public method for writing whole buffer to file with single write
+ *
+ * @param[in] emitter           emitter object
+ * @param[in] path              destination file path, overwritten
+ *
+ * @return                      Success state
+ */
+bool Emitter_writeFile(const EmitterHandle_t emitter, const char* path)
+{
+    FILE* file;
+    size_t written;
+
+    file = fopen(path, "w");
+
+    NULL_GUARD(file, ERROR, Log_e(TAG, "Failed to open %s", path));
+
+    // Buffer is already complete, stdio buffering would only add a copy
+    setvbuf(file, NULL, _IONBF, 0);
+
+    written = fwrite(emitter->data, BYTE_SIZE, emitter->length, file);
+
+    if(fclose(file) || (written != emitter->length))
+    {
+        Log_e(TAG, "Failed to write %lu bytes to %s", emitter->length, path);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for dropping buffer contents, allocated memory is kept for reuse
+ *
+ * @param[in/out] emitter       emitter object
+ */
+void Emitter_reset(EmitterHandle_t emitter)
+{
+    emitter->length = 0;
+}
+
+/**
+ * @brief Public method for freeing emitter buffer
+ *
+ * @param[in/out] emitter       emitter object
+ */
+void Emitter_destroy(EmitterHandle_t emitter)
+{
+    free(emitter->data);
+    emitter->data = NULL;
+    emitter->length = 0;
+    emitter->capacity = 0;
+}
+
+/**
+ * @brief Private method for getting cached template of format string, keyed by format address
+ *
+ * @param[in] format            format string
+ *
+ * @return                      Template, NULL when cache is full
+ */
+static FormatTemplate_t* findTemplate_(const char* format)
+{
+    uint32_t slot = (uint32_t) ((((uintptr_t) format) >> 3) * 2654435761u) & (TEMPLATE_CACHE_SIZE - 1);
+
+    for(uint32_t probe = 0; probe < TEMPLATE_CACHE_SIZE; probe++)
+    {
+        FormatTemplate_t* template = &templates_[slot];
+
+        if(template->format == format)
+        {
+            return template;
+        }
+
+        if(template->format == NULL)
+        {
+            compileTemplate_(template, format);
+            return template;
+        }
+
+        slot = (slot + 1) & (TEMPLATE_CACHE_SIZE - 1);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Private method for splitting format string to segments, formats
+ * which cannot be represented are marked to be handled by printf
+ *
+ * @param[out] template         template to fill
+ * @param[in] format            format string
+ */
+static void compileTemplate_(FormatTemplate_t* template, const char* format)
+{
+    const char* literalStart = format;
+    const char* cursor = format;
+
+    template->format = format;
+    template->isPrintfOnly = false;
+    template->segmentsCount = 0;
+
+    while(*cursor != '\0')
+    {
+        SegmentType_t type;
+        uint8_t specifierLength;
+
+        if(*cursor != '%')
+        {
+            cursor++;
+            continue;
+        }
+
+        if((cursor > literalStart) && !appendSegment_(template, SEGMENT_LITERAL, literalStart, (uint32_t) (cursor - literalStart)))
+        {
+            return;
+        }
+
+        switch(cursor[1])
+        {
+            case 's': type = SEGMENT_STRING;   specifierLength = 2;break;
+            case 'd': type = SEGMENT_INT;      specifierLength = 2;break;
+            case 'u': type = SEGMENT_UNSIGNED; specifierLength = 2;break;
+            case '%': type = SEGMENT_LITERAL;  specifierLength = 2;break;
+            case 'l':
+            {
+                specifierLength = 3;
+
+                switch(cursor[2])
+                {
+                    case 'd': type = SEGMENT_LONG;break;
+                    case 'u': type = SEGMENT_UNSIGNED_LONG;break;
+                    case 'x': type = SEGMENT_HEX_LONG;break;
+                    default:
+                        template->isPrintfOnly = true;
+                        return;
+                }
+            }break;
+
+            default:
+                // Flags, widths and other conversions are left for printf
+                template->isPrintfOnly = true;
+                return;
+        }
+
+        // Escaped percent stays as one character literal
+        if(!appendSegment_(template, type, cursor + 1, (type == SEGMENT_LITERAL) ? 1 : 0))
+        {
+            return;
+        }
+
+        cursor += specifierLength;
+        literalStart = cursor;
+    }
+
+    if(cursor > literalStart)
+    {
+        appendSegment_(template, SEGMENT_LITERAL, literalStart, (uint32_t) (cursor - literalStart));
+    }
+}
+
+/**
+ * @brief Private method for adding segment to template, too long templates fall back to printf
+ *
+ * @param[in/out] template      template being compiled
+ * @param[in] type              segment type
+ * @param[in] literal           literal text start, only for literal segments
+ * @param[in] length            literal text length
+ *
+ * @return                      Success state, false if template became printf only
+ */
+static bool appendSegment_(FormatTemplate_t* template, const SegmentType_t type, const char* literal, const uint32_t length)
+{
+    if(template->segmentsCount >= TEMPLATE_MAX_SEGMENTS)
+    {
+        template->isPrintfOnly = true;
+        return ERROR;
+    }
+
+    template->segments[template->segmentsCount].type = type;
+    template->segments[template->segmentsCount].literal = literal;
+    template->segments[template->segmentsCount].length = length;
+    template->segmentsCount++;
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Private method for appending text formatted by vsnprintf
+ *
+ * @param[in/out] emitter       emitter object
+ * @param[in] format            format string
+ * @param[in] args              format arguments
+ *
+ * @return                      Appended bytes count, negative on failure
+ */
+static int formatVariadic_(EmitterHandle_t emitter, const char* format, va_list args)
+{
+    va_list argsCopy;
+    int length;
+
+    va_copy(argsCopy, args);
+    length = vsnprintf(NULL, 0, format, argsCopy);
+    va_end(argsCopy);
+
+    if((length < 0) || !Emitter_reserve(emitter, (size_t) length + 1))
+    {
+        Log_e(TAG, "Failed to format \"%s\"", format);
+        return -1;
+    }
+
+    vsnprintf(emitter->data + emitter->length, (size_t) length + 1, format, args);
+    emitter->length += (size_t) length;
+
+    return length;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file emitter.h
+ *
+ * Append only growable text buffer for generated sources, whole buffer is written to file at once
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-07-14
+ */
+
+#ifndef UTILITY_EMITTER_EMITTER_H_
+#define UTILITY_EMITTER_EMITTER_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../misc/safety_macros.h"
+
+#define EMITTER_INITIAL_CAPACITY_DEFAULT    4096
+
+typedef struct
+{
+    char* data;
+    size_t length;
+    size_t capacity;
+}Emitter_t;
+
+typedef Emitter_t* EmitterHandle_t;
+
+bool Emitter_create(EmitterHandle_t emitter, const size_t initialCapacity);
+bool Emitter_reserve(EmitterHandle_t emitter, const size_t additionalLength);
+bool Emitter_append(EmitterHandle_t emitter, const char* data, const size_t length);
+bool Emitter_appendString(EmitterHandle_t emitter, const char* string);
+bool Emitter_appendUnsigned(EmitterHandle_t emitter, uint64_t value);
+bool Emitter_appendSigned(EmitterHandle_t emitter, const int64_t value);
+bool Emitter_appendHex(EmitterHandle_t emitter, uint64_t value);
+int Emitter_format(EmitterHandle_t emitter, const char* format, ...) __attribute__((format(printf, 2, 3)));
+bool Emitter_writeFile(const EmitterHandle_t emitter, const char* path);
+void Emitter_reset(EmitterHandle_t emitter);
+void Emitter_destroy(EmitterHandle_t emitter);
+
+#endif // UTILITY_EMITTER_EMITTER_H_
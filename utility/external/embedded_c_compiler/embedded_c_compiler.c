@@ -0,0 +1,102 @@
+/**
+ * @file embedded_c_compiler.c
+ *
+ * In process C compiler on top of libtcc, generated C is compiled without spawning external compiler
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-04
+ */
+
+#include "embedded_c_compiler.h"
+#include <stdlib.h>
+#include <string.h>
+#include <libtcc.h>
+#include <safety_macros.h>
+#include <logger.h>
+
+////////////////////////////////
+// DEFINES
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+static const char* TAG = "EMBEDDED_C_COMPILER";
+
+// Generated code is written for gcc, builtins tcc does not know are spelled out before it
+static const char COMPAT_PRELUDE[] =
+    "void exit(int status);\n"
+    "#define __builtin_exit(status) exit(status)\n"
+    "#define __builtin_add_overflow(a, b, r) ((*(r) = (a) + (b)) < (a))\n"
+    "#define __builtin_sub_overflow(a, b, r) ((*(r) = (a) - (b)) > (a))\n";
+
+////////////////////////////////
+// PRIVATE TYPES
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static void errorCallback_(void* opaque, const char* message);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for compiling generated C in process to object file
+ *
+ * @param[in] source        generated C code, not null terminated
+ * @param[in] length        generated C code length
+ * @param[in] objectPath    object file path
+ *
+ * @return                  Success state, false if code needs external compiler
+ */
+bool EmbeddedCCompiler_compileSource(const char* source, const size_t length, const char* objectPath)
+{
+    TCCState* state;
+    char* code;
+    bool status;
+
+    // libtcc compiles only null terminated strings
+    ALLOC_CHECK(code, sizeof(COMPAT_PRELUDE) + length, ERROR);
+
+    memcpy(code, COMPAT_PRELUDE, sizeof(COMPAT_PRELUDE) - 1);
+    memcpy(code + sizeof(COMPAT_PRELUDE) - 1, source, length);
+    code[sizeof(COMPAT_PRELUDE) - 1 + length] = '\0';
+
+    state = tcc_new();
+
+    if(state == NULL)
+    {
+        free(code);
+        Log_e(TAG, "Failed to create compiler state");
+        return ERROR;
+    }
+
+    tcc_set_error_func(state, NULL, errorCallback_);
+
+    // Output type goes first, compilation depends on it
+    status = (tcc_set_output_type(state, TCC_OUTPUT_OBJ) == 0) &&
+             (tcc_compile_string(state, code) == 0) &&
+             (tcc_output_file(state, objectPath) == 0);
+
+    tcc_delete(state);
+    free(code);
+
+    if(!status)
+    {
+        Log_d(TAG, "Failed to compile %s in process", objectPath);
+        return ERROR;
+    }
+
+    Log_d(TAG, "Compiled %s in process", objectPath);
+
+    return SUCCESS;
+}
+
+static void errorCallback_(void* opaque, const char* message)
+{
+    Log_d(TAG, "%s", message);
+}
@@ -0,0 +1,22 @@
+/**
+ * @file embedded_c_compiler.h
+ *
+ * In process C compiler on top of libtcc, generated C is compiled without spawning external compiler
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-04
+ */
+
+#ifndef UTILITY_EXTERNAL_EMBEDDED_C_COMPILER_EMBEDDED_C_COMPILER_H_
+#define UTILITY_EXTERNAL_EMBEDDED_C_COMPILER_EMBEDDED_C_COMPILER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+bool EmbeddedCCompiler_compileSource(const char* source, const size_t length, const char* objectPath);
+
+#endif // UTILITY_EXTERNAL_EMBEDDED_C_COMPILER_EMBEDDED_C_COMPILER_H_
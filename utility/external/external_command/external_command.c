@@ -0,0 +1,128 @@
+/**
+ * @file external_command.c
+ *
+ * Helpers shared by drivers of external tools: piping generated source to command stdin and
+ * private directory for objects waiting for linker
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-27
+ */
+
+#include "external_command.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <safety_macros.h>
+#include <global_config.h>
+#include <logger.h>
+
+////////////////////////////////
+// DEFINES
+
+#define OBJECT_EXTENSION_LENGTH     3       // ".o" and null terminator
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+static const char* TAG = "EXTERNAL_COMMAND";
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for running command with source written to its stdin
+ *
+ * @param[in] command       shell command
+ * @param[in] source        data for stdin
+ * @param[in] length        data length
+ *
+ * @return                  Success state, false if command failed
+ */
+bool ExternalCommand_pipeSource(const char* command, const char* source, const size_t length)
+{
+    FILE* pipe;
+    size_t written;
+    int exitStatus;
+
+    pipe = popen(command, "w");
+
+    NULL_GUARD(pipe, ERROR, Log_e(TAG, "Failed to start command %s", command));
+
+    written = fwrite(source, BYTE_SIZE, length, pipe);
+    exitStatus = pclose(pipe);
+
+    if((written != length) || (exitStatus == -1) || !WIFEXITED(exitStatus) || (WEXITSTATUS(exitStatus) != 0))
+    {
+        Log_e(TAG, "Command failed with status %d: %s", exitStatus, command);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for getting private objects directory, created on first use, so parallel
+ * builds do not clobber objects of each other
+ *
+ * @param[in,out] objectsDir    driver buffer of EXTERNAL_OBJECTS_DIR_LENGTH bytes
+ *
+ * @return                      Directory path ending with separator, NULL on failure
+ */
+const char* ExternalCommand_getObjectsDir(char* objectsDir)
+{
+    if(objectsDir[0] == '\0')
+    {
+        strcpy(objectsDir, EXTERNAL_OBJECTS_DIR_TEMPLATE);
+
+        if(mkdtemp(objectsDir) == NULL)
+        {
+            objectsDir[0] = '\0';
+            return NULL;
+        }
+
+        strcat(objectsDir, "/");
+    }
+
+    return objectsDir;
+}
+
+/**
+ * @brief Public method for removing objects together with their private directory, next build
+ * gets new directory
+ *
+ * @param[in,out] objectsDir    driver buffer, emptied
+ * @param[in] objectNames       Iguana object names, objects are named after them
+ */
+void ExternalCommand_removeObjects(char* objectsDir, const VectorHandler_t objectNames)
+{
+    if(objectsDir[0] == '\0')
+    {
+        return;
+    }
+
+    for(size_t idx = 0; idx < objectNames->currentSize; idx++)
+    {
+        char objectPath[EXTERNAL_OBJECTS_DIR_LENGTH + CFILES_LENGTH + OBJECT_EXTENSION_LENGTH];
+
+        snprintf(objectPath, sizeof(objectPath), "%s%s.o", objectsDir, (const char*) objectNames->expandable[idx]);
+
+        // Failed build could stop before producing every object
+        if((remove(objectPath) != 0) && (access(objectPath, F_OK) == 0))
+        {
+            Log_w(TAG, "Failed to remove object file %s", objectPath);
+        }
+    }
+
+    if(rmdir(objectsDir) != 0)
+    {
+        Log_w(TAG, "Failed to remove objects directory %s", objectsDir);
+    }
+
+    objectsDir[0] = '\0';
+}
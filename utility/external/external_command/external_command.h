@@ -0,0 +1,31 @@
+/**
+ * @file external_command.h
+ *
+ * Helpers shared by drivers of external tools: piping generated source to command stdin and
+ * private directory for objects waiting for linker
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-27
+ */
+
+#ifndef UTILITY_EXTERNAL_EXTERNAL_COMMAND_EXTERNAL_COMMAND_H_
+#define UTILITY_EXTERNAL_EXTERNAL_COMMAND_EXTERNAL_COMMAND_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <vector.h>
+
+#define EXTERNAL_OBJECTS_DIR_TEMPLATE   "/tmp/iguanaXXXXXX"
+
+// Directory buffer of driver, holds created path with separator appended, empty when not created
+#define EXTERNAL_OBJECTS_DIR_LENGTH     (sizeof(EXTERNAL_OBJECTS_DIR_TEMPLATE) + 1)
+
+bool ExternalCommand_pipeSource(const char* command, const char* source, const size_t length);
+const char* ExternalCommand_getObjectsDir(char* objectsDir);
+void ExternalCommand_removeObjects(char* objectsDir, const VectorHandler_t objectNames);
+
+#endif // UTILITY_EXTERNAL_EXTERNAL_COMMAND_EXTERNAL_COMMAND_H_
@@ -17,6 +17,15 @@
 #include "../../misc/safety_macros.h"
 #include "../../logger/logger.h"
 #include "c_compiler_macros.h"
+#include <compiler_options.h>
+#include <external_command.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#ifdef IGUANA_EMBEDDED_CC
+#include <embedded_c_compiler.h>
+#endif
 
 ////////////////////////////////
 // DEFINES
@@ -27,6 +36,12 @@
 
 #define GCC_COMPILER_COMMAND_COMPILE_LINK "gcc -o %s -Wl,--entry=entry_main -nostartfiles "
 #define GCC_COMPILER_COMMAND_COMPILE      "gcc -c -Wl,--entry=entry_main -nostartfiles "
+#define GCC_MARCH_OPTION                  "-march=%s "
+
+// Generated source is read from stdin, objects after "-x none" are detected by extension again
+#define GCC_COMPILER_COMMAND_PIPE_OBJECT  "gcc -c -o %s%s.o "
+#define GCC_COMPILER_COMMAND_PIPE_LINK    "gcc -o %s -Wl,--entry=entry_main -nostartfiles "
+#define GCC_PIPE_SOURCE_OPTION            "-x c - -x none"
 
 
 #define FULL_COMMAND_LEN     sizeof(GCC_COMPILER_COMMAND) + CFILES_LENGTH + CFILES_LENGTH
@@ -37,10 +52,14 @@ static const char* TAG = "C_COMPILER";
 ////////////////////////////////
 // PRIVATE TYPES
 
+// Objects of piped sources live in private directory, so parallel builds do not clobber them
+static char pipedObjectsDir_[EXTERNAL_OBJECTS_DIR_LENGTH] = {0};
 
 ////////////////////////////////
 // PRIVATE METHODS
 
+static bool compileEmbedded_(const char* objectsDir, const char* objectName, const char* source, const size_t length);
+static size_t marchOptionLength_(void);
 
 ////////////////////////////////
 // IMPLEMENTATION
@@ -131,12 +150,16 @@ bool CExternalCompiler_compile(const VectorHandler_t objectsCompiledExternaly, c
 {
     char* full_command;
     char* iterator;
+    int exitStatus;
+    const char* targetArch = CompilerOptions_get()->targetArch;
+    const size_t marchLength = (targetArch != NULL) ? (sizeof(GCC_MARCH_OPTION) + strlen(targetArch)) : 0;
+
     if(linkingEnabled)
     {
-        ALLOC_CHECK(full_command, sizeof(GCC_COMPILER_COMMAND_COMPILE_LINK) + CFILES_LENGTH + (CFILES_LENGTH * objectsCompiledExternaly->currentSize), ERROR);
+        ALLOC_CHECK(full_command, sizeof(GCC_COMPILER_COMMAND_COMPILE_LINK) + marchLength + CFILES_LENGTH + (CFILES_LENGTH * objectsCompiledExternaly->currentSize), ERROR);
     }else
     {
-        ALLOC_CHECK(full_command, sizeof(GCC_COMPILER_COMMAND_COMPILE) + CFILES_LENGTH + (CFILES_LENGTH * objectsCompiledExternaly->currentSize), ERROR);
+        ALLOC_CHECK(full_command, sizeof(GCC_COMPILER_COMMAND_COMPILE) + marchLength + CFILES_LENGTH + (CFILES_LENGTH * objectsCompiledExternaly->currentSize), ERROR);
     }
     
     full_command[0] = '\0'; //null terminator beggining for strncat
@@ -149,6 +172,12 @@ bool CExternalCompiler_compile(const VectorHandler_t objectsCompiledExternaly, c
     {
         iterator += sprintf(full_command, GCC_COMPILER_COMMAND_COMPILE);
     }
+
+    // Generated code picks field access instructions by target features
+    if(targetArch != NULL)
+    {
+        iterator += sprintf(iterator, GCC_MARCH_OPTION, targetArch);
+    }
     
     Log_d(TAG, "Executing command:%s", full_command);
 
@@ -156,7 +185,12 @@ bool CExternalCompiler_compile(const VectorHandler_t objectsCompiledExternaly, c
     {
         const char* iguanaFileobject = objectsCompiledExternaly->expandable[idx];
 
-        NULL_GUARD(iguanaFileobject, ERROR, Log_e(TAG, "Null object in linker passed"));
+        if(iguanaFileobject == NULL)
+        {
+            Log_e(TAG, "Null object in linker passed");
+            free(full_command);
+            return ERROR;
+        }
 
         iterator += sprintf(iterator, " %s%s.c", TEMP_PATH, iguanaFileobject);
     }
@@ -169,13 +203,20 @@ bool CExternalCompiler_compile(const VectorHandler_t objectsCompiledExternaly, c
         Log_d(TAG, "Executing GCC compiler: %s", full_command);  
     }
     
-    if(system(full_command) == -1)
+    // Same check as for piped sources, compile errors are reported by exit status only
+    exitStatus = system(full_command);
+
+    if((exitStatus == -1) || !WIFEXITED(exitStatus) || (WEXITSTATUS(exitStatus) != 0))
     {
+        Log_e(TAG, "Command failed with status %d: %s", exitStatus, full_command);
         free(full_command);
         return ERROR;
     }
 
-    for(size_t idx = 0; idx < objectsCompiledExternaly->currentSize; idx++)
+    free(full_command);
+
+    // Kept sources stay on disk for inspection
+    for(size_t idx = 0; !CompilerOptions_get()->keepC && (idx < objectsCompiledExternaly->currentSize); idx++)
     {
         char sourceFilename[MAX_FILENAME_LENGTH + sizeof(TEMP_PATH)] = {0};
         const char* iguanaFileobject = objectsCompiledExternaly->expandable[idx];
@@ -191,7 +232,179 @@ bool CExternalCompiler_compile(const VectorHandler_t objectsCompiledExternaly, c
         }
     }        
 
-    free(full_command);
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for compiling generated source piped through C compiler stdin to object file
+ *
+ * @param[in] objectName        Iguana object name, object file is named after it
+ * @param[in] source            generated C code
+ * @param[in] length            generated C code length
+ * @param[in] linkingEnabled    object goes to private directory for linking, otherwise to TEMP_PATH
+ *
+ * @return                      Success state
+ */
+bool CExternalCompiler_compileSource(const char* objectName, const char* source, const size_t length, const bool linkingEnabled)
+{
+    char* fullCommand;
+    char* iterator;
+    const char* objectsDir = linkingEnabled ? ExternalCommand_getObjectsDir(pipedObjectsDir_) : TEMP_PATH;
+    bool status;
+
+    NULL_GUARD(objectsDir, ERROR, Log_e(TAG, "Failed to create directory for objects"));
+
+    if(compileEmbedded_(objectsDir, objectName, source, length))
+    {
+        return SUCCESS;
+    }
+
+    ALLOC_CHECK(fullCommand, sizeof(GCC_COMPILER_COMMAND_PIPE_OBJECT) + EXTERNAL_OBJECTS_DIR_LENGTH + CFILES_LENGTH + marchOptionLength_() + sizeof(GCC_PIPE_SOURCE_OPTION), ERROR);
+
+    iterator = fullCommand;
+    iterator += sprintf(iterator, GCC_COMPILER_COMMAND_PIPE_OBJECT, objectsDir, objectName);
+
+    if(CompilerOptions_get()->targetArch != NULL)
+    {
+        iterator += sprintf(iterator, GCC_MARCH_OPTION, CompilerOptions_get()->targetArch);
+    }
+
+    sprintf(iterator, GCC_PIPE_SOURCE_OPTION);
+
+    Log_d(TAG, "Executing GCC compiler with piped source: %s", fullCommand);
+
+    status = ExternalCommand_pipeSource(fullCommand, source, length);
+    free(fullCommand);
+
+    if(!status)
+    {
+        Log_e(TAG, "Failed to compile generated source of %s", objectName);
+        return ERROR;
+    }
 
     return SUCCESS;
 }
+
+/**
+ * @brief Public method for compiling last generated source piped through stdin and linking it
+ * with objects of previously piped sources, those objects are removed afterwards
+ *
+ * @param[in] objectsCompiledExternaly  all Iguana object names, last one is the piped source
+ * @param[in] source                    generated C code of last object
+ * @param[in] length                    generated C code length
+ * @param[in] outputName                executable path
+ *
+ * @return                              Success state
+ */
+bool CExternalCompiler_linkSource(const VectorHandler_t objectsCompiledExternaly, const char* source, const size_t length, char* outputName)
+{
+    char* fullCommand;
+    char* iterator;
+    bool status;
+    const size_t objectsCount = objectsCompiledExternaly->currentSize;
+    const char* objectsDir = ExternalCommand_getObjectsDir(pipedObjectsDir_);
+    size_t linkedObjectsCount = objectsCount - 1;
+
+    NULL_GUARD(objectsDir, ERROR, Log_e(TAG, "Failed to create directory for objects"));
+
+    // Last source compiled in process is linked as object too, then gcc only links
+    if(compileEmbedded_(objectsDir, objectsCompiledExternaly->expandable[objectsCount - 1], source, length))
+    {
+        linkedObjectsCount = objectsCount;
+    }
+
+    ALLOC_CHECK(fullCommand, sizeof(GCC_COMPILER_COMMAND_PIPE_LINK) + CFILES_LENGTH + marchOptionLength_() + sizeof(GCC_PIPE_SOURCE_OPTION) +
+        ((EXTERNAL_OBJECTS_DIR_LENGTH + CFILES_LENGTH) * objectsCount), ERROR);
+
+    iterator = fullCommand;
+    iterator += sprintf(iterator, GCC_COMPILER_COMMAND_PIPE_LINK, outputName);
+
+    if(CompilerOptions_get()->targetArch != NULL)
+    {
+        iterator += sprintf(iterator, GCC_MARCH_OPTION, CompilerOptions_get()->targetArch);
+    }
+
+    if(linkedObjectsCount < objectsCount)
+    {
+        iterator += sprintf(iterator, GCC_PIPE_SOURCE_OPTION);
+    }
+
+    for(size_t idx = 0; idx < linkedObjectsCount; idx++)
+    {
+        iterator += sprintf(iterator, " %s%s.o", objectsDir, (const char*) objectsCompiledExternaly->expandable[idx]);
+    }
+
+    Log_d(TAG, "Executing GCC inbuilt compiler/Linker with piped source: %s", fullCommand);
+
+    // Nothing is read from stdin when every source is compiled already
+    status = ExternalCommand_pipeSource(fullCommand, source, (linkedObjectsCount < objectsCount) ? length : 0);
+    free(fullCommand);
+
+    CExternalCompiler_removeObjects(objectsCompiledExternaly);
+
+    if(!status)
+    {
+        Log_e(TAG, "Failed to compile and link generated source");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for removing objects of piped sources together with their private directory,
+ * next build gets new directory
+ *
+ * @param[in] objectsCompiledExternaly  Iguana object names, same as given for compiling
+ */
+void CExternalCompiler_removeObjects(const VectorHandler_t objectsCompiledExternaly)
+{
+    // Last object of linked build is compiled from stdin and never written
+    ExternalCommand_removeObjects(pipedObjectsDir_, objectsCompiledExternaly);
+}
+
+/**
+ * @brief Private method for compiling generated source in process, when compiler library is built in
+ *
+ * @param[in] objectsDir    directory of object file, ending with separator
+ * @param[in] objectName    Iguana object name, object file is named after it
+ * @param[in] source        generated C code
+ * @param[in] length        generated C code length
+ *
+ * @return                  Success state, false if source has to go through external compiler
+ */
+static bool compileEmbedded_(const char* objectsDir, const char* objectName, const char* source, const size_t length)
+{
+#ifdef IGUANA_EMBEDDED_CC
+    char objectPath[EXTERNAL_OBJECTS_DIR_LENGTH + CFILES_LENGTH + 3];
+
+    // Target specific intrinsics are known only by external compiler
+    if(CompilerOptions_get()->targetArch != NULL)
+    {
+        return ERROR;
+    }
+
+    snprintf(objectPath, sizeof(objectPath), "%s%s.o", objectsDir, objectName);
+
+    if(EmbeddedCCompiler_compileSource(source, length, objectPath))
+    {
+        return SUCCESS;
+    }
+
+    Log_w(TAG, "Embedded C compiler rejected generated source of %s, using external compiler", objectName);
+#endif
+
+    return ERROR;
+}
+
+/**
+ * @brief Private method for getting space needed for -march option in command
+ *
+ * @return          Bytes count, 0 if target is not set
+ */
+static size_t marchOptionLength_(void)
+{
+    const char* targetArch = CompilerOptions_get()->targetArch;
+
+    return (targetArch != NULL) ? (sizeof(GCC_MARCH_OPTION) + strlen(targetArch)) : 0;
+}
@@ -20,5 +20,8 @@
 // bool CExternalCompiler_link(const VectorHandler_t objectsCompiledExternaly, char* outputName);
 
 bool CExternalCompiler_compile(const VectorHandler_t objectsCompiledExternaly, char* outputName, const bool linkingEnabled);
+bool CExternalCompiler_compileSource(const char* objectName, const char* source, const size_t length, const bool linkingEnabled);
+bool CExternalCompiler_linkSource(const VectorHandler_t objectsCompiledExternaly, const char* source, const size_t length, char* outputName);
+void CExternalCompiler_removeObjects(const VectorHandler_t objectsCompiledExternaly);
 
 #endif // UTILITY_EXTERNAL_INBUILT_C_COMPILER_C_COMPILER_H_
\ No newline at end of file
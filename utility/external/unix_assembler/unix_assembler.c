@@ -0,0 +1,96 @@
+/**
+ * @file unix_assembler.c
+ *
+ * GNU assembler driver, generated assembly is piped to as and assembled to object files
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-07-28
+ */
+
+#include "unix_assembler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <safety_macros.h>
+#include <global_config.h>
+#include <logger.h>
+#include <external_command.h>
+
+////////////////////////////////
+// DEFINES
+
+// Assembly is read from stdin
+#define AS_ASSEMBLER_COMMAND_PIPE       "as --64 -o %s%s.o -"
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+static const char* TAG = "UNIX_ASSEMBLER";
+
+////////////////////////////////
+// PRIVATE TYPES
+
+// Objects waiting for linker live in private directory, so parallel builds do not clobber them
+static char objectsDir_[EXTERNAL_OBJECTS_DIR_LENGTH] = {0};
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for assembling generated assembly piped through assembler stdin to object file
+ *
+ * @param[in] objectName        Iguana object name, object file is named after it
+ * @param[in] source            generated assembly
+ * @param[in] length            generated assembly length
+ * @param[in] linkingEnabled    object goes to private directory for linking, otherwise to TEMP_PATH
+ *
+ * @return                      Success state
+ */
+bool UnixAssembler_assembleSource(const char* objectName, const char* source, const size_t length, const bool linkingEnabled)
+{
+    char* fullCommand;
+    const char* objectsDir = linkingEnabled ? UnixAssembler_getObjectsDir() : TEMP_PATH;
+    bool status;
+
+    NULL_GUARD(objectsDir, ERROR, Log_e(TAG, "Failed to create directory for objects"));
+
+    ALLOC_CHECK(fullCommand, sizeof(AS_ASSEMBLER_COMMAND_PIPE) + EXTERNAL_OBJECTS_DIR_LENGTH + CFILES_LENGTH, ERROR);
+
+    sprintf(fullCommand, AS_ASSEMBLER_COMMAND_PIPE, objectsDir, objectName);
+
+    Log_d(TAG, "Executing assembler with piped source: %s", fullCommand);
+
+    status = ExternalCommand_pipeSource(fullCommand, source, length);
+    free(fullCommand);
+
+    if(!status)
+    {
+        Log_e(TAG, "Failed to assemble generated source of %s", objectName);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for getting private objects directory, created on first use
+ *
+ * @return          Directory path ending with separator, NULL on failure
+ */
+const char* UnixAssembler_getObjectsDir(void)
+{
+    return ExternalCommand_getObjectsDir(objectsDir_);
+}
+
+/**
+ * @brief Public method for removing linked objects together with their private directory
+ *
+ * @param[in] objectNames   Iguana object names, same as given for assembling
+ */
+void UnixAssembler_removeObjects(const VectorHandler_t objectNames)
+{
+    ExternalCommand_removeObjects(objectsDir_, objectNames);
+}
@@ -0,0 +1,25 @@
+/**
+ * @file unix_assembler.h
+ *
+ * GNU assembler driver, generated assembly is piped to as and assembled to object files
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-07-28
+ */
+
+#ifndef UTILITY_EXTERNAL_UNIX_ASSEMBLER_UNIX_ASSEMBLER_H_
+#define UTILITY_EXTERNAL_UNIX_ASSEMBLER_UNIX_ASSEMBLER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <vector.h>
+
+bool UnixAssembler_assembleSource(const char* objectName, const char* source, const size_t length, const bool linkingEnabled);
+const char* UnixAssembler_getObjectsDir(void);
+void UnixAssembler_removeObjects(const VectorHandler_t objectNames);
+
+#endif // UTILITY_EXTERNAL_UNIX_ASSEMBLER_UNIX_ASSEMBLER_H_
@@ -14,11 +14,14 @@
 #include "string.h"
 #include <safety_macros.h>
 #include <global_config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
 
 
 ////////////////////////////////
 // DEFINES
-#define LD_LINKER_COMMAND "ld -static -o output --entry " MAIN_PROCESS_FILE_NAME " -lc"
+#define LD_LINKER_COMMAND "ld -o %s --entry " ENTRY_POINT_NAME
 
 ////////////////////////////////
 // PRIVATE CONSTANTS
@@ -35,18 +38,25 @@ static const char* TAG = "UNIX_LINKER";
 ////////////////////////////////
 // IMPLEMENTATION
 
-bool UnixLinker_linkPaths(const VectorHandler_t objectsCompiledExternaly)
+/**
+ * @brief Public method for linking objects without C runtime, objects provide entry point themselves
+ *
+ * @param[in] objectsCompiledExternaly  Iguana object names
+ * @param[in] objectsDir                directory of object files, ending with separator
+ * @param[in] outputName                executable path
+ *
+ * @return                              Success state
+ */
+bool UnixLinker_linkPaths(const VectorHandler_t objectsCompiledExternaly, const char* objectsDir, const char* outputName)
 {
     char* full_command;
     char* iterator;
+    int exitStatus;
 
-    ALLOC_CHECK(full_command, sizeof(LD_LINKER_COMMAND) + CFILES_LENGTH + (CFILES_LENGTH * objectsCompiledExternaly->currentSize), ERROR);
+    ALLOC_CHECK(full_command, sizeof(LD_LINKER_COMMAND) + strlen(outputName) + ((strlen(objectsDir) + CFILES_LENGTH + 3) * objectsCompiledExternaly->currentSize), ERROR);
 
-    full_command[0] = '\0';//null terminator beggining for strncat
     iterator = full_command;
-
-    strcat(iterator, LD_LINKER_COMMAND);
-    iterator += (sizeof(LD_LINKER_COMMAND) - 1);
+    iterator += sprintf(iterator, LD_LINKER_COMMAND, outputName);
 
     for(size_t idx = 0; idx < objectsCompiledExternaly->currentSize; idx++)
     {
@@ -54,21 +64,21 @@ bool UnixLinker_linkPaths(const VectorHandler_t objectsCompiledExternaly)
 
         NULL_GUARD(iguanaFileobject, ERROR, Log_e(TAG, "Null object in linker passed"));
 
-        snprintf(iterator, CFILES_LENGTH + sizeof(' '), " %s%s.o", TEMP_PATH, iguanaFileobject);
-        iterator += (CFILES_LENGTH);
+        iterator += sprintf(iterator, " %s%s.o", objectsDir, iguanaFileobject);
     }
 
     Log_d(TAG, "Executing Linker: %s", full_command);
 
-    if(system(full_command) == -1)
+    exitStatus = system(full_command);
+    free(full_command);
+
+    if((exitStatus == -1) || !WIFEXITED(exitStatus) || (WEXITSTATUS(exitStatus) != 0))
     {
-        free(full_command);
+        Log_e(TAG, "Linker failed with status %d", exitStatus);
         return ERROR;
     }
 
-
     Log_i(TAG, "Linked objects successfuly!");
-    free(full_command);
 
     return SUCCESS;
-}
\ No newline at end of file
+}
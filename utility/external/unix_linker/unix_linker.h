@@ -15,6 +15,6 @@
 #define UTILITY_EXTERNAL_UNIX_LINKER_UNIX_LINKER_H_
 #include <vector.h>
 
-bool UnixLinker_linkPaths(const VectorHandler_t objectsCompiledExternaly);
+bool UnixLinker_linkPaths(const VectorHandler_t objectsCompiledExternaly, const char* objectsDir, const char* outputName);
 
 #endif // UTILITY_EXTERNAL_UNIX_LINKER_UNIX_LINKER_H_
\ No newline at end of file
@@ -0,0 +1,1802 @@
+/**
+ * @file asm_generator.c
+ *
+ * x86-64 GNU assembly backend. Methods are lowered to three address instructions over virtual
+ * registers, packed fields are read and written with shifts and masks on their region words,
+ * virtual registers get machine registers by linear scan and the rest is spilled to frame.
+ *
+ * Only part of language is lowered: one word values, 64 bit words and memory call ABI.
+ * Objects using anything else are reported as not lowered and compiled through C instead.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-07-28
+ */
+
+#include "asm_generator.h"
+#include "generator.h"
+#include <string.h>
+#include <stdlib.h>
+#include <logger.h>
+#include <emitter.h>
+#include <helper_macros.h>
+#include "../hash/hash.h"
+#include <global_config.h>
+#include <compiler_options.h>
+#include "../parser/structures/expression/expressions.h"
+#include "../parser/parser_utilities/post_parsing_utility/bitfit.h"
+
+////////////////////////////////
+// DEFINES
+
+#define ASM_WORD_BITS                   64
+#define ASM_WORD_BYTES                  8
+#define ASM_STACK_ALIGNMENT             16
+#define ASM_INSTRUCTIONS_INITIAL        256
+#define ASM_REGISTERS_INITIAL           64
+#define ASM_SYMBOLS_INITIAL_LENGTH      1024
+#define ASM_OPERAND_TEXT_LENGTH         32
+
+#define ASM_PRINT_FUNCTION              "_iguana_print"
+#define ASM_RETURN_LABEL                ".Liguana_return"
+
+// Region bases live in callee saved registers for whole method
+#define OBJECT_BASE_REGISTER            "%rbx"
+#define PARAMS_BASE_REGISTER            "%r12"
+
+// Never allocated, instructions use them for operands which are not in registers
+#define SCRATCH_REGISTER                "%rax"
+#define REMAINDER_REGISTER              "%rdx"
+#define CONSTANT_REGISTER               "%r11"
+
+#define SPILLED                         -1
+
+// Same word rounding as regions of C backend
+#define WORDS_OF_BITS(bitsize)          ((bitsize) / ASM_WORD_BITS + 1)
+#define FIELD_SHIFT(posBit, bitpack)    (ASM_WORD_BITS - ((posBit) + (bitpack)))
+#define IS_STRADDLING(posBit, bitpack)  (((posBit) + (bitpack)) > ASM_WORD_BITS)
+
+#define EMIT_STRING(string) {if(!Emitter_append(&asmOutput_, string, SIZEOF_NOTERM(string))) {Log_e(TAG, "Failed to emit \"%s\"", string);return ERROR;}}
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+static const char* TAG =                "ASM_GENERATOR";
+
+typedef struct
+{
+    const char* name;
+    bool isCalleeSaved;
+}PhysicalRegister_t;
+
+// Caller saved first, so values not living across calls leave callee saved ones free
+static const PhysicalRegister_t allocatableRegisters_[] =
+{
+    {"%rcx", false},
+    {"%rsi", false},
+    {"%rdi", false},
+    {"%r8", false},
+    {"%r9", false},
+    {"%r10", false},
+    {"%r13", true},
+    {"%r14", true},
+    {"%r15", true}
+};
+
+#define ALLOCATABLE_REGISTERS_COUNT     (sizeof(allocatableRegisters_) / sizeof(PhysicalRegister_t))
+
+static const char ENTRY_POINT_CODE[] =
+    "\t.globl " ENTRY_POINT_NAME "\n"
+    "\t.type " ENTRY_POINT_NAME ", @function\n"
+    ENTRY_POINT_NAME ":\n"
+    "\txorl %edi, %edi\n"
+    "\tcall " MAIN_PROCESS_FILE_NAME "\n"
+    "\tmovl $60, %eax\n"
+    "\txorl %edi, %edi\n"
+    "\tsyscall\n";
+
+// Values are given as words array and count, line is built backwards on stack and written at once
+static const char PRINT_RUNTIME_CODE[] =
+    "\t.type " ASM_PRINT_FUNCTION ", @function\n"
+    ASM_PRINT_FUNCTION ":\n"
+    "\tpushq %rbp\n"
+    "\tmovq %rsp, %rbp\n"
+    "\timulq $21, %rsi, %rax\n"
+    "\taddq $16, %rax\n"
+    "\tandq $-16, %rax\n"
+    "\tsubq %rax, %rsp\n"
+    "\tmovq %rsi, %rcx\n"
+    "\tleaq -1(%rbp), %r9\n"
+    "\tmovb $10, (%r9)\n"
+    "\tmovl $10, %r10d\n"
+    ".Liguana_print_value:\n"
+    "\ttestq %rcx, %rcx\n"
+    "\tjz .Liguana_print_write\n"
+    "\tdecq %rcx\n"
+    "\tdecq %r9\n"
+    "\tmovb $32, (%r9)\n"
+    "\tmovq (%rdi,%rcx,8), %rax\n"
+    ".Liguana_print_digit:\n"
+    "\txorl %edx, %edx\n"
+    "\tdivq %r10\n"
+    "\taddb $48, %dl\n"
+    "\tdecq %r9\n"
+    "\tmovb %dl, (%r9)\n"
+    "\ttestq %rax, %rax\n"
+    "\tjnz .Liguana_print_digit\n"
+    "\tjmp .Liguana_print_value\n"
+    ".Liguana_print_write:\n"
+    "\tmovl $1, %eax\n"
+    "\tmovl $1, %edi\n"
+    "\tmovq %r9, %rsi\n"
+    "\tmovq %rbp, %rdx\n"
+    "\tsubq %r9, %rdx\n"
+    "\tsyscall\n"
+    "\ttestq %rax, %rax\n"
+    "\tjle .Liguana_print_done\n"
+    "\taddq %rax, %r9\n"
+    "\tcmpq %rbp, %r9\n"
+    "\tjb .Liguana_print_write\n"
+    ".Liguana_print_done:\n"
+    "\tleave\n"
+    "\tret\n";
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef enum
+{
+    OPERAND_NONE,
+    OPERAND_CONST,
+    OPERAND_VREG
+}AsmOperandKind_t;
+
+// Constant or virtual register
+typedef struct
+{
+    AsmOperandKind_t kind;
+    uint64_t value;
+}AsmOperand_t;
+
+typedef enum
+{
+    REGION_OBJECT,
+    REGION_PARAMS,
+    REGION_FRAME
+}AsmRegionKind_t;
+
+// Words region, frame ones are placed by byte offset inside method frame
+typedef struct
+{
+    AsmRegionKind_t kind;
+    uint32_t frameOffset;
+}AsmRegion_t;
+
+typedef enum
+{
+    INSTRUCTION_LOAD_FIELD,
+    INSTRUCTION_STORE_FIELD,
+    INSTRUCTION_PACK_FIELD,
+    INSTRUCTION_MASK,
+    INSTRUCTION_BINARY,
+    INSTRUCTION_CALL,
+    INSTRUCTION_PRINT,
+    INSTRUCTION_RETURN
+}AsmInstructionType_t;
+
+typedef struct
+{
+    AsmInstructionType_t type;
+    OperatorType_t operator;
+    AsmOperand_t destination;
+    AsmOperand_t sources[2];
+    AsmRegion_t region;
+    uint32_t group;
+    BitpackPos_t posBit;
+    BitpackSize_t bitpack;
+    uint32_t wordsCount;
+
+    // Method call only
+    bool hasObject;
+    bool isOwnObject;
+    bool hasParams;
+    AsmRegion_t objectRegion;
+    uint32_t objectGroup;
+    size_t symbolOffset;
+}AsmInstruction_t;
+
+typedef struct
+{
+    uint32_t start;
+    uint32_t end;
+    int32_t registerIdx;
+    uint32_t spillOffset;
+    bool crossesCall;
+}VirtualRegister_t;
+
+typedef enum
+{
+    VALUE_OPERAND,
+    VALUE_VARIABLE,
+    VALUE_CALL
+}AsmValueKind_t;
+
+// Postfix stack element, variables and calls are lowered only when operator needs them
+typedef struct
+{
+    AsmValueKind_t kind;
+    AsmOperand_t operand;
+    VariableObjectHandle_t variable;
+    ExMethodCallHandle_t call;
+    BitpackSize_t bitpack;
+}AsmValue_t;
+
+static MainFrameHandle_t currentAst_ =      NULL;
+
+// Whole assembly file is built in memory, buffer is reused between files
+static Emitter_t asmOutput_ =               {0};
+
+// Mangled names of current method, instructions keep offsets into it
+static Emitter_t symbols_ =                 {0};
+
+static AsmInstruction_t* instructions_ =    NULL;
+static uint32_t instructionsCount_ =        0;
+static uint32_t instructionsCapacity_ =     0;
+
+static VirtualRegister_t* registers_ =      NULL;
+static uint32_t registersCount_ =           0;
+static uint32_t registersCapacity_ =        0;
+
+// Frame areas of current method, placed below saved registers
+static uint32_t frameBytes_ =               0;
+static int32_t frameBase_ =                 0;
+static AsmRegion_t localRegion_;
+static uint32_t usedCalleeSaved_ =          0;
+
+static uint32_t methodLabel_ =              0;
+static bool usesPrint_ =                    false;
+static bool isUnsupported_ =                false;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static int methodIteratorCallback_(void *key, int count, void* value, void *user);
+static bool lowerMethod_(const MethodObjectHandle_t method);
+static bool lowerExpression_(const ExpHandle_t expression, AsmValue_t* result);
+static bool lowerOperation_(AsmValue_t* left, AsmValue_t* right, const OperatorType_t operator, AsmValue_t* result);
+static bool lowerCall_(const ExMethodCallHandle_t call, const BitpackSize_t returnBits, AsmValue_t* result);
+static bool lowerVariableLoad_(const VariableObjectHandle_t variable, AsmOperand_t* destination);
+static bool lowerVariableStore_(const VariableObjectHandle_t variable, const AsmOperand_t source);
+static bool valueOfSymbol_(const ExpElementHandle_t symbol, AsmValue_t* value);
+static bool materialize_(AsmValue_t* value);
+static bool checkField_(const VariableObjectHandle_t variable);
+static bool regionOfScope_(const char* scopeName, AsmRegion_t* region);
+static bool unsupported_(const char* feature);
+
+static bool appendInstruction_(const AsmInstruction_t* instruction);
+static bool appendLoadField_(const AsmRegion_t region, const uint32_t group, const BitpackPos_t posBit, const BitpackSize_t bitpack, AsmOperand_t* destination);
+static bool appendStoreField_(const AsmInstructionType_t type, const AsmRegion_t region, const uint32_t group, const BitpackPos_t posBit, const BitpackSize_t bitpack, const AsmOperand_t source);
+static bool appendMask_(const AsmOperand_t source, const BitpackSize_t bitpack, AsmOperand_t* destination);
+static bool appendBinary_(const OperatorType_t operator, const AsmOperand_t left, const AsmOperand_t right, AsmOperand_t* destination);
+static bool newRegister_(AsmOperand_t* operand);
+static uint32_t allocateFrameWords_(const uint32_t wordsCount);
+static bool appendMangledName_(const char* className, const BitpackSize_t objectSizeBits, const char* methodName,
+    const BitpackSize_t returnBits, const VectorHandler_t params, const size_t paramsCount, size_t* symbolOffset);
+
+static bool allocateRegisters_(void);
+static bool emitMethod_(const MethodObjectHandle_t method, const size_t symbolOffset);
+static bool emitInstruction_(const AsmInstruction_t* instruction, const uint32_t returnLabel);
+static bool emitLoadOperand_(const AsmOperand_t* operand, const char* reg);
+static bool emitSourceText_(const AsmOperand_t* operand, char* text);
+static bool emitMask_(const char* reg, const BitpackSize_t bitpack);
+static bool emitStoreWord_(const char* address, const AsmOperand_t* source);
+static bool emitWideImmediate_(const char* mnemonic, const uint64_t value, const char* destination);
+static void operandText_(const AsmOperand_t* operand, char* text);
+static void wordAddressText_(const AsmRegion_t region, const uint32_t group, char* text);
+static inline bool isRegisterOperand_(const AsmOperand_t* operand);
+static inline const char* registerName_(const AsmOperand_t* operand);
+static inline bool fitsImmediate_(const uint64_t value);
+static inline uint64_t bitMask_(const BitpackSize_t bitpack);
+static inline uint8_t bitCount_(uint64_t number);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for lowering one Iguana object to x86-64 assembly
+ *
+ * @param[in] ast               parsed object
+ * @param[in] dstAsmFileName    assembly file path, written only when generated sources are kept
+ * @param[in] isFirstFile       first file gets entry point
+ * @param[out] isLowered        false if object uses features this backend does not lower
+ *
+ * @return                      Success state
+ */
+bool AsmGenerator_generateCode(const MainFrameHandle_t ast, const char* dstAsmFileName, const bool isFirstFile, bool* isLowered)
+{
+    NULL_GUARD(ast, ERROR, Log_e(TAG, "Null AST"));
+
+    currentAst_ = ast;
+    usesPrint_ = false;
+    isUnsupported_ = false;
+    methodLabel_ = 0;
+    *isLowered = false;
+
+    Log_i(TAG, "Starting assembly generation in file: \"%s\"", dstAsmFileName);
+
+    if((asmOutput_.data == NULL) && !Emitter_create(&asmOutput_, ASM_OUTPUT_BUFFER_INITIAL_LENGTH))
+    {
+        Log_e(TAG, "Failed to create assembly output buffer");
+        return ERROR;
+    }
+
+    if((symbols_.data == NULL) && !Emitter_create(&symbols_, ASM_SYMBOLS_INITIAL_LENGTH))
+    {
+        Log_e(TAG, "Failed to create symbols buffer");
+        return ERROR;
+    }
+
+    Emitter_reset(&asmOutput_);
+
+    if(CompilerOptions_get()->wordBits != ASM_WORD_BITS)
+    {
+        unsupported_("word size other than 64 bits");
+        return SUCCESS;
+    }
+
+    if(CompilerOptions_get()->callAbi != CALL_ABI_MEMORY)
+    {
+        unsupported_("register call ABI");
+        return SUCCESS;
+    }
+
+    EMIT_STRING("\t.text\n");
+
+    if(isFirstFile)
+    {
+        EMIT_STRING(ENTRY_POINT_CODE);
+    }
+
+    if(!Hashmap_forEach(&currentAst_->methods, methodIteratorCallback_, NULL))
+    {
+        if(isUnsupported_)
+        {
+            return SUCCESS;
+        }
+
+        Log_e(TAG, "Failed to lower methods of object %s", currentAst_->iguanaObjectName);
+        return ERROR;
+    }
+
+    if(usesPrint_)
+    {
+        EMIT_STRING(PRINT_RUNTIME_CODE);
+    }
+
+    EMIT_STRING("\t.section .note.GNU-stack,\"\",@progbits\n");
+
+    if(CompilerOptions_get()->keepC && !Emitter_writeFile(&asmOutput_, dstAsmFileName))
+    {
+        Log_e(TAG, "Failed to write file %s", dstAsmFileName);
+        return ERROR;
+    }
+
+    *isLowered = true;
+
+    Log_i(TAG, "Assembly generation in file: \"%s\" SUCCESSFUL!", dstAsmFileName);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for getting assembly of last generated file, valid until next generation
+ *
+ * @param[out] code         generated assembly, not null terminated
+ * @param[out] length       generated assembly length in bytes
+ *
+ * @return                  Success state, false if nothing was generated yet
+ */
+bool AsmGenerator_getCode(const char** code, size_t* length)
+{
+    NULL_GUARD(asmOutput_.data, ERROR, Log_e(TAG, "No assembly was generated yet"));
+
+    *code = asmOutput_.data;
+    *length = asmOutput_.length;
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for taking previously generated assembly as last generated file
+ *
+ * @param[in] code              generated assembly
+ * @param[in] length            generated assembly length in bytes
+ * @param[in] dstAsmFileName    assembly file path, written only when generated sources are kept
+ *
+ * @return                      Success state
+ */
+bool AsmGenerator_loadCode(const char* code, const size_t length, const char* dstAsmFileName)
+{
+    if((asmOutput_.data == NULL) && !Emitter_create(&asmOutput_, ASM_OUTPUT_BUFFER_INITIAL_LENGTH))
+    {
+        Log_e(TAG, "Failed to create assembly output buffer");
+        return ERROR;
+    }
+
+    Emitter_reset(&asmOutput_);
+
+    if(!Emitter_append(&asmOutput_, code, length))
+    {
+        Log_e(TAG, "Failed to load assembly of %s", dstAsmFileName);
+        return ERROR;
+    }
+
+    if(CompilerOptions_get()->keepC && !Emitter_writeFile(&asmOutput_, dstAsmFileName))
+    {
+        Log_e(TAG, "Failed to write file %s", dstAsmFileName);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+static int methodIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    const MethodObjectHandle_t method = value;
+
+    NULL_GUARD(method, ERROR, Log_e(TAG, "AST method '%s' is NULL", (char*) key));
+
+    // Ignored and declared only methods are generated elsewhere
+    if((method->accessType == IGNORED) || !method->containsBody)
+    {
+        return SUCCESS;
+    }
+
+    if(!lowerMethod_(method))
+    {
+        if(!isUnsupported_)
+        {
+            Log_e(TAG, "Failed to lower method %s", method->methodName);
+        }
+
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+static bool lowerMethod_(const MethodObjectHandle_t method)
+{
+    size_t symbolOffset;
+
+    instructionsCount_ = 0;
+    registersCount_ = 0;
+    frameBytes_ = 0;
+    usedCalleeSaved_ = 0;
+    Emitter_reset(&symbols_);
+
+    // Params are read straight from region, so they have to fit in one word each
+    for(uint32_t paramIdx = 0; paramIdx < method->parameters->currentSize; paramIdx++)
+    {
+        if(!checkField_(method->parameters->expandable[paramIdx]))
+        {
+            return ERROR;
+        }
+    }
+
+    if(!checkField_(method->returnVariable))
+    {
+        return ERROR;
+    }
+
+    if(!appendMangledName_(currentAst_->iguanaObjectName, currentAst_->objectSizeBits, method->methodName, method->returnVariable->bitpack,
+        method->parameters, method->parameters->currentSize, &symbolOffset))
+    {
+        return ERROR;
+    }
+
+    const uint32_t localWords = WORDS_OF_BITS(method->body.sizeBits);
+
+    localRegion_.kind = REGION_FRAME;
+    localRegion_.frameOffset = allocateFrameWords_(localWords);
+
+    // Locals start zeroed, fields are written by read modify write of their words
+    for(uint32_t wordIdx = 0; wordIdx < localWords; wordIdx++)
+    {
+        const AsmOperand_t zero = {OPERAND_CONST, 0};
+
+        if(!appendStoreField_(INSTRUCTION_STORE_FIELD, localRegion_, wordIdx, 0, ASM_WORD_BITS, zero))
+        {
+            return ERROR;
+        }
+    }
+
+    for(uint64_t scopeElementIndex = 0; scopeElementIndex < method->body.scopeElementsList.currentSize; scopeElementIndex++)
+    {
+        const ExpHandle_t expression = method->body.scopeElementsList.expandable[scopeElementIndex];
+        AsmValue_t result;
+
+        NULL_GUARD(expression, ERROR, Log_e(TAG, "From scope elements extracted NULL expression"));
+
+        switch (Expression_getType(expression))
+        {
+            case SIMPLE_LINE:
+            {
+                if(!lowerExpression_(expression, &result))
+                {
+                    return ERROR;
+                }
+            }break;
+
+            case RETURN_STATEMENT:
+            {
+                AsmInstruction_t returnInstruction = {0};
+
+                if(!lowerExpression_(expression, &result))
+                {
+                    return ERROR;
+                }
+
+                if((method->returnVariable->bitpack > 0) && !lowerVariableStore_(method->returnVariable, result.operand))
+                {
+                    return ERROR;
+                }
+
+                returnInstruction.type = INSTRUCTION_RETURN;
+
+                if(!appendInstruction_(&returnInstruction))
+                {
+                    return ERROR;
+                }
+            }break;
+
+            case REPEAT_LOOP:
+            case WHEN_LOOP:
+            {
+                return unsupported_("loops");
+            }
+
+            default:
+            {
+                return unsupported_("statements other than expressions and return");
+            }
+        }
+    }
+
+    if(!allocateRegisters_())
+    {
+        Log_e(TAG, "Failed to allocate registers of method %s", method->methodName);
+        return ERROR;
+    }
+
+    return emitMethod_(method, symbolOffset);
+}
+
+static bool lowerExpression_(const ExpHandle_t expression, AsmValue_t* result)
+{
+    const size_t elementsCount = Expression_size(expression);
+    AsmValue_t* valuesStack;
+    size_t stackTop = 0;
+
+    if(elementsCount == 0)
+    {
+        return unsupported_("empty expression");
+    }
+
+    valuesStack = alloca(elementsCount * sizeof(AsmValue_t));
+
+    for(ExpIterator_t iterator = Expression_iteratorFirst(expression); iterator < Expression_iteratorLast(expression); iterator++)
+    {
+        const ExpElementHandle_t symbol = *iterator;
+
+        if(ExpElement_isSymbolOperand(symbol))
+        {
+            if(!valueOfSymbol_(symbol, &valuesStack[stackTop]))
+            {
+                return ERROR;
+            }
+
+            stackTop++;
+        }else if(ExpElement_isSymbolOperator(symbol) && (stackTop >= 2))
+        {
+            AsmValue_t left = valuesStack[stackTop - 2];
+            AsmValue_t right = valuesStack[stackTop - 1];
+
+            stackTop--;
+
+            if(!lowerOperation_(&left, &right, (OperatorType_t) ExpElement_getObject(symbol), &valuesStack[stackTop - 1]))
+            {
+                return ERROR;
+            }
+        }else
+        {
+            return unsupported_("malformed expression");
+        }
+    }
+
+    *result = valuesStack[stackTop - 1];
+
+    return materialize_(result);
+}
+
+static bool lowerOperation_(AsmValue_t* left, AsmValue_t* right, const OperatorType_t operator, AsmValue_t* result)
+{
+    const bool isLeftConst = (left->kind == VALUE_OPERAND) && (left->operand.kind == OPERAND_CONST);
+    const bool isRightConst = (right->kind == VALUE_OPERAND) && (right->operand.kind == OPERAND_CONST);
+
+    result->kind = VALUE_OPERAND;
+
+    if(isLeftConst && isRightConst)
+    {
+        AssignValue_t folded;
+
+        result->operand.kind = OPERAND_CONST;
+
+        if(!Generator_foldConstants((AssignValue_t) left->operand.value, (AssignValue_t) right->operand.value, operator, &folded))
+        {
+            return unsupported_("constant operation");
+        }
+
+        result->operand.value = (uint64_t) folded;
+
+        result->bitpack = bitCount_(result->operand.value);
+        return SUCCESS;
+    }
+
+    switch (operator)
+    {
+        case OP_CAST:
+        {
+            if(!isLeftConst || (left->operand.value > ASM_WORD_BITS))
+            {
+                return unsupported_("dynamic or wide cast");
+            }
+
+            const BitpackSize_t castBits = left->operand.value;
+
+            // Cast of call gives its return size
+            if(right->kind == VALUE_CALL)
+            {
+                return lowerCall_(right->call, castBits, result);
+            }
+
+            if(!materialize_(right))
+            {
+                return ERROR;
+            }
+
+            result->bitpack = castBits;
+
+            if(castBits < ASM_WORD_BITS)
+            {
+                return appendMask_(right->operand, castBits, &result->operand);
+            }
+
+            result->operand = right->operand;
+        }break;
+
+        case OP_SET:
+        {
+            if(left->kind != VALUE_VARIABLE)
+            {
+                return unsupported_("assignment to non variable");
+            }
+
+            const bool isRightVariable = (right->kind == VALUE_VARIABLE);
+
+            if(!materialize_(right) || !lowerVariableStore_(left->variable, right->operand))
+            {
+                return ERROR;
+            }
+
+            // Assignment value is assigned variable value, as C backend gives it
+            result->bitpack = left->variable->bitpack;
+
+            if(isRightVariable && (left->variable->bitpack < ASM_WORD_BITS))
+            {
+                return appendMask_(right->operand, left->variable->bitpack, &result->operand);
+            }
+
+            result->operand = right->operand;
+        }break;
+
+        case OP_PLUS:
+        case OP_MINUS:
+        case OP_MULTIPLY:
+        case OP_DIVIDE:
+        case OP_MODULUS:
+        case OP_BIN_AND:
+        case OP_BIN_OR:
+        case OP_BIN_XOR:
+        {
+            // Calls go first, so variables are read after calls could change them
+            if((left->kind == VALUE_CALL) && !materialize_(left))
+            {
+                return ERROR;
+            }
+
+            if((right->kind == VALUE_CALL) && !materialize_(right))
+            {
+                return ERROR;
+            }
+
+            if(!materialize_(left) || !materialize_(right))
+            {
+                return ERROR;
+            }
+
+            result->bitpack = max(left->bitpack, right->bitpack);
+
+            return appendBinary_(operator, left->operand, right->operand, &result->operand);
+        }
+
+        default:
+        {
+            return unsupported_("logical operators");
+        }
+    }
+
+    return SUCCESS;
+}
+
+static bool lowerCall_(const ExMethodCallHandle_t call, const BitpackSize_t returnBits, AsmValue_t* result)
+{
+    const bool isPrintCall = (strcmp("print", call->name) == 0);
+    const size_t paramsCount = call->parameters.currentSize;
+
+    AsmOperand_t* arguments = alloca((paramsCount + 1) * sizeof(AsmOperand_t));
+    VariableObjectHandle_t layoutVars = alloca((paramsCount + 1) * sizeof(VariableObject_t));
+    uint64_t* wordConstants;
+
+    Vector_t layout;
+    BitpackSize_t sizeBits = 0;
+    AsmInstruction_t callInstruction = {0};
+
+    for(size_t paramIdx = 0; paramIdx < paramsCount; paramIdx++)
+    {
+        const ExpHandle_t paramExpression = call->parameters.expandable[paramIdx];
+        AsmValue_t argument;
+        AssignValue_t constant;
+
+        layoutVars[paramIdx].castedFile = NULL;
+        layoutVars[paramIdx].arrayLength = 0;
+
+        // Constant arguments never reach runtime, they are combined into params words
+        if(!isPrintCall && Generator_isConstantExpression(paramExpression, &constant))
+        {
+            arguments[paramIdx].kind = OPERAND_CONST;
+            arguments[paramIdx].value = (uint64_t) constant;
+            layoutVars[paramIdx].bitpack = bitCount_(arguments[paramIdx].value);
+            continue;
+        }
+
+        if(!lowerExpression_(paramExpression, &argument))
+        {
+            return ERROR;
+        }
+
+        if(argument.bitpack > ASM_WORD_BITS)
+        {
+            return unsupported_("wide arguments");
+        }
+
+        arguments[paramIdx] = argument.operand;
+        layoutVars[paramIdx].bitpack = argument.bitpack;
+    }
+
+    result->kind = VALUE_OPERAND;
+    result->operand.kind = OPERAND_CONST;
+    result->operand.value = 0;
+    result->bitpack = returnBits;
+
+    if(isPrintCall)
+    {
+        const AsmRegion_t area = {REGION_FRAME, allocateFrameWords_(paramsCount)};
+
+        for(size_t paramIdx = 0; paramIdx < paramsCount; paramIdx++)
+        {
+            if(!appendStoreField_(INSTRUCTION_STORE_FIELD, area, paramIdx, 0, ASM_WORD_BITS, arguments[paramIdx]))
+            {
+                return ERROR;
+            }
+        }
+
+        callInstruction.type = INSTRUCTION_PRINT;
+        callInstruction.region = area;
+        callInstruction.wordsCount = paramsCount;
+        usesPrint_ = true;
+
+        return appendInstruction_(&callInstruction);
+    }
+
+    if(returnBits > ASM_WORD_BITS)
+    {
+        return unsupported_("wide return values");
+    }
+
+    if(!Vector_create(&layout, NULL))
+    {
+        Log_e(TAG, "Failed to create params layout vector");
+        return ERROR;
+    }
+
+    // Return variable is fitted last, same as in method definition
+    layoutVars[paramsCount].bitpack = returnBits;
+    layoutVars[paramsCount].castedFile = NULL;
+    layoutVars[paramsCount].arrayLength = 0;
+
+    for(size_t paramIdx = 0; paramIdx <= paramsCount; paramIdx++)
+    {
+        if(!Vector_append(&layout, &layoutVars[paramIdx]))
+        {
+            Log_e(TAG, "Failed to append to params layout");
+            return ERROR;
+        }
+    }
+
+    if(!Bitfit_assignGroupsAndPositionForVariableVector_(&layout, FIRST_FIT, &sizeBits))
+    {
+        Log_e(TAG, "Failed to fit params bits");
+        return ERROR;
+    }
+
+    for(size_t paramIdx = 0; paramIdx <= paramsCount; paramIdx++)
+    {
+        if((layoutVars[paramIdx].bitpack > 0) && IS_STRADDLING(layoutVars[paramIdx].posBit, layoutVars[paramIdx].bitpack))
+        {
+            free(layout.expandable);
+            return unsupported_("params straddling words");
+        }
+    }
+
+    const char* className = (call->caller == NULL) ? currentAst_->iguanaObjectName : call->caller->castedFile;
+    const BitpackSize_t objectSizeBits = (call->caller == NULL) ? currentAst_->objectSizeBits : call->caller->bitpack;
+
+    if(className == NULL)
+    {
+        free(layout.expandable);
+        return unsupported_("call on non object variable");
+    }
+
+    if(!appendMangledName_(className, objectSizeBits, call->name, returnBits, &layout, paramsCount, &callInstruction.symbolOffset))
+    {
+        return ERROR;
+    }
+
+    // Params themselves are on stack, only vector array is released
+    free(layout.expandable);
+
+    callInstruction.type = INSTRUCTION_CALL;
+    callInstruction.hasObject = (objectSizeBits > 0);
+    callInstruction.isOwnObject = (call->caller == NULL);
+    callInstruction.hasParams = (paramsCount > 0) || (returnBits > 0);
+
+    if(!callInstruction.isOwnObject)
+    {
+        if(call->caller->allocation != ALLOCATION_STATIC_STACK)
+        {
+            return unsupported_("objects placed with ds or dh");
+        }
+
+        if(!regionOfScope_(call->caller->scopeName, &callInstruction.objectRegion))
+        {
+            return ERROR;
+        }
+
+        callInstruction.objectGroup = call->caller->belongToGroup;
+    }
+
+    if(callInstruction.hasParams)
+    {
+        const uint32_t paramsWords = WORDS_OF_BITS(sizeBits);
+
+        callInstruction.region.kind = REGION_FRAME;
+        callInstruction.region.frameOffset = allocateFrameWords_(paramsWords);
+
+        wordConstants = alloca(paramsWords * sizeof(uint64_t));
+        memset(wordConstants, 0, paramsWords * sizeof(uint64_t));
+
+        for(size_t paramIdx = 0; paramIdx < paramsCount; paramIdx++)
+        {
+            const VariableObjectHandle_t param = &layoutVars[paramIdx];
+
+            if((arguments[paramIdx].kind == OPERAND_CONST) && (param->bitpack > 0))
+            {
+                wordConstants[param->belongToGroup] |= (arguments[paramIdx].value & bitMask_(param->bitpack)) << FIELD_SHIFT(param->posBit, param->bitpack);
+            }
+        }
+
+        // Every params word is written whole once, fields are or-ed into it afterwards
+        for(uint32_t wordIdx = 0; wordIdx < paramsWords; wordIdx++)
+        {
+            const AsmOperand_t wordConstant = {OPERAND_CONST, wordConstants[wordIdx]};
+
+            if(!appendStoreField_(INSTRUCTION_STORE_FIELD, callInstruction.region, wordIdx, 0, ASM_WORD_BITS, wordConstant))
+            {
+                return ERROR;
+            }
+        }
+
+        for(size_t paramIdx = 0; paramIdx < paramsCount; paramIdx++)
+        {
+            const VariableObjectHandle_t param = &layoutVars[paramIdx];
+
+            if((arguments[paramIdx].kind == OPERAND_CONST) || (param->bitpack == 0))
+            {
+                continue;
+            }
+
+            if(!appendStoreField_(INSTRUCTION_PACK_FIELD, callInstruction.region, param->belongToGroup, param->posBit, param->bitpack, arguments[paramIdx]))
+            {
+                return ERROR;
+            }
+        }
+    }
+
+    if(!appendInstruction_(&callInstruction))
+    {
+        return ERROR;
+    }
+
+    if(returnBits > 0)
+    {
+        const VariableObjectHandle_t returnVar = &layoutVars[paramsCount];
+
+        return appendLoadField_(callInstruction.region, returnVar->belongToGroup, returnVar->posBit, returnVar->bitpack, &result->operand);
+    }
+
+    return SUCCESS;
+}
+
+static bool lowerVariableLoad_(const VariableObjectHandle_t variable, AsmOperand_t* destination)
+{
+    AsmRegion_t region;
+
+    if(!checkField_(variable) || !regionOfScope_(variable->scopeName, &region))
+    {
+        return ERROR;
+    }
+
+    if(variable->bitpack == 0)
+    {
+        destination->kind = OPERAND_CONST;
+        destination->value = 0;
+        return SUCCESS;
+    }
+
+    return appendLoadField_(region, variable->belongToGroup, variable->posBit, variable->bitpack, destination);
+}
+
+static bool lowerVariableStore_(const VariableObjectHandle_t variable, const AsmOperand_t source)
+{
+    AsmRegion_t region;
+
+    if(!checkField_(variable) || !regionOfScope_(variable->scopeName, &region))
+    {
+        return ERROR;
+    }
+
+    if(variable->bitpack == 0)
+    {
+        return SUCCESS;
+    }
+
+    return appendStoreField_(INSTRUCTION_STORE_FIELD, region, variable->belongToGroup, variable->posBit, variable->bitpack, source);
+}
+
+static bool valueOfSymbol_(const ExpElementHandle_t symbol, AsmValue_t* value)
+{
+    switch (ExpElement_getType(symbol))
+    {
+        case EXP_CONST_NUMBER:
+        {
+            value->kind = VALUE_OPERAND;
+            value->operand.kind = OPERAND_CONST;
+            value->operand.value = (uint64_t) ExpElement_getObject(symbol);
+            value->bitpack = bitCount_(value->operand.value);
+        }break;
+
+        case EXP_VARIABLE:
+        {
+            value->kind = VALUE_VARIABLE;
+            value->variable = ExpElement_getObject(symbol);
+
+            NULL_GUARD(value->variable, ERROR, Log_e(TAG, "NULL variable in expression"));
+
+            value->bitpack = value->variable->bitpack;
+        }break;
+
+        case EXP_METHOD_CALL:
+        {
+            value->kind = VALUE_CALL;
+            value->call = ExpElement_getObject(symbol);
+
+            NULL_GUARD(value->call, ERROR, Log_e(TAG, "NULL method call in expression"));
+
+            // Call without cast returns nothing
+            value->bitpack = 0;
+        }break;
+
+        default:
+        {
+            return unsupported_("expression element");
+        }
+    }
+
+    return SUCCESS;
+}
+
+static bool materialize_(AsmValue_t* value)
+{
+    switch (value->kind)
+    {
+        case VALUE_VARIABLE:
+        {
+            if(!lowerVariableLoad_(value->variable, &value->operand))
+            {
+                return ERROR;
+            }
+        }break;
+
+        case VALUE_CALL:
+        {
+            if(!lowerCall_(value->call, 0, value))
+            {
+                return ERROR;
+            }
+        }break;
+
+        default: break;
+    }
+
+    value->kind = VALUE_OPERAND;
+
+    return SUCCESS;
+}
+
+static bool checkField_(const VariableObjectHandle_t variable)
+{
+    if(BITFIT_IS_ARRAY(variable) || (variable->arrayOwner != NULL))
+    {
+        return unsupported_("packed arrays");
+    }
+
+    if(variable->bitpack > ASM_WORD_BITS)
+    {
+        return unsupported_("wide variables");
+    }
+
+    if(IS_STRADDLING(variable->posBit, variable->bitpack))
+    {
+        return unsupported_("variables straddling words");
+    }
+
+    return SUCCESS;
+}
+
+static bool regionOfScope_(const char* scopeName, AsmRegion_t* region)
+{
+    NULL_GUARD(scopeName, ERROR, unsupported_("variables without scope"));
+
+    region->frameOffset = 0;
+
+    if(strcmp(scopeName, CLASS_VAR_REGION_NAME) == 0)
+    {
+        region->kind = REGION_OBJECT;
+    }else if(strcmp(scopeName, PARAMS_VAR_REGION_NAME) == 0)
+    {
+        region->kind = REGION_PARAMS;
+    }else if(strcmp(scopeName, LOCAL_VAR_REGION_NAME) == 0)
+    {
+        *region = localRegion_;
+    }else
+    {
+        return unsupported_("variables of unknown scope");
+    }
+
+    return SUCCESS;
+}
+
+static bool unsupported_(const char* feature)
+{
+    isUnsupported_ = true;
+    Log_w(TAG, "Object %s uses %s, which assembly backend does not lower", currentAst_->iguanaObjectName, feature);
+
+    return ERROR;
+}
+
+static bool appendInstruction_(const AsmInstruction_t* instruction)
+{
+    if(instructionsCount_ == instructionsCapacity_)
+    {
+        instructionsCapacity_ = (instructionsCapacity_ == 0) ? ASM_INSTRUCTIONS_INITIAL : (instructionsCapacity_ * 2);
+        REALLOC_CHECK(instructions_, instructionsCapacity_ * sizeof(AsmInstruction_t), ERROR);
+    }
+
+    instructions_[instructionsCount_++] = *instruction;
+
+    return SUCCESS;
+}
+
+static bool appendLoadField_(const AsmRegion_t region, const uint32_t group, const BitpackPos_t posBit, const BitpackSize_t bitpack, AsmOperand_t* destination)
+{
+    AsmInstruction_t instruction = {0};
+
+    if(!newRegister_(destination))
+    {
+        return ERROR;
+    }
+
+    instruction.type = INSTRUCTION_LOAD_FIELD;
+    instruction.destination = *destination;
+    instruction.region = region;
+    instruction.group = group;
+    instruction.posBit = posBit;
+    instruction.bitpack = bitpack;
+
+    return appendInstruction_(&instruction);
+}
+
+static bool appendStoreField_(const AsmInstructionType_t type, const AsmRegion_t region, const uint32_t group, const BitpackPos_t posBit, const BitpackSize_t bitpack, const AsmOperand_t source)
+{
+    AsmInstruction_t instruction = {0};
+
+    instruction.type = type;
+    instruction.sources[0] = source;
+    instruction.region = region;
+    instruction.group = group;
+    instruction.posBit = posBit;
+    instruction.bitpack = bitpack;
+
+    return appendInstruction_(&instruction);
+}
+
+static bool appendMask_(const AsmOperand_t source, const BitpackSize_t bitpack, AsmOperand_t* destination)
+{
+    AsmInstruction_t instruction = {0};
+
+    if(source.kind == OPERAND_CONST)
+    {
+        destination->kind = OPERAND_CONST;
+        destination->value = source.value & bitMask_(bitpack);
+        return SUCCESS;
+    }
+
+    if(!newRegister_(destination))
+    {
+        return ERROR;
+    }
+
+    instruction.type = INSTRUCTION_MASK;
+    instruction.destination = *destination;
+    instruction.sources[0] = source;
+    instruction.bitpack = bitpack;
+
+    return appendInstruction_(&instruction);
+}
+
+static bool appendBinary_(const OperatorType_t operator, const AsmOperand_t left, const AsmOperand_t right, AsmOperand_t* destination)
+{
+    AsmInstruction_t instruction = {0};
+
+    if(!newRegister_(destination))
+    {
+        return ERROR;
+    }
+
+    instruction.type = INSTRUCTION_BINARY;
+    instruction.operator = operator;
+    instruction.destination = *destination;
+    instruction.sources[0] = left;
+    instruction.sources[1] = right;
+
+    return appendInstruction_(&instruction);
+}
+
+static bool newRegister_(AsmOperand_t* operand)
+{
+    if(registersCount_ == registersCapacity_)
+    {
+        registersCapacity_ = (registersCapacity_ == 0) ? ASM_REGISTERS_INITIAL : (registersCapacity_ * 2);
+        REALLOC_CHECK(registers_, registersCapacity_ * sizeof(VirtualRegister_t), ERROR);
+    }
+
+    operand->kind = OPERAND_VREG;
+    operand->value = registersCount_++;
+
+    return SUCCESS;
+}
+
+static uint32_t allocateFrameWords_(const uint32_t wordsCount)
+{
+    const uint32_t offset = frameBytes_;
+
+    frameBytes_ += wordsCount * ASM_WORD_BYTES;
+
+    return offset;
+}
+
+static bool appendMangledName_(const char* className, const BitpackSize_t objectSizeBits, const char* methodName,
+    const BitpackSize_t returnBits, const VectorHandler_t params, const size_t paramsCount, size_t* symbolOffset)
+{
+    *symbolOffset = symbols_.length;
+
+    // Same names as C backend gives through asm labels, so both backends link together. Register ABI is not lowered
+    return Generator_emitMangledName(&symbols_, className, objectSizeBits, methodName, returnBits, false, params, paramsCount) &&
+           Emitter_append(&symbols_, "", 1);
+}
+
+/**
+ * @brief Linear scan over live intervals of virtual registers. Values living across calls get
+ * only callee saved registers, when none is free the interval ending last is spilled to frame.
+ */
+static bool allocateRegisters_(void)
+{
+    uint32_t* callsUntil;
+    uint32_t active[ALLOCATABLE_REGISTERS_COUNT];
+    uint32_t activeCount = 0;
+    int32_t registerOwner[ALLOCATABLE_REGISTERS_COUNT];
+
+    for(uint32_t registerIdx = 0; registerIdx < registersCount_; registerIdx++)
+    {
+        registers_[registerIdx].start = UINT32_MAX;
+        registers_[registerIdx].end = 0;
+        registers_[registerIdx].registerIdx = SPILLED;
+    }
+
+    ALLOC_CHECK(callsUntil, (instructionsCount_ + 1) * sizeof(uint32_t), ERROR);
+
+    callsUntil[0] = 0;
+
+    for(uint32_t instructionIdx = 0; instructionIdx < instructionsCount_; instructionIdx++)
+    {
+        const AsmInstruction_t* instruction = &instructions_[instructionIdx];
+
+        for(uint32_t sourceIdx = 0; sourceIdx < 2; sourceIdx++)
+        {
+            if(instruction->sources[sourceIdx].kind == OPERAND_VREG)
+            {
+                registers_[instruction->sources[sourceIdx].value].end = instructionIdx;
+            }
+        }
+
+        if(instruction->destination.kind == OPERAND_VREG)
+        {
+            VirtualRegister_t* defined = &registers_[instruction->destination.value];
+
+            defined->start = instructionIdx;
+            defined->end = max(defined->end, instructionIdx);
+        }
+
+        callsUntil[instructionIdx + 1] = callsUntil[instructionIdx] +
+            (((instruction->type == INSTRUCTION_CALL) || (instruction->type == INSTRUCTION_PRINT)) ? 1 : 0);
+    }
+
+    for(uint32_t registerIdx = 0; registerIdx < ALLOCATABLE_REGISTERS_COUNT; registerIdx++)
+    {
+        registerOwner[registerIdx] = SPILLED;
+    }
+
+    // Registers are created in definition order, so they are already sorted by interval start
+    for(uint32_t current = 0; current < registersCount_; current++)
+    {
+        VirtualRegister_t* interval = &registers_[current];
+        int32_t chosen = SPILLED;
+
+        interval->crossesCall = (callsUntil[interval->end] - callsUntil[interval->start + 1]) > 0;
+
+        // Expiring intervals which ended before this one starts
+        for(uint32_t activeIdx = 0; activeIdx < activeCount;)
+        {
+            if(registers_[active[activeIdx]].end < interval->start)
+            {
+                registerOwner[registers_[active[activeIdx]].registerIdx] = SPILLED;
+                active[activeIdx] = active[--activeCount];
+            }else
+            {
+                activeIdx++;
+            }
+        }
+
+        for(uint32_t registerIdx = 0; registerIdx < ALLOCATABLE_REGISTERS_COUNT; registerIdx++)
+        {
+            if((registerOwner[registerIdx] == SPILLED) && (!interval->crossesCall || allocatableRegisters_[registerIdx].isCalleeSaved))
+            {
+                chosen = registerIdx;
+                break;
+            }
+        }
+
+        if(chosen == SPILLED)
+        {
+            uint32_t victimIdx = activeCount;
+
+            for(uint32_t activeIdx = 0; activeIdx < activeCount; activeIdx++)
+            {
+                const VirtualRegister_t* candidate = &registers_[active[activeIdx]];
+
+                if((!interval->crossesCall || allocatableRegisters_[candidate->registerIdx].isCalleeSaved) &&
+                   ((victimIdx == activeCount) || (candidate->end > registers_[active[victimIdx]].end)))
+                {
+                    victimIdx = activeIdx;
+                }
+            }
+
+            if((victimIdx == activeCount) || (registers_[active[victimIdx]].end <= interval->end))
+            {
+                interval->spillOffset = allocateFrameWords_(1);
+                continue;
+            }
+
+            VirtualRegister_t* victim = &registers_[active[victimIdx]];
+
+            chosen = victim->registerIdx;
+            victim->registerIdx = SPILLED;
+            victim->spillOffset = allocateFrameWords_(1);
+            active[victimIdx] = active[--activeCount];
+        }
+
+        interval->registerIdx = chosen;
+        registerOwner[chosen] = current;
+        active[activeCount++] = current;
+
+        if(allocatableRegisters_[chosen].isCalleeSaved)
+        {
+            usedCalleeSaved_ |= (1U << chosen);
+        }
+    }
+
+    free(callsUntil);
+
+    return SUCCESS;
+}
+
+static bool emitMethod_(const MethodObjectHandle_t method, const size_t symbolOffset)
+{
+    const char* savedRegisters[ALLOCATABLE_REGISTERS_COUNT + 2];
+    uint32_t savedCount = 0;
+
+    const char* symbol = symbols_.data + symbolOffset;
+    const bool hasObject = (currentAst_->objectSizeBits > 0);
+    const bool hasParams = (method->parameters->currentSize > 0) || (method->returnVariable->bitpack > 0);
+    const uint32_t returnLabel = methodLabel_++;
+
+    if(hasObject)
+    {
+        savedRegisters[savedCount++] = OBJECT_BASE_REGISTER;
+    }
+
+    if(hasParams)
+    {
+        savedRegisters[savedCount++] = PARAMS_BASE_REGISTER;
+    }
+
+    for(uint32_t registerIdx = 0; registerIdx < ALLOCATABLE_REGISTERS_COUNT; registerIdx++)
+    {
+        if(usedCalleeSaved_ & (1U << registerIdx))
+        {
+            savedRegisters[savedCount++] = allocatableRegisters_[registerIdx].name;
+        }
+    }
+
+    // Frame is sized so stack stays aligned for calls
+    const uint32_t savedBytes = savedCount * ASM_WORD_BYTES;
+    const uint32_t frameSize = ((savedBytes + frameBytes_ + ASM_STACK_ALIGNMENT - 1) / ASM_STACK_ALIGNMENT) * ASM_STACK_ALIGNMENT - savedBytes;
+
+    frameBase_ = -((int32_t) (savedBytes + frameSize));
+
+    Emitter_format(&asmOutput_, "\t.globl %s\n\t.type %s, @function\n%s:\n\tpushq %%rbp\n\tmovq %%rsp, %%rbp\n", symbol, symbol, symbol);
+
+    for(uint32_t savedIdx = 0; savedIdx < savedCount; savedIdx++)
+    {
+        Emitter_format(&asmOutput_, "\tpushq %s\n", savedRegisters[savedIdx]);
+    }
+
+    if(frameSize > 0)
+    {
+        Emitter_format(&asmOutput_, "\tsubq $%u, %%rsp\n", frameSize);
+    }
+
+    if(hasObject)
+    {
+        EMIT_STRING("\tmovq %rdi, " OBJECT_BASE_REGISTER "\n");
+    }
+
+    if(hasParams)
+    {
+        Emitter_format(&asmOutput_, "\tmovq %s, %s\n", hasObject ? "%rsi" : "%rdi", PARAMS_BASE_REGISTER);
+    }
+
+    for(uint32_t instructionIdx = 0; instructionIdx < instructionsCount_; instructionIdx++)
+    {
+        if(!emitInstruction_(&instructions_[instructionIdx], returnLabel))
+        {
+            Log_e(TAG, "Failed to emit instruction of method %s", method->methodName);
+            return ERROR;
+        }
+    }
+
+    Emitter_format(&asmOutput_, ASM_RETURN_LABEL "%u:\n", returnLabel);
+
+    if(savedCount > 0)
+    {
+        Emitter_format(&asmOutput_, "\tleaq -%u(%%rbp), %%rsp\n", savedBytes);
+    }
+
+    for(uint32_t savedIdx = savedCount; savedIdx > 0; savedIdx--)
+    {
+        Emitter_format(&asmOutput_, "\tpopq %s\n", savedRegisters[savedIdx - 1]);
+    }
+
+    if(savedCount > 0)
+    {
+        EMIT_STRING("\tpopq %rbp\n");
+    }else
+    {
+        EMIT_STRING("\tleave\n");
+    }
+
+    return Emitter_format(&asmOutput_, "\tret\n\t.size %s, .-%s\n", symbol, symbol) > 0;
+}
+
+static bool emitInstruction_(const AsmInstruction_t* instruction, const uint32_t returnLabel)
+{
+    char address[ASM_OPERAND_TEXT_LENGTH];
+    char destination[ASM_OPERAND_TEXT_LENGTH];
+    char source[ASM_OPERAND_TEXT_LENGTH];
+
+    const BitpackSize_t bitpack = instruction->bitpack;
+    const BitpackSize_t shift = FIELD_SHIFT(instruction->posBit, bitpack);
+
+    wordAddressText_(instruction->region, instruction->group, address);
+    operandText_(&instruction->destination, destination);
+
+    // Destination not in register is computed in scratch and stored afterwards
+    const char* target = isRegisterOperand_(&instruction->destination) ? registerName_(&instruction->destination) : SCRATCH_REGISTER;
+
+    switch (instruction->type)
+    {
+        case INSTRUCTION_LOAD_FIELD:
+        {
+            Emitter_format(&asmOutput_, "\tmovq %s, %s\n", address, target);
+
+            if(shift > 0)
+            {
+                Emitter_format(&asmOutput_, "\tshrq $%lu, %s\n", shift, target);
+            }
+
+            // Field on top of word has nothing left above it after shift
+            if((instruction->posBit > 0) && !emitMask_(target, bitpack))
+            {
+                return ERROR;
+            }
+        }break;
+
+        case INSTRUCTION_STORE_FIELD:
+        case INSTRUCTION_PACK_FIELD:
+        {
+            const AsmOperand_t* value = &instruction->sources[0];
+
+            if(bitpack == ASM_WORD_BITS)
+            {
+                return emitStoreWord_(address, value);
+            }
+
+            if(instruction->type == INSTRUCTION_STORE_FIELD)
+            {
+                const uint64_t keepMask = ~(bitMask_(bitpack) << shift);
+
+                if(fitsImmediate_(keepMask))
+                {
+                    Emitter_format(&asmOutput_, "\tandq $%ld, %s\n", (int64_t) keepMask, address);
+                }else
+                {
+                    emitWideImmediate_("andq", keepMask, address);
+                }
+            }
+
+            if(value->kind == OPERAND_CONST)
+            {
+                const uint64_t fieldBits = (value->value & bitMask_(bitpack)) << shift;
+
+                if(fieldBits == 0)
+                {
+                    return SUCCESS;
+                }
+
+                if(fitsImmediate_(fieldBits))
+                {
+                    return Emitter_format(&asmOutput_, "\torq $%ld, %s\n", (int64_t) fieldBits, address) > 0;
+                }
+
+                return emitWideImmediate_("orq", fieldBits, address);
+            }
+
+            if(!emitLoadOperand_(value, SCRATCH_REGISTER))
+            {
+                return ERROR;
+            }
+
+            // Bits above top field are shifted out of word anyway
+            if((instruction->posBit > 0) && !emitMask_(SCRATCH_REGISTER, bitpack))
+            {
+                return ERROR;
+            }
+
+            if(shift > 0)
+            {
+                Emitter_format(&asmOutput_, "\tshlq $%lu, %s\n", shift, SCRATCH_REGISTER);
+            }
+
+            return Emitter_format(&asmOutput_, "\torq %s, %s\n", SCRATCH_REGISTER, address) > 0;
+        }
+
+        case INSTRUCTION_MASK:
+        {
+            if(!emitLoadOperand_(&instruction->sources[0], target) || !emitMask_(target, bitpack))
+            {
+                return ERROR;
+            }
+        }break;
+
+        case INSTRUCTION_BINARY:
+        {
+            const AsmOperand_t* left = &instruction->sources[0];
+            const AsmOperand_t* right = &instruction->sources[1];
+
+            if((instruction->operator == OP_DIVIDE) || (instruction->operator == OP_MODULUS))
+            {
+                if(!emitLoadOperand_(left, SCRATCH_REGISTER))
+                {
+                    return ERROR;
+                }
+
+                EMIT_STRING("\txorl %edx, %edx\n");
+
+                if(right->kind == OPERAND_CONST)
+                {
+                    if(!emitLoadOperand_(right, CONSTANT_REGISTER))
+                    {
+                        return ERROR;
+                    }
+
+                    EMIT_STRING("\tdivq " CONSTANT_REGISTER "\n");
+                }else
+                {
+                    operandText_(right, source);
+                    Emitter_format(&asmOutput_, "\tdivq %s\n", source);
+                }
+
+                return Emitter_format(&asmOutput_, "\tmovq %s, %s\n", (instruction->operator == OP_DIVIDE) ? SCRATCH_REGISTER : REMAINDER_REGISTER, destination) > 0;
+            }
+
+            const char* mnemonic;
+
+            switch (instruction->operator)
+            {
+                case OP_PLUS:       mnemonic = "addq"; break;
+                case OP_MINUS:      mnemonic = "subq"; break;
+                case OP_MULTIPLY:   mnemonic = "imulq"; break;
+                case OP_BIN_AND:    mnemonic = "andq"; break;
+                case OP_BIN_OR:     mnemonic = "orq"; break;
+                case OP_BIN_XOR:    mnemonic = "xorq"; break;
+
+                default:
+                {
+                    Log_e(TAG, "Unhandled binary operator %d", instruction->operator);
+                }return ERROR;
+            }
+
+            if(!emitLoadOperand_(left, target) || !emitSourceText_(right, source))
+            {
+                return ERROR;
+            }
+
+            Emitter_format(&asmOutput_, "\t%s %s, %s\n", mnemonic, source, target);
+        }break;
+
+        case INSTRUCTION_CALL:
+        {
+            const char* argumentRegisters[] = {"%rdi", "%rsi"};
+            uint32_t argumentIdx = 0;
+
+            if(instruction->hasObject)
+            {
+                if(instruction->isOwnObject)
+                {
+                    EMIT_STRING("\tmovq " OBJECT_BASE_REGISTER ", %rdi\n");
+                }else
+                {
+                    wordAddressText_(instruction->objectRegion, instruction->objectGroup, source);
+                    Emitter_format(&asmOutput_, "\tleaq %s, %%rdi\n", source);
+                }
+
+                argumentIdx++;
+            }
+
+            if(instruction->hasParams)
+            {
+                Emitter_format(&asmOutput_, "\tleaq %s, %s\n", address, argumentRegisters[argumentIdx]);
+            }
+
+            return Emitter_format(&asmOutput_, "\tcall %s\n", symbols_.data + instruction->symbolOffset) > 0;
+        }
+
+        case INSTRUCTION_PRINT:
+        {
+            return Emitter_format(&asmOutput_, "\tleaq %s, %%rdi\n\tmovl $%u, %%esi\n\tcall " ASM_PRINT_FUNCTION "\n", address, instruction->wordsCount) > 0;
+        }
+
+        case INSTRUCTION_RETURN:
+        {
+            return Emitter_format(&asmOutput_, "\tjmp " ASM_RETURN_LABEL "%u\n", returnLabel) > 0;
+        }
+
+        default:
+        {
+            Log_e(TAG, "Unknown instruction type %d", instruction->type);
+        }return ERROR;
+    }
+
+    if(!isRegisterOperand_(&instruction->destination))
+    {
+        return Emitter_format(&asmOutput_, "\tmovq %s, %s\n", SCRATCH_REGISTER, destination) > 0;
+    }
+
+    return SUCCESS;
+}
+
+static bool emitLoadOperand_(const AsmOperand_t* operand, const char* reg)
+{
+    char text[ASM_OPERAND_TEXT_LENGTH];
+
+    if(operand->kind == OPERAND_CONST)
+    {
+        if(fitsImmediate_(operand->value))
+        {
+            return Emitter_format(&asmOutput_, "\tmovq $%ld, %s\n", (int64_t) operand->value, reg) > 0;
+        }
+
+        return Emitter_format(&asmOutput_, "\tmovabsq $0x%lx, %s\n", operand->value, reg) > 0;
+    }
+
+    if(isRegisterOperand_(operand) && (strcmp(registerName_(operand), reg) == 0))
+    {
+        return SUCCESS;
+    }
+
+    operandText_(operand, text);
+
+    return Emitter_format(&asmOutput_, "\tmovq %s, %s\n", text, reg) > 0;
+}
+
+static bool emitSourceText_(const AsmOperand_t* operand, char* text)
+{
+    // Immediate of ALU instruction is sign extended 32 bits, bigger constants go through register
+    if((operand->kind == OPERAND_CONST) && !fitsImmediate_(operand->value))
+    {
+        strcpy(text, CONSTANT_REGISTER);
+        return emitLoadOperand_(operand, CONSTANT_REGISTER);
+    }
+
+    operandText_(operand, text);
+
+    return SUCCESS;
+}
+
+static bool emitMask_(const char* reg, const BitpackSize_t bitpack)
+{
+    if(bitpack >= ASM_WORD_BITS)
+    {
+        return SUCCESS;
+    }
+
+    if(fitsImmediate_(bitMask_(bitpack)))
+    {
+        return Emitter_format(&asmOutput_, "\tandq $0x%lx, %s\n", bitMask_(bitpack), reg) > 0;
+    }
+
+    return emitWideImmediate_("andq", bitMask_(bitpack), reg);
+}
+
+static bool emitStoreWord_(const char* address, const AsmOperand_t* source)
+{
+    char text[ASM_OPERAND_TEXT_LENGTH];
+
+    if(((source->kind == OPERAND_CONST) && fitsImmediate_(source->value)) || isRegisterOperand_(source))
+    {
+        operandText_(source, text);
+        return Emitter_format(&asmOutput_, "\tmovq %s, %s\n", text, address) > 0;
+    }
+
+    if(!emitLoadOperand_(source, SCRATCH_REGISTER))
+    {
+        return ERROR;
+    }
+
+    return Emitter_format(&asmOutput_, "\tmovq %s, %s\n", SCRATCH_REGISTER, address) > 0;
+}
+
+static bool emitWideImmediate_(const char* mnemonic, const uint64_t value, const char* destination)
+{
+    return Emitter_format(&asmOutput_, "\tmovabsq $0x%lx, %s\n\t%s %s, %s\n", value, CONSTANT_REGISTER, mnemonic, CONSTANT_REGISTER, destination) > 0;
+}
+
+static void operandText_(const AsmOperand_t* operand, char* text)
+{
+    switch (operand->kind)
+    {
+        case OPERAND_CONST:
+        {
+            snprintf(text, ASM_OPERAND_TEXT_LENGTH, "$%ld", (int64_t) operand->value);
+        }break;
+
+        case OPERAND_VREG:
+        {
+            const VirtualRegister_t* vreg = &registers_[operand->value];
+
+            if(vreg->registerIdx != SPILLED)
+            {
+                snprintf(text, ASM_OPERAND_TEXT_LENGTH, "%s", allocatableRegisters_[vreg->registerIdx].name);
+            }else
+            {
+                snprintf(text, ASM_OPERAND_TEXT_LENGTH, "%d(%%rbp)", frameBase_ + (int32_t) vreg->spillOffset);
+            }
+        }break;
+
+        default:
+        {
+            text[0] = '\0';
+        }break;
+    }
+}
+
+static void wordAddressText_(const AsmRegion_t region, const uint32_t group, char* text)
+{
+    switch (region.kind)
+    {
+        case REGION_OBJECT: snprintf(text, ASM_OPERAND_TEXT_LENGTH, "%u(%s)", group * ASM_WORD_BYTES, OBJECT_BASE_REGISTER); break;
+        case REGION_PARAMS: snprintf(text, ASM_OPERAND_TEXT_LENGTH, "%u(%s)", group * ASM_WORD_BYTES, PARAMS_BASE_REGISTER); break;
+
+        default:
+        {
+            snprintf(text, ASM_OPERAND_TEXT_LENGTH, "%d(%%rbp)", frameBase_ + (int32_t) (region.frameOffset + group * ASM_WORD_BYTES));
+        }break;
+    }
+}
+
+static inline bool isRegisterOperand_(const AsmOperand_t* operand)
+{
+    return (operand->kind == OPERAND_VREG) && (registers_[operand->value].registerIdx != SPILLED);
+}
+
+static inline const char* registerName_(const AsmOperand_t* operand)
+{
+    return allocatableRegisters_[registers_[operand->value].registerIdx].name;
+}
+
+static inline bool fitsImmediate_(const uint64_t value)
+{
+    return ((int64_t) value) == ((int64_t) (int32_t) value);
+}
+
+static inline uint64_t bitMask_(const BitpackSize_t bitpack)
+{
+    return (bitpack >= ASM_WORD_BITS) ? UINT64_MAX : ((((uint64_t) 1) << bitpack) - 1);
+}
+
+static inline uint8_t bitCount_(uint64_t number)
+{
+    uint8_t count = 0;
+
+    while(number)
+    {
+        count++;
+        number >>= 1;
+    }
+
+    return count;
+}
@@ -0,0 +1,27 @@
+/**
+ * @file asm_generator.h
+ *
+ * x86-64 GNU assembly backend, lowers AST straight to assembly for as without C compiler
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-07-28
+ */
+
+#ifndef UTILITY_GENERATOR_ASM_GENERATOR_H_
+#define UTILITY_GENERATOR_ASM_GENERATOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../parser/structures/main_frame/main_frame.h"
+
+#define ASM_OUTPUT_BUFFER_INITIAL_LENGTH    65536
+
+bool AsmGenerator_generateCode(const MainFrameHandle_t ast, const char* dstAsmFileName, const bool isFirstFile, bool* isLowered);
+bool AsmGenerator_getCode(const char** code, size_t* length);
+bool AsmGenerator_loadCode(const char* code, const size_t length, const char* dstAsmFileName);
+
+#endif // UTILITY_GENERATOR_ASM_GENERATOR_H_
@@ -0,0 +1,66 @@
+/**
+ * @file alloc_arithmetic.h
+ *
+ * Runtime injected into generated C when method places object with ds or dh keyword.
+ * ds object takes its words with alloca at method entry, so they are freed with frame.
+ * dh object takes words from pool of its object type. Size of type is known at compile time,
+ * so pool has one cell size: slabs are carved into cells, freed cells go to free list and are
+ * taken before new slab, so allocation and free are few stores. First cell of slab links slabs
+ * of pool. Pools are weak symbols named by type, every object file using type carries one and
+ * linker keeps one of them. Cells are word aligned, or start on own cache line when asked.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-26
+ */
+
+#ifndef UTILITY_GENERATOR_BIT_ARITHMETIC_ALLOC_ARITHMETIC_H_
+#define UTILITY_GENERATOR_BIT_ARITHMETIC_ALLOC_ARITHMETIC_H_
+
+#include <global_config.h>
+#include "../csyntax_database.h"
+#include "../config_generator.h"
+
+#define AALLOC_SLAB_SIZE            "4096"
+#define AALLOC_SLAB_MIN_CELLS       "8"
+
+// Alignment of pool cells, cache line one needs aligned_alloc of C11
+#define AALLOC_ALIGN_WORD           "sizeof(void*)"
+#define AALLOC_ALIGN_CACHE_LINE     "64"
+
+// Names of runtime helpers used by generator
+#define AALLOC_STACK_DEF            "alloca"
+#define AALLOC_POOL_TYPE_DEF        "_iguana_pool_t"
+#define AALLOC_POOL_ALIGN_DEF       "_IGUANA_POOL_ALIGN"
+#define AALLOC_POOL_ALLOC_DEF       "_iguana_pool_alloc"
+#define AALLOC_POOL_FREE_DEF        "_iguana_pool_free"
+#define AALLOC_POOL_FREE_BULK_DEF   "_iguana_pool_free_bulk"
+
+// Prefix of pointer to words of object placed with ds / dh and prefix of object type pool
+#define AALLOC_OBJECT_PREFIX        "_iguana_obj_"
+#define AALLOC_POOL_PREFIX          "_iguana_pool_"
+
+static const char ALLOC_STACK_RUNTIME[] =
+INCLUDE_WRAP("alloca");
+
+// Generator defines _IGUANA_POOL_ALIGN before runtime, bulk free takes chain already linked through cells
+static const char ALLOC_POOL_RUNTIME[] =
+INCLUDE_WRAP("stdlib")
+"typedef struct{void* free; void* slabs;} " AALLOC_POOL_TYPE_DEF ";\n"
+"#define _IGUANA_POOL_CELL(bytes) ((((bytes) + " AALLOC_POOL_ALIGN_DEF " - 1) / " AALLOC_POOL_ALIGN_DEF ") * " AALLOC_POOL_ALIGN_DEF ")\n"
+"static void _iguana_pool_grow(" AALLOC_POOL_TYPE_DEF "* pool, unsigned long cell)\n"
+"{unsigned long size = cell * " AALLOC_SLAB_MIN_CELLS "; if(size < " AALLOC_SLAB_SIZE ") size = (" AALLOC_SLAB_SIZE " / cell) * cell;\n"
+" char* slab = (" AALLOC_POOL_ALIGN_DEF " > sizeof(void*)) ? aligned_alloc(" AALLOC_POOL_ALIGN_DEF ", size) : malloc(size); if(slab == NULL) abort();\n"
+" *(void**) slab = pool->slabs; pool->slabs = slab;\n"
+" for(unsigned long i = size - cell; i >= cell; i -= cell){*(void**) (slab + i) = pool->free; pool->free = slab + i;}}\n"
+"static inline void* " AALLOC_POOL_ALLOC_DEF "(" AALLOC_POOL_TYPE_DEF "* pool, unsigned long bytes)\n"
+"{if(pool->free == NULL) _iguana_pool_grow(pool, _IGUANA_POOL_CELL(bytes)); void* p = pool->free; pool->free = *(void**) p; return p;}\n"
+"static inline void " AALLOC_POOL_FREE_DEF "(" AALLOC_POOL_TYPE_DEF "* pool, void* p)\n"
+"{*(void**) p = pool->free; pool->free = p;}\n"
+"static inline void " AALLOC_POOL_FREE_BULK_DEF "(" AALLOC_POOL_TYPE_DEF "* pool, void* first, void* last)\n"
+"{*(void**) last = pool->free; pool->free = first;}\n";
+
+#endif // UTILITY_GENERATOR_BIT_ARITHMETIC_ALLOC_ARITHMETIC_H_
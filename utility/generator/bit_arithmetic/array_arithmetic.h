@@ -0,0 +1,80 @@
+/**
+ * @file array_arithmetic.h
+ *
+ * Runtime injected into generated C when object or method declares packed array. Array is run
+ * of whole words with lanes of equal width, so bulk statements never look at separate elements.
+ * Kernels go over words with GCC vector extensions, 32 bytes at once (SSE2 pairs, AVX2 when C
+ * compiler target has it), remaining words and compilers without extensions use scalar loops.
+ * Element-wise addition is SWAR: top bit of every lane is added without carry, so carry never
+ * leaks into neighbouring lane. Popcount counts storage as bytes, padding lanes are always zero.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-21
+ */
+
+#ifndef UTILITY_GENERATOR_BIT_ARITHMETIC_ARRAY_ARITHMETIC_H_
+#define UTILITY_GENERATOR_BIT_ARITHMETIC_ARRAY_ARITHMETIC_H_
+
+#include <global_config.h>
+#include "../csyntax_database.h"
+#include "../config_generator.h"
+
+// Names of runtime helpers used by generator
+#define AARRAY_FILL_DEF             "_iguana_array_fill"
+#define AARRAY_COPY_DEF             "_iguana_array_copy"
+#define AARRAY_ADD_DEF              "_iguana_array_add"
+#define AARRAY_XOR_DEF              "_iguana_array_xor"
+#define AARRAY_AND_DEF              "_iguana_array_and"
+#define AARRAY_POPCOUNT_DEF         "_iguana_array_popcount"
+
+// Builtin method of language counting set bits of array
+#define AARRAY_POPCOUNT_NAME        "popcount"
+
+// Vectors are loaded and stored with memcpy, array words have no alignment beyond word one
+#define AARRAY_VECTOR_LOOP(operation) \
+"#ifdef _IGUANA_VEC_WORDS\n" \
+" for(; i + _IGUANA_VEC_WORDS <= words; i += _IGUANA_VEC_WORDS){_iguana_vec_t x, y; memcpy(&x, a + i, sizeof(x)); memcpy(&y, b + i, sizeof(y)); " operation " memcpy(d + i, &x, sizeof(x));}\n" \
+"#endif\n"
+
+static const char ARRAY_ARITHMETIC_RUNTIME[] =
+"#if defined(__GNUC__) && !defined(__TINYC__)\n"
+"typedef " BITPACK_TYPE_NAME " _iguana_vec_t __attribute__((vector_size(32)));\n"
+"typedef uint64_t _iguana_vec64_t __attribute__((vector_size(32)));\n"
+"#define _IGUANA_VEC_WORDS (sizeof(_iguana_vec_t) / sizeof(" BITPACK_TYPE_NAME "))\n"
+"#endif\n"
+"static inline void " AARRAY_FILL_DEF "(" BITPACK_TYPE_NAME "* d, " BITPACK_TYPE_NAME " pattern, " BITPACK_TYPE_NAME " tail, unsigned words)\n"
+"{unsigned i = 0;\n"
+"#ifdef _IGUANA_VEC_WORDS\n"
+" _iguana_vec_t x = ((_iguana_vec_t) {0}) + pattern; for(; i + _IGUANA_VEC_WORDS <= words; i += _IGUANA_VEC_WORDS){memcpy(d + i, &x, sizeof(x));}\n"
+"#endif\n"
+" for(; i < words; i++){d[i] = pattern;} d[words - 1] = tail;}\n"
+"static inline void " AARRAY_COPY_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* s, unsigned words)\n"
+"{memmove(d, s, words * sizeof(" BITPACK_TYPE_NAME "));}\n"
+"static inline void " AARRAY_ADD_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* a, const " BITPACK_TYPE_NAME "* b, " BITPACK_TYPE_NAME " high, unsigned words)\n"
+"{unsigned i = 0; " BITPACK_TYPE_NAME " low = (" BITPACK_TYPE_NAME ") ~high;\n"
+AARRAY_VECTOR_LOOP("x = ((x & low) + (y & low)) ^ ((x ^ y) & high);")
+" for(; i < words; i++){d[i] = ((a[i] & low) + (b[i] & low)) ^ ((a[i] ^ b[i]) & high);}}\n"
+"static inline void " AARRAY_XOR_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* a, const " BITPACK_TYPE_NAME "* b, unsigned words)\n"
+"{unsigned i = 0;\n"
+AARRAY_VECTOR_LOOP("x ^= y;")
+" for(; i < words; i++){d[i] = a[i] ^ b[i];}}\n"
+"static inline void " AARRAY_AND_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* a, const " BITPACK_TYPE_NAME "* b, unsigned words)\n"
+"{unsigned i = 0;\n"
+AARRAY_VECTOR_LOOP("x &= y;")
+" for(; i < words; i++){d[i] = a[i] & b[i];}}\n"
+"#define _IGUANA_POPCOUNT64(v) (v = v - ((v >> 1) & 0x5555555555555555ULL), v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL),\\\n"
+" v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0fULL, (v * 0x0101010101010101ULL) >> 56)\n"
+"static inline uint64_t " AARRAY_POPCOUNT_DEF "(const " BITPACK_TYPE_NAME "* s, unsigned words)\n"
+"{const unsigned char* p = (const unsigned char*) s; unsigned n = words * sizeof(" BITPACK_TYPE_NAME "); unsigned i = 0; uint64_t count = 0;\n"
+"#ifdef _IGUANA_VEC_WORDS\n"
+" _iguana_vec64_t acc = {0}; for(; i + sizeof(acc) <= n; i += sizeof(acc)){_iguana_vec64_t v; memcpy(&v, p + i, sizeof(v)); acc += _IGUANA_POPCOUNT64(v);}\n"
+" for(unsigned j = 0; j < sizeof(acc) / sizeof(uint64_t); j++){count += acc[j];}\n"
+"#endif\n"
+" for(; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)){uint64_t v; memcpy(&v, p + i, sizeof(v)); count += _IGUANA_POPCOUNT64(v);}\n"
+" for(; i < n; i++){uint64_t v = p[i]; count += _IGUANA_POPCOUNT64(v);} return count;}\n";
+
+#endif // UTILITY_GENERATOR_BIT_ARITHMETIC_ARRAY_ARITHMETIC_H_
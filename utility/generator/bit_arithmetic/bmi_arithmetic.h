@@ -0,0 +1,52 @@
+/**
+ * @file bmi_arithmetic.h
+ *
+ * Runtime injected into generated C when target CPU is given. Field extraction and insertion
+ * go through BMI instructions (bextr, pdep) if C compiler target has BMI2, otherwise
+ * through same shift and mask arithmetic as fit_arithmetic.h. Word of 16 and 32 bits uses
+ * 32 bit instructions
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-05-14
+ */
+
+#ifndef UTILITY_GENERATOR_BIT_ARITHMETIC_BMI_ARITHMETIC_H_
+#define UTILITY_GENERATOR_BIT_ARITHMETIC_BMI_ARITHMETIC_H_
+
+#include <global_config.h>
+#include "../csyntax_database.h"
+#include "../config_generator.h"
+
+#define ABMI_WORD_BITS              STRINGIFY(BIT_SIZE_BITPACK)
+
+// Names of runtime helpers used by generator
+#define ABMI_READ_DEF               "_iguana_field_read"
+#define ABMI_INSERT_DEF             "_iguana_field_insert"
+
+// Field is shifted by its distance from word end, mask is already in field place
+static const char BMI_ARITHMETIC_RUNTIME[] =
+"#if defined(__BMI2__) && (defined(__x86_64__) || (defined(__i386__) && (" ABMI_WORD_BITS " < 64)))\n"
+"#include <immintrin.h>\n"
+"#if " ABMI_WORD_BITS " == 64\n"
+"#define _IGUANA_BEXTR _bextr_u64\n"
+"#define _IGUANA_PDEP _pdep_u64\n"
+"#else\n"
+"#define _IGUANA_BEXTR _bextr_u32\n"
+"#define _IGUANA_PDEP _pdep_u32\n"
+"#endif\n"
+"static inline " BITPACK_TYPE_NAME " " ABMI_READ_DEF "(" BITPACK_TYPE_NAME " w, unsigned shift, unsigned count)\n"
+"{return _IGUANA_BEXTR(w, shift, count);}\n"
+"static inline " BITPACK_TYPE_NAME " " ABMI_INSERT_DEF "(" BITPACK_TYPE_NAME " w, " BITPACK_TYPE_NAME " mask, " BITPACK_TYPE_NAME " v)\n"
+"{return (w & ~mask) | _IGUANA_PDEP(v, mask);}\n"
+"#else\n"
+"static inline " BITPACK_TYPE_NAME " " ABMI_READ_DEF "(" BITPACK_TYPE_NAME " w, unsigned shift, unsigned count)\n"
+"{return (w >> shift) & ((((" BITPACK_TYPE_NAME ") 1) << count) - 1);}\n"
+"static inline " BITPACK_TYPE_NAME " " ABMI_INSERT_DEF "(" BITPACK_TYPE_NAME " w, " BITPACK_TYPE_NAME " mask, " BITPACK_TYPE_NAME " v)\n"
+"{return (w & ~mask) | ((v << __builtin_ctzll(mask)) & mask);}\n"
+"#endif\n";
+
+#endif // UTILITY_GENERATOR_BIT_ARITHMETIC_BMI_ARITHMETIC_H_
@@ -0,0 +1,41 @@
+/**
+ * @file dense_arithmetic.h
+ *
+ * Runtime injected into generated C when object is packed densely and some variable
+ * starts in one bitpack word and ends in the next one. Both words are joined into
+ * double word, so variable is accessed with one shift and mask.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-05-12
+ */
+
+#ifndef UTILITY_GENERATOR_BIT_ARITHMETIC_DENSE_ARITHMETIC_H_
+#define UTILITY_GENERATOR_BIT_ARITHMETIC_DENSE_ARITHMETIC_H_
+
+#include <global_config.h>
+#include "../csyntax_database.h"
+#include "../config_generator.h"
+
+#define ADENSE_WORD_BITS            STRINGIFY(BIT_SIZE_BITPACK)
+
+// Names of runtime helpers used by generator
+#define ADENSE_READ_DEF             "_iguana_dense_read"
+#define ADENSE_WRITE_DEF            "_iguana_dense_write"
+
+// Straddling variable at bit position pos of word s[0], continuing into s[1]
+static const char DENSE_ARITHMETIC_RUNTIME[] =
+"static inline " BITPACK_TYPE_NAME " " ADENSE_READ_DEF "(const " BITPACK_TYPE_NAME "* s, unsigned pos, unsigned count)\n"
+"{" DOUBLE_BITPACK_TYPE_NAME " w = (((" DOUBLE_BITPACK_TYPE_NAME ") s[0]) << " ADENSE_WORD_BITS ") | s[1];\n"
+" return (" BITPACK_TYPE_NAME ") ((w >> (2 * " ADENSE_WORD_BITS " - (pos + count))) & ((((" DOUBLE_BITPACK_TYPE_NAME ") 1) << count) - 1));}\n"
+
+"static inline void " ADENSE_WRITE_DEF "(" BITPACK_TYPE_NAME "* d, unsigned pos, unsigned count, " BITPACK_TYPE_NAME " v)\n"
+"{unsigned shift = 2 * " ADENSE_WORD_BITS " - (pos + count); " DOUBLE_BITPACK_TYPE_NAME " m = ((((" DOUBLE_BITPACK_TYPE_NAME ") 1) << count) - 1);\n"
+" " DOUBLE_BITPACK_TYPE_NAME " w = (((" DOUBLE_BITPACK_TYPE_NAME ") d[0]) << " ADENSE_WORD_BITS ") | d[1];\n"
+" w = (w & ~(m << shift)) | ((((" DOUBLE_BITPACK_TYPE_NAME ") v) & m) << shift);\n"
+" d[0] = (" BITPACK_TYPE_NAME ") (w >> " ADENSE_WORD_BITS "); d[1] = (" BITPACK_TYPE_NAME ") w;}\n";
+
+#endif // UTILITY_GENERATOR_BIT_ARITHMETIC_DENSE_ARITHMETIC_H_
@@ -0,0 +1,69 @@
+/**
+ * @file print_arithmetic.h
+ *
+ * Runtime injected into every generated C file for print(). Values are converted to decimal
+ * two digits at a time from pairs table and appended to one per process output buffer,
+ * which is written to stdout when it overflows and at exit from entry_main. Buffer and flush
+ * are weak symbols, so every object carries them and linker keeps one of them.
+ * Helper is picked by bitpack of argument: up to 3 bits prints digit directly, up to 32 bits
+ * converts with 32 bit division, wider values with 64 bit one.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-18
+ */
+
+#ifndef UTILITY_GENERATOR_BIT_ARITHMETIC_PRINT_ARITHMETIC_H_
+#define UTILITY_GENERATOR_BIT_ARITHMETIC_PRINT_ARITHMETIC_H_
+
+#include <global_config.h>
+#include "../csyntax_database.h"
+#include "../config_generator.h"
+
+#define APRINT_BUFFER_SIZE          "4096"
+
+// Names of runtime helpers used by generator
+#define APRINT_FLUSH_DEF            "_iguana_print_flush"
+#define APRINT_APPEND_DEF           "_iguana_print_append"
+#define APRINT_DIGIT_DEF            "_iguana_print_digit"
+#define APRINT_U32_DEF              "_iguana_print_u32"
+#define APRINT_U64_DEF              "_iguana_print_u64"
+#define APRINT_PADDED_DEF           "_iguana_print_padded"
+#define APRINT_END_DEF              "_iguana_print_end"
+
+// Widest bitpack converted with 32 bit division and widest printed as single digit. Expression
+// results are not truncated to their bitpack, so helpers fall back to wider conversion by value
+#define APRINT_U32_MAX_BITS         32
+#define APRINT_DIGIT_MAX_BITS       3
+
+// Digits are written backwards into scratch ending with separator, then appended at once
+static const char PRINT_ARITHMETIC_RUNTIME[] =
+"__attribute__((weak)) char _iguana_print_buffer[" APRINT_BUFFER_SIZE "];\n"
+"__attribute__((weak)) unsigned _iguana_print_length;\n"
+"__attribute__((weak)) void " APRINT_FLUSH_DEF "(void)\n"
+"{unsigned done = 0; while(done < _iguana_print_length){long n = write(1, _iguana_print_buffer + done, _iguana_print_length - done); if(n <= 0) break; done += n;} _iguana_print_length = 0;}\n"
+"static const char _iguana_digit_pairs[] =\n"
+"\"00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899\";\n"
+"static inline void " APRINT_APPEND_DEF "(const char* s, unsigned n)\n"
+"{if(_iguana_print_length + n > " APRINT_BUFFER_SIZE ") " APRINT_FLUSH_DEF "(); memcpy(_iguana_print_buffer + _iguana_print_length, s, n); _iguana_print_length += n;}\n"
+"static inline char* _iguana_utoa64(uint64_t v, char* s)\n"
+"{while(v >= 100){unsigned i = (unsigned) (v % 100) * 2; v /= 100; s -= 2; s[0] = _iguana_digit_pairs[i]; s[1] = _iguana_digit_pairs[i + 1];}\n"
+" if(v >= 10){s -= 2; s[0] = _iguana_digit_pairs[v * 2]; s[1] = _iguana_digit_pairs[v * 2 + 1];}else{*--s = (char) ('0' + v);} return s;}\n"
+"static inline char* _iguana_utoa32(uint32_t v, char* s)\n"
+"{while(v >= 100){unsigned i = (v % 100) * 2; v /= 100; s -= 2; s[0] = _iguana_digit_pairs[i]; s[1] = _iguana_digit_pairs[i + 1];}\n"
+" if(v >= 10){s -= 2; s[0] = _iguana_digit_pairs[v * 2]; s[1] = _iguana_digit_pairs[v * 2 + 1];}else{*--s = (char) ('0' + v);} return s;}\n"
+"static inline void " APRINT_U64_DEF "(uint64_t v)\n"
+"{char t[21]; t[20] = ' '; char* s = _iguana_utoa64(v, t + 20); " APRINT_APPEND_DEF "(s, (unsigned) (t + 21 - s));}\n"
+"static inline void " APRINT_U32_DEF "(uint64_t v)\n"
+"{if(v >> 32){" APRINT_U64_DEF "(v); return;} char t[11]; t[10] = ' '; char* s = _iguana_utoa32((uint32_t) v, t + 10); " APRINT_APPEND_DEF "(s, (unsigned) (t + 11 - s));}\n"
+"static inline void " APRINT_DIGIT_DEF "(uint64_t v)\n"
+"{if(v > 9){" APRINT_U32_DEF "(v); return;} char t[2] = {(char) ('0' + v), ' '}; " APRINT_APPEND_DEF "(t, 2);}\n"
+"static inline void " APRINT_PADDED_DEF "(uint64_t v, unsigned width)\n"
+"{char t[20]; char* s = _iguana_utoa64(v, t + 20); while(t + 20 - s < (long) width){*--s = '0';} " APRINT_APPEND_DEF "(s, (unsigned) (t + 20 - s));}\n"
+"static inline void " APRINT_END_DEF "(void)\n"
+"{" APRINT_APPEND_DEF "(\"\\n\", 1);}\n";
+
+#endif // UTILITY_GENERATOR_BIT_ARITHMETIC_PRINT_ARITHMETIC_H_
@@ -0,0 +1,83 @@
+/**
+ * @file wide_arithmetic.h
+ *
+ * Runtime injected into generated C when values wider than one bitpack word are used.
+ * Wide value is array of limbs, least significant limb first. Limbs count is always
+ * constant at call sites, so C compiler unrolls these loops.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-05-09
+ */
+
+#ifndef UTILITY_GENERATOR_BIT_ARITHMETIC_WIDE_ARITHMETIC_H_
+#define UTILITY_GENERATOR_BIT_ARITHMETIC_WIDE_ARITHMETIC_H_
+
+#include <global_config.h>
+#include "../csyntax_database.h"
+#include "../config_generator.h"
+#include "print_arithmetic.h"
+
+#define AWIDE_WORD_BITS             STRINGIFY(BIT_SIZE_BITPACK)
+
+// Names of runtime helpers used by generator
+#define AWIDE_SET_DEF               "_iguana_wide_set"
+#define AWIDE_LOAD_DEF              "_iguana_wide_load"
+#define AWIDE_STORE_DEF             "_iguana_wide_store"
+#define AWIDE_ADD_DEF               "_iguana_wide_add"
+#define AWIDE_SUB_DEF               "_iguana_wide_sub"
+#define AWIDE_MUL_DEF               "_iguana_wide_mul"
+#define AWIDE_AND_DEF               "_iguana_wide_and"
+#define AWIDE_OR_DEF                "_iguana_wide_or"
+#define AWIDE_XOR_DEF               "_iguana_wide_xor"
+#define AWIDE_PRINT_DEF             "_iguana_wide_print"
+
+// Wide value placed in bitpack region: top limb is at the beginning of its word
+static const char WIDE_ARITHMETIC_RUNTIME[] =
+"static inline void " AWIDE_SET_DEF "(" BITPACK_TYPE_NAME "* d, unsigned n, " BITPACK_TYPE_NAME " v)\n"
+"{d[0] = v; for(unsigned i = 1; i < n; i++) d[i] = 0;}\n"
+
+"static inline void " AWIDE_LOAD_DEF "(" BITPACK_TYPE_NAME "* d, unsigned n, const " BITPACK_TYPE_NAME "* s, unsigned sn, unsigned top)\n"
+"{for(unsigned i = 0; i < n; i++) d[i] = (i + 1 < sn) ? s[i] : (i + 1 == sn) ? ((top == " AWIDE_WORD_BITS ") ? s[i] : (s[i] >> (" AWIDE_WORD_BITS " - top))) : 0;}\n"
+
+"static inline void " AWIDE_STORE_DEF "(" BITPACK_TYPE_NAME "* d, unsigned n, unsigned top, const " BITPACK_TYPE_NAME "* s)\n"
+"{for(unsigned i = 0; i + 1 < n; i++) d[i] = s[i];\n"
+" if(top == " AWIDE_WORD_BITS "){d[n - 1] = s[n - 1];}\n"
+" else{" BITPACK_TYPE_NAME " m = (((" BITPACK_TYPE_NAME ") 1) << top) - 1; d[n - 1] = (d[n - 1] & ~(m << (" AWIDE_WORD_BITS " - top))) | ((s[n - 1] & m) << (" AWIDE_WORD_BITS " - top));}}\n"
+
+"static inline void " AWIDE_ADD_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* a, const " BITPACK_TYPE_NAME "* b, unsigned n)\n"
+"{unsigned char c = 0; for(unsigned i = 0; i < n; i++){" BITPACK_TYPE_NAME " t; unsigned char c1 = __builtin_add_overflow(a[i], b[i], &t); c = c1 | __builtin_add_overflow(t, (" BITPACK_TYPE_NAME ") c, &d[i]);}}\n"
+
+"static inline void " AWIDE_SUB_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* a, const " BITPACK_TYPE_NAME "* b, unsigned n)\n"
+"{unsigned char c = 0; for(unsigned i = 0; i < n; i++){" BITPACK_TYPE_NAME " t; unsigned char c1 = __builtin_sub_overflow(a[i], b[i], &t); c = c1 | __builtin_sub_overflow(t, (" BITPACK_TYPE_NAME ") c, &d[i]);}}\n"
+
+"static inline void " AWIDE_MUL_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* a, const " BITPACK_TYPE_NAME "* b, unsigned n)\n"
+"{" BITPACK_TYPE_NAME " r[n]; for(unsigned i = 0; i < n; i++) r[i] = 0;\n"
+" for(unsigned i = 0; i < n; i++){" BITPACK_TYPE_NAME " c = 0; for(unsigned j = 0; i + j < n; j++){\n"
+" " DOUBLE_BITPACK_TYPE_NAME " p = (" DOUBLE_BITPACK_TYPE_NAME ") a[i] * b[j] + r[i + j] + c; r[i + j] = (" BITPACK_TYPE_NAME ") p; c = (" BITPACK_TYPE_NAME ") (p >> " AWIDE_WORD_BITS ");}}\n"
+" for(unsigned i = 0; i < n; i++) d[i] = r[i];}\n"
+
+"static inline void " AWIDE_AND_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* a, const " BITPACK_TYPE_NAME "* b, unsigned n)\n"
+"{for(unsigned i = 0; i < n; i++) d[i] = a[i] & b[i];}\n"
+
+"static inline void " AWIDE_OR_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* a, const " BITPACK_TYPE_NAME "* b, unsigned n)\n"
+"{for(unsigned i = 0; i < n; i++) d[i] = a[i] | b[i];}\n"
+
+"static inline void " AWIDE_XOR_DEF "(" BITPACK_TYPE_NAME "* d, const " BITPACK_TYPE_NAME "* a, const " BITPACK_TYPE_NAME "* b, unsigned n)\n"
+"{for(unsigned i = 0; i < n; i++) d[i] = a[i] ^ b[i];}\n"
+
+// Decimal printing by dividing with biggest power of 10 chunks fitting one word
+"static inline void " AWIDE_PRINT_DEF "(const " BITPACK_TYPE_NAME "* v, unsigned n)\n"
+"{" BITPACK_TYPE_NAME " t[n]; " BITPACK_TYPE_NAME " chunks[n * 2 + 1]; unsigned count = 0; unsigned nonzero;\n"
+" for(unsigned i = 0; i < n; i++) t[i] = v[i];\n"
+" do{" DOUBLE_BITPACK_TYPE_NAME " rem = 0; nonzero = 0;\n"
+" for(unsigned i = n; i-- > 0;){" DOUBLE_BITPACK_TYPE_NAME " cur = (rem << " AWIDE_WORD_BITS ") | t[i]; t[i] = (" BITPACK_TYPE_NAME ") (cur / " BITPACK_PRINT_CHUNK_DEF "); rem = cur % " BITPACK_PRINT_CHUNK_DEF "; nonzero |= (t[i] != 0);}\n"
+" chunks[count++] = (" BITPACK_TYPE_NAME ") rem;}while(nonzero);\n"
+" " APRINT_PADDED_DEF "(chunks[count - 1], 0);\n"
+" while(count-- > 1){" APRINT_PADDED_DEF "(chunks[count - 1], " BITPACK_PRINT_DIGITS_DEF ");}\n"
+" " APRINT_APPEND_DEF "(\" \", 1);}\n";
+
+#endif // UTILITY_GENERATOR_BIT_ARITHMETIC_WIDE_ARITHMETIC_H_
@@ -18,6 +18,12 @@
 
 #define BITPACK_TYPE_EXP            Bitpack_t
 #define BITPACK_TYPE_NAME           STRINGIFY(BITPACK_TYPE_EXP)
+#define DOUBLE_BITPACK_TYPE_EXP     DoubleBitpack_t
+#define DOUBLE_BITPACK_TYPE_NAME    STRINGIFY(DOUBLE_BITPACK_TYPE_EXP)
+#define BITPACK_PRINT_CHUNK_DEF     "BITPACK_PRINT_CHUNK"
+#define BITPACK_PRINT_DIGITS_DEF    "BITPACK_PRINT_DIGITS"
+#define REGISTER_PACK_TYPE_NAME     "BitpackRegs_t"
+#define REGISTER_PACK_WORDS         2
 #define FUNCTION_OBJ_NAME           CLASS_VAR_REGION_NAME
 #define FUNCTION_PARAM_NAME         PARAMS_VAR_REGION_NAME
 
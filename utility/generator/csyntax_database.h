@@ -29,6 +29,8 @@
 #define STRUCT_KEYWORD_DEF          "struct"
 #define UNSIGNED_KEYWORD_DEF        "unsigned"
 #define EXTERN_KEYWORD_DEF          "extern"
+#define STATIC_KEYWORD_DEF          "static"
+#define INLINE_KEYWORD_DEF          "inline"
 #define RETURN_DEF                  "return"
 
 
@@ -72,6 +74,7 @@ CONST_STRING TYPE_BINDS[] =
 #define BIT_DEF                   "bit"
 
 #define END_LINE_DEF              "\n"
+#define COMMENT_LINE_DEF          "//"
 #define NULL_TERMINATOR_DEF       "\0"
 #define DOUBLE_QUOTE_DEF          "\""
 
@@ -86,6 +89,7 @@ CONST_STRING TYPE_BINDS[] =
 #define MANGLE_MAGIC_BYTE_DEF    "_Z"
 #define MANGLE_NEST_ID_DEF       "N"
 #define MANGLE_END_DEF           "E"
+#define MANGLE_ABI_REGISTER_DEF  "B3reg"
 
 #define MANGLE_TYPE_VOID_DEF     "v"
 #define MANGLE_TYPE_INT_DEF      "i"
@@ -111,33 +115,16 @@ CONST_STRING TYPE_BINDS[] =
 
 #define C_OPERATOR_BIN_OR_EQUAL_DEF     "|="
 
-#if ARCHITECTURE_DEFAULT_BITS == 64
-    #define BIT_TYPE_EXP              TYPE_BIT64_EXP
-    #define BIT_SIZE_BITPACK          64
-#elif ARCHITECTURE_DEFAULT_BITS == 32
-    #define BIT_TYPE_EXP              TYPE_BIT32_EXP
-    #define BIT_SIZE_BITPACK          32
-#elif ARCHITECTURE_DEFAULT_BITS == 16
-    #define BIT_TYPE_EXP              TYPE_BIT16_EXP
-    #define BIT_SIZE_BITPACK          16
-#elif ARCHITECTURE_DEFAULT_BITS == 8
-    #define BIT_TYPE_EXP              TYPE_BIT8_EXP
-    #define BIT_SIZE_BITPACK          8
-#else
-    #define BIT_TYPE_EXP              TYPE_BIT32_EXP
-    #define BIT_SIZE_BITPACK          32
-#endif
-
-#define BIT_TYPE_DEF              STRINGIFY(BIT_TYPE_EXP)
+// Word size is chosen when compiling Iguana code (--word-bits), generated code defines it for itself
+#define BIT_SIZE_BITPACK          BITPACK_BITS
 
 
 #define PARAM_TYPE_DEF            BITPACK_TYPE_NAME POINTER_SIGN_DEF
-#define BITPACK_TYPE_TYPEDEF_DEF  TYPEDEF_WRAP(BIT_TYPE_DEF, BITPACK_TYPE_NAME)
 
 
 #define TYPE_BIT64_EXP            uint64_t
-#define TYPE_BIT32__EXP           uint32_t
-#define TYPE_BIT16__EXP           uint16_t
+#define TYPE_BIT32_EXP            uint32_t
+#define TYPE_BIT16_EXP            uint16_t
 #define TYPE_BIT8_EXP             uint8_t
 #define TYPE_BIT0_EXP             void
 
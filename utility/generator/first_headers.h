@@ -16,9 +16,11 @@
 #define UTILITY_FIRST_HEADERS_H_
 
 #include <global_config.h>
+#include "bit_arithmetic/print_arithmetic.h"
 
 
 // TODO: in future need implement args handling
-static const char START_POINT[] = "extern void f(void* p) asm(\"" MAIN_PROCESS_FILE_NAME "\"); int entry_main(void){f((void*) 0);__builtin_exit(0);}\n";
+// Print buffer is written out before exit, entry_main never returns through libc
+static const char START_POINT[] = "extern void f(void* p) asm(\"" MAIN_PROCESS_FILE_NAME "\"); void " APRINT_FLUSH_DEF "(void); int entry_main(void){f((void*) 0);" APRINT_FLUSH_DEF "();__builtin_exit(0);}\n";
 
 #endif // UTILITY_FIRST_HEADERS_H_
\ No newline at end of file
@@ -22,9 +22,19 @@
 #include "../parser/structures/expression/expressions.h"
 #include "bit_arithmetic/fit_arithmetic.h"
 #include "bit_arithmetic/plt_arithmetic.h"
+#include "bit_arithmetic/wide_arithmetic.h"
+#include "bit_arithmetic/dense_arithmetic.h"
+#include "bit_arithmetic/bmi_arithmetic.h"
+#include "bit_arithmetic/print_arithmetic.h"
+#include "bit_arithmetic/array_arithmetic.h"
+#include "bit_arithmetic/alloc_arithmetic.h"
+#include <compiler_options.h>
 #include <dstack.h>
+#include <emitter.h>
 #include "first_headers.h"
 #include "../parser/parser_utilities/post_parsing_utility/bitfit.h"
+#include "../parser/parser_utilities/post_parsing_utility/object_layout.h"
+#include "../parser/parser_utilities/post_parsing_utility/loop_analysis.h"
 
 ////////////////////////////////
 // DEFINES
@@ -36,10 +46,35 @@
     #define READABILITY_SPACE               ""
 #endif
 
-#define BITSCNT_TO_BYTESCNT(bitsize) (bitsize / BIT_SIZE_BITPACK + 1)
+// Word size of generated code, BIT_SIZE_BITPACK is only its name inside generated code
+#define BITPACK_WORD_BITS            ((BitpackSize_t) CompilerOptions_get()->wordBits)
 
+#define BITSCNT_TO_BYTESCNT(bitsize) (bitsize / BITPACK_WORD_BITS + 1)
+#define WIDE_LIMBS(bitsize)          BITFIT_LIMBS_COUNT(bitsize, BITPACK_WORD_BITS)
+#define WIDE_TOP_BITS(bitsize)       ((bitsize) - ((BitpackSize_t) (WIDE_LIMBS(bitsize) - 1) * BITPACK_WORD_BITS))
+#define IS_WIDE_BITPACK(bitsize)     ((bitsize) > BITPACK_WORD_BITS)
 
-#define FWRITE_STRING(string) {if(fwrite(string, BYTE_SIZE, SIZEOF_NOTERM(string), currentCfile_) < 0) {Log_e(TAG, "fwrite failed to write \"%s\"", string);return ERROR;}}
+// Signature key of parameters layout, longer signatures are fitted on every call
+#define PARAM_LAYOUT_KEY_LENGTH      255
+#define PARAM_LAYOUT_CACHE_SIZE      64
+
+// Methods with this many expression elements or less are inlined without inline keyword
+#define INLINE_SIZE_LIMIT            12
+#define INLINE_MAX_DEPTH             4
+#define INLINE_FUNCTION_PREFIX       "_iguana_inline_"
+#define INLINE_END_LABEL             "_iguana_inline_end"
+
+// Packed variables used by loop are kept in plain words, limits are per loop and for all nested loops
+#define LOOP_REGISTERS_LIMIT         16
+#define LOOP_REGISTERS_MAX           64
+#define LOOP_REGISTER_NAME_LENGTH    48
+#define LOOP_PREFIX                  "_iguana_loop"
+
+// Pool of dh objects is named by object type, name is also key of pools declared in file
+#define POOL_NAME_LENGTH             255
+
+
+#define EMIT_STRING(string) {if(!Emitter_append(&cOutput_, string, SIZEOF_NOTERM(string))) {Log_e(TAG, "Failed to emit \"%s\"", string);return ERROR;}}
 
 ////////////////////////////////
 // PRIVATE CONSTANTS
@@ -63,11 +98,59 @@ typedef enum
     PRIVATE_CLASS_METHOD
 }NameMangleType_t;
 
+// Position of one parameter inside params bitpack region
+typedef struct
+{
+    GroupID_t belongToGroup;
+    BitpackPos_t posBit;
+}ParamSlot_t;
+
+// Parameters layout of one method signature, last slot is return variable
+typedef struct
+{
+    BitpackSize_t sizeBits;
+    uint32_t slotsCount;
+    ParamSlot_t slots[];
+}ParamLayout_t;
+
+typedef ParamLayout_t* ParamLayoutHandle_t;
+
+// Packed variable which is read and written through plain word while loop runs
+typedef struct
+{
+    VariableObjectHandle_t variable;
+    bool isWritten;
+    char name[LOOP_REGISTER_NAME_LENGTH];
+}LoopRegister_t;
+
+typedef LoopRegister_t* LoopRegisterHandle_t;
+
 // privateTypes
 static MainFrameHandle_t currentAst_ =   NULL;
-static FILE* currentCfile_ =             NULL;
 
-static char writingBufferC_[FOUT_BUFFER_LENGTH];
+// Whole C file is built in memory and written at once, buffer is reused between files
+static Emitter_t cOutput_ =              {0};
+
+// Layouts are same for same signature, so they are shared between all generated files
+static HashmapHandle_t paramLayoutCache_ = NULL;
+
+// Words count of currently generated method, when its params are passed in registers
+static uint32_t currentMethodRegisterWords_ = 0;
+
+// Methods which bodies are being expanded at call site, innermost last
+static MethodObjectHandle_t inlineStack_[INLINE_MAX_DEPTH];
+static uint32_t inlineDepth_ = 0;
+static int64_t currentInlineLabel_ = -1;
+
+// Registers of loops being generated, innermost loop ones last
+static LoopRegister_t loopRegisters_[LOOP_REGISTERS_MAX];
+static uint32_t loopRegistersCount_ = 0;
+
+// Method which body is generated, its dh objects are given back on every return
+static MethodObjectHandle_t currentMethod_ = NULL;
+
+// Bit size of variable assigned by currently generated statement, 0 if statement does not assign
+static BitpackSize_t assignTargetBits_ = 0;
 
 ////////////////////////////////
 // PRIVATE METHODS
@@ -89,7 +172,9 @@ static inline uint8_t getDigitCountU64_(uint64_t number);
 static bool fileWriteNameMangleMethod_(const char* const className, const MethodObjectHandle_t method, const bool isPublic, const BitpackSize_t callerObjectSizeBits);
 static bool fileWriteIncludes_(void);
 static bool fileWriteMainHTypedefs_(void);
+static bool fileWriteDoubleWordTypedefs_(void);
 static bool fileWriteMainHeader_(const bool isFirstFile);
+static bool fileWriteObjectLayoutComment_(void);
 static bool determineResultVariableExpression_(ExpElementHandle_t resultExp, VariableObjectHandle_t tmpVarAllocation, const ExpElementHandle_t left, const ExpElementHandle_t right, const OperatorType_t operator);
 static bool fileWriteSimpleLine_(const ExpHandle_t expression, VariableObjectHandle_t resultVar, const char* tmpSuffix);
 static inline bool fileWriteVariablesAllocation_(const BitpackSize_t bitsize, const char* scopeName);
@@ -99,13 +184,70 @@ static bool fileWriteBitVariableSet_(const VariableObjectHandle_t assignedTmpVar
 static bool getBitpackFromOperand_(const ExpElementHandle_t symbol, BitpackSize_t* resultBitpack);
 static bool handleCastOperator_(const VariableObjectHandle_t assignedTmpVar, const ExpElementHandle_t left, const ExpElementHandle_t right);
 static bool generateMethodCallScope_(const BitpackSize_t returnSizeBits, const VariableObjectHandle_t assignedTmpVar, ExMethodCallHandle_t method);
-static bool fileWriteNameMangleParams_(const VectorHandler_t params);
 static bool generateCodeForOneOperand_(const ExpElementHandle_t symbol, VariableObjectHandle_t resultVariable);
-static AssignValue_t calculateConstantResultValue_(const AssignValue_t leftConst, const AssignValue_t rightConst, const OperatorType_t operator);
 static inline uint8_t getBitCountU64_(uint64_t number);
+static inline const char* printHelperName_(const BitpackSize_t bitpack);
 static bool generatePrintFunction_(const VectorHandler_t params);
 static bool fileWriteReturnStatement_(const ExpHandle_t expression, VariableObjectHandle_t returnVariable, VariableObjectHandle_t resultVar, const uint64_t elementId);
 static bool filewriteExpression_(const ExpHandle_t expression, const  MethodObjectHandle_t methodOfExpression, VariableObjectHandle_t resVar, const uint64_t elementId);
+static bool isWideOperand_(const ExpElementHandle_t operand);
+static bool estimateExpressionBitpack_(const ExpHandle_t expression, BitpackSize_t* bitpack);
+static BitpackSize_t getAssignTargetBits_(const ExpHandle_t expression);
+static BitpackSize_t getOperationBits_(const OperatorType_t operator, const BitpackSize_t leftBits, const BitpackSize_t rightBits);
+static bool astUsesWideValues_(void);
+static bool expressionUsesWideCast_(const ExpHandle_t expression);
+static int wideVariableIteratorCallback_(void *key, int count, void* value, void *user);
+static int wideMethodIteratorCallback_(void *key, int count, void* value, void *user);
+static bool fileWriteWideLoad_(const char* destination, const uint32_t limbs, const ExpElementHandle_t operand);
+static bool fileWriteWideOperation_(const VariableObjectHandle_t assignedTmpVar, const ExpElementHandle_t left, const ExpElementHandle_t right, const OperatorType_t operator);
+static bool fileWriteWideVariableSet_(const VariableObjectHandle_t assignedTmpVar, const VariableObjectHandle_t leftVar, const ExpElementHandle_t right);
+static bool isStraddlingOperand_(const ExpElementHandle_t operand);
+static bool astUsesStraddlingValues_(void);
+static int straddlingVariableIteratorCallback_(void *key, int count, void* value, void *user);
+static bool fileWriteHelperVariableSet_(const VariableObjectHandle_t assignedTmpVar, const VariableObjectHandle_t leftVar, const ExpElementHandle_t right);
+static inline bool useFieldIntrinsics_(void);
+static inline BitpackSize_t fieldShift_(const uint32_t posBit, const BitpackSize_t bitpack);
+static inline uint64_t fieldMask_(const uint32_t posBit, const BitpackSize_t bitpack);
+static bool paramLayoutKey_(const VectorHandler_t params, const VariableObjectHandle_t returnVar, char* key);
+static bool paramLayoutStore_(const char* key, const VectorHandler_t params, const VariableObjectHandle_t returnVar, const BitpackSize_t sizeBits);
+static bool paramLayoutAssign_(const VectorHandler_t params, const VariableObjectHandle_t returnVar, BitpackSize_t* sizeBits);
+static int paramLayoutSeedIteratorCallback_(void *key, int count, void* value, void *user);
+static bool fileWriteParamsPacking_(const VectorHandler_t params, const bool* constantParams, const AssignValue_t* constantValues, const char* psetName, const BitpackSize_t sizeBits);
+static inline uint32_t registerPackWords_(const MethodObjectHandle_t method);
+static bool fileWriteRegisterPackReturn_(const uint32_t registerWords);
+static bool isInlineCandidate_(const MethodObjectHandle_t method);
+static MethodObjectHandle_t findInlineCallee_(const ExMethodCallHandle_t call, const VectorHandler_t args, const BitpackSize_t returnSizeBits);
+static bool canExpandInline_(const MethodObjectHandle_t method);
+static bool fileWriteInlinedMethodBody_(const MethodObjectHandle_t method, const char* psetName);
+static bool fileWriteMethodArguments_(const MethodObjectHandle_t method, const BitpackSize_t callerObjectBitsize);
+static bool isArrayOperand_(const ExpElementHandle_t operand);
+static bool prepareArrayOperands_(const ExpHandle_t expression);
+static bool fileWriteArrayStatement_(const ExpHandle_t expression, const VariableObjectHandle_t resultVar);
+static bool isPopcountCall_(const ExMethodCallHandle_t method);
+static bool generatePopcountFunction_(const BitpackSize_t returnSizeBits, const VariableObjectHandle_t assignedTmpVar, const ExMethodCallHandle_t method);
+static uint64_t arrayLanesPattern_(const uint64_t value, const BitpackSize_t bitpack, const uint32_t lanes);
+static bool astUsesArrays_(void);
+static int arrayVariableIteratorCallback_(void *key, int count, void* value, void *user);
+static int arrayMethodIteratorCallback_(void *key, int count, void* value, void *user);
+static bool fileWriteLoop_(const ExpHandle_t loop, const MethodObjectHandle_t method, VariableObjectHandle_t resVar);
+static bool fileWriteLoopValue_(const VariableObjectHandle_t value, const bool isCount);
+static bool fileWriteLoopRegisters_(const ExpHandle_t loop, const uint64_t loopId);
+static bool fileWriteLoopWriteBack_(const uint32_t firstRegister, const bool objectOnly);
+static bool fileWriteLoopRegisterSet_(const VariableObjectHandle_t assignedTmpVar, const LoopRegisterHandle_t loopRegister, const ExpElementHandle_t right);
+static bool isLoopRegisterCandidate_(const LoopVariableUseHandle_t use, const bool callsOwnMethods);
+static LoopRegisterHandle_t loopRegisterOf_(const VariableObjectHandle_t variable);
+static uint32_t astUsedAllocations_(void);
+static int allocationVariableIteratorCallback_(void *key, int count, void* value, void *user);
+static int allocationMethodIteratorCallback_(void *key, int count, void* value, void *user);
+static bool methodPlacesObjects_(const MethodObjectHandle_t method);
+static int objectAllocationIteratorCallback_(void *key, int count, void* value, void *user);
+static int heapObjectIteratorCallback_(void *key, int count, void* value, void *user);
+static bool collectHeapObjects_(const MethodObjectHandle_t method, VectorHandler_t objects);
+static bool fileWriteObjectReleases_(const MethodObjectHandle_t method);
+static bool fileWritePoolDeclarations_(void);
+static int poolDeclarationIteratorCallback_(void *key, int count, void* value, void *user);
+static inline bool isSameObjectType_(const VariableObjectHandle_t first, const VariableObjectHandle_t second);
+static inline void poolNameOf_(const VariableObjectHandle_t variable, char* name);
 ////////////////////////////////
 // IMPLEMENTATION
 
@@ -115,6 +257,8 @@ bool Generator_generateCode(const MainFrameHandle_t ast, const char* dstCFileNam
     NULL_GUARD(ast, ERROR, Log_e(TAG, "Null AST"));
 
     currentAst_ = ast;
+    inlineDepth_ = 0;
+    currentInlineLabel_ = -1;
     
     Log_i(TAG, "Starting C code generation in file: \"%s\"", dstCFileName);
 
@@ -124,13 +268,32 @@ bool Generator_generateCode(const MainFrameHandle_t ast, const char* dstCFileNam
         return ERROR;
     }
 
-    currentCfile_ = fopen(dstCFileName, "w");
+    if((cOutput_.data == NULL) && !Emitter_create(&cOutput_, OUTPUT_BUFFER_INITIAL_LENGTH))
+    {
+        Log_e(TAG, "Failed to create C output buffer");
+        return ERROR;
+    }
 
-    NULL_GUARD(currentCfile_, ERROR, Log_e(TAG, "Failed to open %s", dstCFileName));
+    Emitter_reset(&cOutput_);
 
-    setvbuf(currentCfile_, writingBufferC_, _IOFBF, FOUT_BUFFER_LENGTH);
+    if(paramLayoutCache_ == NULL)
+    {
+        ALLOC_CHECK(paramLayoutCache_, sizeof(Hashmap_t), ERROR);
+
+        if(!Hashmap_new(paramLayoutCache_, PARAM_LAYOUT_CACHE_SIZE))
+        {
+            Log_e(TAG, "Failed to create parameters layout cache");
+            return ERROR;
+        }
+    }
+
+    // Methods of this file already have their parameters fitted, calls will reuse them
+    if(!Hashmap_forEach(&currentAst_->methods, paramLayoutSeedIteratorCallback_, NULL))
+    {
+        Log_e(TAG, "Failed to cache methods parameters layouts");
+        return ERROR;
+    }
 
-    
     // // Generating public methods
     if(!fileWriteMainHeader_(isFirstFile))
     {
@@ -144,33 +307,221 @@ bool Generator_generateCode(const MainFrameHandle_t ast, const char* dstCFileNam
         return ERROR;
     }
 
-    if(fflush(currentCfile_))  // flushing what is left in buffer
+    // Piped sources are taken from buffer by C compiler, files are written only when asked to keep them
+    if(CompilerOptions_get()->keepC && !Emitter_writeFile(&cOutput_, dstCFileName))
     {
-        Log_e(TAG, "Failed to flush file %s buffer", currentCfile_);
+        Log_e(TAG, "Failed to write file %s", dstCFileName);
         return ERROR;
     }
 
-    if(fclose(currentCfile_))
+    Log_i(TAG, "C code generation in file: \"%s\" SUCCESSFUL!", dstCFileName);
+
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for taking previously generated C code as last generated file
+ *
+ * @param[in] code          generated code
+ * @param[in] length        generated code length in bytes
+ * @param[in] dstCFileName  C file path, written only when C files are kept
+ *
+ * @return                  Success state
+ */
+bool Generator_loadCode(const char* code, const size_t length, const char* dstCFileName)
+{
+    if((cOutput_.data == NULL) && !Emitter_create(&cOutput_, OUTPUT_BUFFER_INITIAL_LENGTH))
     {
-        Log_w(TAG, "Failed to close file %s", currentCfile_);
+        Log_e(TAG, "Failed to create C output buffer");
+        return ERROR;
     }
 
-    Log_i(TAG, "C code generation in file: \"%s\" SUCCESSFUL!", dstCFileName);
+    Emitter_reset(&cOutput_);
+
+    if(!Emitter_append(&cOutput_, code, length))
+    {
+        Log_e(TAG, "Failed to load C code of %s", dstCFileName);
+        return ERROR;
+    }
+
+    if(CompilerOptions_get()->keepC && !Emitter_writeFile(&cOutput_, dstCFileName))
+    {
+        Log_e(TAG, "Failed to write file %s", dstCFileName);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for getting C code of last generated file, valid until next generation
+ *
+ * @param[out] code         generated code, not null terminated
+ * @param[out] length       generated code length in bytes
+ *
+ * @return                  Success state, false if nothing was generated yet
+ */
+bool Generator_getCode(const char** code, size_t* length)
+{
+    NULL_GUARD(cOutput_.data, ERROR, Log_e(TAG, "No C code was generated yet"));
+
+    *code = cOutput_.data;
+    *length = cOutput_.length;
 
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for emitting mangled method symbol, both backends name methods with it so they link together
+ *
+ * @param[in] output            emitter receiving symbol, not null terminated
+ * @param[in] className         Iguana object name
+ * @param[in] objectSizeBits    object size in bits
+ * @param[in] methodName        method name
+ * @param[in] returnBits        return value size in bits
+ * @param[in] isRegisterAbi     method is called with register ABI
+ * @param[in] params            params variables
+ * @param[in] paramsCount       count of params taken from vector
+ *
+ * @return                      Success state
+ */
+bool Generator_emitMangledName(EmitterHandle_t output, const char* className, const BitpackSize_t objectSizeBits, const char* methodName,
+    const BitpackSize_t returnBits, const bool isRegisterAbi, const VectorHandler_t params, const size_t paramsCount)
+{
+    //ex: _ZN9wikipedia3fooEv
+    if(Emitter_format(output, MANGLE_MAGIC_BYTE_DEF MANGLE_NEST_ID_DEF "%lu" BIT_DEF "%lu_%s%lu" BIT_DEF "%lu_%s%s" MANGLE_END_DEF,
+        strlen(className) + ((uint8_t) SIZEOF_NOTERM(BIT_DEF)) + ((uint8_t) SIZEOF_NOTERM("_")) + getDigitCountU64_((uint64_t) objectSizeBits),
+        objectSizeBits,
+        className,
+        strlen(methodName) + SIZEOF_NOTERM("_") + getDigitCountU64_((uint64_t) returnBits) + ((uint8_t) SIZEOF_NOTERM(BIT_DEF)),
+        returnBits,
+        methodName,
+        isRegisterAbi ? MANGLE_ABI_REGISTER_DEF : "") < 0)
+    {
+        return ERROR;
+    }
+
+    for(size_t paramIdx = 0; paramIdx < paramsCount; paramIdx++)
+    {
+        const VariableObjectHandle_t varParam = (VariableObjectHandle_t) params->expandable[paramIdx];
+
+        if(Emitter_format(output, "%u" BIT_DEF "%lu", (uint8_t) SIZEOF_NOTERM(BIT_DEF) + getDigitCountU64_(varParam->bitpack), varParam->bitpack) < 0)
+        {
+            return ERROR;
+        }
+    }
+
+    if((paramsCount == 0) && !Emitter_appendString(output, MANGLE_TYPE_VOID_DEF))
+    {
+        return ERROR;
+    }
 
     return SUCCESS;
 }
 
+/**
+ * @brief Public method for folding operation of two constants same way for both backends
+ *
+ * @param[in] left          left constant
+ * @param[in] right         right constant
+ * @param[in] operator      binary operator
+ * @param[out] value        folded value
+ *
+ * @return                  false if operator cannot be folded or constant is divided by zero
+ */
+bool Generator_foldConstants(const AssignValue_t left, const AssignValue_t right, const OperatorType_t operator, AssignValue_t* value)
+{
+    switch (operator)
+    {
+        case OP_PLUS:       *value = left + right; break;
+        case OP_MINUS:      *value = left - right; break;
+        case OP_MULTIPLY:   *value = left * right; break;
+        case OP_AND:        *value = left && right; break;
+        case OP_OR:         *value = left || right; break;
+        case OP_BIN_XOR:    *value = left ^ right; break;
+        case OP_BIN_AND:    *value = left & right; break;
+        case OP_BIN_OR:     *value = left | right; break;
+        case OP_CAST:       *value = right & ((left >= LOOKUP_MASKS_COUNT) ? ~((AssignValue_t) 0) : (AssignValue_t) LOOKUP_MASK(left)); break;
+
+        case OP_DIVIDE:
+        case OP_MODULUS:
+        {
+            if(right == 0)
+            {
+                return false;
+            }
+
+            *value = (operator == OP_DIVIDE) ? (left / right) : (left % right);
+        }break;
+
+        default: return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Public method for checking if expression consists of constants only and folding it
+ *
+ * @param[in] expression    expression in postfix order
+ * @param[out] value        folded value
+ *
+ * @return                  true if expression was folded to single constant
+ */
+bool Generator_isConstantExpression(const ExpHandle_t expression, AssignValue_t* value)
+{
+    const size_t elementsCount = Expression_size(expression);
+    AssignValue_t* valuesStack;
+    size_t stackTop = 0;
+
+    if(elementsCount == 0)
+    {
+        return false;
+    }
+
+    valuesStack = alloca(elementsCount * sizeof(AssignValue_t));
+
+    // Same folding as expression generation does, so folded value gets same bitpack
+    for(ExpIterator_t iterator = Expression_iteratorFirst(expression); iterator < Expression_iteratorLast(expression); iterator++)
+    {
+        const ExpElementHandle_t symbol = *iterator;
+
+        if(ExpElement_getType(symbol) == EXP_CONST_NUMBER)
+        {
+            valuesStack[stackTop++] = (AssignValue_t) ExpElement_getObject(symbol);
+        }else if(ExpElement_isSymbolOperator(symbol) && (stackTop >= 2))
+        {
+            stackTop--;
+
+            if(!Generator_foldConstants(valuesStack[stackTop - 1], valuesStack[stackTop], (OperatorType_t) ExpElement_getObject(symbol), &valuesStack[stackTop - 1]))
+            {
+                return false;
+            }
+        }else
+        {
+            return false;
+        }
+    }
+
+    if(stackTop != 1)
+    {
+        return false;
+    }
+
+    *value = valuesStack[0];
+
+    return true;
+}
+
 
 
 static bool fileWriteMainHeader_(const bool isFirstFile)
 {
-    int status;
     // first file needs some more stuff to have
     if(isFirstFile)
     {
-        status = fwrite(START_POINT, BYTE_SIZE, SIZEOF_NOTERM(START_POINT), currentCfile_);
-        if(status < 0)
+        if(!Emitter_append(&cOutput_, START_POINT, SIZEOF_NOTERM(START_POINT)))
         {
             Log_e(TAG, "Failed to write starting point injection");
             return ERROR;
@@ -189,93 +540,172 @@ static bool fileWriteMainHeader_(const bool isFirstFile)
         return ERROR;
     }
 
+    // Print buffer is shared by all objects, each file carries its weak copy
+    EMIT_STRING(PRINT_ARITHMETIC_RUNTIME);
+
+    const bool usesWide = astUsesWideValues_();
+    const bool usesStraddling = astUsesStraddlingValues_();
+
+    if((usesWide || usesStraddling) && !fileWriteDoubleWordTypedefs_())
+    {
+        Log_e(TAG, "Failed to write double word type definitions in object:%s", currentAst_->iguanaObjectName);
+        return ERROR;
+    }
+
+    if(usesWide)
+    {
+        EMIT_STRING(WIDE_ARITHMETIC_RUNTIME);
+    }
+
+    if(usesStraddling)
+    {
+        EMIT_STRING(DENSE_ARITHMETIC_RUNTIME);
+    }
+
+    if(useFieldIntrinsics_())
+    {
+        EMIT_STRING(BMI_ARITHMETIC_RUNTIME);
+    }
+
+    if(astUsesArrays_())
+    {
+        EMIT_STRING(ARRAY_ARITHMETIC_RUNTIME);
+    }
+
+    const uint32_t usedAllocations = astUsedAllocations_();
+
+    if(usedAllocations & (1u << ALLOCATION_DYNAMIC_STACK))
+    {
+        EMIT_STRING(ALLOC_STACK_RUNTIME);
+    }
+
+    if(usedAllocations & (1u << ALLOCATION_DYNAMIC_HEAP))
+    {
+        Emitter_format(&cOutput_, "#define " AALLOC_POOL_ALIGN_DEF " %s" END_LINE_DEF,
+            (CompilerOptions_get()->poolAlignment == POOL_ALIGN_CACHE_LINE) ? AALLOC_ALIGN_CACHE_LINE : AALLOC_ALIGN_WORD);
+
+        EMIT_STRING(ALLOC_POOL_RUNTIME);
+
+        if(!fileWritePoolDeclarations_())
+        {
+            Log_e(TAG, "Failed to write object pools in object:%s", currentAst_->iguanaObjectName);
+            return ERROR;
+        }
+    }
+
+    if(CompilerOptions_get()->callAbi == CALL_ABI_REGISTER)
+    {
+        EMIT_STRING(TYPEDEF_KEYWORD_DEF " struct" BRACKET_START_DEF BITPACK_TYPE_NAME " w[" STRINGIFY(REGISTER_PACK_WORDS) "]" SEMICOLON_DEF BRACKET_END_DEF " " REGISTER_PACK_TYPE_NAME SEMICOLON_DEF READABILITY_ENDLINE);
+    }
+
+    if(currentAst_->isHotColdSplit && !fileWriteObjectLayoutComment_())
+    {
+        Log_e(TAG, "Failed to write layout comment in object:%s", currentAst_->iguanaObjectName);
+        return ERROR;
+    }
+
     return SUCCESS;
 }
 
-static bool fileWriteIncludes_(void)
+static bool fileWriteObjectLayoutComment_(void)
 {
-    FWRITE_STRING(INCLUDE_WRAP("stdint"));
-    FWRITE_STRING(INCLUDE_WRAP("stdio") READABILITY_ENDLINE);
+    VariableObjectHandle_t* variables;
+    uint32_t variablesCount;
+
+    variables = ObjectLayout_getVariablesByPosition(currentAst_, &variablesCount);
+    NULL_GUARD(variables, ERROR, Log_e(TAG, "Failed to get object variables by position"));
+
+    Emitter_format(&cOutput_, COMMENT_LINE_DEF " Object layout hot/cold: %lu bits, hot part %lu bits" END_LINE_DEF,
+            currentAst_->objectSizeBits, currentAst_->hotSizeBits);
+
+    for(uint32_t varIdx = 0; varIdx < variablesCount; varIdx++)
+    {
+        Emitter_format(&cOutput_, COMMENT_LINE_DEF "   %-4s " CLASS_VAR_REGION_NAME "[%u] bit %u bit:%lu %s (reads %u, writes %u)" END_LINE_DEF,
+                ObjectLayout_isColdVariable(currentAst_, variables[varIdx]) ? "cold" : "hot",
+                variables[varIdx]->belongToGroup, variables[varIdx]->posBit, variables[varIdx]->bitpack,
+                variables[varIdx]->objectName, variables[varIdx]->readCount, variables[varIdx]->writeCount);
+    }
+
+    free(variables);
 
     return SUCCESS;
 }
 
-static bool fileWriteMainHTypedefs_(void)
+static bool fileWriteIncludes_(void)
 {
-    const int writeStatus = fwrite(BITPACK_TYPE_TYPEDEF_DEF READABILITY_ENDLINE, BYTE_SIZE, SIZEOF_NOTERM(BITPACK_TYPE_TYPEDEF_DEF READABILITY_ENDLINE), currentCfile_);
-    return (writeStatus >= 0);
+    EMIT_STRING(INCLUDE_WRAP("stdint"));
+    EMIT_STRING(INCLUDE_WRAP("stdio"));
+    EMIT_STRING(INCLUDE_WRAP("string"));
+    EMIT_STRING(INCLUDE_WRAP("unistd") READABILITY_ENDLINE);
+
+    return SUCCESS;
 }
 
-static bool fileWriteNameMangleParams_(const VectorHandler_t params)
+static bool fileWriteMainHTypedefs_(void)
 {
-    int writeStatus;
+    const char* wordType;
 
-    if(params->currentSize > 0)
+    switch (BITPACK_WORD_BITS)
     {
-        for(uint32_t parameterIdx = 0; parameterIdx < params->currentSize; parameterIdx++)
+        case 16: wordType = TYPE_BIT16_DEF; break;
+        case 32: wordType = TYPE_BIT32_DEF; break;
+        case 64: wordType = TYPE_BIT64_DEF; break;
+        
+        default:
         {
-            const VariableObjectHandle_t varParam = (VariableObjectHandle_t) params->expandable[parameterIdx];
-            writeStatus = fprintf(currentCfile_, "%u" BIT_DEF "%lu", (uint8_t) SIZEOF_NOTERM(BIT_DEF) + getDigitCountU64_(varParam->bitpack), varParam->bitpack);
-            
-            if(writeStatus < 0)
-            {
-                return ERROR;
-            }
-        }
+            Log_e(TAG, "Unsupported bitpack word size %lu", BITPACK_WORD_BITS);
+        }return ERROR;
+    }
 
-        writeStatus = fwrite(ASM_FOOTER_MANGLE SEMICOLON_DEF, BYTE_SIZE, SIZEOF_NOTERM(ASM_FOOTER_MANGLE SEMICOLON_DEF), currentCfile_);
+    const int writeStatus = Emitter_format(&cOutput_, TYPEDEF_WRAP("%s", BITPACK_TYPE_NAME) READABILITY_ENDLINE "#define " STRINGIFY(BIT_SIZE_BITPACK) " %lu" READABILITY_ENDLINE,
+        wordType, BITPACK_WORD_BITS);
 
-        if(writeStatus < 0)
-        {
-            return ERROR;
-        }
+    return (writeStatus >= 0);
+}
 
-    }else
+/**
+ * @brief Double word type used by wide and straddling runtime, and wide printing chunk which
+ * still fits double word after shifting by one word
+ */
+static bool fileWriteDoubleWordTypedefs_(void)
+{
+    const char* doubleWordType;
+    const char* printChunk;
+    uint8_t printDigits;
+
+    switch (BITPACK_WORD_BITS)
     {
-        writeStatus = fwrite(MANGLE_TYPE_VOID_DEF ASM_FOOTER_MANGLE SEMICOLON_DEF, BYTE_SIZE, SIZEOF_NOTERM(MANGLE_TYPE_VOID_DEF ASM_FOOTER_MANGLE SEMICOLON_DEF), currentCfile_);
+        case 16: doubleWordType = TYPE_BIT32_DEF; printChunk = "10000U"; printDigits = 4; break;
+        case 32: doubleWordType = TYPE_BIT64_DEF; printChunk = "1000000000U"; printDigits = 9; break;
+        case 64: doubleWordType = "unsigned __int128"; printChunk = "10000000000000000000ULL"; printDigits = 19; break;
 
-        if(writeStatus < 0)
+        default:
         {
-            return ERROR;
-        }
-    }
-    
-    if(writeStatus < 0)
-    {
-        return ERROR;
+            Log_e(TAG, "Unsupported bitpack word size %lu", BITPACK_WORD_BITS);
+        }return ERROR;
     }
 
-    return SUCCESS;
+    const int writeStatus = Emitter_format(&cOutput_, TYPEDEF_WRAP("%s", DOUBLE_BITPACK_TYPE_NAME) READABILITY_ENDLINE
+        "#define " BITPACK_PRINT_CHUNK_DEF " %s" READABILITY_ENDLINE "#define " BITPACK_PRINT_DIGITS_DEF " %u" READABILITY_ENDLINE,
+        doubleWordType, printChunk, printDigits);
+
+    return (writeStatus >= 0);
 }
 
 static bool fileWriteNameMangleMethod_(const char* const className, const MethodObjectHandle_t method, const bool isPublic, const BitpackSize_t callerObjectSizeBits)
 {
-    int writeStatus;
-    // TODO: optimize this so length will be somewhere stored entire generator
-    size_t objectNameLen = strlen(className);
-    size_t methodNameLen = strlen(method->methodName);
-
-    writeStatus = fprintf(currentCfile_,
-        //ex: asm("_ZN9wikipedia3fooEv");
-        READABILITY_SPACE ASM_HEADER_MANGLE MANGLE_MAGIC_BYTE_DEF MANGLE_NEST_ID_DEF "%lu" BIT_DEF "%lu_%s%ld" BIT_DEF "%lu_%s" MANGLE_END_DEF,
-        objectNameLen + ((uint8_t) SIZEOF_NOTERM(BIT_DEF)) + ((uint8_t) SIZEOF_NOTERM("_")) + getDigitCountU64_((uint64_t) callerObjectSizeBits),
-        callerObjectSizeBits,
-        className,
-        methodNameLen + SIZEOF_NOTERM("_") + getDigitCountU64_((uint64_t) method->returnVariable->bitpack) + ((uint8_t) SIZEOF_NOTERM(BIT_DEF)),
-        method->returnVariable->bitpack,
-        method->methodName);
+    //ex: asm("_ZN9wikipedia3fooEv");
+    EMIT_STRING(READABILITY_SPACE ASM_HEADER_MANGLE);
 
-    if(writeStatus < 0)
+    if(!Generator_emitMangledName(&cOutput_, className, callerObjectSizeBits, method->methodName, method->returnVariable->bitpack,
+        registerPackWords_(method) > 0, method->parameters, method->parameters->currentSize))
     {
+        Log_e(TAG, "Failed to write name mangle of method");
         return ERROR;
     }
 
-    if(!fileWriteNameMangleParams_(method->parameters))
-    {
-        Log_e(TAG, "Failed to write params mangle of method");
-        return ERROR;
-    }
-    
+    EMIT_STRING(ASM_FOOTER_MANGLE SEMICOLON_DEF);
+
     return SUCCESS;
 }
 
@@ -301,7 +731,7 @@ static inline bool fileWriteMethods_()
 
 static inline bool fileWriteVariablesAllocation_(const BitpackSize_t bitsize, const char* scopeName)
 {
-    const int status = fprintf(currentCfile_, BITPACK_TYPE_NAME " %s[%lu]" SEMICOLON_DEF READABILITY_ENDLINE, scopeName, BITSCNT_TO_BYTESCNT(bitsize));
+    const int status = Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s[%lu]" SEMICOLON_DEF READABILITY_ENDLINE, scopeName, BITSCNT_TO_BYTESCNT(bitsize));
     return (status >= 0);
 }
 
@@ -314,13 +744,37 @@ static inline bool fileWriteMethodBody_(const MethodObjectHandle_t method)
 
     NULL_GUARD(method, ERROR, Log_e(TAG, "method passed NULL to writing"));
 
-    fwrite(READABILITY_ENDLINE BRACKET_START_DEF READABILITY_ENDLINE, BYTE_SIZE, SIZEOF_NOTERM(READABILITY_ENDLINE BRACKET_START_DEF READABILITY_ENDLINE), currentCfile_);
+    EMIT_STRING(READABILITY_ENDLINE BRACKET_START_DEF READABILITY_ENDLINE);
+
+    currentMethodRegisterWords_ = registerPackWords_(method);
+
+    // Params passed by value are put back to region, so body accesses them same way
+    if(currentMethodRegisterWords_ > 0)
+    {
+        Emitter_format(&cOutput_, BITPACK_TYPE_NAME " " FUNCTION_PARAM_NAME "[%u]" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE BRACKET_START_DEF, currentMethodRegisterWords_);
+
+        for(uint32_t wordIdx = 0; wordIdx < currentMethodRegisterWords_; wordIdx++)
+        {
+            Emitter_format(&cOutput_, "%s" FUNCTION_PARAM_NAME "%u", (wordIdx > 0) ? COMMA_DEF READABILITY_SPACE : "", wordIdx);
+        }
+
+        EMIT_STRING(BRACKET_END_DEF SEMICOLON_DEF READABILITY_ENDLINE);
+    }
 
     if(!fileWriteVariablesAllocation_(method->body.sizeBits, LOCAL_VAR_REGION_NAME))
     {
         Log_e(TAG, "Failed to write method scope variables");
         return ERROR;
     }
+
+    // Objects placed with ds / dh get their words once at entry, also when declared inside loop
+    if(!Hashmap_forEach(&method->body.localVariables, objectAllocationIteratorCallback_, NULL))
+    {
+        Log_e(TAG, "Failed to write placed objects allocation");
+        return ERROR;
+    }
+
+    currentMethod_ = method;
     
     for(uint64_t scopeElementIndex = 0; scopeElementIndex < method->body.scopeElementsList.currentSize; scopeElementIndex++)
     {
@@ -338,7 +792,21 @@ static inline bool fileWriteMethodBody_(const MethodObjectHandle_t method)
         
     }
 
-    FWRITE_STRING(READABILITY_ENDLINE BRACKET_END_DEF READABILITY_ENDLINE);
+    if(!fileWriteObjectReleases_(method))
+    {
+        Log_e(TAG, "Failed to write placed objects release");
+        return ERROR;
+    }
+
+    currentMethod_ = NULL;
+
+    if((currentMethodRegisterWords_ > 0) && (method->returnVariable->bitpack > 0) && !fileWriteRegisterPackReturn_(currentMethodRegisterWords_))
+    {
+        Log_e(TAG, "Failed to write method registers return");
+        return ERROR;
+    }
+
+    EMIT_STRING(READABILITY_ENDLINE BRACKET_END_DEF READABILITY_ENDLINE);
     
     return SUCCESS;
 }
@@ -365,6 +833,16 @@ static bool filewriteExpression_(const ExpHandle_t expression, const  MethodObje
                 return ERROR;
             }
         }break;
+
+        case REPEAT_LOOP:
+        case WHEN_LOOP:
+        {
+            if(!fileWriteLoop_(expression, methodOfExpression, resVar))
+            {
+                Log_e(TAG, "Failed to write loop");
+                return ERROR;
+            }
+        }break;
         
         default:
         {
@@ -400,32 +878,83 @@ static bool fileWriteReturnStatement_(const ExpHandle_t expression, VariableObje
         return ERROR;
     }
 
-    FWRITE_STRING(RETURN_DEF SEMICOLON_DEF READABILITY_ENDLINE);
+    // Return from loop leaves its registers, object variables must be in object words again
+    if(!fileWriteLoopWriteBack_(0, true))
+    {
+        Log_e(TAG, "Failed to write back loop registers on return");
+        return ERROR;
+    }
 
-    return SUCCESS;
-}
+    if(currentInlineLabel_ >= 0)
+    {
+        Emitter_format(&cOutput_, "goto " INLINE_END_LABEL "%ld" SEMICOLON_DEF READABILITY_ENDLINE, currentInlineLabel_);
+        return SUCCESS;
+    }
+
+    // Return value is already in params region, so objects it was computed from can go
+    if((currentMethod_ != NULL) && !fileWriteObjectReleases_(currentMethod_))
+    {
+        Log_e(TAG, "Failed to write placed objects release on return");
+        return ERROR;
+    }
+
+    if((currentMethodRegisterWords_ > 0) && (returnVariable->bitpack > 0))
+    {
+        return fileWriteRegisterPackReturn_(currentMethodRegisterWords_);
+    }
+
+    EMIT_STRING(RETURN_DEF SEMICOLON_DEF READABILITY_ENDLINE);
+
+    return SUCCESS;
+}
 
 static bool fileWriteSimpleLine_(const ExpHandle_t expression, VariableObjectHandle_t resultVar, const char* tmpSuffix)
 {
     DynamicStack_t symbolStack;
     uint64_t tmpIncrement = 0;
 
+    // Method calls of statement generate their own statements, target of this one is given back after them
+    const BitpackSize_t outerTargetBits = assignTargetBits_;
+
     ExpElementHandle_t resultExpressionElement = NULL;
     VariableObjectHandle_t tmpVar = NULL;
+    BitpackSize_t resultBitpack;
     char* currSufix;
 
+    // Whole arrays are handled by bulk kernels, statement is not evaluated value by value
+    if(prepareArrayOperands_(expression))
+    {
+        return fileWriteArrayStatement_(expression, resultVar);
+    }
+
     if(!Stack_create(&symbolStack))
     {
         Log_e(TAG, "Failed to create dynamic stack for postfix handling");
         return ERROR;
     }
 
+    // Wide target keeps carries and high product bits of its expression
+    assignTargetBits_ = getAssignTargetBits_(expression);
+
+    // Result shape must be known before its declaration
+    if(!estimateExpressionBitpack_(expression, &resultBitpack))
+    {
+        Log_e(TAG, "Failed to estimate expression result bit size");
+        return ERROR;
+    }
+
     if(resultVar->objectName[0] != '\0')
     {
-        fprintf(currentCfile_, BITPACK_TYPE_NAME " %s" SEMICOLON_DEF READABILITY_ENDLINE, resultVar->objectName);
+        if(IS_WIDE_BITPACK(resultBitpack))
+        {
+            Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s[%lu]" SEMICOLON_DEF READABILITY_ENDLINE, resultVar->objectName, WIDE_LIMBS(resultBitpack));
+        }else
+        {
+            Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" SEMICOLON_DEF READABILITY_ENDLINE, resultVar->objectName);
+        }
     }
 
-    FWRITE_STRING(BRACKET_START_DEF READABILITY_ENDLINE);
+    EMIT_STRING(BRACKET_START_DEF READABILITY_ENDLINE);
 
     // there is one element pushed in postfix
     // May be a operand just laying around
@@ -532,9 +1061,29 @@ static bool fileWriteSimpleLine_(const ExpHandle_t expression, VariableObjectHan
 
     }
 
+    if((resultVar->objectName[0] != '\0') && IS_WIDE_BITPACK(resultBitpack))
+    {
+        if(!fileWriteWideLoad_(resultVar->objectName, WIDE_LIMBS(resultBitpack), resultExpressionElement))
+        {
+            Log_e(TAG, "Failed to write wide result of expression");
+            return ERROR;
+        }
+
+        resultVar->bitpack = resultBitpack;
+        resultVar->castedFile = NULL;
+
+        EMIT_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
+
+        Stack_destroy(&symbolStack);
+
+        assignTargetBits_ = outerTargetBits;
+
+        return SUCCESS;
+    }
+
     if(resultVar->objectName[0] != '\0')
     {
-        fprintf(currentCfile_, "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, resultVar->objectName);
+        Emitter_format(&cOutput_, "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, resultVar->objectName);
     }
 
     ExpElementType_t typeResult = ExpElement_getType(resultExpressionElement);
@@ -548,7 +1097,15 @@ static bool fileWriteSimpleLine_(const ExpHandle_t expression, VariableObjectHan
 
             if(resultVar->objectName[0] != '\0')
             {
-                fprintf(currentCfile_, "%s" SEMICOLON_DEF READABILITY_ENDLINE, tmpVar->objectName);
+                if(IS_WIDE_BITPACK(tmpVar->bitpack))
+                {
+                    // Declared as one word, so wide value is truncated to its lowest limb
+                    resultVar->bitpack = BITPACK_WORD_BITS;
+                    Emitter_format(&cOutput_, "%s[0]" SEMICOLON_DEF READABILITY_ENDLINE, tmpVar->objectName);
+                }else
+                {
+                    Emitter_format(&cOutput_, "%s" SEMICOLON_DEF READABILITY_ENDLINE, tmpVar->objectName);
+                }
             }
         }break;
 
@@ -559,7 +1116,7 @@ static bool fileWriteSimpleLine_(const ExpHandle_t expression, VariableObjectHan
             resultVar->bitpack = getBitCountU64_(constantValue);
             resultVar->castedFile = NULL;
 
-            fprintf(currentCfile_, STRINGIFY(APLT_READ(%lu)) SEMICOLON_DEF READABILITY_ENDLINE, constantValue);
+            Emitter_format(&cOutput_, STRINGIFY(APLT_READ(%lu)) SEMICOLON_DEF READABILITY_ENDLINE, constantValue);
         }break;
 
         default:
@@ -571,9 +1128,11 @@ static bool fileWriteSimpleLine_(const ExpHandle_t expression, VariableObjectHan
     // Var name left, since it passed through object, through params
     
 
-    FWRITE_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
+    EMIT_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
 
     Stack_destroy(&symbolStack);
+
+    assignTargetBits_ = outerTargetBits;
     
     return SUCCESS;
 }
@@ -585,7 +1144,15 @@ static bool determineResultVariableExpression_(ExpElementHandle_t resultExp, Var
     
     if ((leftType == EXP_CONST_NUMBER) && (rightType == EXP_CONST_NUMBER))
     {
-        if(!ExpElement_set(resultExp, EXP_CONST_NUMBER, (void*) (uintptr_t) calculateConstantResultValue_((AssignValue_t) left->expressionElement, (AssignValue_t) right->expressionElement, operator)))
+        AssignValue_t folded;
+
+        if(!Generator_foldConstants((AssignValue_t) left->expressionElement, (AssignValue_t) right->expressionElement, operator, &folded))
+        {
+            Log_e(TAG, "Constants cannot be folded with operator %d, or are divided by zero", operator);
+            return ERROR;
+        }
+
+        if(!ExpElement_set(resultExp, EXP_CONST_NUMBER, (void*) (uintptr_t) folded))
         {
             Log_e(TAG, "Failed to set expression constant number");
             return ERROR;
@@ -641,6 +1208,7 @@ static bool determineResultVariableExpression_(ExpElementHandle_t resultExp, Var
     }else
     {
         // On simple operations resulting bitsize lets take just the biggest operand bit size, to more prevent overflows
+        // unless wide target of assignment can hold more
         BitpackSize_t leftBitsize;
         BitpackSize_t rightBitsize;
 
@@ -656,38 +1224,13 @@ static bool determineResultVariableExpression_(ExpElementHandle_t resultExp, Var
             return ERROR;
         }
 
-        tmpVarAllocation->bitpack = max(leftBitsize, rightBitsize);
+        tmpVarAllocation->bitpack = getOperationBits_(operator, leftBitsize, rightBitsize);
     }
 
 
     return SUCCESS;
 }
 
-static AssignValue_t calculateConstantResultValue_(const AssignValue_t leftConst, const AssignValue_t rightConst, const OperatorType_t operator)
-{
-    switch (operator)
-    {
-        case OP_PLUS: return leftConst + rightConst;
-        case OP_MINUS: return leftConst - rightConst;
-        case OP_MULTIPLY: return leftConst * rightConst;
-        case OP_DIVIDE: return leftConst / rightConst;
-        case OP_MODULUS: return leftConst % rightConst;
-        case OP_AND: return leftConst && rightConst;
-        case OP_OR: return leftConst || rightConst;
-
-        case OP_BIN_XOR: return leftConst && rightConst;
-        case OP_BIN_AND: return leftConst & rightConst;
-        case OP_BIN_OR:  return leftConst | rightConst;
-        case OP_CAST:    return rightConst & MASK(leftConst);
-
-        default:
-        {
-            Log_e(TAG, "calculating result value of constants with operator: %d not allowed", operator);
-        }return 0;
-    }
-
-}
-
 static bool getBitpackFromOperand_(const ExpElementHandle_t symbol, BitpackSize_t* resultBitpack)
 {
     NULL_GUARD(resultBitpack, ERROR, Log_e(TAG, "Passed NULL bitpack ptr for bit count estimation"));
@@ -738,11 +1281,19 @@ static bool generateCodeForOneOperand_(const ExpElementHandle_t symbol, Variable
         return ERROR;
     }
 
-    if(ExpElement_getType(symbol) != EXP_METHOD_CALL)
+    if((ExpElement_getType(symbol) != EXP_METHOD_CALL) && IS_WIDE_BITPACK(resultVariable->bitpack))
+    {
+        if(resultVariable->objectName[0] != '\0')
+        {
+            Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s[%lu]" SEMICOLON_DEF READABILITY_ENDLINE, resultVariable->objectName, WIDE_LIMBS(resultVariable->bitpack));
+
+            return fileWriteWideLoad_(resultVariable->objectName, WIDE_LIMBS(resultVariable->bitpack), symbol);
+        }
+    }else if(ExpElement_getType(symbol) != EXP_METHOD_CALL)
     {
         if(resultVariable->objectName[0] != '\0')
         {
-            fprintf(currentCfile_, BITPACK_TYPE_NAME " %s" C_OPERATOR_EQUAL_DEF READABILITY_SPACE, resultVariable->objectName);
+            Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" C_OPERATOR_EQUAL_DEF READABILITY_SPACE, resultVariable->objectName);
         }
 
         if(!printBitVariableReading_(symbol))
@@ -750,7 +1301,7 @@ static bool generateCodeForOneOperand_(const ExpElementHandle_t symbol, Variable
             return ERROR;
         }
         
-        FWRITE_STRING(SEMICOLON_DEF READABILITY_ENDLINE);
+        EMIT_STRING(SEMICOLON_DEF READABILITY_ENDLINE);
     }else
     {
         ExMethodCallHandle_t methodCall = ExpElement_getObject(symbol);
@@ -775,29 +1326,63 @@ static bool generateMethodCallScope_(const BitpackSize_t returnSizeBits, const V
 
     snprintf(functionPrefix, sizeof(functionPrefix), "_%lu", functionIdCounter++);
 
-    fprintf(currentCfile_, BITPACK_TYPE_NAME " %s" SEMICOLON_DEF READABILITY_ENDLINE BRACKET_START_DEF READABILITY_ENDLINE, assignedTmpVar->objectName);
+    if(IS_WIDE_BITPACK(returnSizeBits))
+    {
+        Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s[%lu]" SEMICOLON_DEF READABILITY_ENDLINE BRACKET_START_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, WIDE_LIMBS(returnSizeBits));
+    }else
+    {
+        Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" SEMICOLON_DEF READABILITY_ENDLINE BRACKET_START_DEF READABILITY_ENDLINE, assignedTmpVar->objectName);
+    }
     
     Log_d(TAG, "Start on method call generation: %s", method->name);
 
+    // Builtin reads array storage directly, its argument is not evaluated as value
+    if(isPopcountCall_(method))
+    {
+        if(!generatePopcountFunction_(returnSizeBits, assignedTmpVar, method))
+        {
+            Log_e(TAG, "Failed to generate popcount function");
+            return ERROR;
+        }
+
+        EMIT_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
+
+        return SUCCESS;
+    }
+
     if(!Vector_create(&resultVars, NULL))
     {
         Log_e(TAG, "Failed to create result vars vector");
         return ERROR;
     }
 
-    for(size_t paramIdx = 0; paramIdx < method->parameters.currentSize; paramIdx++)
+    const bool isPrintCall = (strcmp("print", method->name) == 0);
+    const size_t paramsCount = method->parameters.currentSize;
+
+    bool* constantParams = alloca(paramsCount * sizeof(bool) + 1);
+    AssignValue_t* constantValues = alloca(paramsCount * sizeof(AssignValue_t) + 1);
+    VariableObjectHandle_t paramVars = alloca(paramsCount * sizeof(VariableObject_t) + 1);
+    char* paramNames = alloca(paramsCount * (strlen(assignedTmpVar->objectName) + 22) + 1);
+
+    for(size_t paramIdx = 0; paramIdx < paramsCount; paramIdx++)
     {
-        VariableObjectHandle_t resultVar = alloca(sizeof(VariableObject_t));
-        
-        char* paramName = alloca(strlen(assignedTmpVar->objectName) + 10);
-        NULL_GUARD(paramName, ERROR, Log_e(TAG, "Failed to allocate param name"));
-        paramName[0] = '\0'; 
+        VariableObjectHandle_t resultVar = &paramVars[paramIdx];
+        const ExpHandle_t paramExpression = method->parameters.expandable[paramIdx];
 
-        sprintf(paramName, "%sp%lu", assignedTmpVar->objectName, paramIdx);
+        resultVar->objectName = paramNames;
+        resultVar->arrayLength = 0;
+        paramNames += sprintf(paramNames, "%sp%lu", assignedTmpVar->objectName, paramIdx) + 1;
 
-        resultVar->objectName = paramName;
+        // Constant arguments never reach runtime, they are combined into params words
+        constantParams[paramIdx] = !isPrintCall && Generator_isConstantExpression(paramExpression, &constantValues[paramIdx]) &&
+            !IS_WIDE_BITPACK(getBitCountU64_(constantValues[paramIdx]));
+
+        if(constantParams[paramIdx])
+        {
+            resultVar->bitpack = getBitCountU64_(constantValues[paramIdx]);
+            resultVar->castedFile = NULL;
 
-        if(!fileWriteSimpleLine_(method->parameters.expandable[paramIdx], resultVar, assignedTmpVar->objectName))
+        }else if(!fileWriteSimpleLine_(paramExpression, resultVar, assignedTmpVar->objectName))
         {
             Log_e(TAG, "Failed to write parameter expression");
             return ERROR;
@@ -812,29 +1397,15 @@ static bool generateMethodCallScope_(const BitpackSize_t returnSizeBits, const V
     }
     
     VariableObject_t returnVar;
-    BitpackSize_t sizeNeededForFunctionParams;
+    BitpackSize_t sizeNeededForFunctionParams = 0;
     returnVar.bitpack = returnSizeBits;
+    returnVar.arrayLength = 0;
 
-    // Adding return variable also to bitfit
-    if(!Vector_append(&resultVars, &returnVar))
-    {
-        Log_e(TAG, "Failed to append to result variables");
-        return ERROR;
-    }
-   
-    
-    if(!Bitfit_assignGroupsAndPositionForVariableVector_(&resultVars, FIRST_FIT, &sizeNeededForFunctionParams))
+    if(!isPrintCall && !paramLayoutAssign_(&resultVars, &returnVar, &sizeNeededForFunctionParams))
     {
         Log_e(TAG, "Failed to fit params bits");
         return ERROR;
     }
-    
-    // Popping result value, but it got assigned, so no matter anymore
-    if(Vector_popLast(&resultVars) == NULL)
-    {
-        Log_e(TAG, "Failed to append to result variables");
-        return ERROR;
-    }
 
     MethodObject_t tempMethodObj;
 
@@ -842,23 +1413,26 @@ static bool generateMethodCallScope_(const BitpackSize_t returnSizeBits, const V
     tempMethodObj.parameters = &resultVars;
     tempMethodObj.containsBody = true;    
     tempMethodObj.returnVariable = &returnVar;
+    tempMethodObj.parametersSizeBits = sizeNeededForFunctionParams;
+
+    const MethodObjectHandle_t inlineCallee = isPrintCall ? NULL : findInlineCallee_(method, &resultVars, returnSizeBits);
+    const bool expandInline = (inlineCallee != NULL) && canExpandInline_(inlineCallee);
+    const uint32_t registerWords = (isPrintCall || expandInline) ? 0 : registerPackWords_(&tempMethodObj);
 
 
     // TODO: for now lets put print only, in future need mechanism to handle special functions
     // Like the print function and other functions
 
-    if (strcmp("print", method->name) == 0)
+    if(isPrintCall)
     {
         if(!generatePrintFunction_(&resultVars))
         {
             Log_e(TAG, "Failed to generate print function");
             return ERROR;
         }
-        FWRITE_STRING(SEMICOLON_DEF READABILITY_ENDLINE);
+        EMIT_STRING(SEMICOLON_DEF READABILITY_ENDLINE);
     }else
     {
-        FWRITE_STRING(EXTERN_KEYWORD_DEF " ");
-
         char* callerObjectName;
         BitpackSize_t callerObjectSizeBits;
 
@@ -873,132 +1447,171 @@ static bool generateMethodCallScope_(const BitpackSize_t returnSizeBits, const V
             callerObjectSizeBits = method->caller->bitpack;
         }
 
-        if(!generateMethodHeader_(&tempMethodObj, functionPrefix, callerObjectSizeBits))
+        // Methods of same object are reached directly, others only through mangled name
+        if(inlineCallee == NULL)
         {
-            Log_e(TAG, "Failed to generate method call header");
-            return ERROR;
+            EMIT_STRING(EXTERN_KEYWORD_DEF " ");
+
+            if(!generateMethodHeader_(&tempMethodObj, functionPrefix, callerObjectSizeBits))
+            {
+                Log_e(TAG, "Failed to generate method call header");
+                return ERROR;
+            }
+
+            if(!fileWriteNameMangleMethod_(callerObjectName, &tempMethodObj, true, callerObjectSizeBits))
+            {
+                Log_e(TAG, "Failed to write mangle self method \'%s\'", method->name);
+                return ERROR;
+            }
         }
 
-        if(!fileWriteNameMangleMethod_(callerObjectName, &tempMethodObj, true, callerObjectSizeBits))
+
+        if(registerWords > 0)
         {
-            Log_e(TAG, "Failed to write mangle self method \'%s\'", method->name);
-            return ERROR;
+            // Words not holding any param are still passed, so they are zeroed
+            Emitter_format(&cOutput_, READABILITY_ENDLINE BITPACK_TYPE_NAME " %spset[%u]" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "{0}" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, registerWords);
+
+        }else if((resultVars.currentSize > 0) || (returnSizeBits > 0))
+        {
+            Emitter_format(&cOutput_, READABILITY_ENDLINE BITPACK_TYPE_NAME " %spset[%lu]" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, BITSCNT_TO_BYTESCNT(sizeNeededForFunctionParams));
         }
 
+        if(resultVars.currentSize > 0)
+        {
+            char* psetName = alloca(strlen(assignedTmpVar->objectName) + sizeof("pset"));
+            sprintf(psetName, "%spset", assignedTmpVar->objectName);
+
+            if(!fileWriteParamsPacking_(&resultVars, constantParams, constantValues, psetName, sizeNeededForFunctionParams))
+            {
+                Log_e(TAG, "Failed to write parameters packing");
+                return ERROR;
+            }
 
-        if((resultVars.currentSize > 0) || (returnSizeBits > 0))
+        }else
         {
-            fprintf(currentCfile_, READABILITY_ENDLINE BITPACK_TYPE_NAME " %spset[%lu]" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, BITSCNT_TO_BYTESCNT(sizeNeededForFunctionParams));
+            EMIT_STRING(READABILITY_ENDLINE)
         }
+        
+        if(expandInline)
+        {
+            const bool hasParamsRegion = (resultVars.currentSize > 0) || (returnSizeBits > 0);
 
-        if(resultVars.currentSize > 0)
+            if(!fileWriteInlinedMethodBody_(inlineCallee, hasParamsRegion ? assignedTmpVar->objectName : NULL))
+            {
+                Log_e(TAG, "Failed to inline method \'%s\'", method->name);
+                return ERROR;
+            }
+
+        }else
         {
-            for(uint32_t paramIdx = 0; paramIdx < resultVars.currentSize; paramIdx++)
+            if((registerWords > 0) && (returnSizeBits > 0))
             {
-                VariableObjectHandle_t param = (VariableObjectHandle_t) resultVars.expandable[paramIdx];
-                
-                if(param->bitpack < BIT_SIZE_BITPACK)
-                {
-                    fprintf(currentCfile_,STRINGIFY(%spset[%u] = AFIT_RESET(%spset[%u], %u, %lu)) READABILITY_SPACE C_OPERATOR_BIN_OR_DEF READABILITY_SPACE,
-                        assignedTmpVar->objectName,
-                        param->belongToGroup,
-                        assignedTmpVar->objectName,
-                        param->belongToGroup,
-                        param->bitpack,
-                        param->posBit,
-                        param->bitpack);
+                Emitter_format(&cOutput_, REGISTER_PACK_TYPE_NAME " %spret" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, assignedTmpVar->objectName);
+            }
 
+            Emitter_format(&cOutput_, "%s%s" BRACKET_ROUND_START_DEF, (inlineCallee != NULL) ? INLINE_FUNCTION_PREFIX : functionPrefix, method->name);
+            
+            if(callerObjectSizeBits > 0)
+            {
 
-                }else if (param->bitpack == BIT_SIZE_BITPACK)
+                if((method->caller != NULL) && (method->caller->allocation != ALLOCATION_STATIC_STACK))
+                {
+                    Emitter_format(&cOutput_, AALLOC_OBJECT_PREFIX "%s", method->caller->objectName);
+                }else if( method->caller != NULL)
                 {
-                    fprintf(currentCfile_, STRINGIFY(%spset[%u]) READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, 
-                    assignedTmpVar->objectName, param->belongToGroup);
+                    Emitter_format(&cOutput_, "&%s[%u]", method->caller->scopeName, method->caller->belongToGroup);
                 }else
                 {
-                    Log_e(TAG, "Unhandled case vars cant be now bigger than %u", BIT_SIZE_BITPACK);
-                    return ERROR;
+                    // If caller is null, it means object tries to call another function in same object
+                    // So just pass the caller function object param to another function through
+                    EMIT_STRING(CLASS_VAR_REGION_NAME);
                 }
 
-                fprintf(currentCfile_, STRINGIFY(((%s) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, param->objectName, param->posBit, param->bitpack);
+                if((resultVars.currentSize > 0) || returnSizeBits)
+                {
+                    EMIT_STRING(COMMA_DEF READABILITY_SPACE);
+                }
             }
 
-        }else
-        {
-            FWRITE_STRING(READABILITY_ENDLINE)
-        }
-        
-        fprintf(currentCfile_, "%s%s" BRACKET_ROUND_START_DEF, functionPrefix, method->name);
-            
-        if(callerObjectSizeBits > 0)
-        {
+            if(registerWords > 0)
+            {
+                for(uint32_t wordIdx = 0; wordIdx < registerWords; wordIdx++)
+                {
+                    Emitter_format(&cOutput_, "%s%spset[%u]", (wordIdx > 0) ? COMMA_DEF READABILITY_SPACE : "", assignedTmpVar->objectName, wordIdx);
+                }
+
+                EMIT_STRING(BRACKET_ROUND_END_DEF SEMICOLON_DEF READABILITY_ENDLINE);
+
+                // Returned words replace params words, so return value is read as from memory region
+                for(uint32_t wordIdx = 0; (returnSizeBits > 0) && (wordIdx < registerWords); wordIdx++)
+                {
+                    Emitter_format(&cOutput_, "%spset[%u]" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "%spret.w[%u]" SEMICOLON_DEF READABILITY_ENDLINE,
+                        assignedTmpVar->objectName, wordIdx, assignedTmpVar->objectName, wordIdx);
+                }
 
-            if( method->caller != NULL)
+            }else if((resultVars.currentSize > 0) || (returnSizeBits > 0))
             {
-                fprintf(currentCfile_, "&%s[%u]", method->caller->scopeName, method->caller->belongToGroup);
+                Emitter_format(&cOutput_, "%spset" BRACKET_ROUND_END_DEF SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName);
             }else
             {
-                // If caller is null, it means object tries to call another function in same object
-                // So just pass the caller function object param to another function through
-                FWRITE_STRING(CLASS_VAR_REGION_NAME);
-            }
-
-            if((resultVars.currentSize > 0) || returnSizeBits)
-            {
-                FWRITE_STRING(COMMA_DEF READABILITY_SPACE);
+                EMIT_STRING(BRACKET_ROUND_END_DEF SEMICOLON_DEF READABILITY_ENDLINE);
             }
         }
 
-        if((resultVars.currentSize > 0) || (returnSizeBits > 0))
+        if(IS_WIDE_BITPACK(returnVar.bitpack))
         {
-            fprintf(currentCfile_, "%spset" BRACKET_ROUND_END_DEF SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName);
-        }else
+            Emitter_format(&cOutput_, AWIDE_LOAD_DEF "(%s, %lu, &%spset[%u], %lu, %lu)" SEMICOLON_DEF READABILITY_ENDLINE,
+                assignedTmpVar->objectName, WIDE_LIMBS(returnVar.bitpack), assignedTmpVar->objectName,
+                returnVar.belongToGroup, WIDE_LIMBS(returnVar.bitpack), WIDE_TOP_BITS(returnVar.bitpack));
+        }else if((returnVar.bitpack != 0) && (returnVar.bitpack < BITPACK_WORD_BITS) && useFieldIntrinsics_())
         {
-            FWRITE_STRING(BRACKET_ROUND_END_DEF SEMICOLON_DEF READABILITY_ENDLINE);
-        }
-
-        if(returnVar.bitpack != 0)
+            Emitter_format(&cOutput_, "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE ABMI_READ_DEF "(%spset[%u], %lu, %lu)" SEMICOLON_DEF READABILITY_ENDLINE,
+                assignedTmpVar->objectName, assignedTmpVar->objectName,
+                returnVar.belongToGroup, fieldShift_(returnVar.posBit, returnVar.bitpack), returnVar.bitpack);
+        }else if(returnVar.bitpack != 0)
         {
-            fprintf(currentCfile_, "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE STRINGIFY(AFIT_READ(%spset[%u], %u, %lu)) SEMICOLON_DEF READABILITY_ENDLINE,
+            Emitter_format(&cOutput_, "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE STRINGIFY(AFIT_READ(%spset[%u], %u, %lu)) SEMICOLON_DEF READABILITY_ENDLINE,
                 assignedTmpVar->objectName, assignedTmpVar->objectName,
                 returnVar.belongToGroup, returnVar.posBit, returnVar.bitpack);
         }else
         {
-            fprintf(currentCfile_, "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "0" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName);
+            Emitter_format(&cOutput_, "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "0" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName);
         }
     }
 
    
-    FWRITE_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
+    EMIT_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
+
+    // Params themselves are on stack, only vector array is released
+    free(resultVars.expandable);
 
     return SUCCESS;
 }
 
 static bool generatePrintFunction_(const VectorHandler_t params)
 {
-    FWRITE_STRING("printf(\"");
-    for(uint16_t paramIdx = 0; paramIdx < params->currentSize; paramIdx++)
-    {
-        FWRITE_STRING("%lu ");
-    }
-    FWRITE_STRING("\\n\"");
+    EMIT_STRING(BRACKET_ROUND_START_DEF);
 
     for(uint16_t paramIdx = 0; paramIdx < params->currentSize; paramIdx++)
     {
-        FWRITE_STRING("," READABILITY_SPACE);
-
         const VariableObjectHandle_t param = params->expandable[paramIdx];
 
-        fprintf(currentCfile_, "%s", param->objectName);
+        if(IS_WIDE_BITPACK(param->bitpack))
+        {
+            Emitter_format(&cOutput_, AWIDE_PRINT_DEF "(%s, %lu)" COMMA_DEF READABILITY_SPACE, param->objectName, WIDE_LIMBS(param->bitpack));
+        }else
+        {
+            Emitter_format(&cOutput_, "%s(%s)" COMMA_DEF READABILITY_SPACE, printHelperName_(param->bitpack), param->objectName);
+        }
     }
 
-    FWRITE_STRING(BRACKET_ROUND_END_DEF);
+    EMIT_STRING(APRINT_END_DEF "()" BRACKET_ROUND_END_DEF);
     return SUCCESS;
 }
 
 static bool generateCodeForOperation_(const VariableObjectHandle_t assignedTmpVar, ExpElementHandle_t leftOperand, ExpElementHandle_t rightOperand, const OperatorType_t operator)
 {
     char* operatorString = NULL;
-    int status;
     
     ExpElementHandle_t chosenOperandLeft = leftOperand;
     ExpElementHandle_t chosenOperandRight = rightOperand;
@@ -1019,6 +1632,8 @@ static bool generateCodeForOperation_(const VariableObjectHandle_t assignedTmpVa
             NULL_GUARD(tmpVar, ERROR, Log_e(TAG, "Failed to allocate function operand tmp var"))
 
             tmpVar->objectName = functionResultVarName;
+            tmpVar->bitpack = 0;
+            tmpVar->castedFile = NULL;
             
             if(!generateMethodCallScope_(0, tmpVar, ExpElement_getObject(leftOperand)))
             {
@@ -1048,6 +1663,8 @@ static bool generateCodeForOperation_(const VariableObjectHandle_t assignedTmpVa
             NULL_GUARD(tmpVar, ERROR, Log_e(TAG, "Failed to allocate function operand tmp var"))
 
             tmpVar->objectName = functionResultVarName;
+            tmpVar->bitpack = 0;
+            tmpVar->castedFile = NULL;
             
             if(!generateMethodCallScope_(0, tmpVar, ExpElement_getObject(rightOperand)))
             {
@@ -1070,10 +1687,15 @@ static bool generateCodeForOperation_(const VariableObjectHandle_t assignedTmpVa
         return handleCastOperator_(assignedTmpVar, chosenOperandLeft, chosenOperandRight);
     }
 
+    if((operator != OP_SET) && IS_WIDE_BITPACK(assignedTmpVar->bitpack))
+    {
+        return fileWriteWideOperation_(assignedTmpVar, chosenOperandLeft, chosenOperandRight, operator);
+    }
+
     // Set handling differently
     if(operator != OP_SET)
     {
-        fprintf(currentCfile_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, assignedTmpVar->objectName);
+        Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, assignedTmpVar->objectName);
 
         if(!printBitVariableReading_(chosenOperandLeft))
         {
@@ -1100,9 +1722,7 @@ static bool generateCodeForOperation_(const VariableObjectHandle_t assignedTmpVa
         default: operatorString = NULL; break;
     }
 
-    status = fwrite(operatorString, BYTE_SIZE, strlen(operatorString), currentCfile_);
-
-    if(status < 0)
+    if((operatorString == NULL) || !Emitter_appendString(&cOutput_, operatorString))
     {
         Log_e(TAG, "Failed to write operator string %s", operatorString);
         return ERROR;
@@ -1113,7 +1733,7 @@ static bool generateCodeForOperation_(const VariableObjectHandle_t assignedTmpVa
         return ERROR;
     }
 
-    FWRITE_STRING(SEMICOLON_DEF READABILITY_ENDLINE)
+    EMIT_STRING(SEMICOLON_DEF READABILITY_ENDLINE)
 
     return SUCCESS;
 }
@@ -1134,12 +1754,25 @@ static bool printBitVariableReading_(const ExpElementHandle_t operand)
 
         Log_d(TAG, "Variable name: %s variable.pos=%u variable_bitpack:%lu", variable->objectName, variable->posBit, variable->bitpack);
 
-        if(variable->bitpack < BIT_SIZE_BITPACK)
+        const LoopRegisterHandle_t loopRegister = loopRegisterOf_(variable);
+
+        if(loopRegister != NULL)
+        {
+            status = Emitter_format(&cOutput_, STRINGIFY(APLT_READ(%s)), loopRegister->name);
+        }else if(BITFIT_IS_STRADDLING(variable, BITPACK_WORD_BITS))
+        {
+            status = Emitter_format(&cOutput_, ADENSE_READ_DEF "(&%s[%u], %u, %lu)", variable->scopeName, variable->belongToGroup, variable->posBit, variable->bitpack);
+        }else if((variable->bitpack < BITPACK_WORD_BITS) && useFieldIntrinsics_())
         {
-            status = fprintf(currentCfile_, STRINGIFY((AFIT_READ(%s[%u], %u, %lu)&MASK(%lu))), variable->scopeName, variable->belongToGroup, variable->posBit, variable->bitpack, variable->bitpack);
-        }else if (variable->bitpack == BIT_SIZE_BITPACK)
+            status = Emitter_format(&cOutput_, ABMI_READ_DEF "(%s[%u], %lu, %lu)", variable->scopeName, variable->belongToGroup,
+                fieldShift_(variable->posBit, variable->bitpack), variable->bitpack);
+        }else if(variable->bitpack < BITPACK_WORD_BITS)
         {
-            status = fprintf(currentCfile_, STRINGIFY(APLT_READ(%s[%u])), variable->scopeName, variable->belongToGroup);
+            status = Emitter_format(&cOutput_, STRINGIFY((AFIT_READ(%s[%u], %u, %lu)&MASK(%lu))), variable->scopeName, variable->belongToGroup, variable->posBit, variable->bitpack, variable->bitpack);
+        }else
+        {
+            // Wide variable in one word context is its lowest limb
+            status = Emitter_format(&cOutput_, STRINGIFY(APLT_READ(%s[%u])), variable->scopeName, variable->belongToGroup);
         }
 
     }else if(ExpElement_getType(operand) == EXP_TMP_VAR)
@@ -1148,10 +1781,16 @@ static bool printBitVariableReading_(const ExpElementHandle_t operand)
 
         NULL_GUARD(var, ERROR, Log_e(TAG, "NULL variable passed to print EXP variable"));
 
-        status = fprintf(currentCfile_, STRINGIFY(APLT_READ(%s)), var->objectName);
+        if(IS_WIDE_BITPACK(var->bitpack))
+        {
+            status = Emitter_format(&cOutput_, STRINGIFY(APLT_READ(%s[0])), var->objectName);
+        }else
+        {
+            status = Emitter_format(&cOutput_, STRINGIFY(APLT_READ(%s)), var->objectName);
+        }
     }else if(ExpElement_getType(operand) == EXP_CONST_NUMBER)
     {
-        status = fprintf(currentCfile_, STRINGIFY(APLT_READ(%lu)), (AssignValue_t) ExpElement_getObject(operand));
+        status = Emitter_format(&cOutput_, STRINGIFY(APLT_READ(%lu)), (AssignValue_t) ExpElement_getObject(operand));
     }
 
     return status > 0;
@@ -1163,25 +1802,52 @@ static bool fileWriteBitVariableSet_(const VariableObjectHandle_t assignedTmpVar
     int status;
     const VariableObjectHandle_t leftVar = ExpElement_getObject(left);
     const VariableObjectHandle_t rightVar = ExpElement_getObject(right);
+
+    // Variable kept in loop register is value of that register, like result of operation
+    if((ExpElement_getType(right) == EXP_VARIABLE) && (loopRegisterOf_(rightVar) != NULL))
+    {
+        VariableObject_t registerVar = *rightVar;
+        ExpElement_t registerOperand;
+
+        registerVar.objectName = loopRegisterOf_(rightVar)->name;
+        ExpElement_set(&registerOperand, EXP_TMP_VAR, &registerVar);
+
+        return fileWriteBitVariableSet_(assignedTmpVar, left, &registerOperand);
+    }
+
+    if((ExpElement_getType(left) == EXP_VARIABLE) && (loopRegisterOf_(leftVar) != NULL))
+    {
+        return fileWriteLoopRegisterSet_(assignedTmpVar, loopRegisterOf_(leftVar), right);
+    }
     
+    if((ExpElement_getType(left) == EXP_VARIABLE) && IS_WIDE_BITPACK(leftVar->bitpack))
+    {
+        return fileWriteWideVariableSet_(assignedTmpVar, leftVar, right);
+    }
+
+    if((ExpElement_getType(left) == EXP_VARIABLE) &&
+       (BITFIT_IS_STRADDLING(leftVar, BITPACK_WORD_BITS) || (useFieldIntrinsics_() && (leftVar->bitpack < BITPACK_WORD_BITS))))
+    {
+        return fileWriteHelperVariableSet_(assignedTmpVar, leftVar, right);
+    }
     
     if(ExpElement_getType(left) == EXP_VARIABLE)
     {
-        if(leftVar->bitpack < BIT_SIZE_BITPACK)
+        if(leftVar->bitpack < BITPACK_WORD_BITS)
         {
-            status = fprintf(currentCfile_,STRINGIFY(%s[%u] = AFIT_RESET(%s[%u], %u, %lu)) READABILITY_SPACE C_OPERATOR_BIN_OR_DEF READABILITY_SPACE,
+            status = Emitter_format(&cOutput_, STRINGIFY(%s[%u] = AFIT_RESET(%s[%u], %u, %lu)) READABILITY_SPACE C_OPERATOR_BIN_OR_DEF READABILITY_SPACE,
                 leftVar->scopeName,
                 leftVar->belongToGroup, leftVar->scopeName,
                 leftVar->belongToGroup,
                 leftVar->bitpack, leftVar->posBit, leftVar->bitpack);
 
-        }else if (leftVar->bitpack == BIT_SIZE_BITPACK)
+        }else if (leftVar->bitpack == BITPACK_WORD_BITS)
         {
-            status = fprintf(currentCfile_, STRINGIFY(%s[%u]) READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, 
+            status = Emitter_format(&cOutput_, STRINGIFY(%s[%u]) READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, 
             leftVar->scopeName, leftVar->belongToGroup);
         }else
         {
-            Log_e(TAG, "Unhandled case vars cant be now bigger than %u", BIT_SIZE_BITPACK);
+            Log_e(TAG, "Unhandled case vars cant be now bigger than %lu", BITPACK_WORD_BITS);
             return ERROR;
         }
     }else if(ExpElement_getType(left) == EXP_CONST_NUMBER)
@@ -1189,6 +1855,44 @@ static bool fileWriteBitVariableSet_(const VariableObjectHandle_t assignedTmpVar
         Log_e(TAG, "Unhandled case %ld = value", (AssignValue_t) ExpElement_getObject(left));
         return ERROR;
     }
+
+    // Wide value assigned to one word variable is truncated from its lowest limb,
+    // straddling value is read as whole with double word shift
+    if(isWideOperand_(right) || isStraddlingOperand_(right))
+    {
+        EMIT_STRING(BRACKET_ROUND_START_DEF BRACKET_ROUND_START_DEF);
+
+        if(!printBitVariableReading_(right))
+        {
+            return ERROR;
+        }
+
+        if(leftVar->bitpack < BITPACK_WORD_BITS)
+        {
+            Emitter_format(&cOutput_, STRINGIFY(& MASK(%lu)), leftVar->bitpack);
+        }
+
+        status = Emitter_format(&cOutput_, BRACKET_ROUND_END_DEF " << (" STRINGIFY(BIT_SIZE_BITPACK) " - (%u + %lu)))" SEMICOLON_DEF READABILITY_ENDLINE, leftVar->posBit, leftVar->bitpack);
+
+        if(assignedTmpVar != NULL)
+        {
+            Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, assignedTmpVar->objectName);
+
+            if(!printBitVariableReading_(right))
+            {
+                return ERROR;
+            }
+
+            if(leftVar->bitpack < BITPACK_WORD_BITS)
+            {
+                Emitter_format(&cOutput_, STRINGIFY(& MASK(%lu)), leftVar->bitpack);
+            }
+
+            status = Emitter_format(&cOutput_, SEMICOLON_DEF READABILITY_ENDLINE);
+        }
+
+        return (status > 0);
+    }
     
 
 
@@ -1198,42 +1902,50 @@ static bool fileWriteBitVariableSet_(const VariableObjectHandle_t assignedTmpVar
 
         NULL_GUARD(var, ERROR, Log_e(TAG, "Variable is NULL"));
 
-        status = fprintf(currentCfile_, STRINGIFY(((%s) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, var->objectName, leftVar->posBit, leftVar->bitpack);
+        // Result of operation may be wider than variable, it must not overflow into neighbouring variables
+        if(leftVar->bitpack < BITPACK_WORD_BITS)
+        {
+            status = Emitter_format(&cOutput_, STRINGIFY((((%s) & MASK(%lu)) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, var->objectName, leftVar->bitpack, leftVar->posBit, leftVar->bitpack);
+        }else
+        {
+            status = Emitter_format(&cOutput_, STRINGIFY(((%s) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, var->objectName, leftVar->posBit, leftVar->bitpack);
+        }
+
         if (assignedTmpVar != NULL)
         {
-            status = fprintf(currentCfile_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "%s" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, var->objectName);
+            status = Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "%s" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, var->objectName);
         }
 
     }else if (ExpElement_getType(right) == EXP_VARIABLE)
     {
-        if(rightVar->bitpack < BIT_SIZE_BITPACK)
+        if(rightVar->bitpack < BITPACK_WORD_BITS)
         {
-            status = fprintf(currentCfile_, STRINGIFY(((AFIT_READ(%s[%u], %u, %lu) & MASK(%lu)) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, rightVar->scopeName, rightVar->belongToGroup, rightVar->posBit, rightVar->bitpack, leftVar->bitpack, leftVar->posBit, leftVar->bitpack);
+            status = Emitter_format(&cOutput_, STRINGIFY(((AFIT_READ(%s[%u], %u, %lu) & MASK(%lu)) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, rightVar->scopeName, rightVar->belongToGroup, rightVar->posBit, rightVar->bitpack, leftVar->bitpack, leftVar->posBit, leftVar->bitpack);
             if(assignedTmpVar != NULL)
             {
-                status = fprintf(currentCfile_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE STRINGIFY(AFIT_READ(%s[%u], %u, %lu) & MASK(%lu)) SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, rightVar->scopeName, rightVar->belongToGroup, rightVar->posBit, rightVar->bitpack, leftVar->bitpack);
+                status = Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE STRINGIFY(AFIT_READ(%s[%u], %u, %lu) & MASK(%lu)) SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, rightVar->scopeName, rightVar->belongToGroup, rightVar->posBit, rightVar->bitpack, leftVar->bitpack);
             }
-        }else if (rightVar->bitpack == BIT_SIZE_BITPACK)
+        }else if (rightVar->bitpack == BITPACK_WORD_BITS)
         {
-            status = fprintf(currentCfile_, STRINGIFY(((%s[%u] & MASK(%lu)) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, rightVar->scopeName, rightVar->belongToGroup, leftVar->bitpack, leftVar->posBit, leftVar->bitpack);
+            status = Emitter_format(&cOutput_, STRINGIFY(((%s[%u] & MASK(%lu)) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, rightVar->scopeName, rightVar->belongToGroup, leftVar->bitpack, leftVar->posBit, leftVar->bitpack);
             
             if(assignedTmpVar != NULL)
             {
-                status = fprintf(currentCfile_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE STRINGIFY(%s[%u] & MASK(%lu)) SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, rightVar->scopeName, rightVar->belongToGroup, leftVar->bitpack);
+                status = Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE STRINGIFY(%s[%u] & MASK(%lu)) SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, rightVar->scopeName, rightVar->belongToGroup, leftVar->bitpack);
             }
         }else
         {   
-            Log_e(TAG, "Unhandled case vars cant be now bigger than %u", BIT_SIZE_BITPACK);
+            Log_e(TAG, "Unhandled case vars cant be now bigger than %lu", BITPACK_WORD_BITS);
             return ERROR;
         }
     }else if(ExpElement_getType(right) == EXP_CONST_NUMBER)
     {
         const AssignValue_t constValue = (AssignValue_t) ExpElement_getObject(right);
 
-        status = fprintf(currentCfile_, STRINGIFY(((%ld & MASK(%lu)) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, constValue, leftVar->bitpack, leftVar->posBit, leftVar->bitpack);
+        status = Emitter_format(&cOutput_, STRINGIFY(((%ld & MASK(%lu)) << (BIT_SIZE_BITPACK - (%u + %lu)))) SEMICOLON_DEF READABILITY_ENDLINE, constValue, leftVar->bitpack, leftVar->posBit, leftVar->bitpack);
         if(assignedTmpVar != NULL)
         {
-            status = fprintf(currentCfile_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "%lu" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, constValue);
+            status = Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "%lu" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, constValue);
         }
     }
    
@@ -1245,6 +1957,21 @@ static int methodDefinitionIteratorCallback_(void *key, int count, void* value,
 {
     MethodObjectHandle_t method;
     method = value;
+
+    // Body of inline method lives in static inline function, calls which were not expanded reach it directly
+    if(isInlineCandidate_(method))
+    {
+        EMIT_STRING(STATIC_KEYWORD_DEF " " INLINE_KEYWORD_DEF " ");
+
+        if(!generateMethodHeader_(method, INLINE_FUNCTION_PREFIX, currentAst_->objectSizeBits))
+        {
+            Log_e(TAG, "Failed to write inline method %s header", method->methodName);
+            return ERROR;
+        }
+
+        EMIT_STRING(SEMICOLON_DEF READABILITY_ENDLINE);
+    }
+
     if(!generateMethodHeader_(method, "", currentAst_->objectSizeBits))
     {
         Log_e(TAG, "Failed to write method %s header", method->methodName);
@@ -1258,7 +1985,7 @@ static int methodDefinitionIteratorCallback_(void *key, int count, void* value,
     }
 
     #if ENABLE_READABILITY
-        fwrite(END_LINE_DEF, BYTE_SIZE, 1, currentCfile_);  
+        EMIT_STRING(END_LINE_DEF);
     #endif
       
 
@@ -1268,34 +1995,43 @@ static int methodDefinitionIteratorCallback_(void *key, int count, void* value,
 
 static bool generateMethodHeader_(const MethodObjectHandle_t method, const char* prefixFunc, const BitpackSize_t callerObjectBitsize)
 {
+    const uint32_t registerWords = registerPackWords_(method);
     
     if(method->containsBody)
     {
-        fprintf(currentCfile_, "void %s%s" BRACKET_ROUND_START_DEF, prefixFunc, method->methodName);
+        Emitter_format(&cOutput_, "%s %s%s" BRACKET_ROUND_START_DEF,
+            ((registerWords > 0) && (method->returnVariable->bitpack > 0)) ? REGISTER_PACK_TYPE_NAME : "void", prefixFunc, method->methodName);
     }
 
     if(callerObjectBitsize > 0)
     {
             // TODO later change this hardcoded 
-        FWRITE_STRING(PARAM_TYPE_DEF READABILITY_SPACE FUNCTION_OBJ_NAME);
+        EMIT_STRING(PARAM_TYPE_DEF READABILITY_SPACE FUNCTION_OBJ_NAME);
 
         if((method->parameters->currentSize > 0) || (method->returnVariable->bitpack > 0))
         {
-            FWRITE_STRING(COMMA_DEF READABILITY_SPACE);
+            EMIT_STRING(COMMA_DEF READABILITY_SPACE);
         }
     }
 
-    if((method->parameters->currentSize > 0) || (method->returnVariable->bitpack > 0))
+    if(registerWords > 0)
+    {
+        for(uint32_t wordIdx = 0; wordIdx < registerWords; wordIdx++)
+        {
+            Emitter_format(&cOutput_, "%s" BITPACK_TYPE_NAME " " FUNCTION_PARAM_NAME "%u", (wordIdx > 0) ? COMMA_DEF READABILITY_SPACE : "", wordIdx);
+        }
+
+    }else if((method->parameters->currentSize > 0) || (method->returnVariable->bitpack > 0))
     {
-        FWRITE_STRING(PARAM_TYPE_DEF READABILITY_SPACE FUNCTION_PARAM_NAME);
+        EMIT_STRING(PARAM_TYPE_DEF READABILITY_SPACE FUNCTION_PARAM_NAME);
     }
     
-    if((callerObjectBitsize == 0) && (method->parameters->currentSize == 0))
+    if((callerObjectBitsize == 0) && (method->parameters->currentSize == 0) && (method->returnVariable->bitpack == 0))
     {
-        FWRITE_STRING(TYPE_BIT0_DEF);
+        EMIT_STRING(TYPE_BIT0_DEF);
     }
     
-    FWRITE_STRING(BRACKET_ROUND_END_DEF);
+    EMIT_STRING(BRACKET_ROUND_END_DEF);
 
     return SUCCESS;
 }
@@ -1319,6 +2055,33 @@ static int methodDeclarationIteratorCallback_(void *key, int count, void* value,
         return ERROR;
     }
 
+    if(isInlineCandidate_(method))
+    {
+        // Exported method only forwards to its static inline body for other objects
+        EMIT_STRING(READABILITY_ENDLINE BRACKET_START_DEF READABILITY_ENDLINE);
+
+        if((registerPackWords_(method) > 0) && (method->returnVariable->bitpack > 0))
+        {
+            EMIT_STRING(RETURN_DEF " ");
+        }
+
+        if(!fileWriteMethodArguments_(method, currentAst_->objectSizeBits))
+        {
+            Log_e(TAG, "Failed to write inline method %s call", method->methodName);
+            return ERROR;
+        }
+
+        EMIT_STRING(SEMICOLON_DEF READABILITY_ENDLINE BRACKET_END_DEF READABILITY_ENDLINE);
+
+        EMIT_STRING(STATIC_KEYWORD_DEF " " INLINE_KEYWORD_DEF " ");
+
+        if(!generateMethodHeader_(method, INLINE_FUNCTION_PREFIX, currentAst_->objectSizeBits))
+        {
+            Log_e(TAG, "Failed to generate inline method %s header", method->methodName);
+            return ERROR;
+        }
+    }
+
     if(method->containsBody)
     {
         if(!fileWriteMethodBody_(method))
@@ -1328,8 +2091,7 @@ static int methodDeclarationIteratorCallback_(void *key, int count, void* value,
         }
     }else
     {
-        // TODO abstracting fwrites
-        fwrite(SEMICOLON_DEF, BYTE_SIZE, 1, currentCfile_);
+        EMIT_STRING(SEMICOLON_DEF);
     }
     return SUCCESS;
 }
@@ -1398,13 +2160,28 @@ static bool handleCastOperator_(const VariableObjectHandle_t assignedTmpVar, con
     {
         Log_e(TAG, "Cast on constant value not supported yet");
         return ERROR;
+    }else if(((rightType == EXP_TMP_VAR) || (rightType == EXP_VARIABLE)) && IS_WIDE_BITPACK(castValue))
+    {
+        Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s[%lu]" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, WIDE_LIMBS(castValue));
+
+        if(!fileWriteWideLoad_(assignedTmpVar->objectName, WIDE_LIMBS(castValue), right))
+        {
+            return ERROR;
+        }
+
+        if(WIDE_TOP_BITS(castValue) < BITPACK_WORD_BITS)
+        {
+            Emitter_format(&cOutput_, STRINGIFY(%s[%lu] &= MASK(%lu)) SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, WIDE_LIMBS(castValue) - 1, WIDE_TOP_BITS(castValue));
+        }
+
+        return SUCCESS;
     }else if((rightType == EXP_TMP_VAR) || (rightType == EXP_VARIABLE))
     {
-        fprintf(currentCfile_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, assignedTmpVar->objectName);
+        Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, assignedTmpVar->objectName);
 
         printBitVariableReading_(right);
         
-        fprintf(currentCfile_, STRINGIFY(&MASK(%lu)) SEMICOLON_DEF READABILITY_ENDLINE, castValue);
+        Emitter_format(&cOutput_, STRINGIFY(&MASK(%lu)) SEMICOLON_DEF READABILITY_ENDLINE, castValue);
 
         return SUCCESS;
     }else
@@ -1416,37 +2193,1653 @@ static bool handleCastOperator_(const VariableObjectHandle_t assignedTmpVar, con
     return SUCCESS;
 }
 
-static inline uint8_t getBitCountU64_(uint64_t number)
+static bool isWideOperand_(const ExpElementHandle_t operand)
+{
+    const ExpElementType_t type = ExpElement_getType(operand);
+
+    if((type == EXP_VARIABLE) || (type == EXP_TMP_VAR))
+    {
+        return IS_WIDE_BITPACK(((VariableObjectHandle_t) ExpElement_getObject(operand))->bitpack);
+    }
+
+    return false;
+}
+
+/**
+ * @brief Same bit size rules as in determineResultVariableExpression_, but without writing anything
+ */
+static bool estimateExpressionBitpack_(const ExpHandle_t expression, BitpackSize_t* bitpack)
+{
+    const size_t elementsCount = Expression_size(expression);
+    BitpackSize_t* sizesStack;
+    size_t stackTop = 0;
+
+    *bitpack = 0;
+
+    if(elementsCount == 0)
+    {
+        return SUCCESS;
+    }
+
+    sizesStack = alloca(elementsCount * sizeof(BitpackSize_t));
+    bool* constantsStack = alloca(elementsCount * sizeof(bool));
+
+    for(ExpIterator_t iterator = Expression_iteratorFirst(expression); iterator < Expression_iteratorLast(expression); iterator++)
+    {
+        const ExpElementHandle_t symbol = *iterator;
+
+        if(ExpElement_isSymbolOperand(symbol))
+        {
+            if(!getBitpackFromOperand_(symbol, &sizesStack[stackTop]))
+            {
+                return ERROR;
+            }
+
+            constantsStack[stackTop] = (ExpElement_getType(symbol) == EXP_CONST_NUMBER);
+
+            // Cast size is kept as constant value itself
+            if(constantsStack[stackTop])
+            {
+                sizesStack[stackTop] = (AssignValue_t) ExpElement_getObject(symbol);
+            }
+
+            stackTop++;
+        }else if(ExpElement_isSymbolOperator(symbol))
+        {
+            const OperatorType_t operator = (OperatorType_t) ExpElement_getObject(symbol);
+            BitpackSize_t leftSize;
+            BitpackSize_t rightSize;
+            bool leftConstant;
+            bool rightConstant;
+
+            if(stackTop < 2)
+            {
+                break;
+            }
+
+            rightSize = sizesStack[--stackTop];
+            rightConstant = constantsStack[stackTop];
+            leftSize = sizesStack[--stackTop];
+            leftConstant = constantsStack[stackTop];
+
+            if(operator == OP_CAST)
+            {
+                sizesStack[stackTop] = leftSize;
+                constantsStack[stackTop] = false;
+            }else if(leftConstant && rightConstant)
+            {
+                AssignValue_t folded;
+
+                // Pair which cannot be folded is reported when expression itself is generated
+                sizesStack[stackTop] = Generator_foldConstants(leftSize, rightSize, operator, &folded) ? getBitCountU64_(folded) : 0;
+                constantsStack[stackTop] = false;
+            }else
+            {
+                leftSize = leftConstant ? getBitCountU64_(leftSize) : leftSize;
+                rightSize = rightConstant ? getBitCountU64_(rightSize) : rightSize;
+
+                sizesStack[stackTop] = (operator == OP_SET) ? leftSize : getOperationBits_(operator, leftSize, rightSize);
+                constantsStack[stackTop] = false;
+            }
+
+            stackTop++;
+        }
+    }
+
+    if(stackTop > 0)
+    {
+        *bitpack = constantsStack[stackTop - 1] ? getBitCountU64_(sizesStack[stackTop - 1]) : sizesStack[stackTop - 1];
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Bit size of variable which statement assigns, postfix of it starts with variable and ends with set
+ */
+static BitpackSize_t getAssignTargetBits_(const ExpHandle_t expression)
+{
+    ExpElementHandle_t target;
+    ExpElementHandle_t lastSymbol;
+
+    if(Expression_size(expression) < 3)
+    {
+        return 0;
+    }
+
+    target = *Expression_iteratorFirst(expression);
+    lastSymbol = *(Expression_iteratorLast(expression) - 1);
+
+    if((ExpElement_getType(target) != EXP_VARIABLE) || !ExpElement_isSymbolOperator(lastSymbol) ||
+        ((OperatorType_t) ExpElement_getObject(lastSymbol) != OP_SET))
+    {
+        return 0;
+    }
+
+    return ((VariableObjectHandle_t) ExpElement_getObject(target))->bitpack;
+}
+
+/**
+ * @brief Result bit size of operation, which is the biggest operand size. When wide variable is assigned,
+ * sum gets one carry bit, product gets bits of both operands and difference borrows up to the target size,
+ * as much as target holds
+ */
+static BitpackSize_t getOperationBits_(const OperatorType_t operator, const BitpackSize_t leftBits, const BitpackSize_t rightBits)
+{
+    const BitpackSize_t operandBits = max(leftBits, rightBits);
+    BitpackSize_t fullBits;
+
+    if(!IS_WIDE_BITPACK(assignTargetBits_))
+    {
+        return operandBits;
+    }
+
+    switch (operator)
+    {
+        case OP_PLUS:       fullBits = operandBits + 1; break;
+        case OP_MINUS:      fullBits = assignTargetBits_; break;
+        case OP_MULTIPLY:   fullBits = leftBits + rightBits; break;
+        default:            return operandBits;
+    }
+
+    fullBits = (fullBits < assignTargetBits_) ? fullBits : assignTargetBits_;
+
+    return max(operandBits, fullBits);
+}
+
+static bool astUsesWideValues_(void)
+{
+    bool usesWide = false;
+
+    Hashmap_forEach(&currentAst_->classVariables, wideVariableIteratorCallback_, &usesWide);
+    Hashmap_forEach(&currentAst_->methods, wideMethodIteratorCallback_, &usesWide);
+
+    return usesWide;
+}
+
+static bool expressionUsesWideCast_(const ExpHandle_t expression)
+{
+    bool containsCast = false;
+    bool containsWideConstant = false;
+
+    for(ExpIterator_t iterator = Expression_iteratorFirst(expression); iterator < Expression_iteratorLast(expression); iterator++)
+    {
+        const ExpElementHandle_t symbol = *iterator;
+
+        switch (ExpElement_getType(symbol))
+        {
+            case EXP_OPERATOR:
+            {
+                containsCast |= ((OperatorType_t) ExpElement_getObject(symbol) == OP_CAST);
+            }break;
+
+            case EXP_CONST_NUMBER:
+            {
+                containsWideConstant |= IS_WIDE_BITPACK((AssignValue_t) ExpElement_getObject(symbol));
+            }break;
+
+            case EXP_METHOD_CALL:
+            {
+                const ExMethodCallHandle_t methodCall = ExpElement_getObject(symbol);
+
+                for(size_t paramIdx = 0; paramIdx < methodCall->parameters.currentSize; paramIdx++)
+                {
+                    if(expressionUsesWideCast_(methodCall->parameters.expandable[paramIdx]))
+                    {
+                        return true;
+                    }
+                }
+            }break;
+
+            default: break;
+        }
+    }
+
+    for(size_t elementIdx = 0; (expression->loopBody != NULL) && (elementIdx < expression->loopBody->currentSize); elementIdx++)
+    {
+        if(expressionUsesWideCast_(expression->loopBody->expandable[elementIdx]))
+        {
+            return true;
+        }
+    }
+
+    return containsCast && containsWideConstant;
+}
+
+static int wideVariableIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    bool* usesWide = user;
+
+    *usesWide |= IS_WIDE_BITPACK(((VariableObjectHandle_t) value)->bitpack);
+
+    // Iteration stops on first wide variable
+    return !(*usesWide);
+}
+
+static int wideMethodIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    const MethodObjectHandle_t method = value;
+    bool* usesWide = user;
+
+    *usesWide |= IS_WIDE_BITPACK(method->returnVariable->bitpack);
+
+    for(size_t paramIdx = 0; paramIdx < method->parameters->currentSize; paramIdx++)
+    {
+        *usesWide |= IS_WIDE_BITPACK(((VariableObjectHandle_t) method->parameters->expandable[paramIdx])->bitpack);
+    }
+
+    if(!method->containsBody || *usesWide)
+    {
+        return !(*usesWide);
+    }
+
+    Hashmap_forEach(&method->body.localVariables, wideVariableIteratorCallback_, usesWide);
+
+    for(size_t elementIdx = 0; (elementIdx < method->body.scopeElementsList.currentSize) && !(*usesWide); elementIdx++)
+    {
+        *usesWide |= expressionUsesWideCast_(method->body.scopeElementsList.expandable[elementIdx]);
+    }
+
+    return !(*usesWide);
+}
+
+static bool fileWriteWideLoad_(const char* destination, const uint32_t limbs, const ExpElementHandle_t operand)
+{
+    int status = -1;
+
+    switch (ExpElement_getType(operand))
+    {
+        case EXP_VARIABLE:
+        {
+            const VariableObjectHandle_t variable = ExpElement_getObject(operand);
+
+            if(IS_WIDE_BITPACK(variable->bitpack))
+            {
+                status = Emitter_format(&cOutput_, AWIDE_LOAD_DEF "(%s, %u, &%s[%u], %lu, %lu)" SEMICOLON_DEF READABILITY_ENDLINE,
+                    destination, limbs, variable->scopeName, variable->belongToGroup, WIDE_LIMBS(variable->bitpack), WIDE_TOP_BITS(variable->bitpack));
+                break;
+            }
+
+            Emitter_format(&cOutput_, AWIDE_SET_DEF "(%s, %u, ", destination, limbs);
+
+            if(!printBitVariableReading_(operand))
+            {
+                return ERROR;
+            }
+
+            status = Emitter_format(&cOutput_, BRACKET_ROUND_END_DEF SEMICOLON_DEF READABILITY_ENDLINE);
+        }break;
+
+        case EXP_TMP_VAR:
+        {
+            const VariableObjectHandle_t variable = ExpElement_getObject(operand);
+
+            if(IS_WIDE_BITPACK(variable->bitpack))
+            {
+                status = Emitter_format(&cOutput_, AWIDE_LOAD_DEF "(%s, %u, %s, %lu, " AWIDE_WORD_BITS ")" SEMICOLON_DEF READABILITY_ENDLINE,
+                    destination, limbs, variable->objectName, WIDE_LIMBS(variable->bitpack));
+            }else
+            {
+                status = Emitter_format(&cOutput_, AWIDE_SET_DEF "(%s, %u, %s)" SEMICOLON_DEF READABILITY_ENDLINE, destination, limbs, variable->objectName);
+            }
+        }break;
+
+        case EXP_CONST_NUMBER:
+        {
+            const uint64_t constValue = (AssignValue_t) ExpElement_getObject(operand);
+
+            status = Emitter_format(&cOutput_, AWIDE_SET_DEF "(%s, %u, %luUL)" SEMICOLON_DEF READABILITY_ENDLINE, destination, limbs,
+                (BITPACK_WORD_BITS < 64) ? (constValue & LOOKUP_BIT_MASK[BITPACK_WORD_BITS]) : constValue);
+
+            // Constant wider than word continues in upper limbs
+            for(uint32_t limbIdx = 1; (limbIdx < limbs) && (limbIdx * BITPACK_WORD_BITS < 64) && ((constValue >> (limbIdx * BITPACK_WORD_BITS)) != 0); limbIdx++)
+            {
+                status = Emitter_format(&cOutput_, "%s[%u]" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "%luUL" SEMICOLON_DEF READABILITY_ENDLINE, destination, limbIdx,
+                    (constValue >> (limbIdx * BITPACK_WORD_BITS)) & LOOKUP_BIT_MASK[BITPACK_WORD_BITS]);
+            }
+        }break;
+
+        default:
+        {
+            Log_e(TAG, "Unhandled operand type for wide value: %d", ExpElement_getType(operand));
+        }return ERROR;
+    }
+
+    return (status > 0);
+}
+
+static bool fileWriteWideOperation_(const VariableObjectHandle_t assignedTmpVar, const ExpElementHandle_t left, const ExpElementHandle_t right, const OperatorType_t operator)
+{
+    const uint32_t limbs = WIDE_LIMBS(assignedTmpVar->bitpack);
+    const char* operationName;
+
+    switch (operator)
+    {
+        case OP_PLUS:       operationName = AWIDE_ADD_DEF; break;
+        case OP_MINUS:      operationName = AWIDE_SUB_DEF; break;
+        case OP_MULTIPLY:   operationName = AWIDE_MUL_DEF; break;
+        case OP_BIN_AND:    operationName = AWIDE_AND_DEF; break;
+        case OP_BIN_OR:     operationName = AWIDE_OR_DEF; break;
+        case OP_BIN_XOR:    operationName = AWIDE_XOR_DEF; break;
+
+        default:
+        {
+            Log_e(TAG, "Operator %d is not supported on values wider than %lu bits", operator, BITPACK_WORD_BITS);
+        }return ERROR;
+    }
+
+    Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s[%u]" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, limbs);
+    Emitter_format(&cOutput_, BRACKET_START_DEF BITPACK_TYPE_NAME " _wl[%u]" SEMICOLON_DEF READABILITY_SPACE BITPACK_TYPE_NAME " _wr[%u]" SEMICOLON_DEF READABILITY_ENDLINE, limbs, limbs);
+
+    if(!fileWriteWideLoad_("_wl", limbs, left) || !fileWriteWideLoad_("_wr", limbs, right))
+    {
+        Log_e(TAG, "Failed to load wide operands");
+        return ERROR;
+    }
+
+    Emitter_format(&cOutput_, "%s(%s, _wl, _wr, %u)" SEMICOLON_DEF BRACKET_END_DEF READABILITY_ENDLINE, operationName, assignedTmpVar->objectName, limbs);
+
+    return SUCCESS;
+}
+
+static bool fileWriteWideVariableSet_(const VariableObjectHandle_t assignedTmpVar, const VariableObjectHandle_t leftVar, const ExpElementHandle_t right)
+{
+    const uint32_t limbs = WIDE_LIMBS(leftVar->bitpack);
+    const char* valueName = "_wv";
+
+    if(assignedTmpVar != NULL)
+    {
+        // Result of set is also value of expression
+        valueName = assignedTmpVar->objectName;
+        Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s[%u]" SEMICOLON_DEF READABILITY_ENDLINE, valueName, limbs);
+    }else
+    {
+        Emitter_format(&cOutput_, BRACKET_START_DEF BITPACK_TYPE_NAME " %s[%u]" SEMICOLON_DEF READABILITY_ENDLINE, valueName, limbs);
+    }
+
+    if(!fileWriteWideLoad_(valueName, limbs, right))
+    {
+        Log_e(TAG, "Failed to load value for wide variable %s", leftVar->objectName);
+        return ERROR;
+    }
+
+    Emitter_format(&cOutput_, AWIDE_STORE_DEF "(&%s[%u], %u, %lu, %s)" SEMICOLON_DEF READABILITY_ENDLINE,
+        leftVar->scopeName, leftVar->belongToGroup, limbs, WIDE_TOP_BITS(leftVar->bitpack), valueName);
+
+    if(assignedTmpVar == NULL)
+    {
+        EMIT_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
+    }
+
+    return SUCCESS;
+}
+
+static bool isStraddlingOperand_(const ExpElementHandle_t operand)
+{
+    if(ExpElement_getType(operand) == EXP_VARIABLE)
+    {
+        return BITFIT_IS_STRADDLING((VariableObjectHandle_t) ExpElement_getObject(operand), BITPACK_WORD_BITS);
+    }
+
+    return false;
+}
+
+static bool astUsesStraddlingValues_(void)
+{
+    bool usesStraddling = false;
+
+    // Only object variables are packed densely
+    Hashmap_forEach(&currentAst_->classVariables, straddlingVariableIteratorCallback_, &usesStraddling);
+
+    return usesStraddling;
+}
+
+static int straddlingVariableIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    if(BITFIT_IS_STRADDLING((VariableObjectHandle_t) value, BITPACK_WORD_BITS))
+    {
+        *(bool*) user = true;
+        return 0;
+    }
+
+    return 1;
+}
+
+static bool isArrayOperand_(const ExpElementHandle_t operand)
+{
+    if(ExpElement_getType(operand) == EXP_VARIABLE)
+    {
+        return BITFIT_IS_ARRAY((VariableObjectHandle_t) ExpElement_getObject(operand));
+    }
+
+    return false;
+}
+
+/**
+ * @brief Places array element views of expression by their arrays, after that elements are
+ * read and written as any other variable
+ *
+ * @return  true if expression has whole array operand
+ */
+static bool prepareArrayOperands_(const ExpHandle_t expression)
+{
+    bool usesArray = false;
+
+    for(ExpIterator_t iterator = Expression_iteratorFirst(expression); iterator < Expression_iteratorLast(expression); iterator++)
+    {
+        if(ExpElement_getType(*iterator) != EXP_VARIABLE)
+        {
+            continue;
+        }
+
+        const VariableObjectHandle_t variable = ExpElement_getObject(*iterator);
+
+        if(variable->arrayOwner != NULL)
+        {
+            Bitfit_resolveArrayElement(variable, BITPACK_WORD_BITS);
+        }
+
+        usesArray |= BITFIT_IS_ARRAY(variable);
+    }
+
+    return usesArray;
+}
+
+/**
+ * @brief Statement over whole arrays is one call of bulk kernel. Array can be filled with constant,
+ * copied or get element-wise +, ^, & of two arrays, all arrays of statement have same shape
+ */
+static bool fileWriteArrayStatement_(const ExpHandle_t expression, const VariableObjectHandle_t resultVar)
+{
+    const size_t elementsCount = Expression_size(expression);
+    const ExpIterator_t symbols = Expression_iteratorFirst(expression);
+    const ExpElementHandle_t lastSymbol = symbols[elementsCount - 1];
+
+    if((resultVar->objectName[0] != '\0') || ((elementsCount != 3) && (elementsCount != 5)) || !isArrayOperand_(symbols[0]) ||
+       !ExpElement_isSymbolOperator(lastSymbol) || ((OperatorType_t) ExpElement_getObject(lastSymbol) != OP_SET))
+    {
+        Log_e(TAG, "Arrays can only be filled, copied or combined element-wise into array, not used as values");
+        return ERROR;
+    }
+
+    const VariableObjectHandle_t destination = ExpElement_getObject(symbols[0]);
+    const uint32_t lanes = BITFIT_ARRAY_LANES(destination->bitpack, BITPACK_WORD_BITS);
+    const uint32_t words = BITFIT_ARRAY_GROUPS(destination, BITPACK_WORD_BITS);
+
+    for(size_t symbolIdx = 1; symbolIdx < elementsCount - 1; symbolIdx++)
+    {
+        const VariableObjectHandle_t operand = ExpElement_getObject(symbols[symbolIdx]);
+
+        if(isArrayOperand_(symbols[symbolIdx]) && ((operand->bitpack != destination->bitpack) || (operand->arrayLength != destination->arrayLength)))
+        {
+            Log_e(TAG, "Array '%s' and '%s' have different shapes", destination->objectName, operand->objectName);
+            return ERROR;
+        }
+    }
+
+    if((elementsCount == 3) && (ExpElement_getType(symbols[1]) == EXP_CONST_NUMBER))
+    {
+        // Padding lanes of last word stay zero, so popcount and element-wise kernels can go over them
+        const uint64_t value = (AssignValue_t) ExpElement_getObject(symbols[1]);
+        const uint32_t tailLanes = destination->arrayLength - (words - 1) * lanes;
+
+        Emitter_format(&cOutput_, AARRAY_FILL_DEF "(&%s[%u], 0x%lx, 0x%lx, %u)" SEMICOLON_DEF READABILITY_ENDLINE,
+            destination->scopeName, destination->belongToGroup,
+            arrayLanesPattern_(value, destination->bitpack, lanes), arrayLanesPattern_(value, destination->bitpack, tailLanes), words);
+
+        return SUCCESS;
+    }
+
+    if((elementsCount == 3) && isArrayOperand_(symbols[1]))
+    {
+        const VariableObjectHandle_t source = ExpElement_getObject(symbols[1]);
+
+        Emitter_format(&cOutput_, AARRAY_COPY_DEF "(&%s[%u], &%s[%u], %u)" SEMICOLON_DEF READABILITY_ENDLINE,
+            destination->scopeName, destination->belongToGroup, source->scopeName, source->belongToGroup, words);
+
+        return SUCCESS;
+    }
+
+    if((elementsCount == 5) && isArrayOperand_(symbols[1]) && isArrayOperand_(symbols[2]) && ExpElement_isSymbolOperator(symbols[3]))
+    {
+        const VariableObjectHandle_t left = ExpElement_getObject(symbols[1]);
+        const VariableObjectHandle_t right = ExpElement_getObject(symbols[2]);
+
+        switch ((OperatorType_t) ExpElement_getObject(symbols[3]))
+        {
+            case OP_PLUS:
+            {
+                Emitter_format(&cOutput_, AARRAY_ADD_DEF "(&%s[%u], &%s[%u], &%s[%u], 0x%lx, %u)" SEMICOLON_DEF READABILITY_ENDLINE,
+                    destination->scopeName, destination->belongToGroup, left->scopeName, left->belongToGroup, right->scopeName, right->belongToGroup,
+                    arrayLanesPattern_(1ULL << (destination->bitpack - 1), destination->bitpack, lanes), words);
+            }return SUCCESS;
+
+            case OP_BIN_XOR:
+            {
+                Emitter_format(&cOutput_, AARRAY_XOR_DEF "(&%s[%u], &%s[%u], &%s[%u], %u)" SEMICOLON_DEF READABILITY_ENDLINE,
+                    destination->scopeName, destination->belongToGroup, left->scopeName, left->belongToGroup, right->scopeName, right->belongToGroup, words);
+            }return SUCCESS;
+
+            case OP_BIN_AND:
+            {
+                Emitter_format(&cOutput_, AARRAY_AND_DEF "(&%s[%u], &%s[%u], &%s[%u], %u)" SEMICOLON_DEF READABILITY_ENDLINE,
+                    destination->scopeName, destination->belongToGroup, left->scopeName, left->belongToGroup, right->scopeName, right->belongToGroup, words);
+            }return SUCCESS;
+
+            default: break;
+        }
+    }
+
+    Log_e(TAG, "Unsupported statement on array '%s', only fill, copy and element-wise +, ^, & of arrays are allowed", destination->objectName);
+
+    return ERROR;
+}
+
+static bool isPopcountCall_(const ExMethodCallHandle_t method)
+{
+    const ExpHandle_t argument = (method->parameters.currentSize == 1) ? method->parameters.expandable[0] : NULL;
+
+    // Object own method with same name is called as usual
+    return (method->caller == NULL) && (argument != NULL) && (strcmp(AARRAY_POPCOUNT_NAME, method->name) == 0) &&
+        (Expression_size(argument) == 1) && isArrayOperand_(*Expression_iteratorFirst(argument));
+}
+
+static bool generatePopcountFunction_(const BitpackSize_t returnSizeBits, const VariableObjectHandle_t assignedTmpVar, const ExMethodCallHandle_t method)
+{
+    const VariableObjectHandle_t array = ExpElement_getObject(*Expression_iteratorFirst(method->parameters.expandable[0]));
+    const uint32_t words = BITFIT_ARRAY_GROUPS(array, BITPACK_WORD_BITS);
+
+    if(IS_WIDE_BITPACK(returnSizeBits))
+    {
+        // Count always fits lowest limb
+        for(uint32_t limbIdx = 1; limbIdx < WIDE_LIMBS(returnSizeBits); limbIdx++)
+        {
+            Emitter_format(&cOutput_, "%s[%u]" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "0" SEMICOLON_DEF READABILITY_ENDLINE, assignedTmpVar->objectName, limbIdx);
+        }
+
+        Emitter_format(&cOutput_, "%s[0]" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE AARRAY_POPCOUNT_DEF "(&%s[%u], %u)" SEMICOLON_DEF READABILITY_ENDLINE,
+            assignedTmpVar->objectName, array->scopeName, array->belongToGroup, words);
+
+        return SUCCESS;
+    }
+
+    Emitter_format(&cOutput_, "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE AARRAY_POPCOUNT_DEF "(&%s[%u], %u)" SEMICOLON_DEF READABILITY_ENDLINE,
+        assignedTmpVar->objectName, array->scopeName, array->belongToGroup, words);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Word with value in first lanes of array, lanes are counted from word top as positions are
+ */
+static uint64_t arrayLanesPattern_(const uint64_t value, const BitpackSize_t bitpack, const uint32_t lanes)
+{
+    const uint64_t laneValue = (bitpack < 64) ? (value & ((1ULL << bitpack) - 1)) : value;
+    uint64_t pattern = 0;
+
+    for(uint32_t laneIdx = 0; laneIdx < lanes; laneIdx++)
+    {
+        pattern |= laneValue << fieldShift_(laneIdx * bitpack, bitpack);
+    }
+
+    return pattern;
+}
+
+static bool astUsesArrays_(void)
+{
+    bool usesArrays = false;
+
+    Hashmap_forEach(&currentAst_->classVariables, arrayVariableIteratorCallback_, &usesArrays);
+    Hashmap_forEach(&currentAst_->methods, arrayMethodIteratorCallback_, &usesArrays);
+
+    return usesArrays;
+}
+
+static int arrayVariableIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    bool* usesArrays = user;
+
+    *usesArrays |= BITFIT_IS_ARRAY((VariableObjectHandle_t) value);
+
+    // Iteration stops on first array
+    return !(*usesArrays);
+}
+
+static int arrayMethodIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    const MethodObjectHandle_t method = value;
+    bool* usesArrays = user;
+
+    if(method->containsBody && !(*usesArrays))
+    {
+        Hashmap_forEach(&method->body.localVariables, arrayVariableIteratorCallback_, usesArrays);
+    }
+
+    return !(*usesArrays);
+}
+
+/**
+ * @brief Field set through runtime helper, value is computed first and then stored
+ * with straddling store or field insert instruction
+ */
+static bool fileWriteHelperVariableSet_(const VariableObjectHandle_t assignedTmpVar, const VariableObjectHandle_t leftVar, const ExpElementHandle_t right)
+{
+    const char* valueName = "_dv";
+
+    if(assignedTmpVar != NULL)
+    {
+        // Result of set is also value of expression
+        valueName = assignedTmpVar->objectName;
+        Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, valueName);
+    }else
+    {
+        Emitter_format(&cOutput_, BRACKET_START_DEF BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, valueName);
+    }
+
+    if(!printBitVariableReading_(right))
+    {
+        Log_e(TAG, "Failed to read value for variable %s", leftVar->objectName);
+        return ERROR;
+    }
+
+    if(leftVar->bitpack < BITPACK_WORD_BITS)
+    {
+        Emitter_format(&cOutput_, STRINGIFY(& MASK(%lu)), leftVar->bitpack);
+    }
+
+    EMIT_STRING(SEMICOLON_DEF READABILITY_ENDLINE);
+
+    if(BITFIT_IS_STRADDLING(leftVar, BITPACK_WORD_BITS))
+    {
+        Emitter_format(&cOutput_, ADENSE_WRITE_DEF "(&%s[%u], %u, %lu, %s)" SEMICOLON_DEF READABILITY_ENDLINE,
+            leftVar->scopeName, leftVar->belongToGroup, leftVar->posBit, leftVar->bitpack, valueName);
+    }else
+    {
+        Emitter_format(&cOutput_, "%s[%u]" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE ABMI_INSERT_DEF "(%s[%u], 0x%lxUL, %s)" SEMICOLON_DEF READABILITY_ENDLINE,
+            leftVar->scopeName, leftVar->belongToGroup, leftVar->scopeName, leftVar->belongToGroup,
+            fieldMask_(leftVar->posBit, leftVar->bitpack), valueName);
+    }
+
+    if(assignedTmpVar == NULL)
+    {
+        EMIT_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Print runtime helper converting value of given bitpack, unknown (0) bitpack takes widest
+ */
+static inline const char* printHelperName_(const BitpackSize_t bitpack)
+{
+    if(bitpack == 0 || bitpack > APRINT_U32_MAX_BITS)
+    {
+        return APRINT_U64_DEF;
+    }
+
+    return (bitpack <= APRINT_DIGIT_MAX_BITS) ? APRINT_DIGIT_DEF : APRINT_U32_DEF;
+}
+
+static inline uint8_t getBitCountU64_(uint64_t number)
 {
     uint8_t count = 0;
     while (number) {
         count++;
         number >>= 1;
     }
-    return count;
+    return count;
+}
+
+static inline uint8_t getDigitCountU64_(uint64_t number) 
+{
+    if (number < 10ULL) {return 1;}
+    if (number < 100ULL) {return 2;}
+    if (number < 1000ULL) {return 3;}
+    if (number < 10000ULL) {return 4;}
+    if (number < 100000ULL) {return 5;}
+    if (number < 1000000ULL) {return 6;}
+    if (number < 10000000ULL) {return 7;}
+    if (number < 100000000ULL) {return 8;}
+    if (number < 1000000000ULL) {return 9;}
+    if (number < 10000000000ULL) {return 10;}
+    if (number < 100000000000ULL) {return 11;}
+    if (number < 1000000000000ULL) {return 12;}
+    if (number < 10000000000000ULL) {return 13;}
+    if (number < 100000000000000ULL) {return 14;}
+    if (number < 1000000000000000ULL) {return 15;}
+    if (number < 10000000000000000ULL) {return 16;}
+    if (number < 100000000000000000ULL) {return 17;}
+    if (number < 1000000000000000000ULL) {return 18;}
+    if (number < 10000000000000000000ULL) {return 19;}
+
+    return 20;
+}
+
+
+/**
+ * @brief Field access through BMI helpers is enabled by giving target CPU,
+ * generated code itself checks if target has BMI2
+ */
+static inline bool useFieldIntrinsics_(void)
+{
+    return CompilerOptions_get()->targetArch != NULL;
+}
+
+
+static inline BitpackSize_t fieldShift_(const uint32_t posBit, const BitpackSize_t bitpack)
+{
+    return BITPACK_WORD_BITS - (posBit + bitpack);
+}
+
+
+static inline uint64_t fieldMask_(const uint32_t posBit, const BitpackSize_t bitpack)
+{
+    return LOOKUP_BIT_MASK[bitpack] << fieldShift_(posBit, bitpack);
+}
+
+static bool paramLayoutKey_(const VectorHandler_t params, const VariableObjectHandle_t returnVar, char* key)
+{
+    // Compile server keeps cache between runs which may use other word size
+    size_t keyLength = snprintf(key, PARAM_LAYOUT_KEY_LENGTH, "w%u:", CompilerOptions_get()->wordBits);
+
+    for(uint32_t paramIdx = 0; paramIdx < params->currentSize; paramIdx++)
+    {
+        keyLength += snprintf(key + keyLength, PARAM_LAYOUT_KEY_LENGTH - keyLength, "%lu,", ((VariableObjectHandle_t) params->expandable[paramIdx])->bitpack);
+
+        if(keyLength >= PARAM_LAYOUT_KEY_LENGTH)
+        {
+            return false;
+        }
+    }
+
+    keyLength += snprintf(key + keyLength, PARAM_LAYOUT_KEY_LENGTH - keyLength, "r%lu", returnVar->bitpack);
+
+    return keyLength < PARAM_LAYOUT_KEY_LENGTH;
+}
+
+static bool paramLayoutStore_(const char* key, const VectorHandler_t params, const VariableObjectHandle_t returnVar, const BitpackSize_t sizeBits)
+{
+    ParamLayoutHandle_t layout;
+
+    if(Hashmap_find(paramLayoutCache_, key, strlen(key)))
+    {
+        return SUCCESS;
+    }
+
+    ALLOC_CHECK(layout, sizeof(ParamLayout_t) + (params->currentSize + 1) * sizeof(ParamSlot_t), ERROR);
+
+    layout->sizeBits = sizeBits;
+    layout->slotsCount = params->currentSize + 1;
+
+    for(uint32_t paramIdx = 0; paramIdx < params->currentSize; paramIdx++)
+    {
+        const VariableObjectHandle_t param = (VariableObjectHandle_t) params->expandable[paramIdx];
+
+        layout->slots[paramIdx].belongToGroup = param->belongToGroup;
+        layout->slots[paramIdx].posBit = param->posBit;
+    }
+
+    layout->slots[params->currentSize].belongToGroup = returnVar->belongToGroup;
+    layout->slots[params->currentSize].posBit = returnVar->posBit;
+
+    Hashmap_set(paramLayoutCache_, key, layout);
+
+    return SUCCESS;
+}
+
+static bool paramLayoutAssign_(const VectorHandler_t params, const VariableObjectHandle_t returnVar, BitpackSize_t* sizeBits)
+{
+    char key[PARAM_LAYOUT_KEY_LENGTH];
+    const bool isCacheable = paramLayoutKey_(params, returnVar, key);
+
+    if(isCacheable && Hashmap_find(paramLayoutCache_, key, strlen(key)))
+    {
+        const ParamLayoutHandle_t layout = *(paramLayoutCache_->value);
+
+        for(uint32_t paramIdx = 0; paramIdx < params->currentSize; paramIdx++)
+        {
+            const VariableObjectHandle_t param = (VariableObjectHandle_t) params->expandable[paramIdx];
+
+            param->belongToGroup = layout->slots[paramIdx].belongToGroup;
+            param->posBit = layout->slots[paramIdx].posBit;
+        }
+
+        returnVar->belongToGroup = layout->slots[params->currentSize].belongToGroup;
+        returnVar->posBit = layout->slots[params->currentSize].posBit;
+        *sizeBits = layout->sizeBits;
+
+        return SUCCESS;
+    }
+
+    // Return variable is packed together with params, same as in method definition
+    if(!Vector_append(params, returnVar))
+    {
+        Log_e(TAG, "Failed to append to result variables");
+        return ERROR;
+    }
+
+    if(!Bitfit_assignGroupsAndPositionForVariableVector_(params, FIRST_FIT, sizeBits))
+    {
+        Log_e(TAG, "Failed to fit params bits");
+        return ERROR;
+    }
+
+    if(Vector_popLast(params) == NULL)
+    {
+        Log_e(TAG, "Failed to pop return variable");
+        return ERROR;
+    }
+
+    if(isCacheable)
+    {
+        return paramLayoutStore_(key, params, returnVar, *sizeBits);
+    }
+
+    return SUCCESS;
+}
+
+static int paramLayoutSeedIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    char layoutKey[PARAM_LAYOUT_KEY_LENGTH];
+    const MethodObjectHandle_t method = value;
+
+    NULL_GUARD(method, ERROR, Log_e(TAG, "AST method '%s' is NULL", key));
+
+    if(!paramLayoutKey_(method->parameters, method->returnVariable, layoutKey))
+    {
+        return SUCCESS;
+    }
+
+    return paramLayoutStore_(layoutKey, method->parameters, method->returnVariable, method->parametersSizeBits);
+}
+
+static bool fileWriteParamsPacking_(const VectorHandler_t params, const bool* constantParams, const AssignValue_t* constantValues, const char* psetName, const BitpackSize_t sizeBits)
+{
+    const uint32_t groupsCount = BITSCNT_TO_BYTESCNT(sizeBits);
+
+    uint64_t* groupConstants = alloca(groupsCount * sizeof(uint64_t));
+    uint32_t* groupFields = alloca(groupsCount * sizeof(uint32_t));
+
+    memset(groupConstants, 0, groupsCount * sizeof(uint64_t));
+    memset(groupFields, 0, groupsCount * sizeof(uint32_t));
+
+    for(uint32_t paramIdx = 0; paramIdx < params->currentSize; paramIdx++)
+    {
+        const VariableObjectHandle_t param = (VariableObjectHandle_t) params->expandable[paramIdx];
+
+        if(IS_WIDE_BITPACK(param->bitpack) || (param->bitpack == 0))
+        {
+            continue;
+        }
+
+        if(constantParams[paramIdx])
+        {
+            const uint64_t valueMask = (param->bitpack < LOOKUP_MASKS_COUNT) ? LOOKUP_BIT_MASK[param->bitpack] : UINT64_MAX;
+            groupConstants[param->belongToGroup] |= ((uint64_t) constantValues[paramIdx] & valueMask) << fieldShift_(param->posBit, param->bitpack);
+        }
+
+        groupFields[param->belongToGroup]++;
+    }
+
+    // Every params word is written once, constant parts of it are already combined
+    for(uint32_t groupIdx = 0; groupIdx < groupsCount; groupIdx++)
+    {
+        bool isFirstPart = true;
+
+        if(groupFields[groupIdx] == 0)
+        {
+            continue;
+        }
+
+        Emitter_format(&cOutput_, "%s[%u]" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, psetName, groupIdx);
+
+        for(uint32_t paramIdx = 0; paramIdx < params->currentSize; paramIdx++)
+        {
+            const VariableObjectHandle_t param = (VariableObjectHandle_t) params->expandable[paramIdx];
+
+            if(IS_WIDE_BITPACK(param->bitpack) || (param->bitpack == 0) || constantParams[paramIdx] || (param->belongToGroup != groupIdx))
+            {
+                continue;
+            }
+
+            if(!isFirstPart)
+            {
+                EMIT_STRING(READABILITY_SPACE C_OPERATOR_BIN_OR_DEF READABILITY_SPACE);
+            }
+
+            Emitter_format(&cOutput_, STRINGIFY(((%s) << (BIT_SIZE_BITPACK - (%u + %lu)))), param->objectName, param->posBit, param->bitpack);
+            isFirstPart = false;
+        }
+
+        if(isFirstPart)
+        {
+            Emitter_format(&cOutput_, "0x%lxUL", groupConstants[groupIdx]);
+        }else if(groupConstants[groupIdx] != 0)
+        {
+            Emitter_format(&cOutput_, READABILITY_SPACE C_OPERATOR_BIN_OR_DEF READABILITY_SPACE "0x%lxUL", groupConstants[groupIdx]);
+        }
+
+        EMIT_STRING(SEMICOLON_DEF READABILITY_ENDLINE);
+    }
+
+    // Wide params keep bits of their last word, so they go after whole words are written
+    for(uint32_t paramIdx = 0; paramIdx < params->currentSize; paramIdx++)
+    {
+        const VariableObjectHandle_t param = (VariableObjectHandle_t) params->expandable[paramIdx];
+
+        if(IS_WIDE_BITPACK(param->bitpack))
+        {
+            Emitter_format(&cOutput_, AWIDE_STORE_DEF "(&%s[%u], %lu, %lu, %s)" SEMICOLON_DEF READABILITY_ENDLINE,
+                psetName, param->belongToGroup, WIDE_LIMBS(param->bitpack), WIDE_TOP_BITS(param->bitpack), param->objectName);
+        }
+    }
+
+    return SUCCESS;
+}
+
+static inline uint32_t registerPackWords_(const MethodObjectHandle_t method)
+{
+    if((CompilerOptions_get()->callAbi != CALL_ABI_REGISTER) ||
+       ((method->parameters->currentSize == 0) && (method->returnVariable->bitpack == 0)))
+    {
+        return 0;
+    }
+
+    const uint32_t words = (method->parametersSizeBits == 0) ? 1 : BITFIT_LIMBS_COUNT(method->parametersSizeBits, BITPACK_WORD_BITS);
+
+    // Bigger signatures stay in memory region passed by pointer
+    return (words <= REGISTER_PACK_WORDS) ? words : 0;
+}
+
+static bool fileWriteRegisterPackReturn_(const uint32_t registerWords)
+{
+    EMIT_STRING(RETURN_DEF " " BRACKET_ROUND_START_DEF REGISTER_PACK_TYPE_NAME BRACKET_ROUND_END_DEF BRACKET_START_DEF BRACKET_START_DEF);
+
+    for(uint32_t wordIdx = 0; wordIdx < registerWords; wordIdx++)
+    {
+        Emitter_format(&cOutput_, "%s" FUNCTION_PARAM_NAME "[%u]", (wordIdx > 0) ? COMMA_DEF READABILITY_SPACE : "", wordIdx);
+    }
+
+    EMIT_STRING(BRACKET_END_DEF BRACKET_END_DEF SEMICOLON_DEF READABILITY_ENDLINE);
+
+    return SUCCESS;
+}
+
+static bool isInlineCandidate_(const MethodObjectHandle_t method)
+{
+    size_t elementsCount = 0;
+
+    if(!method->containsBody || method->hasInfinityParams || (method->accessType == IGNORED))
+    {
+        return false;
+    }
+
+    // Inlined body has no exit of its own where dh objects could be given back
+    if(methodPlacesObjects_(method))
+    {
+        return false;
+    }
+
+    if(method->isInline)
+    {
+        return true;
+    }
+
+    for(uint64_t scopeElementIndex = 0; scopeElementIndex < method->body.scopeElementsList.currentSize; scopeElementIndex++)
+    {
+        const ExpHandle_t expression = method->body.scopeElementsList.expandable[scopeElementIndex];
+
+        // Size of loop is not its elements count, such methods are inlined only when asked
+        if(expression->loopBody != NULL)
+        {
+            return false;
+        }
+
+        elementsCount += Expression_size(expression);
+    }
+
+    return (elementsCount <= INLINE_SIZE_LIMIT);
+}
+
+static MethodObjectHandle_t findInlineCallee_(const ExMethodCallHandle_t call, const VectorHandler_t args, const BitpackSize_t returnSizeBits)
+{
+    // Other objects are generated from their own files, so their bodies are not known here
+    if((call->caller != NULL) || !Hashmap_find(&currentAst_->methods, call->name, strlen(call->name)))
+    {
+        return NULL;
+    }
+
+    const MethodObjectHandle_t method = *(currentAst_->methods.value);
+
+    if(!isInlineCandidate_(method) || (method->parameters->currentSize != args->currentSize) ||
+       (method->returnVariable->bitpack != returnSizeBits))
+    {
+        return NULL;
+    }
+
+    // Call with other signature is resolved to other mangled method, it is left for linker
+    for(uint32_t paramIdx = 0; paramIdx < args->currentSize; paramIdx++)
+    {
+        if(((VariableObjectHandle_t) method->parameters->expandable[paramIdx])->bitpack != ((VariableObjectHandle_t) args->expandable[paramIdx])->bitpack)
+        {
+            return NULL;
+        }
+    }
+
+    return method;
+}
+
+static bool canExpandInline_(const MethodObjectHandle_t method)
+{
+    if(inlineDepth_ >= INLINE_MAX_DEPTH)
+    {
+        return false;
+    }
+
+    // Recursive calls are not expanded, they call static inline body instead
+    for(uint32_t depthIdx = 0; depthIdx < inlineDepth_; depthIdx++)
+    {
+        if(inlineStack_[depthIdx] == method)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool fileWriteInlinedMethodBody_(const MethodObjectHandle_t method, const char* psetName)
+{
+    static int64_t inlineLabelCounter = 0;
+
+    VariableObject_t resultVar;
+    const int64_t outerInlineLabel = currentInlineLabel_;
+    const uint32_t outerRegisterWords = currentMethodRegisterWords_;
+    const int64_t inlineLabel = inlineLabelCounter++;
+
+    resultVar.objectName = "";
+
+    EMIT_STRING(BRACKET_START_DEF READABILITY_ENDLINE);
+
+    // Callee body is generated as is, its params and locals names are shadowed by call site ones
+    if(psetName != NULL)
+    {
+        Emitter_format(&cOutput_, PARAM_TYPE_DEF " " FUNCTION_PARAM_NAME READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "%spset" SEMICOLON_DEF READABILITY_ENDLINE, psetName);
+    }
+
+    if(!fileWriteVariablesAllocation_(method->body.sizeBits, LOCAL_VAR_REGION_NAME))
+    {
+        Log_e(TAG, "Failed to write inlined method scope variables");
+        return ERROR;
+    }
+
+    inlineStack_[inlineDepth_++] = method;
+    currentInlineLabel_ = inlineLabel;
+    currentMethodRegisterWords_ = 0;
+
+    for(uint64_t scopeElementIndex = 0; scopeElementIndex < method->body.scopeElementsList.currentSize; scopeElementIndex++)
+    {
+        if(!filewriteExpression_(method->body.scopeElementsList.expandable[scopeElementIndex], method, &resultVar, scopeElementIndex))
+        {
+            Log_e(TAG, "Failed to write inlined scope expression");
+            return ERROR;
+        }
+    }
+
+    inlineDepth_--;
+    currentInlineLabel_ = outerInlineLabel;
+    currentMethodRegisterWords_ = outerRegisterWords;
+
+    Emitter_format(&cOutput_, INLINE_END_LABEL "%ld:" SEMICOLON_DEF READABILITY_ENDLINE BRACKET_END_DEF READABILITY_ENDLINE, inlineLabel);
+
+    return SUCCESS;
+}
+
+static bool fileWriteMethodArguments_(const MethodObjectHandle_t method, const BitpackSize_t callerObjectBitsize)
+{
+    const uint32_t registerWords = registerPackWords_(method);
+    const bool hasParams = (method->parameters->currentSize > 0) || (method->returnVariable->bitpack > 0);
+
+    Emitter_format(&cOutput_, INLINE_FUNCTION_PREFIX "%s" BRACKET_ROUND_START_DEF, method->methodName);
+
+    if(callerObjectBitsize > 0)
+    {
+        Emitter_format(&cOutput_, FUNCTION_OBJ_NAME "%s", hasParams ? COMMA_DEF READABILITY_SPACE : "");
+    }
+
+    if(registerWords > 0)
+    {
+        for(uint32_t wordIdx = 0; wordIdx < registerWords; wordIdx++)
+        {
+            Emitter_format(&cOutput_, "%s" FUNCTION_PARAM_NAME "%u", (wordIdx > 0) ? COMMA_DEF READABILITY_SPACE : "", wordIdx);
+        }
+
+    }else if(hasParams)
+    {
+        EMIT_STRING(FUNCTION_PARAM_NAME);
+    }
+
+    EMIT_STRING(BRACKET_ROUND_END_DEF);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Loop is C block of its own: repeat count is evaluated once before it, when condition
+ * before every pass. Packed variables used by loop are extracted once into plain words (registers)
+ * before loop and written back after it, so passes do not decode and encode them again
+ *
+ * @param[in] loop      REPEAT_LOOP or WHEN_LOOP expression, its elements are count or condition
+ * @param[in] method    method which body is generated
+ * @param[in] resVar    result variable passed to body statements
+ *
+ * @return              Success state
+ */
+static bool fileWriteLoop_(const ExpHandle_t loop, const MethodObjectHandle_t method, VariableObjectHandle_t resVar)
+{
+    static uint64_t loopCounter = 0;
+
+    const uint64_t loopId = loopCounter++;
+    const uint32_t outerRegistersCount = loopRegistersCount_;
+    const bool isRepeat = (Expression_getType(loop) == REPEAT_LOOP);
+
+    VariableObject_t valueVar;
+    char valueName[LOOP_REGISTER_NAME_LENGTH];
+
+    snprintf(valueName, sizeof(valueName), LOOP_PREFIX "%luv", loopId);
+
+    valueVar.objectName = valueName;
+    valueVar.arrayLength = 0;
+
+    EMIT_STRING(BRACKET_START_DEF READABILITY_ENDLINE);
+
+    if(isRepeat)
+    {
+        if(!fileWriteSimpleLine_(loop, &valueVar, "_"))
+        {
+            Log_e(TAG, "Failed to write loop count");
+            return ERROR;
+        }
+
+        Emitter_format(&cOutput_, "uint64_t " LOOP_PREFIX "%luc" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE, loopId);
+
+        if(!fileWriteLoopValue_(&valueVar, true))
+        {
+            return ERROR;
+        }
+
+        EMIT_STRING(SEMICOLON_DEF READABILITY_ENDLINE);
+    }
+
+    // Count is evaluated before registers of this loop exist, condition on every pass with them
+    if(!fileWriteLoopRegisters_(loop, loopId))
+    {
+        Log_e(TAG, "Failed to write loop registers");
+        return ERROR;
+    }
+
+    if(isRepeat)
+    {
+        Emitter_format(&cOutput_, "for(;" READABILITY_SPACE LOOP_PREFIX "%luc > 0" SEMICOLON_DEF READABILITY_SPACE LOOP_PREFIX "%luc--)" READABILITY_ENDLINE BRACKET_START_DEF READABILITY_ENDLINE,
+            loopId, loopId);
+    }else
+    {
+        EMIT_STRING("for(;;)" READABILITY_ENDLINE BRACKET_START_DEF READABILITY_ENDLINE);
+
+        if(!fileWriteSimpleLine_(loop, &valueVar, "_"))
+        {
+            Log_e(TAG, "Failed to write loop condition");
+            return ERROR;
+        }
+
+        EMIT_STRING("if(!(");
+
+        if(!fileWriteLoopValue_(&valueVar, false))
+        {
+            return ERROR;
+        }
+
+        EMIT_STRING(")) break" SEMICOLON_DEF READABILITY_ENDLINE);
+    }
+
+    for(uint64_t bodyElementIndex = 0; bodyElementIndex < loop->loopBody->currentSize; bodyElementIndex++)
+    {
+        if(!filewriteExpression_(loop->loopBody->expandable[bodyElementIndex], method, resVar, bodyElementIndex))
+        {
+            Log_e(TAG, "Failed to write loop body expression");
+            return ERROR;
+        }
+    }
+
+    EMIT_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
+
+    if(!fileWriteLoopWriteBack_(outerRegistersCount, false))
+    {
+        Log_e(TAG, "Failed to write back loop registers");
+        return ERROR;
+    }
+
+    loopRegistersCount_ = outerRegistersCount;
+
+    EMIT_STRING(BRACKET_END_DEF READABILITY_ENDLINE);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Writes loop count or condition value as one C value. Wide count is composed from limbs
+ * fitting 64 bits, wide condition is true when any of its limbs is non zero
+ */
+static bool fileWriteLoopValue_(const VariableObjectHandle_t value, const bool isCount)
+{
+    if(!IS_WIDE_BITPACK(value->bitpack))
+    {
+        return Emitter_format(&cOutput_, "%s", value->objectName) > 0;
+    }
+
+    for(uint32_t limbIdx = 0; limbIdx < WIDE_LIMBS(value->bitpack); limbIdx++)
+    {
+        const char* separator = (limbIdx > 0) ? READABILITY_SPACE C_OPERATOR_BIN_OR_DEF READABILITY_SPACE : "";
+
+        if(!isCount)
+        {
+            Emitter_format(&cOutput_, "%s%s[%u]", separator, value->objectName, limbIdx);
+        }else if(limbIdx * BITPACK_WORD_BITS < 64)
+        {
+            Emitter_format(&cOutput_, "%s((uint64_t) %s[%u] << %lu)", separator, value->objectName, limbIdx, limbIdx * BITPACK_WORD_BITS);
+        }
+    }
+
+    return SUCCESS;
 }
 
-static inline uint8_t getDigitCountU64_(uint64_t number) 
+/**
+ * @brief Declares registers of loop, most used variables first. Variables not written by loop
+ * are invariant, their registers are const and only hold field extracted once
+ */
+static bool fileWriteLoopRegisters_(const ExpHandle_t loop, const uint64_t loopId)
 {
-    if (number < 10ULL) {return 1;}
-    if (number < 100ULL) {return 2;}
-    if (number < 1000ULL) {return 3;}
-    if (number < 10000ULL) {return 4;}
-    if (number < 100000ULL) {return 5;}
-    if (number < 1000000ULL) {return 6;}
-    if (number < 10000000ULL) {return 7;}
-    if (number < 100000000ULL) {return 8;}
-    if (number < 1000000000ULL) {return 9;}
-    if (number < 10000000000ULL) {return 10;}
-    if (number < 100000000000ULL) {return 11;}
-    if (number < 1000000000000ULL) {return 12;}
-    if (number < 10000000000000ULL) {return 13;}
-    if (number < 100000000000000ULL) {return 14;}
-    if (number < 1000000000000000ULL) {return 15;}
-    if (number < 10000000000000000ULL) {return 16;}
-    if (number < 100000000000000000ULL) {return 17;}
-    if (number < 1000000000000000000ULL) {return 18;}
-    if (number < 10000000000000000000ULL) {return 19;}
+    LoopAnalysis_t analysis;
 
-    return 20;
-}
\ No newline at end of file
+    if(!LoopAnalysis_collect(&analysis, loop))
+    {
+        Log_e(TAG, "Failed to analyse loop variables");
+        return ERROR;
+    }
+
+    for(uint32_t registerIdx = 0; (registerIdx < LOOP_REGISTERS_LIMIT) && (loopRegistersCount_ < LOOP_REGISTERS_MAX); registerIdx++)
+    {
+        LoopVariableUseHandle_t chosenUse = NULL;
+
+        for(uint32_t useIdx = 0; useIdx < analysis.usesCount; useIdx++)
+        {
+            const LoopVariableUseHandle_t use = &analysis.uses[useIdx];
+
+            if(isLoopRegisterCandidate_(use, analysis.callsOwnMethods) &&
+               ((chosenUse == NULL) || (use->readCount + use->writeCount > chosenUse->readCount + chosenUse->writeCount)))
+            {
+                chosenUse = use;
+            }
+        }
+
+        if(chosenUse == NULL)
+        {
+            break;
+        }
+
+        const LoopRegisterHandle_t loopRegister = &loopRegisters_[loopRegistersCount_];
+        ExpElement_t operand;
+
+        loopRegister->variable = chosenUse->variable;
+        loopRegister->isWritten = (chosenUse->writeCount > 0);
+        snprintf(loopRegister->name, sizeof(loopRegister->name), LOOP_PREFIX "%lur%u", loopId, registerIdx);
+
+        ExpElement_set(&operand, EXP_VARIABLE, chosenUse->variable);
+
+        Emitter_format(&cOutput_, "%s" BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE,
+            loopRegister->isWritten ? "" : "const ", loopRegister->name);
+
+        // Register is not active yet, so value is read from variable words
+        if(!printBitVariableReading_(&operand))
+        {
+            LoopAnalysis_destroy(&analysis);
+            return ERROR;
+        }
+
+        EMIT_STRING(SEMICOLON_DEF READABILITY_ENDLINE);
+
+        loopRegistersCount_++;
+    }
+
+    LoopAnalysis_destroy(&analysis);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Writes changed registers back to their variables words
+ *
+ * @param[in] firstRegister     first register to write, registers of outer loops are before it
+ * @param[in] objectOnly        only object variables, locals and params are not seen after return
+ *
+ * @return                      Success state
+ */
+static bool fileWriteLoopWriteBack_(const uint32_t firstRegister, const bool objectOnly)
+{
+    const uint32_t registersCount = loopRegistersCount_;
+    bool status = SUCCESS;
+
+    // Registers are not looked up while they are written back
+    loopRegistersCount_ = 0;
+
+    for(uint32_t registerIdx = firstRegister; (registerIdx < registersCount) && status; registerIdx++)
+    {
+        const LoopRegisterHandle_t loopRegister = &loopRegisters_[registerIdx];
+        VariableObject_t registerVar;
+        ExpElement_t leftOperand;
+        ExpElement_t rightOperand;
+
+        if(!loopRegister->isWritten || (objectOnly && (strcmp(loopRegister->variable->scopeName, CLASS_VAR_REGION_NAME) != 0)))
+        {
+            continue;
+        }
+
+        registerVar = *loopRegister->variable;
+        registerVar.objectName = loopRegister->name;
+
+        ExpElement_set(&leftOperand, EXP_VARIABLE, loopRegister->variable);
+        ExpElement_set(&rightOperand, EXP_TMP_VAR, &registerVar);
+
+        status = fileWriteBitVariableSet_(NULL, &leftOperand, &rightOperand);
+    }
+
+    loopRegistersCount_ = registersCount;
+
+    return status;
+}
+
+static bool fileWriteLoopRegisterSet_(const VariableObjectHandle_t assignedTmpVar, const LoopRegisterHandle_t loopRegister, const ExpElementHandle_t right)
+{
+    const BitpackSize_t bitpack = loopRegister->variable->bitpack;
+
+    Emitter_format(&cOutput_, "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE BRACKET_ROUND_START_DEF, loopRegister->name);
+
+    if(!printBitVariableReading_(right))
+    {
+        Log_e(TAG, "Failed to read value for loop register of %s", loopRegister->variable->objectName);
+        return ERROR;
+    }
+
+    // Register holds value as variable would, without bits above its bitpack
+    if(bitpack < BITPACK_WORD_BITS)
+    {
+        Emitter_format(&cOutput_, STRINGIFY(& MASK(%lu)), bitpack);
+    }
+
+    EMIT_STRING(BRACKET_ROUND_END_DEF SEMICOLON_DEF READABILITY_ENDLINE);
+
+    if(assignedTmpVar != NULL)
+    {
+        Emitter_format(&cOutput_, BITPACK_TYPE_NAME " %s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE "%s" SEMICOLON_DEF READABILITY_ENDLINE,
+            assignedTmpVar->objectName, loopRegister->name);
+    }
+
+    return SUCCESS;
+}
+
+static bool isLoopRegisterCandidate_(const LoopVariableUseHandle_t use, const bool callsOwnMethods)
+{
+    const VariableObjectHandle_t variable = use->variable;
+
+    // Objects are passed by pointer, arrays are handled as whole words and wide values as limbs
+    if((variable->scopeName == NULL) || (variable->castedFile != NULL) || BITFIT_IS_ARRAY(variable) || (variable->arrayOwner != NULL) ||
+       (variable->bitpack == 0) || IS_WIDE_BITPACK(variable->bitpack) || (loopRegisterOf_(variable) != NULL))
+    {
+        return false;
+    }
+
+    // Other methods of object read and write its words, not registers of this loop
+    return !callsOwnMethods || (strcmp(variable->scopeName, CLASS_VAR_REGION_NAME) != 0);
+}
+
+static LoopRegisterHandle_t loopRegisterOf_(const VariableObjectHandle_t variable)
+{
+    for(uint32_t registerIdx = loopRegistersCount_; registerIdx > 0; registerIdx--)
+    {
+        if(loopRegisters_[registerIdx - 1].variable == variable)
+        {
+            return &loopRegisters_[registerIdx - 1];
+        }
+    }
+
+    return NULL;
+}
+
+static uint32_t astUsedAllocations_(void)
+{
+    uint32_t usedAllocations = 0;
+
+    Hashmap_forEach(&currentAst_->methods, allocationMethodIteratorCallback_, &usedAllocations);
+
+    return usedAllocations;
+}
+
+static int allocationVariableIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    uint32_t* usedAllocations = user;
+
+    *usedAllocations |= (1u << ((VariableObjectHandle_t) value)->allocation);
+
+    return SUCCESS;
+}
+
+static int allocationMethodIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    const MethodObjectHandle_t method = value;
+
+    if(method->containsBody)
+    {
+        Hashmap_forEach(&method->body.localVariables, allocationVariableIteratorCallback_, user);
+    }
+
+    return SUCCESS;
+}
+
+static bool methodPlacesObjects_(const MethodObjectHandle_t method)
+{
+    uint32_t usedAllocations = 0;
+
+    Hashmap_forEach(&method->body.localVariables, allocationVariableIteratorCallback_, &usedAllocations);
+
+    return (usedAllocations & ~(1u << ALLOCATION_STATIC_STACK)) != 0;
+}
+
+static int objectAllocationIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    const VariableObjectHandle_t variable = value;
+    int status;
+
+    if(variable->allocation == ALLOCATION_DYNAMIC_STACK)
+    {
+        status = Emitter_format(&cOutput_, BITPACK_TYPE_NAME "* const " AALLOC_OBJECT_PREFIX "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE
+            AALLOC_STACK_DEF "(sizeof(" BITPACK_TYPE_NAME "[%lu]))" SEMICOLON_DEF READABILITY_ENDLINE,
+            variable->objectName, BITSCNT_TO_BYTESCNT(variable->bitpack));
+
+    }else if(variable->allocation == ALLOCATION_DYNAMIC_HEAP)
+    {
+        char poolName[POOL_NAME_LENGTH + 1];
+
+        poolNameOf_(variable, poolName);
+
+        status = Emitter_format(&cOutput_, BITPACK_TYPE_NAME "* const " AALLOC_OBJECT_PREFIX "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE
+            AALLOC_POOL_ALLOC_DEF "(&%s, sizeof(" BITPACK_TYPE_NAME "[%lu]))" SEMICOLON_DEF READABILITY_ENDLINE,
+            variable->objectName, poolName, BITSCNT_TO_BYTESCNT(variable->bitpack));
+    }else
+    {
+        return SUCCESS;
+    }
+
+    return (status >= 0);
+}
+
+static int heapObjectIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    // ds words go away with frame, only dh ones are given back
+    if(((VariableObjectHandle_t) value)->allocation != ALLOCATION_DYNAMIC_HEAP)
+    {
+        return SUCCESS;
+    }
+
+    return Vector_append((VectorHandler_t) user, value);
+}
+
+static bool collectHeapObjects_(const MethodObjectHandle_t method, VectorHandler_t objects)
+{
+    InitialSettings_t settingVector;
+
+    settingVector.containsVectors = false;
+    settingVector.expandableConstant = EXPANDABLE_CONSTANT_DEFAULT;
+    settingVector.initialSize = 4;
+
+    if(!Vector_create(objects, &settingVector))
+    {
+        Log_e(TAG, "Failed to create dh objects vector");
+        return ERROR;
+    }
+
+    if(!Hashmap_forEach(&method->body.localVariables, heapObjectIteratorCallback_, objects))
+    {
+        free(objects->expandable);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Gives dh objects of method back to their pools. Objects of same type are linked
+ * through their first word into one chain, which is put on free list with single store
+ */
+static bool fileWriteObjectReleases_(const MethodObjectHandle_t method)
+{
+    Vector_t objects;
+
+    if(!collectHeapObjects_(method, &objects))
+    {
+        return ERROR;
+    }
+
+    bool* released = calloc(objects.currentSize + 1, sizeof(bool));
+
+    if(released == NULL)
+    {
+        free(objects.expandable);
+        return ERROR;
+    }
+
+    for(size_t objectIdx = 0; objectIdx < objects.currentSize; objectIdx++)
+    {
+        const VariableObjectHandle_t first = objects.expandable[objectIdx];
+        VariableObjectHandle_t last = first;
+        char poolName[POOL_NAME_LENGTH + 1];
+
+        if(released[objectIdx])
+        {
+            continue;
+        }
+
+        for(size_t nextIdx = objectIdx + 1; nextIdx < objects.currentSize; nextIdx++)
+        {
+            const VariableObjectHandle_t next = objects.expandable[nextIdx];
+
+            if(!released[nextIdx] && isSameObjectType_(first, next))
+            {
+                Emitter_format(&cOutput_, "*(void**) " AALLOC_OBJECT_PREFIX "%s" READABILITY_SPACE C_OPERATOR_EQUAL_DEF READABILITY_SPACE AALLOC_OBJECT_PREFIX "%s" SEMICOLON_DEF READABILITY_ENDLINE,
+                    last->objectName, next->objectName);
+
+                released[nextIdx] = true;
+                last = next;
+            }
+        }
+
+        poolNameOf_(first, poolName);
+
+        if(last == first)
+        {
+            Emitter_format(&cOutput_, AALLOC_POOL_FREE_DEF "(&%s, " AALLOC_OBJECT_PREFIX "%s)" SEMICOLON_DEF READABILITY_ENDLINE, poolName, first->objectName);
+        }else
+        {
+            Emitter_format(&cOutput_, AALLOC_POOL_FREE_BULK_DEF "(&%s, " AALLOC_OBJECT_PREFIX "%s, " AALLOC_OBJECT_PREFIX "%s)" SEMICOLON_DEF READABILITY_ENDLINE,
+                poolName, first->objectName, last->objectName);
+        }
+    }
+
+    free(released);
+    free(objects.expandable);
+
+    return SUCCESS;
+}
+
+static bool fileWritePoolDeclarations_(void)
+{
+    HashmapHandle_t declaredPools;
+    bool status;
+
+    ALLOC_CHECK(declaredPools, sizeof(Hashmap_t), ERROR);
+
+    if(!Hashmap_new(declaredPools, 8))
+    {
+        free(declaredPools);
+        return ERROR;
+    }
+
+    status = Hashmap_forEach(&currentAst_->methods, poolDeclarationIteratorCallback_, declaredPools);
+
+    Hashmap_delete(declaredPools);
+
+    return status;
+}
+
+static int poolDeclarationIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    const MethodObjectHandle_t method = value;
+    Vector_t objects;
+
+    if(!method->containsBody)
+    {
+        return SUCCESS;
+    }
+
+    if(!collectHeapObjects_(method, &objects))
+    {
+        return ERROR;
+    }
+
+    for(size_t objectIdx = 0; objectIdx < objects.currentSize; objectIdx++)
+    {
+        char poolName[POOL_NAME_LENGTH + 1];
+
+        poolNameOf_(objects.expandable[objectIdx], poolName);
+
+        // Same type may be placed by several methods, pool is declared once per file
+        if(!Hashmap_add((HashmapHandle_t) user, poolName, strlen(poolName)))
+        {
+            Emitter_format(&cOutput_, "__attribute__((weak)) " AALLOC_POOL_TYPE_DEF " %s" SEMICOLON_DEF END_LINE_DEF, poolName);
+        }
+    }
+
+    free(objects.expandable);
+
+    return SUCCESS;
+}
+
+static inline bool isSameObjectType_(const VariableObjectHandle_t first, const VariableObjectHandle_t second)
+{
+    return (first->bitpack == second->bitpack) && (strcmp(first->castedFile, second->castedFile) == 0);
+}
+
+static inline void poolNameOf_(const VariableObjectHandle_t variable, char* name)
+{
+    snprintf(name, POOL_NAME_LENGTH + 1, AALLOC_POOL_PREFIX "bit%lu_%s", variable->bitpack, variable->castedFile);
+}
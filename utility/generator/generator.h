@@ -20,9 +20,17 @@
 #include <stdio.h>
 #include "../global_config/global_config.h"
 #include "../compiler/compiler.h"
+#include "../parser/structures/expression/expressions.h"
+#include <emitter.h>
 
-#define FOUT_BUFFER_LENGTH          1024
+#define OUTPUT_BUFFER_INITIAL_LENGTH    65536
 
 bool Generator_generateCode(const MainFrameHandle_t ast, const char* dstCFileName, const bool isFirstFile);
+bool Generator_getCode(const char** code, size_t* length);
+bool Generator_loadCode(const char* code, const size_t length, const char* dstCFileName);
+bool Generator_emitMangledName(EmitterHandle_t output, const char* className, const BitpackSize_t objectSizeBits, const char* methodName,
+    const BitpackSize_t returnBits, const bool isRegisterAbi, const VectorHandler_t params, const size_t paramsCount);
+bool Generator_foldConstants(const AssignValue_t left, const AssignValue_t right, const OperatorType_t operator, AssignValue_t* value);
+bool Generator_isConstantExpression(const ExpHandle_t expression, AssignValue_t* value);
 
 #endif // UTILITY_GENERATOR_GENERATOR_H_
\ No newline at end of file
@@ -19,154 +19,151 @@
 #include <arch_specific.h>
 #include "csyntax_database.h"
 
-#define MASK(bit_count) ((((BIT_TYPE_EXP) 0x1) << bit_count) - 1)
+// Masks used in generated code, Bitpack_t there is word of chosen size
+#define MASK(bit_count) ((((BITPACK_TYPE_EXP) 0x1) << bit_count) - 1)
 #define INVERTED_MASK(bit_count) (~MASK(bit_count))
 
-static const BIT_TYPE_EXP LOOKUP_BIT_MASK[ARCHITECTURE_DEFAULT_BITS] = 
+// Masks used by compiler itself, same for any word size up to 64 bits
+#define LOOKUP_MASKS_COUNT          64
+#define LOOKUP_MASK(bit_count) ((((uint64_t) 0x1) << bit_count) - 1)
 
-#if ARCHITECTURE_DEFAULT_BITS == 64
+static const uint64_t LOOKUP_BIT_MASK[LOOKUP_MASKS_COUNT] = 
 {
-    MASK(0),
-    MASK(1),
-    MASK(2),
-    MASK(3),
-    MASK(4),
-    MASK(5),
-    MASK(6),
-    MASK(7),
-    MASK(8),
-    MASK(9),
-    MASK(10),
-    MASK(11),
-    MASK(12),
-    MASK(13),
-    MASK(14),
-    MASK(15),
-    MASK(16),
-    MASK(17),
-    MASK(18),
-    MASK(19),
-    MASK(20),
-    MASK(21),
-    MASK(22),
-    MASK(23),
-    MASK(24),
-    MASK(25),
-    MASK(26),
-    MASK(27),
-    MASK(28),
-    MASK(29),
-    MASK(30),
-    MASK(31),
-    MASK(32),
-    MASK(33),
-    MASK(34),
-    MASK(35),
-    MASK(36),
-    MASK(37),
-    MASK(38),
-    MASK(39),
-    MASK(40),
-    MASK(41),
-    MASK(42),
-    MASK(43),
-    MASK(44),
-    MASK(45),
-    MASK(46),
-    MASK(47),
-    MASK(48),
-    MASK(49),
-    MASK(50),
-    MASK(51),
-    MASK(52),
-    MASK(53),
-    MASK(54),
-    MASK(55),
-    MASK(56),
-    MASK(57),
-    MASK(58),
-    MASK(59),
-    MASK(50),
-    MASK(61),
-    MASK(62),
-    MASK(63)
+    LOOKUP_MASK(0),
+    LOOKUP_MASK(1),
+    LOOKUP_MASK(2),
+    LOOKUP_MASK(3),
+    LOOKUP_MASK(4),
+    LOOKUP_MASK(5),
+    LOOKUP_MASK(6),
+    LOOKUP_MASK(7),
+    LOOKUP_MASK(8),
+    LOOKUP_MASK(9),
+    LOOKUP_MASK(10),
+    LOOKUP_MASK(11),
+    LOOKUP_MASK(12),
+    LOOKUP_MASK(13),
+    LOOKUP_MASK(14),
+    LOOKUP_MASK(15),
+    LOOKUP_MASK(16),
+    LOOKUP_MASK(17),
+    LOOKUP_MASK(18),
+    LOOKUP_MASK(19),
+    LOOKUP_MASK(20),
+    LOOKUP_MASK(21),
+    LOOKUP_MASK(22),
+    LOOKUP_MASK(23),
+    LOOKUP_MASK(24),
+    LOOKUP_MASK(25),
+    LOOKUP_MASK(26),
+    LOOKUP_MASK(27),
+    LOOKUP_MASK(28),
+    LOOKUP_MASK(29),
+    LOOKUP_MASK(30),
+    LOOKUP_MASK(31),
+    LOOKUP_MASK(32),
+    LOOKUP_MASK(33),
+    LOOKUP_MASK(34),
+    LOOKUP_MASK(35),
+    LOOKUP_MASK(36),
+    LOOKUP_MASK(37),
+    LOOKUP_MASK(38),
+    LOOKUP_MASK(39),
+    LOOKUP_MASK(40),
+    LOOKUP_MASK(41),
+    LOOKUP_MASK(42),
+    LOOKUP_MASK(43),
+    LOOKUP_MASK(44),
+    LOOKUP_MASK(45),
+    LOOKUP_MASK(46),
+    LOOKUP_MASK(47),
+    LOOKUP_MASK(48),
+    LOOKUP_MASK(49),
+    LOOKUP_MASK(50),
+    LOOKUP_MASK(51),
+    LOOKUP_MASK(52),
+    LOOKUP_MASK(53),
+    LOOKUP_MASK(54),
+    LOOKUP_MASK(55),
+    LOOKUP_MASK(56),
+    LOOKUP_MASK(57),
+    LOOKUP_MASK(58),
+    LOOKUP_MASK(59),
+    LOOKUP_MASK(60),
+    LOOKUP_MASK(61),
+    LOOKUP_MASK(62),
+    LOOKUP_MASK(63)
 };
 
-#endif
 
-
-static const BIT_TYPE_EXP LOOKUP_BIT_MASK_INVERTED[ARCHITECTURE_DEFAULT_BITS] = 
-
-#if ARCHITECTURE_DEFAULT_BITS == 64
+static const uint64_t LOOKUP_BIT_MASK_INVERTED[LOOKUP_MASKS_COUNT] = 
 {
-    INVERTED_MASK(0),
-    INVERTED_MASK(1),
-    INVERTED_MASK(2),
-    INVERTED_MASK(3),
-    INVERTED_MASK(4),
-    INVERTED_MASK(5),
-    INVERTED_MASK(6),
-    INVERTED_MASK(7),
-    INVERTED_MASK(8),
-    INVERTED_MASK(9),
-    INVERTED_MASK(10),
-    INVERTED_MASK(11),
-    INVERTED_MASK(12),
-    INVERTED_MASK(13),
-    INVERTED_MASK(14),
-    INVERTED_MASK(15),
-    INVERTED_MASK(16),
-    INVERTED_MASK(17),
-    INVERTED_MASK(18),
-    INVERTED_MASK(19),
-    INVERTED_MASK(20),
-    INVERTED_MASK(21),
-    INVERTED_MASK(22),
-    INVERTED_MASK(23),
-    INVERTED_MASK(24),
-    INVERTED_MASK(25),
-    INVERTED_MASK(26),
-    INVERTED_MASK(27),
-    INVERTED_MASK(28),
-    INVERTED_MASK(29),
-    INVERTED_MASK(30),
-    INVERTED_MASK(31),
-    INVERTED_MASK(32),
-    INVERTED_MASK(33),
-    INVERTED_MASK(34),
-    INVERTED_MASK(35),
-    INVERTED_MASK(36),
-    INVERTED_MASK(37),
-    INVERTED_MASK(38),
-    INVERTED_MASK(39),
-    INVERTED_MASK(40),
-    INVERTED_MASK(41),
-    INVERTED_MASK(42),
-    INVERTED_MASK(43),
-    INVERTED_MASK(44),
-    INVERTED_MASK(45),
-    INVERTED_MASK(46),
-    INVERTED_MASK(47),
-    INVERTED_MASK(48),
-    INVERTED_MASK(49),
-    INVERTED_MASK(50),
-    INVERTED_MASK(51),
-    INVERTED_MASK(52),
-    INVERTED_MASK(53),
-    INVERTED_MASK(54),
-    INVERTED_MASK(55),
-    INVERTED_MASK(56),
-    INVERTED_MASK(57),
-    INVERTED_MASK(58),
-    INVERTED_MASK(59),
-    INVERTED_MASK(50),
-    INVERTED_MASK(61),
-    INVERTED_MASK(62),
-    INVERTED_MASK(63)
+    ~LOOKUP_MASK(0),
+    ~LOOKUP_MASK(1),
+    ~LOOKUP_MASK(2),
+    ~LOOKUP_MASK(3),
+    ~LOOKUP_MASK(4),
+    ~LOOKUP_MASK(5),
+    ~LOOKUP_MASK(6),
+    ~LOOKUP_MASK(7),
+    ~LOOKUP_MASK(8),
+    ~LOOKUP_MASK(9),
+    ~LOOKUP_MASK(10),
+    ~LOOKUP_MASK(11),
+    ~LOOKUP_MASK(12),
+    ~LOOKUP_MASK(13),
+    ~LOOKUP_MASK(14),
+    ~LOOKUP_MASK(15),
+    ~LOOKUP_MASK(16),
+    ~LOOKUP_MASK(17),
+    ~LOOKUP_MASK(18),
+    ~LOOKUP_MASK(19),
+    ~LOOKUP_MASK(20),
+    ~LOOKUP_MASK(21),
+    ~LOOKUP_MASK(22),
+    ~LOOKUP_MASK(23),
+    ~LOOKUP_MASK(24),
+    ~LOOKUP_MASK(25),
+    ~LOOKUP_MASK(26),
+    ~LOOKUP_MASK(27),
+    ~LOOKUP_MASK(28),
+    ~LOOKUP_MASK(29),
+    ~LOOKUP_MASK(30),
+    ~LOOKUP_MASK(31),
+    ~LOOKUP_MASK(32),
+    ~LOOKUP_MASK(33),
+    ~LOOKUP_MASK(34),
+    ~LOOKUP_MASK(35),
+    ~LOOKUP_MASK(36),
+    ~LOOKUP_MASK(37),
+    ~LOOKUP_MASK(38),
+    ~LOOKUP_MASK(39),
+    ~LOOKUP_MASK(40),
+    ~LOOKUP_MASK(41),
+    ~LOOKUP_MASK(42),
+    ~LOOKUP_MASK(43),
+    ~LOOKUP_MASK(44),
+    ~LOOKUP_MASK(45),
+    ~LOOKUP_MASK(46),
+    ~LOOKUP_MASK(47),
+    ~LOOKUP_MASK(48),
+    ~LOOKUP_MASK(49),
+    ~LOOKUP_MASK(50),
+    ~LOOKUP_MASK(51),
+    ~LOOKUP_MASK(52),
+    ~LOOKUP_MASK(53),
+    ~LOOKUP_MASK(54),
+    ~LOOKUP_MASK(55),
+    ~LOOKUP_MASK(56),
+    ~LOOKUP_MASK(57),
+    ~LOOKUP_MASK(58),
+    ~LOOKUP_MASK(59),
+    ~LOOKUP_MASK(60),
+    ~LOOKUP_MASK(61),
+    ~LOOKUP_MASK(62),
+    ~LOOKUP_MASK(63)
 };
 
-#endif
-
 
 
 #endif // UTILITY_GENERATOR_LOOKUP_H_
\ No newline at end of file
@@ -0,0 +1,293 @@
+/**
+ * @file compiler_options.c
+ *
+ * Runtime options of compiler, filled from command line arguments
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-05-02
+ */
+
+#include "compiler_options.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <arch_specific.h>
+
+////////////////////////////////
+// DEFINES
+
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+typedef struct
+{
+    const char* naming;
+    PackingStrategy_t strategy;
+}PackingStrategyBinding_t;
+
+static const PackingStrategyBinding_t packingStrategyTable_[] =
+{
+    {"first", PACKING_FIRST_FIT},
+    {"affinity", PACKING_AFFINITY},
+    {"dense", PACKING_DENSE}
+};
+
+typedef struct
+{
+    const char* naming;
+    ObjectLayout_t layout;
+}ObjectLayoutBinding_t;
+
+static const ObjectLayoutBinding_t objectLayoutTable_[] =
+{
+    {"packed", LAYOUT_PACKED},
+    {"hot-cold", LAYOUT_HOT_COLD}
+};
+
+static const uint8_t wordBitsTable_[] = {16, 32, 64};
+
+typedef struct
+{
+    const char* naming;
+    CallAbi_t abi;
+}CallAbiBinding_t;
+
+static const CallAbiBinding_t callAbiTable_[] =
+{
+    {"memory", CALL_ABI_MEMORY},
+    {"register", CALL_ABI_REGISTER}
+};
+
+typedef struct
+{
+    const char* naming;
+    Backend_t backend;
+}BackendBinding_t;
+
+static const BackendBinding_t backendTable_[] =
+{
+    {"c", BACKEND_C},
+    {"asm", BACKEND_ASM}
+};
+
+typedef struct
+{
+    const char* naming;
+    PoolAlignment_t alignment;
+}PoolAlignmentBinding_t;
+
+static const PoolAlignmentBinding_t poolAlignmentTable_[] =
+{
+    {"word", POOL_ALIGN_WORD},
+    {"cacheline", POOL_ALIGN_CACHE_LINE}
+};
+
+////////////////////////////////
+// PRIVATE TYPES
+
+#define OPTIONS_DEFAULT                             \
+{                                                   \
+    .packingStrategy = PACKING_FIRST_FIT,           \
+    .objectLayout = LAYOUT_PACKED,                  \
+    .layoutProfilePath = NULL,                      \
+    .layoutReportPath = NULL,                       \
+    .targetArch = NULL,                             \
+    .wordBits = ARCHITECTURE_DEFAULT_BITS,          \
+    .callAbi = CALL_ABI_MEMORY,                     \
+    .keepC = false,                                 \
+    .backend = BACKEND_C,                           \
+    .poolAlignment = POOL_ALIGN_WORD                \
+}
+
+static CompilerOptions_t options_ = OPTIONS_DEFAULT;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for getting compiler wide options object
+ *
+ * @return      Options handle, never NULL
+ */
+CompilerOptionsHandle_t CompilerOptions_get(void)
+{
+    return &options_;
+}
+
+/**
+ * @brief Public method for restoring default options, used before each compile server job
+ */
+void CompilerOptions_reset(void)
+{
+    const CompilerOptions_t defaults = OPTIONS_DEFAULT;
+
+    options_ = defaults;
+}
+
+/**
+ * @brief Public method for describing options generated code depends on
+ *
+ * @param[out] key          options description
+ * @param[in] keySize       key buffer size
+ *
+ * @return                  Success state, false if code depends on outside files or has side effects
+ */
+bool CompilerOptions_getCodegenKey(char* key, const size_t keySize)
+{
+    int keyLength;
+
+    // Profile may change between runs and report has to be written each time
+    if((options_.layoutProfilePath != NULL) || (options_.layoutReportPath != NULL))
+    {
+        return false;
+    }
+
+    keyLength = snprintf(key, keySize, "%d,%d,%u,%d,%d,%d,%s", options_.packingStrategy, options_.objectLayout, options_.wordBits,
+        options_.callAbi, options_.backend, options_.poolAlignment, (options_.targetArch != NULL) ? options_.targetArch : "");
+
+    return (keyLength > 0) && ((size_t) keyLength < keySize);
+}
+
+/**
+ * @brief Public method for converting packing strategy name to its enum value
+ *
+ * @param[in] name          strategy naming from command line
+ * @param[out] strategy     resolved strategy
+ *
+ * @return                  Success state, false if naming is not known
+ */
+bool CompilerOptions_parsePackingStrategy(const char* name, PackingStrategy_t* strategy)
+{
+    for(uint8_t bindingIdx = 0; bindingIdx < sizeof(packingStrategyTable_) / sizeof(PackingStrategyBinding_t); bindingIdx++)
+    {
+        if(strcmp(name, packingStrategyTable_[bindingIdx].naming) == 0)
+        {
+            *strategy = packingStrategyTable_[bindingIdx].strategy;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Public method for converting object layout name to its enum value
+ *
+ * @param[in] name          layout naming from command line
+ * @param[out] layout       resolved layout
+ *
+ * @return                  Success state, false if naming is not known
+ */
+bool CompilerOptions_parseObjectLayout(const char* name, ObjectLayout_t* layout)
+{
+    for(uint8_t bindingIdx = 0; bindingIdx < sizeof(objectLayoutTable_) / sizeof(ObjectLayoutBinding_t); bindingIdx++)
+    {
+        if(strcmp(name, objectLayoutTable_[bindingIdx].naming) == 0)
+        {
+            *layout = objectLayoutTable_[bindingIdx].layout;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Public method for converting bitpack word size from command line
+ *
+ * @param[in] name          word size in bits as text
+ * @param[out] wordBits     resolved word size
+ *
+ * @return                  Success state, false if word size is not supported
+ */
+bool CompilerOptions_parseWordBits(const char* name, uint8_t* wordBits)
+{
+    char* end;
+    const unsigned long bits = strtoul(name, &end, 10);
+
+    for(uint8_t bitsIdx = 0; (*end == '\0') && (bitsIdx < sizeof(wordBitsTable_)); bitsIdx++)
+    {
+        if(bits == wordBitsTable_[bitsIdx])
+        {
+            *wordBits = wordBitsTable_[bitsIdx];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Public method for converting method call ABI name to its enum value
+ *
+ * @param[in] name          ABI naming from command line
+ * @param[out] abi          resolved ABI
+ *
+ * @return                  Success state, false if naming is not known
+ */
+bool CompilerOptions_parseCallAbi(const char* name, CallAbi_t* abi)
+{
+    for(uint8_t bindingIdx = 0; bindingIdx < sizeof(callAbiTable_) / sizeof(CallAbiBinding_t); bindingIdx++)
+    {
+        if(strcmp(name, callAbiTable_[bindingIdx].naming) == 0)
+        {
+            *abi = callAbiTable_[bindingIdx].abi;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Public method for converting code generation backend name to its enum value
+ *
+ * @param[in] name          backend naming from command line
+ * @param[out] backend      resolved backend
+ *
+ * @return                  Success state, false if naming is not known
+ */
+bool CompilerOptions_parseBackend(const char* name, Backend_t* backend)
+{
+    for(uint8_t bindingIdx = 0; bindingIdx < sizeof(backendTable_) / sizeof(BackendBinding_t); bindingIdx++)
+    {
+        if(strcmp(name, backendTable_[bindingIdx].naming) == 0)
+        {
+            *backend = backendTable_[bindingIdx].backend;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Public method for converting heap pool cells alignment name to its enum value
+ *
+ * @param[in] name          alignment naming from command line
+ * @param[out] alignment    resolved alignment
+ *
+ * @return                  Success state, false if naming is not known
+ */
+bool CompilerOptions_parsePoolAlignment(const char* name, PoolAlignment_t* alignment)
+{
+    for(uint8_t bindingIdx = 0; bindingIdx < sizeof(poolAlignmentTable_) / sizeof(PoolAlignmentBinding_t); bindingIdx++)
+    {
+        if(strcmp(name, poolAlignmentTable_[bindingIdx].naming) == 0)
+        {
+            *alignment = poolAlignmentTable_[bindingIdx].alignment;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file compiler_options.h
+ *
+ * Runtime options of compiler, filled from command line arguments
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-05-02
+ */
+
+#ifndef UTILITY_GLOBAL_CONFIG_COMPILER_OPTIONS_H_
+#define UTILITY_GLOBAL_CONFIG_COMPILER_OPTIONS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum
+{
+    PACKING_FIRST_FIT,
+    PACKING_AFFINITY,
+    PACKING_DENSE
+}PackingStrategy_t;
+
+typedef enum
+{
+    LAYOUT_PACKED,
+    LAYOUT_HOT_COLD
+}ObjectLayout_t;
+
+typedef enum
+{
+    CALL_ABI_MEMORY,
+    CALL_ABI_REGISTER
+}CallAbi_t;
+
+typedef enum
+{
+    BACKEND_C,
+    BACKEND_ASM
+}Backend_t;
+
+typedef enum
+{
+    POOL_ALIGN_WORD,
+    POOL_ALIGN_CACHE_LINE
+}PoolAlignment_t;
+
+typedef struct
+{
+    PackingStrategy_t packingStrategy;
+    ObjectLayout_t objectLayout;
+    const char* layoutProfilePath;
+    const char* layoutReportPath;
+    const char* targetArch;
+    uint8_t wordBits;                       // object sizes in mangled names and bit:N<Object> depend on it
+    CallAbi_t callAbi;
+    bool keepC;
+    Backend_t backend;
+    PoolAlignment_t poolAlignment;
+}CompilerOptions_t;
+
+typedef CompilerOptions_t* CompilerOptionsHandle_t;
+
+CompilerOptionsHandle_t CompilerOptions_get(void);
+void CompilerOptions_reset(void);
+bool CompilerOptions_getCodegenKey(char* key, const size_t keySize);
+bool CompilerOptions_parsePackingStrategy(const char* name, PackingStrategy_t* strategy);
+bool CompilerOptions_parseObjectLayout(const char* name, ObjectLayout_t* layout);
+bool CompilerOptions_parseWordBits(const char* name, uint8_t* wordBits);
+bool CompilerOptions_parseCallAbi(const char* name, CallAbi_t* abi);
+bool CompilerOptions_parseBackend(const char* name, Backend_t* backend);
+bool CompilerOptions_parsePoolAlignment(const char* name, PoolAlignment_t* alignment);
+
+#endif // UTILITY_GLOBAL_CONFIG_COMPILER_OPTIONS_H_
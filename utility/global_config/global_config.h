@@ -16,13 +16,16 @@
 #include <platform_specific.h>
 
 /**
- * @brief Setting up development logging verbose level
+ * @brief Setting up highest development logging level compiled in, set by IGUANA_LOG_LEVEL of cmake
+ * Messages up to it are written when -v options of command line raise runtime level enough
  * 0 - (no verbose)
  * 1 - (ERROR)
  * 2 - (ERROR / WARN)
  * 3 - (INFO / DEBUG / ERROR / WARN)
  */
-#define VERBOSE_LEVEL                   3
+#ifndef VERBOSE_LEVEL
+    #define VERBOSE_LEVEL               3
+#endif
 #define VERBOSE_C_COMPILER              1
 #define ENABLE_TEMP_FILES_CLEANUP       1
 
@@ -32,6 +35,7 @@
 #define OBJECT_RANDOM_SEED              0
 
 #define MAIN_PROCESS_FILE_NAME          "_ZN9bit0_main9bit0_mainEv"
+#define ENTRY_POINT_NAME                "entry_main"
 
 #define PARAMS_VAR_REGION_NAME          "params"
 #define CLASS_VAR_REGION_NAME           "object"
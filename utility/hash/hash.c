@@ -82,12 +82,9 @@ bool EHash_hash(const char* text, const uint32_t inputSize, char* output, const
 
 static bool apply1BitSlidingAlgorithm_(const char* input, const uint32_t inputLength, char* output, const uint32_t outputSize)
 {
-    uint8_t slidingMask;
     uint32_t inputIdx;
-    uint32_t checksum;
     uint32_t maxSize;
 
-    slidingMask = 1;
     inputIdx = 0;
 
     if(output == NULL || input == NULL || outputSize == 0 || inputLength == 0)
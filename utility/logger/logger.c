@@ -15,100 +15,122 @@
 #include "logger.h"
 #include "../global_config/global_config.h"
 #include "colors.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <helper_macros.h>
 
 ////////////////////////////////
 // DEFINES
 
-#define COLOR_PRINT_MACRO(COLOR)                \
-    va_list args;                               \
-    va_start(args, expression);                 \
-    logData_(TAG, COLOR, expression, args);     \
-    va_end(args);
-
-#define COMPILER_LOG(COLOR)                     \
-    printf("%s", COLOR);                        \
-    vprintf(expression, args);                  \
-    printf("%s\n",END)
-
+// Lines of one thread are collected and handed to stdout at once
+#define LOGGER_BUFFER_SIZE      8192
 
 ////////////////////////////////
 // PRIVATE CONSTANTS
 
+
 ////////////////////////////////
 // PRIVATE TYPES
 
+LogLevel_t loggerLevel_ = LOG_LEVEL_DEFAULT;
+
+static _Thread_local char buffer_[LOGGER_BUFFER_SIZE];
+static _Thread_local size_t bufferLength_ = 0;
+static bool isExitFlushRegistered_ = false;
 
 ////////////////////////////////
 // PRIVATE METHODS
 
-static inline void logData_(const char* TAG, const char* colorString, const char* expression, va_list args);
-
+static bool appendLine_(const LogType_t type, const char* TAG, const char* expression, va_list args);
+static inline const char* typeColor_(const LogType_t type);
 
 ////////////////////////////////
 // IMPLEMENTATION
 
-
 /**
- * @brief Public method for logging DEBUG messages
- * 
- * @param[in] TAG               File tag 
- * @param[in] expression[in]    Expression, works same as printf
- * @param ...                   Variadic arguments (numbers, strings, chars...) same as in printf
+ * @brief Public method for setting runtime logging level, levels above VERBOSE_LEVEL stay compiled out
+ *
+ * @param[in] level         highest level of messages written
  */
-void inline Log_d(const char* TAG, const char* expression, ...)
+void Logger_setLevel(const LogLevel_t level)
 {
-    #if VERBOSE_LEVEL > 2
-        COLOR_PRINT_MACRO(LIGHT_WHITE);
-    #endif
+    loggerLevel_ = (level > LOG_LEVEL_DEBUG) ? LOG_LEVEL_DEBUG : level;
 }
 
-
 /**
- * @brief Public method for logging ERROR messages
- * 
- * @param[in] TAG               File tag 
- * @param[in] expression[in]    Expression, works same as printf
- * @param ...                   Variadic arguments (numbers, strings, chars...) same as in printf
+ * @brief Public method for getting runtime logging level
+ *
+ * @return                  Current level
  */
-void inline Log_e(const char* TAG, const char* expression, ...)
+LogLevel_t Logger_getLevel(void)
 {
-    #if VERBOSE_LEVEL > 0
-        COLOR_PRINT_MACRO(LIGHT_RED);
-    #endif
+    return loggerLevel_;
 }
 
-
 /**
- * @brief Public method for logging INFORMATIONAL messages
- * 
- * @param[in] TAG               File tag 
- * @param[in] expression[in]    Expression, works same as printf
- * @param ...                   Variadic arguments (numbers, strings, chars...) same as in printf
+ * @brief Public method for writing message, called through Log_* macros after level is checked
+ *
+ * @param[in] type          message type, selects color
+ * @param[in] TAG           File tag
+ * @param[in] expression    Expression, works same as printf
+ * @param ...               Variadic arguments (numbers, strings, chars...) same as in printf
  */
-void inline Log_i(const char* TAG, const char* expression, ...)
+void Logger_write(const LogType_t type, const char* TAG, const char* expression, ...)
 {
-    #if VERBOSE_LEVEL > 2
-        COLOR_PRINT_MACRO(LIGHT_BLUE);
-    #endif
-}
+    va_list args;
+
+    // Buffer of main thread would be lost on exit, other threads flush before they finish
+    if(!isExitFlushRegistered_)
+    {
+        isExitFlushRegistered_ = true;
+        atexit(Logger_flush);
+    }
+
+    va_start(args, expression);
+
+    if(!appendLine_(type, TAG, expression, args))
+    {
+        va_end(args);
+        va_start(args, expression);
+
+        Logger_flush();
+
+        // Line longer than whole buffer goes straight to stdout
+        if(!appendLine_(type, TAG, expression, args))
+        {
+            va_end(args);
+            va_start(args, expression);
 
+            printf("%s(%s)-> ", typeColor_(type), TAG);
+            vprintf(expression, args);
+            printf("%s\n", END);
+        }
+    }
+
+    va_end(args);
+
+    // Errors are shown right away, compiler may stop after them
+    if(type == LOG_TYPE_ERROR)
+    {
+        Logger_flush();
+    }
+}
 
 /**
- * @brief Public method for logging WARNING messages
- * 
- * @param[in] TAG               File tag 
- * @param[in] expression[in]    Expression, works same as printf
- * @param ...                   Variadic arguments (numbers, strings, chars...) same as in printf
+ * @brief Public method for writing buffered lines of calling thread to stdout, needed before
+ * anything else is printed to stdout, before stdout is redirected and before thread finishes
  */
-void inline Log_w(const char* TAG, const char* expression, ...)
+void Logger_flush(void)
 {
-    #if VERBOSE_LEVEL > 1
-        COLOR_PRINT_MACRO(YELLOW);
-    #endif
+    if(bufferLength_ > 0)
+    {
+        fwrite(buffer_, 1, bufferLength_, stdout);
+        bufferLength_ = 0;
+    }
 }
 
 
-
 /**
  * @brief Public method for logging ERROR messages of compiler
  * 
@@ -126,6 +148,7 @@ inline void Logc(const char* expression, const char* colorString, ...)
 
 inline void Logcc(const char* expression, const char* colorString, va_list args)
 {
+    Logger_flush();
     printf("%s", colorString);
     vprintf(expression, args);
     printf("%s\n",END);
@@ -133,16 +156,71 @@ inline void Logcc(const char* expression, const char* colorString, va_list args)
 
 
 /**
- * @brief Public method for logging any type of messages
+ * @brief Private method for formatting message line at end of thread buffer
  * 
- * @param[in] TAG           File tag 
- * @param colorString       String 
- * @param expression 
- * @param args 
+ * @param[in] type          message type, selects color
+ * @param[in] TAG           File tag
+ * @param[in] expression    Expression, works same as printf
+ * @param[in] args          Expression arguments
+ *
+ * @return                  Success state, false if line does not fit, buffer is left unchanged
  */
-static void logData_(const char* TAG, const char* colorString, const char* expression, va_list args)
+static bool appendLine_(const LogType_t type, const char* TAG, const char* expression, va_list args)
 {
-    printf("%s(%s)-> ", colorString, TAG);
-    vprintf(expression, args);
-    printf("%s\n", END);
+    const char* color = typeColor_(type);
+    const size_t colorLength = strlen(color);
+    const size_t tagLength = strlen(TAG);
+    const size_t endLength = strlen(END);
+    const size_t prefixLength = colorLength + tagLength + SIZEOF_NOTERM("()-> ");
+    char* line = buffer_ + bufferLength_;
+    size_t space = LOGGER_BUFFER_SIZE - bufferLength_;
+    int messageLength;
+
+    // Prefix and ending are copied, only message itself goes through formatting
+    if(prefixLength + endLength + SIZEOF_NOTERM("\n") >= space)
+    {
+        return false;
+    }
+
+    memcpy(line, color, colorLength);
+    line += colorLength;
+    *line++ = '(';
+    memcpy(line, TAG, tagLength);
+    line += tagLength;
+    memcpy(line, ")-> ", SIZEOF_NOTERM(")-> "));
+    line += SIZEOF_NOTERM(")-> ");
+    space -= prefixLength;
+
+    messageLength = vsnprintf(line, space, expression, args);
+
+    if((messageLength < 0) || ((size_t) messageLength + endLength + SIZEOF_NOTERM("\n") >= space))
+    {
+        return false;
+    }
+
+    line += messageLength;
+    memcpy(line, END, endLength);
+    line[endLength] = '\n';
+
+    bufferLength_ += prefixLength + messageLength + endLength + SIZEOF_NOTERM("\n");
+
+    return true;
+}
+
+/**
+ * @brief Private method for getting color of message type
+ *
+ * @param[in] type          message type
+ *
+ * @return                  Terminal color sequence
+ */
+static inline const char* typeColor_(const LogType_t type)
+{
+    switch(type)
+    {
+        case LOG_TYPE_ERROR:    return LIGHT_RED;
+        case LOG_TYPE_WARNING:  return YELLOW;
+        case LOG_TYPE_INFO:     return LIGHT_BLUE;
+        default:                return LIGHT_WHITE;
+    }
 }
\ No newline at end of file
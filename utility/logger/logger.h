@@ -1,7 +1,8 @@
 /**
  * @file logger.h
  *
- * MORE INFO ABOUT THE FILE'S CONTENTS
+ * Development logging. Log_* are macros, messages above VERBOSE_LEVEL are compiled out and
+ * messages above runtime level are skipped before their arguments are evaluated.
  *
  * @copyright This file is a part of the project Iguana and is distributed under MIT license which
  * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
@@ -16,12 +17,74 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <global_config.h>
 
+typedef enum
+{
+    LOG_LEVEL_NONE,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_WARNING,
+    LOG_LEVEL_DEBUG
+}LogLevel_t;
 
-void Log_d(const char* TAG, const char* expression, ...);
-void Log_e(const char* TAG, const char* expression, ...);
-void Log_i(const char* TAG, const char* expression, ...);
-void Log_w(const char* TAG, const char* expression, ...);
+typedef enum
+{
+    LOG_TYPE_ERROR,
+    LOG_TYPE_WARNING,
+    LOG_TYPE_INFO,
+    LOG_TYPE_DEBUG
+}LogType_t;
+
+// Errors only, every -v of command line adds one level
+#define LOG_LEVEL_DEFAULT               LOG_LEVEL_ERROR
+
+// Runtime level read by macros, changed only through Logger_setLevel
+extern LogLevel_t loggerLevel_;
+
+#define LOGGER_WRITE_(level, type, TAG, ...)                            \
+    do                                                                  \
+    {                                                                   \
+        if(loggerLevel_ >= (level))                                     \
+        {                                                               \
+            Logger_write(type, TAG, __VA_ARGS__);                       \
+        }                                                               \
+    }while(0)
+
+// Compiled out message still references its arguments, so variables used only by it stay used
+#define LOGGER_DISCARD_(type, TAG, ...)                                 \
+    do                                                                  \
+    {                                                                   \
+        if(0)                                                           \
+        {                                                               \
+            Logger_write(type, TAG, __VA_ARGS__);                       \
+        }                                                               \
+    }while(0)
+
+#if VERBOSE_LEVEL >= 1
+    #define Log_e(TAG, ...)     LOGGER_WRITE_(LOG_LEVEL_ERROR, LOG_TYPE_ERROR, TAG, __VA_ARGS__)
+#else
+    #define Log_e(TAG, ...)     LOGGER_DISCARD_(LOG_TYPE_ERROR, TAG, __VA_ARGS__)
+#endif
+
+#if VERBOSE_LEVEL >= 2
+    #define Log_w(TAG, ...)     LOGGER_WRITE_(LOG_LEVEL_WARNING, LOG_TYPE_WARNING, TAG, __VA_ARGS__)
+#else
+    #define Log_w(TAG, ...)     LOGGER_DISCARD_(LOG_TYPE_WARNING, TAG, __VA_ARGS__)
+#endif
+
+#if VERBOSE_LEVEL >= 3
+    #define Log_i(TAG, ...)     LOGGER_WRITE_(LOG_LEVEL_DEBUG, LOG_TYPE_INFO, TAG, __VA_ARGS__)
+    #define Log_d(TAG, ...)     LOGGER_WRITE_(LOG_LEVEL_DEBUG, LOG_TYPE_DEBUG, TAG, __VA_ARGS__)
+#else
+    #define Log_i(TAG, ...)     LOGGER_DISCARD_(LOG_TYPE_INFO, TAG, __VA_ARGS__)
+    #define Log_d(TAG, ...)     LOGGER_DISCARD_(LOG_TYPE_DEBUG, TAG, __VA_ARGS__)
+#endif
+
+void Logger_setLevel(const LogLevel_t level);
+LogLevel_t Logger_getLevel(void);
+void Logger_write(const LogType_t type, const char* TAG, const char* expression, ...);
+void Logger_flush(void);
 void Logc(const char* expression, const char* color, ...);
 void Logcc(const char* expression, const char* color, va_list list);
-#endif // UTILITY_LOGGER_LOGGER_H_
\ No newline at end of file
+#endif // UTILITY_LOGGER_LOGGER_H_
@@ -15,17 +15,51 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <argp.h>
+#include <errno.h>
 #include <string.h>
+#include <compiler_options.h>
+#include "server/server.h"
+#include <unix_assembler.h>
+#include "runner/runner.h"
+#include <logger.h>
 
 const char *argp_program_version = "Iguana 1.0";
 const char *argp_program_bug_address = "<markas.vielavicius@gmail.com>";
 static char doc[] = "Iguana compiler options";
-static char args_doc[] = "[FILES]...";
+static char args_doc[] = "[FILES]...\n" RUNNER_COMMAND " [FILES]...";
+
+// Keys for long only options
+enum
+{
+    OPTION_PACKING = 0x100,
+    OPTION_LAYOUT,
+    OPTION_LAYOUT_PROFILE,
+    OPTION_LAYOUT_REPORT,
+    OPTION_MARCH,
+    OPTION_WORD_BITS,
+    OPTION_ABI,
+    OPTION_KEEP_C,
+    OPTION_SERVER,
+    OPTION_BACKEND,
+    OPTION_POOL_ALIGN
+};
 
 static struct argp_option options[] = {
     { "output", 'o', "FILE", 0, "Destination executable path" },
     { "only-c", 'c', 0, 0, "Only generate .c source files (no object files or executable)" },
     { "only-object", 'b', 0, 0, "Only compile to .o object files (no linking)" },
+    { "packing", OPTION_PACKING, "STRATEGY", 0, "Object variables packing strategy: first (default), affinity, dense" },
+    { "layout", OPTION_LAYOUT, "MODE", 0, "Object variables layout: packed (default), hot-cold" },
+    { "layout-profile", OPTION_LAYOUT_PROFILE, "FILE", 0, "Use counts for hot-cold layout, lines of \"[object.]variable count\"" },
+    { "layout-report", OPTION_LAYOUT_REPORT, "FILE", 0, "Write hot-cold layout decisions to FILE" },
+    { "word-bits", OPTION_WORD_BITS, "BITS", 0, "Bitpack word size of generated code: 16, 32 or 64 (default), object sizes and so bit:N<Object> declarations depend on it" },
+    { "abi", OPTION_ABI, "ABI", 0, "Method call ABI: memory (default), register passes signatures up to 128 bits by value" },
+    { "keep-c", OPTION_KEEP_C, 0, 0, "Write generated .c files to disk and compile them from there instead of piping to C compiler" },
+    { "server", OPTION_SERVER, "SOCKET", 0, "Stay resident and compile jobs of clients connecting to Unix socket SOCKET, clients find it through " SERVER_SOCKET_ENV " environment variable" },
+    { "backend", OPTION_BACKEND, "BACKEND", 0, "Code generation backend: c (default), asm emits x86-64 assembly for as and ld, objects it cannot lower make whole program use C" },
+    { "pool-align", OPTION_POOL_ALIGN, "ALIGN", 0, "Cells of dh object pools: word (default), cacheline starts every object on its own 64 byte line" },
+    { "march", OPTION_MARCH, "CPU", 0, "Target CPU passed to C compiler, bit fields are accessed with BMI2 instructions when CPU has them" },
+    { "verbose", 'v', 0, 0, "Log warnings, repeated also info and debug messages, levels above build VERBOSE_LEVEL are compiled out" },
     { 0 }
 };
 
@@ -37,16 +71,18 @@ struct arguments {
     bool isCaseInsensitive;
     bool only_c;
     bool only_obj;
-    char *output_path;
     char **files;
     int file_count;
+    char *server_socket;
+    bool run;
+    char *link_output;          // -o, or in memory image in run mode
 };
 
 static error_t parse_opt(int key, char *arg, struct argp_state *state) {
     struct arguments *arguments = state->input;
     switch (key) {
     case 'o':
-        arguments->output_path = arg;
+        arguments->link_output = arg;
         break;
     case 'c':
         arguments->only_c = true;
@@ -54,6 +90,66 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
     case 'b':
         arguments->only_obj = true;
         break;
+    case 'v':
+        Logger_setLevel(Logger_getLevel() + 1);
+        break;
+    case OPTION_PACKING:
+        if(!CompilerOptions_parsePackingStrategy(arg, &CompilerOptions_get()->packingStrategy))
+        {
+            argp_error(state, "unknown packing strategy '%s'", arg);
+            return EINVAL;
+        }
+        break;
+    case OPTION_LAYOUT:
+        if(!CompilerOptions_parseObjectLayout(arg, &CompilerOptions_get()->objectLayout))
+        {
+            argp_error(state, "unknown layout '%s'", arg);
+            return EINVAL;
+        }
+        break;
+    case OPTION_LAYOUT_PROFILE:
+        CompilerOptions_get()->layoutProfilePath = arg;
+        break;
+    case OPTION_LAYOUT_REPORT:
+        CompilerOptions_get()->layoutReportPath = arg;
+        break;
+    case OPTION_MARCH:
+        CompilerOptions_get()->targetArch = arg;
+        break;
+    case OPTION_WORD_BITS:
+        if(!CompilerOptions_parseWordBits(arg, &CompilerOptions_get()->wordBits))
+        {
+            argp_error(state, "unsupported word size '%s'", arg);
+            return EINVAL;
+        }
+        break;
+    case OPTION_KEEP_C:
+        CompilerOptions_get()->keepC = true;
+        break;
+    case OPTION_SERVER:
+        arguments->server_socket = arg;
+        break;
+    case OPTION_ABI:
+        if(!CompilerOptions_parseCallAbi(arg, &CompilerOptions_get()->callAbi))
+        {
+            argp_error(state, "unknown call ABI '%s'", arg);
+            return EINVAL;
+        }
+        break;
+    case OPTION_BACKEND:
+        if(!CompilerOptions_parseBackend(arg, &CompilerOptions_get()->backend))
+        {
+            argp_error(state, "unknown backend '%s'", arg);
+            return EINVAL;
+        }
+        break;
+    case OPTION_POOL_ALIGN:
+        if(!CompilerOptions_parsePoolAlignment(arg, &CompilerOptions_get()->poolAlignment))
+        {
+            argp_error(state, "unknown pool alignment '%s'", arg);
+            return EINVAL;
+        }
+        break;
     case ARGP_KEY_ARG:
         arguments->files = realloc(arguments->files, (arguments->file_count + 1) * sizeof(char *));
         arguments->files[arguments->file_count++] = arg;
@@ -66,10 +162,75 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
 
 static struct argp argp = { options, parse_opt, args_doc, doc, 0, 0, 0 };
 
+static int compile_(int argc, char **argv, const bool isServerJob);
+static int compileAssembly_(const struct arguments* arguments);
+static int serverJob_(int argc, char **argv, int resultFd);
+static void serverResult_(const char* result, size_t length);
+static bool isServerInvocation_(int argc, char **argv);
+static bool isRunInvocation_(int argc, char **argv);
+static const char* firstFileArgument_(int argc, char **argv);
+static bool longOptionTakesValue_(const char* name);
+static bool shortOptionTakesValue_(const char key);
+
 int main(int argc, char **argv) 
 {
-    struct arguments arguments = { CHARACTER_MODE, false, NULL, NULL, 0 };
-    argp_parse(&argp, argc, argv, 0, 0, &arguments);
+    const char* serverSocket = getenv(SERVER_SOCKET_ENV);
+
+    // Running server takes the job, compiling locally if it is not reachable
+    // Program started by server would run in job process of server, so running is always local
+    if((serverSocket != NULL) && !isServerInvocation_(argc, argv) && !isRunInvocation_(argc, argv))
+    {
+        const int status = Server_submit(serverSocket, argc, argv);
+
+        if(status >= 0)
+        {
+            return status;
+        }
+    }
+
+    return compile_(argc, argv, false);
+}
+
+static int compile_(int argc, char **argv, const bool isServerJob)
+{
+    struct arguments arguments = { CHARACTER_MODE, false, false, false, NULL, 0, NULL, false, "output.out" };
+    char runImagePath[RUNNER_IMAGE_PATH_LENGTH];
+    int runImageFd = -1;
+
+    // Server must survive bad arguments of its clients, argp only prints errors then
+    // so parser reports them back through its return code
+    if(argp_parse(&argp, argc, argv, isServerJob ? ARGP_NO_EXIT : 0, 0, &arguments))
+    {
+        free(arguments.files);
+        return EXIT_FAILURE;
+    }
+
+    if(arguments.server_socket != NULL)
+    {
+        free(arguments.files);
+
+        if(isServerJob)
+        {
+            fprintf(stderr, "Error: compile server cannot be started by its client\n");
+            return EXIT_FAILURE;
+        }
+
+        if(!Compiler_enableCodeCache() || !Server_run(arguments.server_socket, serverJob_, serverResult_))
+        {
+            fprintf(stderr, "Error: compile server failed on socket %s\n", arguments.server_socket);
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    // Program is linked into memory and executed right away
+    if((arguments.file_count > 0) && (strcmp(arguments.files[0], RUNNER_COMMAND) == 0))
+    {
+        arguments.run = true;
+        arguments.file_count--;
+        memmove(arguments.files, arguments.files + 1, arguments.file_count * sizeof(char*));
+    }
 
     if (arguments.file_count == 0) 
     {
@@ -77,22 +238,69 @@ int main(int argc, char **argv)
         return EXIT_FAILURE;
     }
 
+    if(arguments.run)
+    {
+        if(isServerJob || arguments.only_c || arguments.only_obj)
+        {
+            fprintf(stderr, "Error: " RUNNER_COMMAND " cannot be combined with -c, -b or compile server\n");
+            free(arguments.files);
+            return EXIT_FAILURE;
+        }
+
+        runImageFd = Runner_createImage(runImagePath, sizeof(runImagePath));
+
+        if(runImageFd < 0)
+        {
+            fprintf(stderr, "Error: failed to create executable image in memory\n");
+            free(arguments.files);
+            return EXIT_FAILURE;
+        }
+
+        arguments.link_output = runImagePath;
+    }
+
+    // Only generated sources are wanted, so they have to be on disk
+    if(arguments.only_c)
+    {
+        CompilerOptions_get()->keepC = true;
+    }
+
+    if(CompilerOptions_get()->backend == BACKEND_ASM)
+    {
+        int status = compileAssembly_(&arguments);
+
+        // Backend stays assembly unless some object could not be lowered
+        if(CompilerOptions_get()->backend == BACKEND_ASM)
+        {
+            if((status == EXIT_SUCCESS) && arguments.run)
+            {
+                Runner_execute(runImageFd, arguments.files[0]);
+                status = EXIT_FAILURE;
+            }
+
+            free(arguments.files);
+            return status;
+        }
+    }
+
     // REMOVE THIS VECTOR IN FUTURE ITS NOT NEEDED
     Vector_t pathsToLink;
+    int status = EXIT_SUCCESS;
 
     if(!Vector_create(&pathsToLink, NULL))
     {
         fprintf(stderr, "Error: failed to create vector for link paths\n");
+        free(arguments.files);
         return EXIT_FAILURE;
     }
 
     // Process each file
-    for (int argIdx = 0; argIdx < arguments.file_count; argIdx++) 
+    for (int argIdx = 0; (argIdx < arguments.file_count) && (status == EXIT_SUCCESS); argIdx++) 
     {
         char* iguanaObjectName;
 
 
-        iguanaObjectName = malloc(strlen(arguments.files[argIdx]));
+        iguanaObjectName = malloc(strlen(arguments.files[argIdx]) + 1);
 
         Compiler_removeExtensionFromFilenameWithCopy_(iguanaObjectName, basename((char*) arguments.files[argIdx]));
             
@@ -100,26 +308,260 @@ int main(int argc, char **argv)
         if(!Compiler_compileIguana(arguments.files[argIdx], argIdx == 0))
         {
             fprintf(stderr, "Error to compile Iguana path: %s", arguments.files[argIdx]);
-            return EXIT_FAILURE;
+            free(iguanaObjectName);
+            status = EXIT_FAILURE;
+            break;
         }
 
         if(!Vector_append(&pathsToLink, iguanaObjectName))
         {
             fprintf(stderr, "Error: failed to create vector for link paths\n");
-            return EXIT_FAILURE;
+            free(iguanaObjectName);
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        // Generated code is overwritten by next file, so it is piped to C compiler right away.
+        // Last file is left for linking command, unless only objects are needed
+        if(!CompilerOptions_get()->keepC && (arguments.only_obj || (argIdx + 1 < arguments.file_count)))
+        {
+            const char* generatedCode;
+            size_t generatedLength;
+
+            if(!Compiler_getGeneratedCode(&generatedCode, &generatedLength) ||
+               !CExternalCompiler_compileSource(iguanaObjectName, generatedCode, generatedLength, !arguments.only_obj))
+            {
+                fprintf(stderr, "Error failed to compile generated code of: %s\n", arguments.files[argIdx]);
+                status = EXIT_FAILURE;
+            }
         }
         
     }
-    if(!arguments.only_c)
+    if((status == EXIT_SUCCESS) && CompilerOptions_get()->keepC && !arguments.only_c)
     {
-        if(!CExternalCompiler_compile(&pathsToLink, "output.out", !arguments.only_obj))
+        if(!CExternalCompiler_compile(&pathsToLink, arguments.link_output, !arguments.only_obj))
         {
             fprintf(stderr, "Error failed to link objects...");
-            return EXIT_FAILURE;
+            status = EXIT_FAILURE;
+        }
+
+    }else if((status == EXIT_SUCCESS) && !CompilerOptions_get()->keepC && !arguments.only_obj)
+    {
+        const char* generatedCode;
+        size_t generatedLength;
+
+        if(!Compiler_getGeneratedCode(&generatedCode, &generatedLength) ||
+           !CExternalCompiler_linkSource(&pathsToLink, generatedCode, generatedLength, arguments.link_output))
+        {
+            fprintf(stderr, "Error failed to link objects...");
+            status = EXIT_FAILURE;
         }
     }
-    
+
+    // Build stopped before linking leaves objects of piped sources, server runs many jobs
+    // so names and directory of this one are not needed anymore either way
+    CExternalCompiler_removeObjects(&pathsToLink);
+    Vector_destroy(&pathsToLink);
+
+    // Program replaces compiler process, so execution returns only on failure
+    if((status == EXIT_SUCCESS) && arguments.run)
+    {
+        Runner_execute(runImageFd, arguments.files[0]);
+        status = EXIT_FAILURE;
+    }
+
     free(arguments.files);
 
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+    return status;
+}
+
+static int compileAssembly_(const struct arguments* arguments)
+{
+    Vector_t pathsToLink;
+    int status = EXIT_SUCCESS;
+
+    if(!Vector_create(&pathsToLink, NULL))
+    {
+        fprintf(stderr, "Error: failed to create vector for link paths\n");
+        return EXIT_FAILURE;
+    }
+
+    for(int argIdx = 0; (argIdx < arguments->file_count) && (status == EXIT_SUCCESS); argIdx++)
+    {
+        const char* generatedCode;
+        size_t generatedLength;
+        char* iguanaObjectName = malloc(strlen(arguments->files[argIdx]) + 1);
+
+        Compiler_removeExtensionFromFilenameWithCopy_(iguanaObjectName, basename((char*) arguments->files[argIdx]));
+
+        if(!Compiler_compileIguana(arguments->files[argIdx], argIdx == 0))
+        {
+            fprintf(stderr, "Error to compile Iguana path: %s", arguments->files[argIdx]);
+            free(iguanaObjectName);
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        if(CompilerOptions_get()->backend != BACKEND_ASM)
+        {
+            fprintf(stderr, "Warning: %s cannot be compiled by assembly backend, compiling program through C\n", arguments->files[argIdx]);
+            free(iguanaObjectName);
+            break;
+        }
+
+        if(!Vector_append(&pathsToLink, iguanaObjectName))
+        {
+            fprintf(stderr, "Error: failed to create vector for link paths\n");
+            free(iguanaObjectName);
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        if(!arguments->only_c && (!Compiler_getGeneratedCode(&generatedCode, &generatedLength) ||
+           !UnixAssembler_assembleSource(iguanaObjectName, generatedCode, generatedLength, !arguments->only_obj)))
+        {
+            fprintf(stderr, "Error failed to assemble generated code of: %s\n", arguments->files[argIdx]);
+            status = EXIT_FAILURE;
+        }
+    }
+
+    if((status == EXIT_SUCCESS) && (CompilerOptions_get()->backend == BACKEND_ASM) && !arguments->only_c && !arguments->only_obj)
+    {
+        const char* objectsDir = UnixAssembler_getObjectsDir();
+
+        if((objectsDir == NULL) || !UnixLinker_linkPaths(&pathsToLink, objectsDir, arguments->link_output))
+        {
+            fprintf(stderr, "Error failed to link objects...");
+            status = EXIT_FAILURE;
+        }
+    }
+
+    UnixAssembler_removeObjects(&pathsToLink);
+    Vector_destroy(&pathsToLink);
+
+    return status;
+}
+
+static int serverJob_(int argc, char **argv, int resultFd)
+{
+    // Options and diagnostics of previous job should not leak into this one
+    CompilerOptions_reset();
+    Compiler_resetState();
+    Logger_setLevel(LOG_LEVEL_DEFAULT);
+
+    // Job process ends with job, so generated code goes to server cache
+    Compiler_exportCodeCache(resultFd);
+
+    return compile_(argc, argv, true);
+}
+
+static void serverResult_(const char* result, size_t length)
+{
+    if(!Compiler_importCodeCache(result, length))
+    {
+        fprintf(stderr, "Warning: failed to keep generated code of finished job\n");
+    }
+}
+
+static bool isServerInvocation_(int argc, char **argv)
+{
+    for(int argIdx = 1; argIdx < argc; argIdx++)
+    {
+        if(strncmp(argv[argIdx], "--server", sizeof("--server") - 1) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool isRunInvocation_(int argc, char **argv)
+{
+    // Same rule as in compile_, run is the first of files
+    const char* firstFile = firstFileArgument_(argc, argv);
+
+    return (firstFile != NULL) && (strcmp(firstFile, RUNNER_COMMAND) == 0);
+}
+
+/**
+ * @brief First argument which argp gives as file, values of options are skipped
+ */
+static const char* firstFileArgument_(int argc, char **argv)
+{
+    for(int argIdx = 1; argIdx < argc; argIdx++)
+    {
+        const char* argument = argv[argIdx];
+
+        if(strcmp(argument, "--") == 0)
+        {
+            return (argIdx + 1 < argc) ? argv[argIdx + 1] : NULL;
+        }
+
+        if((argument[0] != '-') || (argument[1] == '\0'))
+        {
+            return argument;
+        }
+
+        if(argument[1] == '-')
+        {
+            // Value is joined by '=' or is the next argument
+            if((strchr(argument, '=') == NULL) && longOptionTakesValue_(&argument[2]))
+            {
+                argIdx++;
+            }
+        }else
+        {
+            // Grouped short options end at one taking value, rest of group is its value
+            for(const char* key = &argument[1]; *key != '\0'; key++)
+            {
+                if(shortOptionTakesValue_(*key))
+                {
+                    argIdx += (key[1] == '\0') ? 1 : 0;
+                    break;
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static bool longOptionTakesValue_(const char* name)
+{
+    const size_t nameLength = strlen(name);
+    const struct argp_option* abbreviated = NULL;
+    uint32_t abbreviatedCount = 0;
+
+    for(const struct argp_option* option = options; option->name != NULL; option++)
+    {
+        if(strncmp(option->name, name, nameLength) != 0)
+        {
+            continue;
+        }
+
+        if(option->name[nameLength] == '\0')
+        {
+            return option->arg != NULL;
+        }
+
+        // argp accepts unambiguous beginning of long option too
+        abbreviated = option;
+        abbreviatedCount++;
+    }
+
+    return (abbreviatedCount == 1) && (abbreviated->arg != NULL);
+}
+
+static bool shortOptionTakesValue_(const char key)
+{
+    for(const struct argp_option* option = options; option->name != NULL; option++)
+    {
+        if(option->key == key)
+        {
+            return option->arg != NULL;
+        }
+    }
+
+    return false;
+}
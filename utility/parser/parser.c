@@ -17,6 +17,9 @@
 #include "parser_utilities/smaller_parsers/method_parser/method_parsers.h"
 #include "parser_utilities/smaller_parsers/var_parser/var_parser.h"
 #include "parser_utilities/post_parsing_utility/bitfit.h"
+#include "parser_utilities/post_parsing_utility/object_layout.h"
+#include "parser_utilities/post_parsing_utility/object_sizes.h"
+#include <compiler_options.h>
 
 #include <string.h>
 #include "../hash/random/random.h"
@@ -97,6 +100,10 @@ bool Parser_parseTokens(ParserHandle_t parser, MainFrameHandle_t root, const Vec
     {
         switch(cTokenType)
         {
+            case INLINE: // detected inline method keyword
+            case ALLOC_STATIC_STACK: // detected placement keyword
+            case ALLOC_DYNAMIC_STACK:
+            case ALLOC_DYNAMIC_HEAP:
             case BIT_TYPE: // detected bit keyword
             {
                 if(!handleKeywordInteger_(parser, root, NO_NOTATION))
@@ -124,6 +131,13 @@ bool Parser_parseTokens(ParserHandle_t parser, MainFrameHandle_t root, const Vec
     // Post parsing AST stuff 
     postParsingJobsAST_(root);
 
+    // Object size is known only after layout, declarations of object in other files are checked against it
+    if(!ObjectSizes_addObject(root->iguanaObjectName, root->objectSizeBits))
+    {
+        Log_e(TAG, "Failed to remember size of object %s", root->iguanaObjectName);
+        return ERROR;
+    }
+
     return SUCCESS;
 }
 
@@ -161,6 +175,23 @@ static inline bool handleNotation_(ParserHandle_t parser, MainFrameHandle_t root
 static inline bool handleKeywordInteger_(ParserHandle_t parser, MainFrameHandle_t rootHandle, const Accessibility_t notation)
 {
     VariableObjectHandle_t variable;
+    bool isInline = false;
+
+    if(cTokenType == INLINE)
+    {
+        isInline = true;
+        currentToken++;
+    }
+
+    // Object variables are always part of object words, taking them at method entry has no meaning here
+    if((cTokenType == ALLOC_DYNAMIC_STACK) || (cTokenType == ALLOC_DYNAMIC_HEAP))
+    {
+        Shouter_shoutError(cTokenP, "Only method local objects can be placed with \'%s\'", cTokenP->valueString);
+        currentToken++;
+    }else if(cTokenType == ALLOC_STATIC_STACK)
+    {
+        currentToken++;
+    }
 
     ALLOC_CHECK(variable, sizeof(VariableObject_t), ERROR);
 
@@ -174,6 +205,21 @@ static inline bool handleKeywordInteger_(ParserHandle_t parser, MainFrameHandle_
     
     currentToken++;
 
+    if(cTokenType == BRACKET_SQUARE_START)
+    {
+        if(!VarParser_parseArrayLength(&currentToken, variable))
+        {
+            return ERROR;
+        }
+
+        currentToken++;
+    }
+
+    if((cTokenType != BRACKET_ROUND_START) && isInline)
+    {
+        Shouter_shoutError(cTokenP, "Only methods can be declared inline, \'%s\' is a variable", variable->objectName);
+    }
+
     if(cTokenType == SEMICOLON)
     {
         if(Hashmap_set(&rootHandle->classVariables, variable->objectName, variable))
@@ -191,12 +237,12 @@ static inline bool handleKeywordInteger_(ParserHandle_t parser, MainFrameHandle_
             return ERROR;
         }
         
-    }else if(cTokenType == BRACKET_ROUND_START)   // identified method
+    }else if((cTokenType == BRACKET_ROUND_START) && (variable->arrayLength == 0))   // identified method
     {
         currentToken++;
         // Return type changes scope to params packing
         variable->scopeName = PARAMS_VAR_REGION_NAME;
-        MethodParser_parseMethod(&currentToken, variable, parser, rootHandle, notation);
+        MethodParser_parseMethod(&currentToken, variable, parser, rootHandle, notation, isInline);
     }else
     {
         Shouter_shoutExpectedToken(cTokenP, SEMICOLON);
@@ -218,7 +264,42 @@ static inline bool postParsingJobsAST_(MainFrameHandle_t mainframe)
     // Categorizing each bit pack variable to corresponding group
     // Assigning bitpack positions
     // Algorithm of packing should be decided depending on optimization
-    if(!Bitfit_assignGroupsAndPositionForVariableHashmap_(&mainframe->classVariables, FIRST_FIT, &mainframe->objectSizeBits))
+    if(CompilerOptions_get()->objectLayout == LAYOUT_HOT_COLD)
+    {
+        if(!ObjectLayout_assignHotCold(mainframe))
+        {
+            Log_e(TAG, "Failed to do hot/cold layout");
+            return ERROR;
+        }
+
+        return SUCCESS;
+    }
+
+    if(CompilerOptions_get()->packingStrategy == PACKING_AFFINITY)
+    {
+        AccessGraph_t graph;
+        bool status;
+
+        if(!AccessGraph_build(&graph, mainframe))
+        {
+            Log_e(TAG, "Failed to build variables access graph");
+            return ERROR;
+        }
+
+        status = Bitfit_assignGroupsAndPositionByAffinity_(&graph, NULL, &mainframe->objectSizeBits);
+        AccessGraph_destroy(&graph);
+
+        if(!status)
+        {
+            Log_e(TAG, "Failed to do affinity bitfitting");
+            return ERROR;
+        }
+
+        return SUCCESS;
+    }
+
+    if(!Bitfit_assignGroupsAndPositionForVariableHashmap_(&mainframe->classVariables,
+            (CompilerOptions_get()->packingStrategy == PACKING_DENSE) ? DENSE_FIT : FIRST_FIT, &mainframe->objectSizeBits))
     {
         Log_e(TAG, "Failed to do bitfitting");
         return ERROR;
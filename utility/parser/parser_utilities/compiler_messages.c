@@ -63,6 +63,7 @@ void Shouter_shoutInfo(const TokenHandler_t tokenHandle, const char* errorMessag
 
 static void printLocation_(const TokenHandler_t tokenHandle)
 {
+    Logger_flush();
     printf("%s:%lu:%lu -> ",
     tokenHandle->location.filename,
     tokenHandle->location.line,
@@ -0,0 +1,409 @@
+/**
+ * @file access_graph.c
+ *
+ * Graph of object variables which are accessed together in method bodies
+ *
+ * Each statement of method body is one access unit: every pair of object variables
+ * touched by same statement gets edge weight increased, every touch increases
+ * variable read or write counter. Packers use it to co-locate fields.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-05-02
+ */
+
+#include "access_graph.h"
+#include <stdlib.h>
+#include <string.h>
+#include <logger.h>
+#include <dstack.h>
+#include <safety_macros.h>
+#include <global_config.h>
+#include "../../structures/expression/expressions.h"
+
+////////////////////////////////
+// DEFINES
+
+#define EDGES_INITIAL_CAPACITY      4
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+static const char* TAG = "ACCESS_GRAPH";
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef struct
+{
+    uint32_t* nodes;
+    uint32_t count;
+    uint32_t capacity;
+}StatementAccess_t;
+
+typedef StatementAccess_t* StatementAccessHandle_t;
+
+// Marks result of already counted operation on postfix simulation stack
+static ExpElement_t operationResultSentinel_;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static int variableNodeIteratorCallback_(void *key, int count, void* value, void *user);
+static int methodIteratorCallback_(void *key, int count, void* value, void *user);
+static bool collectStatementAccesses_(AccessGraphHandle_t graph, const ExpHandle_t expression);
+static bool collectExpressionAccesses_(AccessGraphHandle_t graph, const ExpHandle_t expression, StatementAccessHandle_t access);
+static bool countOperandAccess_(AccessGraphHandle_t graph, const ExpElementHandle_t operand, const bool isWrite, StatementAccessHandle_t access);
+static bool markVariableAccess_(AccessGraphHandle_t graph, VariableObjectHandle_t variable, const bool isWrite, StatementAccessHandle_t access);
+static bool addEdgeWeight_(AccessNodeHandle_t node, const uint32_t neighbour, const uint32_t weight);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for building access graph of object (class) variables
+ *
+ * @param[out] graph        graph object to fill
+ * @param[in] mainframe     parsed AST, methods bodies are walked
+ *
+ * @return                  Success state
+ */
+bool AccessGraph_build(AccessGraphHandle_t graph, const MainFrameHandle_t mainframe)
+{
+    const uint64_t variablesCount = Hashmap_size(&mainframe->classVariables);
+
+    graph->nodesCount = 0;
+    graph->nodes = calloc(variablesCount + 1, sizeof(AccessNode_t));
+    NULL_GUARD(graph->nodes, ERROR, Log_e(TAG, "Failed to allocate access graph nodes"));
+
+    ALLOC_CHECK(graph->nodeIndexByName, sizeof(Hashmap_t), ERROR);
+
+    if(!Hashmap_new(graph->nodeIndexByName, variablesCount + 1))
+    {
+        Log_e(TAG, "Failed to create node index hashmap");
+        return ERROR;
+    }
+
+    if(!Hashmap_forEach(&mainframe->classVariables, variableNodeIteratorCallback_, graph))
+    {
+        Log_e(TAG, "Failed to create access graph nodes");
+        return ERROR;
+    }
+
+    if(!Hashmap_forEach(&mainframe->methods, methodIteratorCallback_, graph))
+    {
+        Log_e(TAG, "Failed to collect method body accesses");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for deallocating access graph resources, variables itself are not touched
+ *
+ * @param[in/out] graph     graph object
+ */
+void AccessGraph_destroy(AccessGraphHandle_t graph)
+{
+    for(uint32_t nodeIdx = 0; nodeIdx < graph->nodesCount; nodeIdx++)
+    {
+        free(graph->nodes[nodeIdx].edges);
+    }
+
+    free(graph->nodes);
+    Hashmap_delete(graph->nodeIndexByName);
+
+    graph->nodes = NULL;
+    graph->nodeIndexByName = NULL;
+    graph->nodesCount = 0;
+}
+
+/**
+ * @brief Public method for getting how much node is used: own accesses plus co-accesses
+ *
+ * @param[in] graph     graph object
+ * @param[in] nodeIdx   node index
+ *
+ * @return              heat value, 0 if variable is never touched
+ */
+uint64_t AccessGraph_getNodeHeat(const AccessGraphHandle_t graph, const uint32_t nodeIdx)
+{
+    const AccessNodeHandle_t node = &graph->nodes[nodeIdx];
+    uint64_t heat = (uint64_t) node->variable->readCount + node->variable->writeCount;
+
+    for(uint32_t edgeIdx = 0; edgeIdx < node->edgesCount; edgeIdx++)
+    {
+        heat += node->edges[edgeIdx].weight;
+    }
+
+    return heat;
+}
+
+static int variableNodeIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    AccessGraphHandle_t graph = user;
+    VariableObjectHandle_t variable = value;
+
+    variable->readCount = 0;
+    variable->writeCount = 0;
+
+    graph->nodes[graph->nodesCount].variable = variable;
+    graph->nodes[graph->nodesCount].edges = NULL;
+    graph->nodes[graph->nodesCount].edgesCount = 0;
+    graph->nodes[graph->nodesCount].edgesCapacity = 0;
+
+    Hashmap_set(graph->nodeIndexByName, variable->objectName, (void*) (uintptr_t) graph->nodesCount);
+
+    graph->nodesCount++;
+
+    return SUCCESS;
+}
+
+static int methodIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    AccessGraphHandle_t graph = user;
+    MethodObjectHandle_t method = value;
+
+    if(!method->containsBody)
+    {
+        return SUCCESS;
+    }
+
+    for(size_t elementIdx = 0; elementIdx < method->body.scopeElementsList.currentSize; elementIdx++)
+    {
+        if(!collectStatementAccesses_(graph, method->body.scopeElementsList.expandable[elementIdx]))
+        {
+            Log_e(TAG, "Failed to collect accesses of method %s", method->methodName);
+            return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
+
+static bool collectStatementAccesses_(AccessGraphHandle_t graph, const ExpHandle_t expression)
+{
+    StatementAccess_t access;
+
+    access.count = 0;
+    access.capacity = 0;
+    access.nodes = NULL;
+
+    if(!collectExpressionAccesses_(graph, expression, &access))
+    {
+        free(access.nodes);
+        return ERROR;
+    }
+
+    // Every pair touched by same statement is co-accessed
+    for(uint32_t firstIdx = 0; firstIdx < access.count; firstIdx++)
+    {
+        for(uint32_t secondIdx = firstIdx + 1; secondIdx < access.count; secondIdx++)
+        {
+            if(!addEdgeWeight_(&graph->nodes[access.nodes[firstIdx]], access.nodes[secondIdx], 1) ||
+               !addEdgeWeight_(&graph->nodes[access.nodes[secondIdx]], access.nodes[firstIdx], 1))
+            {
+                free(access.nodes);
+                return ERROR;
+            }
+        }
+    }
+
+    free(access.nodes);
+
+    // Loop condition is statement of its own, body statements follow it
+    for(size_t elementIdx = 0; (expression->loopBody != NULL) && (elementIdx < expression->loopBody->currentSize); elementIdx++)
+    {
+        if(!collectStatementAccesses_(graph, expression->loopBody->expandable[elementIdx]))
+        {
+            return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
+
+static bool collectExpressionAccesses_(AccessGraphHandle_t graph, const ExpHandle_t expression, StatementAccessHandle_t access)
+{
+    DynamicStack_t operandStack;
+
+    if(!Stack_create(&operandStack))
+    {
+        Log_e(TAG, "Failed to create postfix simulation stack");
+        return ERROR;
+    }
+
+    // Simulating postfix evaluation, so left operand of '=' is known as written
+    for(ExpIterator_t iterator = Expression_iteratorFirst(expression); iterator < Expression_iteratorLast(expression); iterator++)
+    {
+        const ExpElementHandle_t symbol = *iterator;
+
+        if(ExpElement_isSymbolOperand(symbol))
+        {
+            if(!Stack_push(&operandStack, symbol))
+            {
+                Stack_destroy(&operandStack);
+                return ERROR;
+            }
+        }else if(ExpElement_isSymbolOperator(symbol))
+        {
+            const ExpElementHandle_t right = Stack_pop(&operandStack);
+            const ExpElementHandle_t left = Stack_pop(&operandStack);
+            const bool isSet = ((OperatorType_t) ExpElement_getObject(symbol)) == OP_SET;
+
+            if(!countOperandAccess_(graph, left, isSet, access) ||
+               !countOperandAccess_(graph, right, false, access))
+            {
+                Stack_destroy(&operandStack);
+                return ERROR;
+            }
+
+            if(!Stack_push(&operandStack, &operationResultSentinel_))
+            {
+                Stack_destroy(&operandStack);
+                return ERROR;
+            }
+        }
+    }
+
+    // Operands which were not consumed by operator, like one operand statements
+    while(!Stack_isEmpty(&operandStack))
+    {
+        if(!countOperandAccess_(graph, Stack_pop(&operandStack), false, access))
+        {
+            Stack_destroy(&operandStack);
+            return ERROR;
+        }
+    }
+
+    Stack_destroy(&operandStack);
+
+    return SUCCESS;
+}
+
+static bool countOperandAccess_(AccessGraphHandle_t graph, const ExpElementHandle_t operand, const bool isWrite, StatementAccessHandle_t access)
+{
+    if((operand == NULL) || (operand == &operationResultSentinel_))
+    {
+        return SUCCESS;
+    }
+
+    switch (ExpElement_getType(operand))
+    {
+        case EXP_VARIABLE:
+        {
+            return markVariableAccess_(graph, ExpElement_getObject(operand), isWrite, access);
+        }
+
+        case EXP_METHOD_CALL:
+        {
+            const ExMethodCallHandle_t methodCall = ExpElement_getObject(operand);
+
+            // Callee gets pointer to caller object words, so it may read and write them
+            if(methodCall->caller != NULL)
+            {
+                if(!markVariableAccess_(graph, methodCall->caller, false, access) ||
+                   !markVariableAccess_(graph, methodCall->caller, true, access))
+                {
+                    return ERROR;
+                }
+            }
+
+            // Arguments are evaluated in same statement, so they are co-accessed with it
+            for(size_t paramIdx = 0; paramIdx < methodCall->parameters.currentSize; paramIdx++)
+            {
+                if(!collectExpressionAccesses_(graph, methodCall->parameters.expandable[paramIdx], access))
+                {
+                    return ERROR;
+                }
+            }
+        }break;
+
+        default: break;
+    }
+
+    return SUCCESS;
+}
+
+static bool markVariableAccess_(AccessGraphHandle_t graph, VariableObjectHandle_t variable, const bool isWrite, StatementAccessHandle_t access)
+{
+    uint32_t nodeIdx;
+
+    if((variable == NULL) || (variable->objectName == NULL))
+    {
+        return SUCCESS;
+    }
+
+    // Array element is placed together with whole array
+    if(variable->arrayOwner != NULL)
+    {
+        variable = variable->arrayOwner;
+    }
+
+    if(!Hashmap_find(graph->nodeIndexByName, variable->objectName, strlen(variable->objectName)))
+    {
+        // Not object variable (local or parameter)
+        return SUCCESS;
+    }
+
+    nodeIdx = (uint32_t) (uintptr_t) *(graph->nodeIndexByName->value);
+
+    // Local variable can shadow object variable with same name
+    if(graph->nodes[nodeIdx].variable != variable)
+    {
+        return SUCCESS;
+    }
+
+    if(isWrite)
+    {
+        variable->writeCount++;
+    }else
+    {
+        variable->readCount++;
+    }
+
+    for(uint32_t accessIdx = 0; accessIdx < access->count; accessIdx++)
+    {
+        if(access->nodes[accessIdx] == nodeIdx)
+        {
+            return SUCCESS;
+        }
+    }
+
+    if(access->count == access->capacity)
+    {
+        access->capacity = (access->capacity == 0) ? EDGES_INITIAL_CAPACITY : access->capacity * 2;
+        REALLOC_CHECK(access->nodes, access->capacity * sizeof(uint32_t), ERROR);
+    }
+
+    access->nodes[access->count++] = nodeIdx;
+
+    return SUCCESS;
+}
+
+static bool addEdgeWeight_(AccessNodeHandle_t node, const uint32_t neighbour, const uint32_t weight)
+{
+    for(uint32_t edgeIdx = 0; edgeIdx < node->edgesCount; edgeIdx++)
+    {
+        if(node->edges[edgeIdx].neighbour == neighbour)
+        {
+            node->edges[edgeIdx].weight += weight;
+            return SUCCESS;
+        }
+    }
+
+    if(node->edgesCount == node->edgesCapacity)
+    {
+        node->edgesCapacity = (node->edgesCapacity == 0) ? EDGES_INITIAL_CAPACITY : node->edgesCapacity * 2;
+        REALLOC_CHECK(node->edges, node->edgesCapacity * sizeof(AccessEdge_t), ERROR);
+    }
+
+    node->edges[node->edgesCount].neighbour = neighbour;
+    node->edges[node->edgesCount].weight = weight;
+    node->edgesCount++;
+
+    return SUCCESS;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file access_graph.h
+ *
+ * Graph of object variables which are accessed together in method bodies
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-05-02
+ */
+
+#ifndef UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_ACCESS_GRAPH_H_
+#define UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_ACCESS_GRAPH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <hashmap.h>
+#include "../../structures/main_frame/main_frame.h"
+
+typedef struct
+{
+    uint32_t neighbour;
+    uint32_t weight;
+}AccessEdge_t;
+
+typedef struct
+{
+    VariableObjectHandle_t variable;
+    AccessEdge_t* edges;
+    uint32_t edgesCount;
+    uint32_t edgesCapacity;
+}AccessNode_t;
+
+typedef struct
+{
+    AccessNode_t* nodes;
+    uint32_t nodesCount;
+    HashmapHandle_t nodeIndexByName;
+}AccessGraph_t;
+
+typedef AccessNode_t* AccessNodeHandle_t;
+typedef AccessGraph_t* AccessGraphHandle_t;
+
+bool AccessGraph_build(AccessGraphHandle_t graph, const MainFrameHandle_t mainframe);
+void AccessGraph_destroy(AccessGraphHandle_t graph);
+uint64_t AccessGraph_getNodeHeat(const AccessGraphHandle_t graph, const uint32_t nodeIdx);
+
+#endif // UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_ACCESS_GRAPH_H_
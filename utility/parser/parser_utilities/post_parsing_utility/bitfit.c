@@ -1,20 +1,77 @@
 #include "bitfit.h"
 #include <stdlib.h>
 #include "../../structures/variable/variable.h"
-#include <arch_specific.h>
+#include <compiler_options.h>
 #include <logger.h>
+#include <safety_macros.h>
 
 
 static const char* TAG = "BITFIT";
 
-#define MAX_GROUPS_POSSIBLE         1024
+#define GROUP_TREE_INITIAL_LEAVES   8
+
+// Groups with segment tree of free bits on top, so leftmost group where variable fits
+// is found in O(log groups). Leaves after groupsCount are not opened yet and have no free bits.
+// First fit places everything through it, affinity fit its wide and never accessed variables,
+// hot-cold layout packs both parts with one of those two
+typedef struct
+{
+    uint32_t* used;
+    uint32_t* maxFree;
+    uint32_t groupsCount;
+    uint32_t leavesCapacity;
+    uint8_t groupSizeMax;
+}GroupTree_t;
+
+typedef GroupTree_t* GroupTreeHandle_t;
+
+// Seed candidate of affinity fit, seeds are taken in sorted order instead of searched for every group
+typedef struct
+{
+    uint64_t heat;
+    BitpackSize_t bitpack;
+    uint32_t nodeIdx;
+}SeedKey_t;
+
+// Variables always accessed alone, bucketed by write behaviour and width, so leftover bits of group
+// are filled largest first without going through every variable. Bucket of class and width is
+// nodes[start[bucket]..start[bucket + 1]), cursor skips taken ones
+typedef struct
+{
+    uint32_t* nodes;
+    uint32_t* start;
+    uint32_t* cursor;
+    uint8_t groupSizeMax;
+}LonerBuckets_t;
+
+typedef LonerBuckets_t* LonerBucketsHandle_t;
 
 typedef bool (*fitAssignFunction_t)(VectorHandler_t vector, const uint8_t groupSizeMax, BitpackSize_t* sizeNeededForVariables);
 
 static bool firstFitMethodFunction_(VectorHandler_t vector, const uint8_t groupSizeMax, BitpackSize_t* sizeNeededForVariables);
+static bool denseFitMethodFunction_(VectorHandler_t vector, const uint8_t groupSizeMax, BitpackSize_t* sizeNeededForVariables);
 
 static int variableIteratorCallback_(void *key, int count, void* value, void *user);
 
+static bool groupTreeInit_(GroupTreeHandle_t tree, const uint8_t groupSizeMax);
+static void groupTreeDestroy_(GroupTreeHandle_t tree);
+static bool groupTreeOpen_(GroupTreeHandle_t tree);
+static void groupTreeUse_(GroupTreeHandle_t tree, const uint32_t groupIdx, const uint32_t bits);
+static uint32_t groupTreeFindFirstFit_(const GroupTreeHandle_t tree, const uint32_t bits);
+static inline void groupTreePull_(GroupTreeHandle_t tree, const uint32_t nodeIdx);
+static bool placeFirstFit_(GroupTreeHandle_t tree, VariableObjectHandle_t variable);
+static void placeVariable_(GroupTreeHandle_t tree, VariableObjectHandle_t variable, const uint32_t groupIdx);
+static bool placeWideVariable_(GroupTreeHandle_t tree, VariableObjectHandle_t variable);
+static bool placeArrayVariable_(GroupTreeHandle_t tree, VariableObjectHandle_t variable);
+static BitpackSize_t groupTreeSizeBits_(const GroupTreeHandle_t tree);
+static bool addNeighbourScores_(const AccessNodeHandle_t node, uint64_t* score, uint32_t* candidates, uint32_t* candidatesCount);
+static inline bool isWriteHeavy_(const VariableObjectHandle_t variable);
+static int compNodes_(const void* elem1, const void* elem2);
+static int compSeeds_(const void* elem1, const void* elem2);
+static bool lonerBucketsInit_(LonerBucketsHandle_t buckets, const AccessGraphHandle_t graph, const uint64_t* heat, const bool* placed, const uint8_t groupSizeMax);
+static void lonerBucketsDestroy_(LonerBucketsHandle_t buckets);
+static void lonerBucketsFill_(LonerBucketsHandle_t buckets, GroupTreeHandle_t tree, const AccessGraphHandle_t graph, bool* placed, const uint32_t groupIdx, const bool writeHeavy);
+
 int comp (const void* elem1, const void* elem2);
 
 
@@ -47,78 +104,697 @@ bool Bitfit_assignGroupsAndPositionForVariableVector_(const VectorHandler_t vari
     switch (fitType)
     {
         case FIRST_FIT: bitFitFunction = firstFitMethodFunction_; break;
+        case DENSE_FIT: bitFitFunction = denseFitMethodFunction_; break;
 
         // Other fits not supported yet
         default: return ERROR;
     }
 
-    return bitFitFunction(variablesVector, ARCHITECTURE_DEFAULT_BITS, sizeNeededForVariables);
+    return bitFitFunction(variablesVector, CompilerOptions_get()->wordBits, sizeNeededForVariables);
 }
 
 
 static bool firstFitMethodFunction_(VectorHandler_t vector, const uint8_t groupSizeMax, BitpackSize_t* sizeNeededForVariables)
 {
-    // TODO: change this number later
-    uint32_t used[MAX_GROUPS_POSSIBLE] = {0};
-
-    uint32_t highestGroupIdxReached = 0;
+    GroupTree_t tree;
+    bool status = ERROR;
 
     // It wont sort original vector but variables get their assigning
     VectorHandler_t tempSortedVector = Vector_duplicate(vector);
-    
+    NULL_GUARD(tempSortedVector, ERROR, Log_e(TAG, "Failed to duplicate variables vector"));
+
+    if(!groupTreeInit_(&tree, groupSizeMax))
+    {
+        Log_e(TAG, "Failed to create groups tree");
+        goto cleanup;
+    }
+
     // Sort fields by bitsize (largest first)
     qsort (tempSortedVector->expandable, tempSortedVector->currentSize, sizeof(VariableObjectHandle_t), comp);
 
     for (uint32_t varIdx = 0; varIdx < tempSortedVector->currentSize; varIdx++) {
 
-        VariableObjectHandle_t variable;
-        bool placed;
+        VariableObjectHandle_t variable = (VariableObjectHandle_t) tempSortedVector->expandable[varIdx];
+
+        if (!placeFirstFit_(&tree, variable)) 
+        {
+            Log_e(TAG, "Failed to place bit:%llu(%s) %s", variable->bitpack, variable->castedFile, variable->objectName);
+            goto cleanup;
+        }
+    }
+
+    *sizeNeededForVariables = groupTreeSizeBits_(&tree);
+
+    status = SUCCESS;
+
+cleanup:
+    groupTreeDestroy_(&tree);
+    free(tempSortedVector->expandable);
+    free(tempSortedVector);
+
+    return status;
+}
+
+
+/**
+ * @brief Packs variables one after another without padding, variable may continue in next group.
+ * Wide variables and object typed variables still start on group beginning,
+ * because they are accessed by group address.
+ */
+static bool denseFitMethodFunction_(VectorHandler_t vector, const uint8_t groupSizeMax, BitpackSize_t* sizeNeededForVariables)
+{
+    BitpackSize_t bitOffset = 0;
+
+    VectorHandler_t tempSortedVector = Vector_duplicate(vector);
+    NULL_GUARD(tempSortedVector, ERROR, Log_e(TAG, "Failed to duplicate variables vector"));
+
+    // Largest first, so aligned ones are placed before stream gets unaligned
+    qsort(tempSortedVector->expandable, tempSortedVector->currentSize, sizeof(VariableObjectHandle_t), comp);
+
+    for(uint32_t varIdx = 0; varIdx < tempSortedVector->currentSize; varIdx++)
+    {
+        const VariableObjectHandle_t variable = (VariableObjectHandle_t) tempSortedVector->expandable[varIdx];
+
+        if((variable->bitpack > groupSizeMax) || (variable->castedFile != NULL) || BITFIT_IS_ARRAY(variable))
+        {
+            bitOffset = BITFIT_LIMBS_COUNT(bitOffset, groupSizeMax) * groupSizeMax;
+        }
+
+        variable->belongToGroup = bitOffset / groupSizeMax;
+        variable->posBit = bitOffset % groupSizeMax;
+
+        if(BITFIT_IS_ARRAY(variable))
+        {
+            bitOffset += (BitpackSize_t) BITFIT_ARRAY_GROUPS(variable, groupSizeMax) * groupSizeMax;
+        }else
+        {
+            bitOffset += variable->bitpack;
+        }
+    }
+
+    free(tempSortedVector->expandable);
+    free(tempSortedVector);
+
+    *sizeNeededForVariables = bitOffset;
+
+    return SUCCESS;
+}
+
+
+/**
+ * @brief Public method for packing object variables, so variables accessed together share same group
+ *
+ * Groups are grown from the most used variable by adding variables which have the highest
+ * co-access weight with group members. Write heavy and read mostly variables are kept apart
+ * when there is a choice. Never accessed variables fill what is left with first fit.
+ * Seeds come from presorted order and leftovers from width buckets, so packing takes
+ * O(n log n) plus co-access edges of placed variables, same as first fit.
+ *
+ * @param[in] graph                     access graph of object variables
+ * @param[in] excludedNodes             nodes which are left untouched, NULL for none
+ * @param[out] sizeNeededForVariables   bits needed for all groups
+ *
+ * @return                              Success state
+ */
+bool Bitfit_assignGroupsAndPositionByAffinity_(const AccessGraphHandle_t graph, const bool* excludedNodes, BitpackSize_t* sizeNeededForVariables)
+{
+    const uint8_t groupSizeMax = CompilerOptions_get()->wordBits;
+
+    GroupTree_t tree;
+    LonerBuckets_t loners = {NULL, NULL, NULL, groupSizeMax};
+    uint32_t candidatesCount = 0;
+    uint32_t seedsCount = 0;
+    uint32_t seedCursor = 0;
+    bool status = ERROR;
+
+    uint64_t* heat = calloc(graph->nodesCount + 1, sizeof(uint64_t));
+    uint64_t* score = calloc(graph->nodesCount + 1, sizeof(uint64_t));
+    uint32_t* candidates = calloc(graph->nodesCount + 1, sizeof(uint32_t));
+    bool* placed = calloc(graph->nodesCount + 1, sizeof(bool));
+    AccessNodeHandle_t* sortedNodes = calloc(graph->nodesCount + 1, sizeof(AccessNodeHandle_t));
+    SeedKey_t* seeds = calloc(graph->nodesCount + 1, sizeof(SeedKey_t));
+
+    if(!groupTreeInit_(&tree, groupSizeMax))
+    {
+        Log_e(TAG, "Failed to create groups tree");
+        goto cleanup;
+    }
+
+    if((heat == NULL) || (score == NULL) || (candidates == NULL) || (placed == NULL) || (sortedNodes == NULL) || (seeds == NULL))
+    {
+        Log_e(TAG, "Failed to allocate affinity fit buffers");
+        goto cleanup;
+    }
+
+    for(uint32_t nodeIdx = 0; nodeIdx < graph->nodesCount; nodeIdx++)
+    {
+        heat[nodeIdx] = AccessGraph_getNodeHeat(graph, nodeIdx);
+        sortedNodes[nodeIdx] = &graph->nodes[nodeIdx];
+        placed[nodeIdx] = (excludedNodes != NULL) && excludedNodes[nodeIdx];
+    }
+
+    // Largest first order used for filling leftovers of groups
+    qsort(sortedNodes, graph->nodesCount, sizeof(AccessNodeHandle_t), compNodes_);
+
+    // Wider than group variables and arrays take whole groups of their own, co-access does not matter for them
+    for(uint32_t nodeIdx = 0; nodeIdx < graph->nodesCount; nodeIdx++)
+    {
+        const VariableObjectHandle_t variable = graph->nodes[nodeIdx].variable;
+
+        if(placed[nodeIdx] || ((variable->bitpack <= groupSizeMax) && !BITFIT_IS_ARRAY(variable)))
+        {
+            continue;
+        }
+
+        if(!placeFirstFit_(&tree, variable))
+        {
+            goto cleanup;
+        }
+
+        placed[nodeIdx] = true;
+    }
+
+    // Hottest, then widest variable seeds next group, placed ones are skipped when reached
+    for(uint32_t nodeIdx = 0; nodeIdx < graph->nodesCount; nodeIdx++)
+    {
+        if(!placed[nodeIdx] && (heat[nodeIdx] != 0))
+        {
+            seeds[seedsCount].heat = heat[nodeIdx];
+            seeds[seedsCount].bitpack = graph->nodes[nodeIdx].variable->bitpack;
+            seeds[seedsCount].nodeIdx = nodeIdx;
+            seedsCount++;
+        }
+    }
+
+    qsort(seeds, seedsCount, sizeof(SeedKey_t), compSeeds_);
+
+    if(!lonerBucketsInit_(&loners, graph, heat, placed, groupSizeMax))
+    {
+        goto cleanup;
+    }
+
+    while(true)
+    {
+        uint32_t seedIdx;
+
+        while((seedCursor < seedsCount) && placed[seeds[seedCursor].nodeIdx])
+        {
+            seedCursor++;
+        }
+
+        if(seedCursor == seedsCount)
+        {
+            break;
+        }
+
+        seedIdx = seeds[seedCursor].nodeIdx;
+
+        if(!groupTreeOpen_(&tree))
+        {
+            goto cleanup;
+        }
+
+        const uint32_t groupIdx = tree.groupsCount - 1;
+        const bool groupWriteHeavy = isWriteHeavy_(graph->nodes[seedIdx].variable);
+
+        for(uint32_t candidateIdx = 0; candidateIdx < candidatesCount; candidateIdx++)
+        {
+            score[candidates[candidateIdx]] = 0;
+        }
+        candidatesCount = 0;
+
+        placeVariable_(&tree, graph->nodes[seedIdx].variable, groupIdx);
+        placed[seedIdx] = true;
 
-        variable = (VariableObjectHandle_t) tempSortedVector->expandable[varIdx];
-        placed = false;
+        if(!addNeighbourScores_(&graph->nodes[seedIdx], score, candidates, &candidatesCount))
+        {
+            goto cleanup;
+        }
 
-        for (int groupIdx = 0; groupIdx < MAX_GROUPS_POSSIBLE; ++groupIdx) 
+        // Growing group by strongest co-access with already placed members
+        while(true)
         {
-            if (used[groupIdx] + variable->bitpack <= groupSizeMax) 
+            int64_t bestIdx = -1;
+            uint64_t bestScore = 0;
+
+            for(uint32_t candidateIdx = 0; candidateIdx < candidatesCount; candidateIdx++)
             {
-                variable->belongToGroup = groupIdx;
-                variable->posBit = used[groupIdx];
+                const uint32_t nodeIdx = candidates[candidateIdx];
+                const VariableObjectHandle_t variable = graph->nodes[nodeIdx].variable;
+                uint64_t candidateScore;
 
-                used[groupIdx] += variable->bitpack;
+                if(placed[nodeIdx] || (tree.used[groupIdx] + variable->bitpack > groupSizeMax))
+                {
+                    continue;
+                }
 
-                placed = true;
+                candidateScore = score[nodeIdx] * ((isWriteHeavy_(variable) == groupWriteHeavy) ? 2 : 1);
 
-                if(highestGroupIdxReached < groupIdx)
+                if(candidateScore > bestScore)
                 {
-                    highestGroupIdxReached = groupIdx;
+                    bestScore = candidateScore;
+                    bestIdx = nodeIdx;
                 }
+            }
 
+            if(bestIdx < 0)
+            {
                 break;
             }
-        }
 
-        if (!placed) 
-        {
-            if(variable->bitpack > groupSizeMax)
-            {
-                Log_e(TAG, "Error bigger than %u not supported now", groupSizeMax);
-            }else
+            placeVariable_(&tree, graph->nodes[bestIdx].variable, groupIdx);
+            placed[bestIdx] = true;
+
+            if(!addNeighbourScores_(&graph->nodes[bestIdx], score, candidates, &candidatesCount))
             {
-                Log_e(TAG, "ERROR: Too much bit groups, bit:%llu(%s) %s doesnt fit\n", variable->bitpack, variable->castedFile, variable->objectName);
+                goto cleanup;
             }
+        }
+
+        // Leftover bits are given to variables which are always accessed alone with same write behaviour,
+        // they do not add loads to anybody else
+        lonerBucketsFill_(&loners, &tree, graph, placed, groupIdx, groupWriteHeavy);
+    }
+
+    // Never accessed variables, first fit into whatever space is left
+    for(uint32_t sortedIdx = 0; sortedIdx < graph->nodesCount; sortedIdx++)
+    {
+        const AccessNodeHandle_t node = sortedNodes[sortedIdx];
+        const uint32_t nodeIdx = node - graph->nodes;
+
+        if(placed[nodeIdx])
+        {
+            continue;
+        }
+
+        if(!placeFirstFit_(&tree, node->variable))
+        {
+            goto cleanup;
+        }
+
+        placed[nodeIdx] = true;
+    }
+
+    *sizeNeededForVariables = groupTreeSizeBits_(&tree);
+
+    status = SUCCESS;
+
+cleanup:
+    groupTreeDestroy_(&tree);
+    lonerBucketsDestroy_(&loners);
+    free(seeds);
+    free(heat);
+    free(score);
+    free(candidates);
+    free(placed);
+    free(sortedNodes);
+
+    return status;
+}
+
+
+static bool groupTreeInit_(GroupTreeHandle_t tree, const uint8_t groupSizeMax)
+{
+    tree->groupsCount = 0;
+    tree->leavesCapacity = GROUP_TREE_INITIAL_LEAVES;
+    tree->groupSizeMax = groupSizeMax;
+    tree->used = calloc(tree->leavesCapacity, sizeof(uint32_t));
+    tree->maxFree = calloc(tree->leavesCapacity * 2, sizeof(uint32_t));
+
+    if((tree->used == NULL) || (tree->maxFree == NULL))
+    {
+        Log_e(TAG, "Failed to allocate groups tree");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+
+static void groupTreeDestroy_(GroupTreeHandle_t tree)
+{
+    free(tree->used);
+    free(tree->maxFree);
+
+    tree->used = NULL;
+    tree->maxFree = NULL;
+}
+
+
+/**
+ * @brief Opens new empty group at the end, tree is doubled and rebuilt when leaves run out
+ */
+static bool groupTreeOpen_(GroupTreeHandle_t tree)
+{
+    if(tree->groupsCount == tree->leavesCapacity)
+    {
+        const uint32_t newCapacity = tree->leavesCapacity * 2;
+
+        REALLOC_CHECK(tree->used, newCapacity * sizeof(uint32_t), ERROR);
+        free(tree->maxFree);
+
+        tree->maxFree = calloc(newCapacity * 2, sizeof(uint32_t));
+        NULL_GUARD(tree->maxFree, ERROR, Log_e(TAG, "Failed to grow groups tree"));
+
+        tree->leavesCapacity = newCapacity;
+
+        for(uint32_t groupIdx = 0; groupIdx < tree->groupsCount; groupIdx++)
+        {
+            tree->maxFree[newCapacity + groupIdx] = tree->groupSizeMax - tree->used[groupIdx];
+        }
+
+        for(uint32_t nodeIdx = newCapacity - 1; nodeIdx > 0; nodeIdx--)
+        {
+            groupTreePull_(tree, nodeIdx);
+        }
+    }
+
+    tree->used[tree->groupsCount] = 0;
+    tree->groupsCount++;
+
+    groupTreeUse_(tree, tree->groupsCount - 1, 0);
+
+    return SUCCESS;
+}
+
+
+static void groupTreeUse_(GroupTreeHandle_t tree, const uint32_t groupIdx, const uint32_t bits)
+{
+    uint32_t nodeIdx = tree->leavesCapacity + groupIdx;
+
+    tree->used[groupIdx] += bits;
+    tree->maxFree[nodeIdx] = tree->groupSizeMax - tree->used[groupIdx];
 
-            return ERROR;   
+    for(nodeIdx /= 2; nodeIdx > 0; nodeIdx /= 2)
+    {
+        groupTreePull_(tree, nodeIdx);
+    }
+}
+
+
+static inline void groupTreePull_(GroupTreeHandle_t tree, const uint32_t nodeIdx)
+{
+    const uint32_t leftFree = tree->maxFree[nodeIdx * 2];
+    const uint32_t rightFree = tree->maxFree[nodeIdx * 2 + 1];
+
+    tree->maxFree[nodeIdx] = (leftFree > rightFree) ? leftFree : rightFree;
+}
+
+
+/**
+ * @brief Finds leftmost opened group with enough free bits
+ *
+ * @return      group index, groupsCount if no opened group fits
+ */
+static uint32_t groupTreeFindFirstFit_(const GroupTreeHandle_t tree, const uint32_t bits)
+{
+    uint32_t nodeIdx = 1;
+
+    if((tree->groupsCount == 0) || (tree->maxFree[nodeIdx] < bits))
+    {
+        return tree->groupsCount;
+    }
+
+    while(nodeIdx < tree->leavesCapacity)
+    {
+        nodeIdx = (tree->maxFree[nodeIdx * 2] >= bits) ? (nodeIdx * 2) : (nodeIdx * 2 + 1);
+    }
+
+    return nodeIdx - tree->leavesCapacity;
+}
+
+
+static bool placeFirstFit_(GroupTreeHandle_t tree, VariableObjectHandle_t variable)
+{
+    uint32_t groupIdx;
+
+    if(BITFIT_IS_ARRAY(variable))
+    {
+        return placeArrayVariable_(tree, variable);
+    }
+
+    if(variable->bitpack > tree->groupSizeMax)
+    {
+        return placeWideVariable_(tree, variable);
+    }
+
+    groupIdx = groupTreeFindFirstFit_(tree, variable->bitpack);
+
+    if((groupIdx == tree->groupsCount) && !groupTreeOpen_(tree))
+    {
+        return ERROR;
+    }
+
+    placeVariable_(tree, variable, groupIdx);
+
+    return SUCCESS;
+}
+
+
+static void placeVariable_(GroupTreeHandle_t tree, VariableObjectHandle_t variable, const uint32_t groupIdx)
+{
+    variable->belongToGroup = groupIdx;
+    variable->posBit = tree->used[groupIdx];
+
+    groupTreeUse_(tree, groupIdx, variable->bitpack);
+}
+
+
+/**
+ * @brief Wide variable limbs go from least significant in first group, top limb takes beginning
+ * of last group, so its leftover stays usable for other variables. Every opened group
+ * holds something already, so whole free groups are only found at the end
+ */
+static bool placeWideVariable_(GroupTreeHandle_t tree, VariableObjectHandle_t variable)
+{
+    const uint32_t limbs = BITFIT_LIMBS_COUNT(variable->bitpack, tree->groupSizeMax);
+    const uint32_t firstGroupIdx = tree->groupsCount;
+
+    for(uint32_t limbIdx = 0; limbIdx < limbs; limbIdx++)
+    {
+        if(!groupTreeOpen_(tree))
+        {
+            return ERROR;
+        }
+    }
+
+    variable->belongToGroup = firstGroupIdx;
+    variable->posBit = 0;
+
+    for(uint32_t limbIdx = 0; limbIdx < limbs - 1; limbIdx++)
+    {
+        groupTreeUse_(tree, firstGroupIdx + limbIdx, tree->groupSizeMax);
+    }
+
+    groupTreeUse_(tree, firstGroupIdx + limbs - 1, variable->bitpack - ((BitpackSize_t) (limbs - 1) * tree->groupSizeMax));
+
+    return SUCCESS;
+}
+
+
+/**
+ * @brief Array groups are opened at the end and used up completely, padding lanes of last group
+ * belong to array, so bulk operations may touch whole words
+ */
+static bool placeArrayVariable_(GroupTreeHandle_t tree, VariableObjectHandle_t variable)
+{
+    const uint32_t groups = BITFIT_ARRAY_GROUPS(variable, tree->groupSizeMax);
+    const uint32_t firstGroupIdx = tree->groupsCount;
+
+    for(uint32_t groupIdx = 0; groupIdx < groups; groupIdx++)
+    {
+        if(!groupTreeOpen_(tree))
+        {
+            return ERROR;
+        }
+
+        groupTreeUse_(tree, firstGroupIdx + groupIdx, tree->groupSizeMax);
+    }
+
+    variable->belongToGroup = firstGroupIdx;
+    variable->posBit = 0;
+
+    return SUCCESS;
+}
+
+
+/**
+ * @brief Public method for placing array element view by its array, element i is in lane i % lanes
+ * of group i / lanes counting from array first group
+ *
+ * @param[in/out] element   view of array element
+ * @param[in] groupSize     bits in group
+ */
+void Bitfit_resolveArrayElement(const VariableObjectHandle_t element, const uint8_t groupSize)
+{
+    const VariableObjectHandle_t array = element->arrayOwner;
+    const uint32_t lanes = BITFIT_ARRAY_LANES(array->bitpack, groupSize);
+
+    element->scopeName = array->scopeName;
+    element->bitpack = array->bitpack;
+    element->belongToGroup = array->belongToGroup + (element->arrayIndex / lanes);
+    element->posBit = (element->arrayIndex % lanes) * array->bitpack;
+}
+
+
+static BitpackSize_t groupTreeSizeBits_(const GroupTreeHandle_t tree)
+{
+    if(tree->groupsCount == 0)
+    {
+        return 0;
+    }
+
+    return ((BitpackSize_t) (tree->groupsCount - 1) * tree->groupSizeMax) + tree->used[tree->groupsCount - 1];
+}
+
+
+static bool addNeighbourScores_(const AccessNodeHandle_t node, uint64_t* score, uint32_t* candidates, uint32_t* candidatesCount)
+{
+    for(uint32_t edgeIdx = 0; edgeIdx < node->edgesCount; edgeIdx++)
+    {
+        const uint32_t neighbour = node->edges[edgeIdx].neighbour;
+
+        if(score[neighbour] == 0)
+        {
+            candidates[(*candidatesCount)++] = neighbour;
+        }
+
+        score[neighbour] += node->edges[edgeIdx].weight;
+    }
+
+    return SUCCESS;
+}
+
+
+static inline bool isWriteHeavy_(const VariableObjectHandle_t variable)
+{
+    return (variable->writeCount > 0) && (variable->writeCount >= variable->readCount);
+}
+
+
+static int compNodes_(const void* elem1, const void* elem2)
+{
+    const AccessNodeHandle_t a = *((AccessNodeHandle_t*) elem1);
+    const AccessNodeHandle_t b = *((AccessNodeHandle_t*) elem2);
+
+    return comp(&a->variable, &b->variable);
+}
+
+
+static int compSeeds_(const void* elem1, const void* elem2)
+{
+    const SeedKey_t* a = elem1;
+    const SeedKey_t* b = elem2;
+
+    if(a->heat != b->heat)
+    {
+        return (a->heat < b->heat) ? 1 : -1;
+    }
+
+    if(a->bitpack != b->bitpack)
+    {
+        return (a->bitpack < b->bitpack) ? 1 : -1;
+    }
+
+    return (a->nodeIdx < b->nodeIdx) ? -1 : 1;
+}
+
+
+static bool lonerBucketsInit_(LonerBucketsHandle_t buckets, const AccessGraphHandle_t graph, const uint64_t* heat, const bool* placed, const uint8_t groupSizeMax)
+{
+    // Two write classes of widths 0..groupSizeMax, one more entry ends last bucket
+    const uint32_t bucketsCount = 2 * ((uint32_t) groupSizeMax + 1);
+
+    buckets->groupSizeMax = groupSizeMax;
+    buckets->nodes = calloc(graph->nodesCount + 1, sizeof(uint32_t));
+    buckets->start = calloc(bucketsCount + 1, sizeof(uint32_t));
+    buckets->cursor = calloc(bucketsCount, sizeof(uint32_t));
+
+    if((buckets->nodes == NULL) || (buckets->start == NULL) || (buckets->cursor == NULL))
+    {
+        Log_e(TAG, "Failed to allocate loner buckets");
+        return ERROR;
+    }
+
+    for(uint32_t nodeIdx = 0; nodeIdx < graph->nodesCount; nodeIdx++)
+    {
+        const AccessNodeHandle_t node = &graph->nodes[nodeIdx];
+
+        if(!placed[nodeIdx] && (heat[nodeIdx] != 0) && (node->edgesCount == 0))
+        {
+            buckets->start[(isWriteHeavy_(node->variable) * (groupSizeMax + 1)) + node->variable->bitpack + 1]++;
+        }
+    }
+
+    for(uint32_t bucketIdx = 0; bucketIdx < bucketsCount; bucketIdx++)
+    {
+        buckets->start[bucketIdx + 1] += buckets->start[bucketIdx];
+        buckets->cursor[bucketIdx] = buckets->start[bucketIdx];
+    }
+
+    for(uint32_t nodeIdx = 0; nodeIdx < graph->nodesCount; nodeIdx++)
+    {
+        const AccessNodeHandle_t node = &graph->nodes[nodeIdx];
+
+        if(!placed[nodeIdx] && (heat[nodeIdx] != 0) && (node->edgesCount == 0))
+        {
+            const uint32_t bucketIdx = (isWriteHeavy_(node->variable) * (groupSizeMax + 1)) + node->variable->bitpack;
+
+            buckets->nodes[buckets->cursor[bucketIdx]++] = nodeIdx;
         }
     }
 
-    *sizeNeededForVariables = (highestGroupIdxReached * groupSizeMax) + used[highestGroupIdxReached];
+    for(uint32_t bucketIdx = 0; bucketIdx < bucketsCount; bucketIdx++)
+    {
+        buckets->cursor[bucketIdx] = buckets->start[bucketIdx];
+    }
 
     return SUCCESS;
 }
 
 
+static void lonerBucketsDestroy_(LonerBucketsHandle_t buckets)
+{
+    free(buckets->nodes);
+    free(buckets->start);
+    free(buckets->cursor);
+}
+
+
+static void lonerBucketsFill_(LonerBucketsHandle_t buckets, GroupTreeHandle_t tree, const AccessGraphHandle_t graph, bool* placed, const uint32_t groupIdx, const bool writeHeavy)
+{
+    const uint32_t classOffset = writeHeavy * ((uint32_t) buckets->groupSizeMax + 1);
+
+    // Widest first, group gets full before narrow variables are reached
+    for(int32_t width = buckets->groupSizeMax - tree->used[groupIdx]; width >= 0; width--)
+    {
+        const uint32_t bucketIdx = classOffset + (uint32_t) width;
+
+        while((buckets->cursor[bucketIdx] < buckets->start[bucketIdx + 1]) && (tree->used[groupIdx] + width <= buckets->groupSizeMax))
+        {
+            const uint32_t nodeIdx = buckets->nodes[buckets->cursor[bucketIdx]++];
+
+            // Loner could have seeded group of its own already
+            if(placed[nodeIdx])
+            {
+                continue;
+            }
+
+            placeVariable_(tree, graph->nodes[nodeIdx].variable, groupIdx);
+            placed[nodeIdx] = true;
+        }
+    }
+}
+
+
 static int variableIteratorCallback_(void *key, int count, void* value, void *user)
 {
+    // Objects placed with ds / dh get own words, packed region has no space for them
+    if(((VariableObjectHandle_t) value)->allocation != ALLOCATION_STATIC_STACK)
+    {
+        return SUCCESS;
+    }
+
     return Vector_append((VectorHandler_t) user, value);
 }
 
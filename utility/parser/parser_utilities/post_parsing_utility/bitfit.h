@@ -19,15 +19,30 @@
 #include <hashmap.h>
 #include <typedefs.h>
 #include <vector.h>
+#include "access_graph.h"
+
+// Count of whole groups needed for variable wider than one group
+#define BITFIT_LIMBS_COUNT(bitpack, groupSize)      (((bitpack) + (groupSize) - 1) / (groupSize))
+
+// Variable continues in next group, possible only with dense fit
+#define BITFIT_IS_STRADDLING(variable, groupSize)   (((variable)->bitpack <= (groupSize)) && (((variable)->posBit + (variable)->bitpack) > (groupSize)))
+
+// Packed array elements never cross word, so unused low bits of each word stay as padding
+#define BITFIT_IS_ARRAY(variable)                   ((variable)->arrayLength > 0)
+#define BITFIT_ARRAY_LANES(bitpack, groupSize)      ((groupSize) / (bitpack))
+#define BITFIT_ARRAY_GROUPS(variable, groupSize)    (((variable)->arrayLength + BITFIT_ARRAY_LANES((variable)->bitpack, groupSize) - 1) / BITFIT_ARRAY_LANES((variable)->bitpack, groupSize))
 
 typedef enum
 {
     FIRST_FIT,
     NEXT_FIT,
-    FULL_FIT
+    FULL_FIT,
+    DENSE_FIT
 }BitFitMethod_t;
 
 bool Bitfit_assignGroupsAndPositionForVariableHashmap_(const HashmapHandle_t variablesHashmap, const BitFitMethod_t fitType, BitpackSize_t* sizeNeededForVariables);
 bool Bitfit_assignGroupsAndPositionForVariableVector_(const VectorHandler_t variablesVector, const BitFitMethod_t fitType, BitpackSize_t* sizeNeededForVariables);
+bool Bitfit_assignGroupsAndPositionByAffinity_(const AccessGraphHandle_t graph, const bool* excludedNodes, BitpackSize_t* sizeNeededForVariables);
+void Bitfit_resolveArrayElement(const VariableObjectHandle_t element, const uint8_t groupSize);
 
 #endif // UTILITY_PARSER_PARSER_UTILITIES_BITFIT_H_
\ No newline at end of file
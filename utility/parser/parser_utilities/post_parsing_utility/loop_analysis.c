@@ -0,0 +1,266 @@
+/**
+ * @file loop_analysis.c
+ *
+ * Variables used by loop condition and body, with reads and writes counted
+ *
+ * Whole loop is walked, nested loops and call arguments included. Left operand of '='
+ * is counted as write, every other variable operand as read. Generator uses it to keep
+ * packed variables of loop in plain words instead of extracting them on every pass.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-24
+ */
+
+#include "loop_analysis.h"
+#include <stdlib.h>
+#include <string.h>
+#include <logger.h>
+#include <dstack.h>
+#include <safety_macros.h>
+#include <global_config.h>
+
+////////////////////////////////
+// DEFINES
+
+#define USES_INITIAL_CAPACITY       8
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+static const char* TAG = "LOOP_ANALYSIS";
+
+// Builtins are generated in place, they never get object words
+static const char* const builtinMethods_[] = {"print", "popcount"};
+
+////////////////////////////////
+// PRIVATE TYPES
+
+// Marks result of operation on postfix simulation stack
+static ExpElement_t operationResultSentinel_;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static bool collectStatements_(LoopAnalysisHandle_t analysis, const VectorHandler_t statements);
+static bool collectExpression_(LoopAnalysisHandle_t analysis, const ExpHandle_t expression);
+static bool countOperand_(LoopAnalysisHandle_t analysis, const ExpElementHandle_t operand, const bool isWrite);
+static bool markVariableUse_(LoopAnalysisHandle_t analysis, const VariableObjectHandle_t variable, const bool isWrite);
+static bool isBuiltinMethod_(const ExMethodCallHandle_t methodCall);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for collecting variables used by loop
+ *
+ * @param[out] analysis     analysis object to fill, released with LoopAnalysis_destroy
+ * @param[in] loop          loop expression, its elements are condition or count
+ *
+ * @return                  Success state
+ */
+bool LoopAnalysis_collect(LoopAnalysisHandle_t analysis, const ExpHandle_t loop)
+{
+    analysis->uses = NULL;
+    analysis->usesCount = 0;
+    analysis->usesCapacity = 0;
+    analysis->callsOwnMethods = false;
+
+    if(!collectExpression_(analysis, loop))
+    {
+        Log_e(TAG, "Failed to collect loop condition variables");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for deallocating analysis resources, variables itself are not touched
+ *
+ * @param[in/out] analysis  analysis object
+ */
+void LoopAnalysis_destroy(LoopAnalysisHandle_t analysis)
+{
+    free(analysis->uses);
+
+    analysis->uses = NULL;
+    analysis->usesCount = 0;
+    analysis->usesCapacity = 0;
+}
+
+static bool collectStatements_(LoopAnalysisHandle_t analysis, const VectorHandler_t statements)
+{
+    for(size_t statementIdx = 0; statementIdx < statements->currentSize; statementIdx++)
+    {
+        if(!collectExpression_(analysis, statements->expandable[statementIdx]))
+        {
+            return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
+
+static bool collectExpression_(LoopAnalysisHandle_t analysis, const ExpHandle_t expression)
+{
+    DynamicStack_t operandStack;
+
+    if(!Stack_create(&operandStack))
+    {
+        Log_e(TAG, "Failed to create postfix simulation stack");
+        return ERROR;
+    }
+
+    // Simulating postfix evaluation, so left operand of '=' is known as written
+    for(ExpIterator_t iterator = Expression_iteratorFirst(expression); iterator < Expression_iteratorLast(expression); iterator++)
+    {
+        const ExpElementHandle_t symbol = *iterator;
+
+        if(ExpElement_isSymbolOperand(symbol))
+        {
+            if(!Stack_push(&operandStack, symbol))
+            {
+                Stack_destroy(&operandStack);
+                return ERROR;
+            }
+        }else if(ExpElement_isSymbolOperator(symbol))
+        {
+            const ExpElementHandle_t right = Stack_pop(&operandStack);
+            const ExpElementHandle_t left = Stack_pop(&operandStack);
+            const bool isSet = ((OperatorType_t) ExpElement_getObject(symbol)) == OP_SET;
+
+            if(!countOperand_(analysis, left, isSet) || !countOperand_(analysis, right, false) ||
+               !Stack_push(&operandStack, &operationResultSentinel_))
+            {
+                Stack_destroy(&operandStack);
+                return ERROR;
+            }
+        }
+    }
+
+    // Operands which were not consumed by operator, like one operand statements
+    while(!Stack_isEmpty(&operandStack))
+    {
+        if(!countOperand_(analysis, Stack_pop(&operandStack), false))
+        {
+            Stack_destroy(&operandStack);
+            return ERROR;
+        }
+    }
+
+    Stack_destroy(&operandStack);
+
+    if(expression->loopBody != NULL)
+    {
+        return collectStatements_(analysis, expression->loopBody);
+    }
+
+    return SUCCESS;
+}
+
+static bool countOperand_(LoopAnalysisHandle_t analysis, const ExpElementHandle_t operand, const bool isWrite)
+{
+    if((operand == NULL) || (operand == &operationResultSentinel_))
+    {
+        return SUCCESS;
+    }
+
+    switch (ExpElement_getType(operand))
+    {
+        case EXP_VARIABLE:
+        {
+            return markVariableUse_(analysis, ExpElement_getObject(operand), isWrite);
+        }
+
+        case EXP_METHOD_CALL:
+        {
+            const ExMethodCallHandle_t methodCall = ExpElement_getObject(operand);
+
+            if(methodCall->caller != NULL)
+            {
+                // Callee gets pointer to caller object words
+                if(!markVariableUse_(analysis, methodCall->caller, false) ||
+                   !markVariableUse_(analysis, methodCall->caller, true))
+                {
+                    return ERROR;
+                }
+
+            }else if(!isBuiltinMethod_(methodCall))
+            {
+                analysis->callsOwnMethods = true;
+            }
+
+            for(size_t paramIdx = 0; paramIdx < methodCall->parameters.currentSize; paramIdx++)
+            {
+                if(!collectExpression_(analysis, methodCall->parameters.expandable[paramIdx]))
+                {
+                    return ERROR;
+                }
+            }
+        }break;
+
+        default: break;
+    }
+
+    return SUCCESS;
+}
+
+static bool markVariableUse_(LoopAnalysisHandle_t analysis, const VariableObjectHandle_t variable, const bool isWrite)
+{
+    LoopVariableUseHandle_t use = NULL;
+
+    if((variable == NULL) || (variable->objectName == NULL))
+    {
+        return SUCCESS;
+    }
+
+    for(uint32_t useIdx = 0; useIdx < analysis->usesCount; useIdx++)
+    {
+        if(analysis->uses[useIdx].variable == variable)
+        {
+            use = &analysis->uses[useIdx];
+            break;
+        }
+    }
+
+    if(use == NULL)
+    {
+        if(analysis->usesCount == analysis->usesCapacity)
+        {
+            analysis->usesCapacity = (analysis->usesCapacity == 0) ? USES_INITIAL_CAPACITY : analysis->usesCapacity * 2;
+            REALLOC_CHECK(analysis->uses, analysis->usesCapacity * sizeof(LoopVariableUse_t), ERROR);
+        }
+
+        use = &analysis->uses[analysis->usesCount++];
+
+        use->variable = variable;
+        use->readCount = 0;
+        use->writeCount = 0;
+    }
+
+    if(isWrite)
+    {
+        use->writeCount++;
+    }else
+    {
+        use->readCount++;
+    }
+
+    return SUCCESS;
+}
+
+static bool isBuiltinMethod_(const ExMethodCallHandle_t methodCall)
+{
+    for(size_t builtinIdx = 0; builtinIdx < sizeof(builtinMethods_) / sizeof(builtinMethods_[0]); builtinIdx++)
+    {
+        if(strcmp(methodCall->name, builtinMethods_[builtinIdx]) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
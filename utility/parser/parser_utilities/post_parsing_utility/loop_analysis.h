@@ -0,0 +1,45 @@
+/**
+ * @file loop_analysis.h
+ *
+ * Variables used by loop condition and body, with reads and writes counted
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-24
+ */
+
+#ifndef UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_LOOP_ANALYSIS_H_
+#define UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_LOOP_ANALYSIS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../structures/variable/variable.h"
+#include "../../structures/expression/expressions.h"
+
+typedef struct
+{
+    VariableObjectHandle_t variable;
+    uint32_t readCount;
+    uint32_t writeCount;
+}LoopVariableUse_t;
+
+typedef struct
+{
+    LoopVariableUse_t* uses;
+    uint32_t usesCount;
+    uint32_t usesCapacity;
+
+    // Methods of same object get object words, so they may touch its variables
+    bool callsOwnMethods;
+}LoopAnalysis_t;
+
+typedef LoopVariableUse_t* LoopVariableUseHandle_t;
+typedef LoopAnalysis_t* LoopAnalysisHandle_t;
+
+bool LoopAnalysis_collect(LoopAnalysisHandle_t analysis, const ExpHandle_t loop);
+void LoopAnalysis_destroy(LoopAnalysisHandle_t analysis);
+
+#endif // UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_LOOP_ANALYSIS_H_
@@ -0,0 +1,441 @@
+/**
+ * @file object_layout.c
+ *
+ * Object variables layout modes, hot/cold splitting of object region
+ *
+ * Hot/cold layout counts how often every object variable is used (statically from
+ * method bodies or from profile file), variables used at least as much as average
+ * are hot and packed at the beginning of object region, all others are moved
+ * after hot words, so hot part of object occupies as few cache lines as possible.
+ * Object size is part of mangled names and of callers bit:N<Object>, so split is
+ * taken only when it fits into size of unsplit object, otherwise object stays unsplit.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-05-06
+ */
+
+#include "object_layout.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <logger.h>
+#include <safety_macros.h>
+#include <arch_specific.h>
+#include <compiler_options.h>
+#include "access_graph.h"
+#include "bitfit.h"
+
+////////////////////////////////
+// DEFINES
+
+#define PROFILE_LINE_LENGTH_MAX         512
+#define PROFILE_OBJECT_SEPARATOR        '.'
+#define PROFILE_COMMENT_CHAR            '#'
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+static const char* TAG = "OBJECT_LAYOUT";
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef struct
+{
+    VariableObjectHandle_t* variables;
+    uint32_t count;
+}VariablesCollector_t;
+
+// Report file is truncated once per compiler run, later objects are appended
+static bool reportStarted_ = false;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static bool loadProfileUses_(const char* profilePath, const MainFrameHandle_t mainframe, const AccessGraphHandle_t graph, uint64_t* uses);
+static bool packVariablesPart_(const AccessGraphHandle_t graph, const bool* isCold, const bool coldPart, const PackingStrategy_t strategy, BitpackSize_t* sizeNeeded);
+static bool writeReport_(const char* reportPath, const MainFrameHandle_t mainframe, const AccessGraphHandle_t graph, const uint64_t* uses);
+static int variableCollectorIteratorCallback_(void *key, int count, void* value, void *user);
+static int compPosition_(const void* elem1, const void* elem2);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for assigning object variables positions with hot part first and cold part after it
+ *
+ * Cold part always begins on new group, so hot groups are not shared with rarely used variables.
+ * Hot part is packed with selected packing strategy, cold part with first fit. Object keeps
+ * size of unsplit packing, when split needs more bits object is left unsplit.
+ *
+ * @param[in/out] mainframe     parsed AST, object variables get groups and positions
+ *
+ * @return                      Success state
+ */
+bool ObjectLayout_assignHotCold(MainFrameHandle_t mainframe)
+{
+    const CompilerOptionsHandle_t options = CompilerOptions_get();
+
+    AccessGraph_t graph;
+    BitpackSize_t unsplitSize = 0;
+    BitpackSize_t hotSize = 0;
+    BitpackSize_t coldSize = 0;
+    BitpackSize_t splitSize;
+    uint64_t usesSum = 0;
+    uint32_t coldCount = 0;
+    GroupID_t hotGroups;
+    bool status = ERROR;
+
+    uint64_t* uses = NULL;
+    bool* isCold = NULL;
+    bool* noneCold = NULL;
+
+    if(!AccessGraph_build(&graph, mainframe))
+    {
+        Log_e(TAG, "Failed to build variables access graph");
+        return ERROR;
+    }
+
+    uses = calloc(graph.nodesCount + 1, sizeof(uint64_t));
+    isCold = calloc(graph.nodesCount + 1, sizeof(bool));
+    noneCold = calloc(graph.nodesCount + 1, sizeof(bool));
+
+    if((uses == NULL) || (isCold == NULL) || (noneCold == NULL))
+    {
+        Log_e(TAG, "Failed to allocate hot/cold split buffers");
+        goto cleanup;
+    }
+
+    for(uint32_t nodeIdx = 0; nodeIdx < graph.nodesCount; nodeIdx++)
+    {
+        uses[nodeIdx] = (uint64_t) graph.nodes[nodeIdx].variable->readCount + graph.nodes[nodeIdx].variable->writeCount;
+    }
+
+    if(options->layoutProfilePath != NULL)
+    {
+        if(!loadProfileUses_(options->layoutProfilePath, mainframe, &graph, uses))
+        {
+            goto cleanup;
+        }
+    }
+
+    for(uint32_t nodeIdx = 0; nodeIdx < graph.nodesCount; nodeIdx++)
+    {
+        usesSum += uses[nodeIdx];
+    }
+
+    // Hot when used at least as much as average variable of object
+    for(uint32_t nodeIdx = 0; nodeIdx < graph.nodesCount; nodeIdx++)
+    {
+        isCold[nodeIdx] = (uses[nodeIdx] == 0) || ((uses[nodeIdx] * graph.nodesCount) < usesSum);
+
+        if(isCold[nodeIdx])
+        {
+            coldCount++;
+        }
+    }
+
+    if(!packVariablesPart_(&graph, noneCold, false, options->packingStrategy, &unsplitSize))
+    {
+        Log_e(TAG, "Failed to pack variables of %s", mainframe->iguanaObjectName);
+        goto cleanup;
+    }
+
+    if(!packVariablesPart_(&graph, isCold, false, options->packingStrategy, &hotSize))
+    {
+        Log_e(TAG, "Failed to pack hot variables of %s", mainframe->iguanaObjectName);
+        goto cleanup;
+    }
+
+    if(!packVariablesPart_(&graph, isCold, true, PACKING_FIRST_FIT, &coldSize))
+    {
+        Log_e(TAG, "Failed to pack cold variables of %s", mainframe->iguanaObjectName);
+        goto cleanup;
+    }
+
+    hotGroups = BITFIT_LIMBS_COUNT(hotSize, options->wordBits);
+    splitSize = (coldCount == 0) ? hotSize : ((BitpackSize_t) hotGroups * options->wordBits) + coldSize;
+
+    // Callers allocate object by its unsplit size, so split only reuses bits object has already
+    mainframe->objectSizeBits = unsplitSize;
+
+    if(splitSize > unsplitSize)
+    {
+        Log_i(TAG, "%s is not split: split needs %" PRIu64 " bits, object has %" PRIu64, mainframe->iguanaObjectName, splitSize, unsplitSize);
+
+        if(!packVariablesPart_(&graph, noneCold, false, options->packingStrategy, &unsplitSize))
+        {
+            Log_e(TAG, "Failed to pack variables of %s", mainframe->iguanaObjectName);
+            goto cleanup;
+        }
+    }else
+    {
+        for(uint32_t nodeIdx = 0; nodeIdx < graph.nodesCount; nodeIdx++)
+        {
+            if(isCold[nodeIdx])
+            {
+                graph.nodes[nodeIdx].variable->belongToGroup += hotGroups;
+            }
+        }
+
+        mainframe->isHotColdSplit = true;
+        mainframe->hotSizeBits = hotSize;
+
+        Log_d(TAG, "%s hot/cold split: hot %" PRIu64 " bits, cold %" PRIu64 " bits", mainframe->iguanaObjectName, hotSize, coldSize);
+    }
+
+    if(options->layoutReportPath != NULL)
+    {
+        if(!writeReport_(options->layoutReportPath, mainframe, &graph, uses))
+        {
+            goto cleanup;
+        }
+    }
+
+    status = SUCCESS;
+
+cleanup:
+    free(uses);
+    free(isCold);
+    free(noneCold);
+    AccessGraph_destroy(&graph);
+
+    return status;
+}
+
+/**
+ * @brief Public method for checking if object variable was moved to cold part of object
+ *
+ * @param[in] mainframe     parsed AST with assigned layout
+ * @param[in] variable      object variable
+ *
+ * @return                  true if object is split and variable lives after hot groups
+ */
+bool ObjectLayout_isColdVariable(const MainFrameHandle_t mainframe, const VariableObjectHandle_t variable)
+{
+    const GroupID_t hotGroups = BITFIT_LIMBS_COUNT(mainframe->hotSizeBits, CompilerOptions_get()->wordBits);
+
+    return mainframe->isHotColdSplit && (variable->belongToGroup >= hotGroups);
+}
+
+/**
+ * @brief Public method for starting new compiler run, next report truncates report file
+ */
+void ObjectLayout_resetReport(void)
+{
+    reportStarted_ = false;
+}
+
+/**
+ * @brief Public method for getting object variables ordered by their place in object region
+ *
+ * @param[in] mainframe             parsed AST with assigned layout
+ * @param[out] variablesCount       count of returned variables
+ *
+ * @return                          allocated array which caller frees, NULL on failure
+ */
+VariableObjectHandle_t* ObjectLayout_getVariablesByPosition(const MainFrameHandle_t mainframe, uint32_t* variablesCount)
+{
+    VariablesCollector_t collector;
+
+    collector.count = 0;
+    collector.variables = calloc(Hashmap_size(&mainframe->classVariables) + 1, sizeof(VariableObjectHandle_t));
+    NULL_GUARD(collector.variables, NULL, Log_e(TAG, "Failed to allocate variables list"));
+
+    Hashmap_forEach(&mainframe->classVariables, variableCollectorIteratorCallback_, &collector);
+
+    qsort(collector.variables, collector.count, sizeof(VariableObjectHandle_t), compPosition_);
+
+    *variablesCount = collector.count;
+
+    return collector.variables;
+}
+
+
+static bool loadProfileUses_(const char* profilePath, const MainFrameHandle_t mainframe, const AccessGraphHandle_t graph, uint64_t* uses)
+{
+    char line[PROFILE_LINE_LENGTH_MAX];
+    char name[PROFILE_LINE_LENGTH_MAX];
+    uint64_t count;
+    FILE* profile;
+
+    profile = fopen(profilePath, "r");
+    NULL_GUARD(profile, ERROR, Log_e(TAG, "Failed to open layout profile %s", profilePath));
+
+    // Line format: "[object.]variable count"
+    while(fgets(line, sizeof(line), profile) != NULL)
+    {
+        char* variableName;
+        char* separator;
+
+        if((line[0] == PROFILE_COMMENT_CHAR) || (sscanf(line, "%511s %" SCNu64, name, &count) != 2))
+        {
+            continue;
+        }
+
+        variableName = name;
+        separator = strchr(name, PROFILE_OBJECT_SEPARATOR);
+
+        if(separator != NULL)
+        {
+            *separator = '\0';
+
+            if(strcmp(name, mainframe->iguanaObjectName) != 0)
+            {
+                continue;
+            }
+
+            variableName = separator + 1;
+        }
+
+        if(!Hashmap_find(graph->nodeIndexByName, variableName, strlen(variableName)))
+        {
+            continue;
+        }
+
+        uses[(uint32_t) (uintptr_t) *(graph->nodeIndexByName->value)] = count;
+    }
+
+    fclose(profile);
+
+    return SUCCESS;
+}
+
+
+static bool packVariablesPart_(const AccessGraphHandle_t graph, const bool* isCold, const bool coldPart, const PackingStrategy_t strategy, BitpackSize_t* sizeNeeded)
+{
+    InitialSettings_t settingVector;
+    Vector_t vector;
+    bool status;
+
+    *sizeNeeded = 0;
+
+    if(strategy == PACKING_AFFINITY)
+    {
+        bool* excluded = calloc(graph->nodesCount + 1, sizeof(bool));
+        NULL_GUARD(excluded, ERROR, Log_e(TAG, "Failed to allocate excluded nodes"));
+
+        for(uint32_t nodeIdx = 0; nodeIdx < graph->nodesCount; nodeIdx++)
+        {
+            excluded[nodeIdx] = (isCold[nodeIdx] != coldPart);
+        }
+
+        status = Bitfit_assignGroupsAndPositionByAffinity_(graph, excluded, sizeNeeded);
+        free(excluded);
+
+        return status;
+    }
+
+    settingVector.containsVectors = false;
+    settingVector.expandableConstant = EXPANDABLE_CONSTANT_DEFAULT;
+    settingVector.initialSize = graph->nodesCount + 1;
+
+    if(!Vector_create(&vector, &settingVector))
+    {
+        Log_e(TAG, "Failed to create vector for variables part");
+        return ERROR;
+    }
+
+    for(uint32_t nodeIdx = 0; nodeIdx < graph->nodesCount; nodeIdx++)
+    {
+        if((isCold[nodeIdx] == coldPart) && !Vector_append(&vector, graph->nodes[nodeIdx].variable))
+        {
+            free(vector.expandable);
+            return ERROR;
+        }
+    }
+
+    status = (vector.currentSize == 0) ||
+        Bitfit_assignGroupsAndPositionForVariableVector_(&vector, (strategy == PACKING_DENSE) ? DENSE_FIT : FIRST_FIT, sizeNeeded);
+
+    // Vector only links variables owned by object hashmap
+    free(vector.expandable);
+
+    return status;
+}
+
+
+static bool writeReport_(const char* reportPath, const MainFrameHandle_t mainframe, const AccessGraphHandle_t graph, const uint64_t* uses)
+{
+    const GroupID_t hotGroups = BITFIT_LIMBS_COUNT(mainframe->hotSizeBits, CompilerOptions_get()->wordBits);
+
+    VariableObjectHandle_t* variables;
+    uint32_t variablesCount;
+    FILE* report;
+
+    report = fopen(reportPath, reportStarted_ ? "a" : "w");
+    NULL_GUARD(report, ERROR, Log_e(TAG, "Failed to open layout report %s", reportPath));
+
+    reportStarted_ = true;
+
+    variables = ObjectLayout_getVariablesByPosition(mainframe, &variablesCount);
+
+    if(variables == NULL)
+    {
+        fclose(report);
+        return ERROR;
+    }
+
+    if(mainframe->isHotColdSplit)
+    {
+        fprintf(report, "object %s: %" PRIu64 " bits, hot %" PRIu64 " bits in groups [0, %u), cold from group %u\n",
+                mainframe->iguanaObjectName, mainframe->objectSizeBits, mainframe->hotSizeBits, hotGroups, hotGroups);
+    }else
+    {
+        fprintf(report, "object %s: %" PRIu64 " bits, not split, split would not fit into object size\n",
+                mainframe->iguanaObjectName, mainframe->objectSizeBits);
+    }
+
+    for(uint32_t varIdx = 0; varIdx < variablesCount; varIdx++)
+    {
+        const VariableObjectHandle_t variable = variables[varIdx];
+        uint64_t variableUses = 0;
+
+        if(Hashmap_find(graph->nodeIndexByName, variable->objectName, strlen(variable->objectName)))
+        {
+            variableUses = uses[(uint32_t) (uintptr_t) *(graph->nodeIndexByName->value)];
+        }
+
+        fprintf(report, "    %-4s group %u bit %u bit:%" PRIu64 " %s uses %" PRIu64 " (reads %u, writes %u)\n",
+                ObjectLayout_isColdVariable(mainframe, variable) ? "cold" : "hot",
+                variable->belongToGroup, variable->posBit, variable->bitpack, variable->objectName,
+                variableUses, variable->readCount, variable->writeCount);
+    }
+
+    free(variables);
+
+    if(fclose(report))
+    {
+        Log_w(TAG, "Failed to close layout report %s", reportPath);
+    }
+
+    return SUCCESS;
+}
+
+
+static int variableCollectorIteratorCallback_(void *key, int count, void* value, void *user)
+{
+    VariablesCollector_t* collector = user;
+
+    collector->variables[collector->count++] = value;
+
+    return SUCCESS;
+}
+
+
+static int compPosition_(const void* elem1, const void* elem2)
+{
+    const VariableObjectHandle_t a = *((VariableObjectHandle_t*) elem1);
+    const VariableObjectHandle_t b = *((VariableObjectHandle_t*) elem2);
+
+    if(a->belongToGroup != b->belongToGroup)
+    {
+        return (a->belongToGroup < b->belongToGroup) ? -1 : 1;
+    }
+
+    return (a->posBit < b->posBit) ? -1 : (a->posBit > b->posBit);
+}
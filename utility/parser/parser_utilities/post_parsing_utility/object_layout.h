@@ -0,0 +1,26 @@
+/**
+ * @file object_layout.h
+ *
+ * Object variables layout modes, hot/cold splitting of object region
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-05-06
+ */
+
+#ifndef UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_OBJECT_LAYOUT_H_
+#define UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_OBJECT_LAYOUT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../structures/main_frame/main_frame.h"
+
+bool ObjectLayout_assignHotCold(MainFrameHandle_t mainframe);
+bool ObjectLayout_isColdVariable(const MainFrameHandle_t mainframe, const VariableObjectHandle_t variable);
+VariableObjectHandle_t* ObjectLayout_getVariablesByPosition(const MainFrameHandle_t mainframe, uint32_t* variablesCount);
+void ObjectLayout_resetReport(void);
+
+#endif // UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_OBJECT_LAYOUT_H_
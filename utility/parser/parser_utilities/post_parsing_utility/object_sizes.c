@@ -0,0 +1,226 @@
+/**
+ * @file object_sizes.c
+ *
+ * Check of object typed variables declared size against size of object parsed in same run
+ *
+ * Size of object is part of its mangled method names and it depends on word size, packing
+ * and layout options, so bit:N<Object> declared for other options does not link. Every
+ * declaration and every parsed object is remembered for compiler run, declaration which
+ * does not match object size is reported as soon as both of them are known.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-28
+ */
+
+#include "object_sizes.h"
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <logger.h>
+#include <vector.h>
+#include <safety_macros.h>
+#include <global_config.h>
+#include "../compiler_messages.h"
+
+////////////////////////////////
+// DEFINES
+
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+static const char* TAG = "OBJECT_SIZES";
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef struct
+{
+    char* objectName;
+    BitpackSize_t bits;
+    TokenLocation_T location;               // declaration only, filename is own copy
+}ObjectSize_t;
+
+typedef ObjectSize_t* ObjectSizeHandle_t;
+
+// Declarations of object typed variables and parsed objects of current compiler run
+static Vector_t uses_;
+static Vector_t objects_;
+static bool isStarted_ = false;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static bool start_(void);
+static ObjectSizeHandle_t newObjectSize_(const char* objectName, const BitpackSize_t bits);
+static void checkUse_(const ObjectSizeHandle_t use, const ObjectSizeHandle_t object);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for remembering declaration of object typed variable
+ *
+ * @param[in] objectToken       object name token of bit:N<Object> declaration
+ * @param[in] declaredBits      N of declaration
+ *
+ * @return                      Success state
+ */
+bool ObjectSizes_addUse(const TokenHandler_t objectToken, const BitpackSize_t declaredBits)
+{
+    ObjectSizeHandle_t use;
+
+    if(!start_())
+    {
+        return ERROR;
+    }
+
+    use = newObjectSize_(objectToken->valueString, declaredBits);
+    NULL_GUARD(use, ERROR, Log_e(TAG, "Failed to allocate object use"));
+
+    use->location = objectToken->location;
+    use->location.filename = (objectToken->location.filename != NULL) ? strdup(objectToken->location.filename) : NULL;
+
+    if(!Vector_append(&uses_, use))
+    {
+        free(use->location.filename);
+        free(use->objectName);
+        free(use);
+        return ERROR;
+    }
+
+    for(size_t objectIdx = 0; objectIdx < objects_.currentSize; objectIdx++)
+    {
+        checkUse_(use, objects_.expandable[objectIdx]);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for remembering size of parsed object, declarations of it seen before are checked
+ *
+ * @param[in] objectName        parsed object name
+ * @param[in] objectSizeBits    object size with current options
+ *
+ * @return                      Success state
+ */
+bool ObjectSizes_addObject(const char* objectName, const BitpackSize_t objectSizeBits)
+{
+    ObjectSizeHandle_t object;
+
+    if(!start_())
+    {
+        return ERROR;
+    }
+
+    object = newObjectSize_(objectName, objectSizeBits);
+    NULL_GUARD(object, ERROR, Log_e(TAG, "Failed to allocate object size"));
+
+    if(!Vector_append(&objects_, object))
+    {
+        free(object->objectName);
+        free(object);
+        return ERROR;
+    }
+
+    for(size_t useIdx = 0; useIdx < uses_.currentSize; useIdx++)
+    {
+        checkUse_(uses_.expandable[useIdx], object);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Public method for forgetting declarations and objects of previous compiler run
+ */
+void ObjectSizes_reset(void)
+{
+    if(!isStarted_)
+    {
+        return;
+    }
+
+    for(size_t useIdx = 0; useIdx < uses_.currentSize; useIdx++)
+    {
+        free(((ObjectSizeHandle_t) uses_.expandable[useIdx])->location.filename);
+        free(((ObjectSizeHandle_t) uses_.expandable[useIdx])->objectName);
+    }
+
+    for(size_t objectIdx = 0; objectIdx < objects_.currentSize; objectIdx++)
+    {
+        free(((ObjectSizeHandle_t) objects_.expandable[objectIdx])->objectName);
+    }
+
+    Vector_destroy(&uses_);
+    Vector_destroy(&objects_);
+
+    isStarted_ = false;
+}
+
+
+static bool start_(void)
+{
+    if(isStarted_)
+    {
+        return SUCCESS;
+    }
+
+    if(!Vector_create(&uses_, NULL))
+    {
+        Log_e(TAG, "Failed to create vector for object uses");
+        return ERROR;
+    }
+
+    if(!Vector_create(&objects_, NULL))
+    {
+        Log_e(TAG, "Failed to create vector for object sizes");
+        Vector_destroy(&uses_);
+        return ERROR;
+    }
+
+    isStarted_ = true;
+
+    return SUCCESS;
+}
+
+
+static ObjectSizeHandle_t newObjectSize_(const char* objectName, const BitpackSize_t bits)
+{
+    ObjectSizeHandle_t objectSize = calloc(1, sizeof(ObjectSize_t));
+    NULL_GUARD(objectSize, NULL, Log_e(TAG, "Failed to allocate object size"));
+
+    objectSize->objectName = strdup(objectName);
+    objectSize->bits = bits;
+
+    if(objectSize->objectName == NULL)
+    {
+        free(objectSize);
+        return NULL;
+    }
+
+    return objectSize;
+}
+
+
+static void checkUse_(const ObjectSizeHandle_t use, const ObjectSizeHandle_t object)
+{
+    Token_t useToken;
+
+    if((use->bits == object->bits) || (strcmp(use->objectName, object->objectName) != 0))
+    {
+        return;
+    }
+
+    useToken.tokenType = NAMING;
+    useToken.location = use->location;
+    useToken.valueString = use->objectName;
+
+    Shouter_shoutError((use->location.filename != NULL) ? &useToken : NULL,
+        "Declared bit:%" PRIu64 "<%s>, but object %s is %" PRIu64 " bits with current --word-bits, --packing and --layout",
+        use->bits, use->objectName, object->objectName, object->bits);
+}
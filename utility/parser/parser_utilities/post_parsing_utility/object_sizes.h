@@ -0,0 +1,25 @@
+/**
+ * @file object_sizes.h
+ *
+ * Check of object typed variables declared size against size of object parsed in same run
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-28
+ */
+
+#ifndef UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_OBJECT_SIZES_H_
+#define UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_OBJECT_SIZES_H_
+
+#include <stdbool.h>
+#include <platform_specific.h>
+#include "../../../tokenizer/token/token.h"
+
+bool ObjectSizes_addUse(const TokenHandler_t objectToken, const BitpackSize_t declaredBits);
+bool ObjectSizes_addObject(const char* objectName, const BitpackSize_t objectSizeBits);
+void ObjectSizes_reset(void);
+
+#endif // UTILITY_PARSER_PARSER_UTILITIES_POST_PARSING_UTILITY_OBJECT_SIZES_H_
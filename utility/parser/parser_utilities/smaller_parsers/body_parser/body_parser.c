@@ -59,8 +59,11 @@ static bool handleNumeric_(LocalScopeObjectHandle_t scopeBody, ExpElementHandle_
 static bool handlePostASTMethodCall_(ExMethodCallHandle_t methodCall);
 static VariableObjectHandle_t searchVariableNameAcrossScopes(LocalScopeObjectHandle_t localScopeBody, const char* varName);
 static VariableObjectHandle_t createUnknownVar_(char* notFoundVarName);
-static bool parseReturnStatement_(LocalScopeObjectHandle_t scopeBody, TokenHandler_t** currentTokenHandle);
-static bool parseSimpleLine_(LocalScopeObjectHandle_t scopeBody, TokenHandler_t** currentTokenHandle);
+static bool handleArrayElement_(ExpElementHandle_t symbol, TokenHandler_t** currentTokenHandle, const VariableObjectHandle_t array);
+static bool parseReturnStatement_(LocalScopeObjectHandle_t scopeBody, VectorHandler_t elementsList, TokenHandler_t** currentTokenHandle);
+static bool parseSimpleLine_(LocalScopeObjectHandle_t scopeBody, VectorHandler_t elementsList, TokenHandler_t** currentTokenHandle);
+static bool parseScopeElements_(LocalScopeObjectHandle_t scopeBody, VectorHandler_t elementsList, TokenHandler_t** currentTokenHandle);
+static bool parseLoop_(LocalScopeObjectHandle_t scopeBody, VectorHandler_t elementsList, TokenHandler_t** currentTokenHandle, TokenHandler_t* conditionEndToken, const ExpType_t loopType);
 ////////////////////////////////
 // IMPLEMENTATION
 
@@ -120,12 +123,30 @@ static inline int32_t expressionPrecedence_(ExpElementHandle_t symbol)
 }
 
 bool BodyParser_parseScope(LocalScopeObjectHandle_t scopeBody, TokenHandler_t** currentTokenHandle)
+{
+    return parseScopeElements_(scopeBody, &scopeBody->scopeElementsList, currentTokenHandle);
+}
+
+/**
+ * @brief Parses statements until closing bracket of scope. Loop bodies are parsed by same method,
+ * their statements go to loop expression, while variables declared in them belong to method scope
+ *
+ * @param[in/out] scopeBody             method scope holding variables
+ * @param[out] elementsList             list where parsed statements are appended
+ * @param[in/out] currentTokenHandle    token pointer, left at closing bracket or end of file
+ *
+ * @return                              Success state
+ */
+static bool parseScopeElements_(LocalScopeObjectHandle_t scopeBody, VectorHandler_t elementsList, TokenHandler_t** currentTokenHandle)
 {
     while ((cTokenType != BRACKET_END) && (cTokenType != END_FILE))
     {
 
         switch (cTokenType)
         {
+            case ALLOC_STATIC_STACK:
+            case ALLOC_DYNAMIC_STACK:
+            case ALLOC_DYNAMIC_HEAP:
             case BIT_TYPE:
             {
                 if(!parseVariableInstance_(scopeBody, currentTokenHandle))
@@ -135,7 +156,7 @@ bool BodyParser_parseScope(LocalScopeObjectHandle_t scopeBody, TokenHandler_t**
                 }
 
                 
-                if(!parseSimpleLine_(scopeBody, currentTokenHandle))
+                if(!parseSimpleLine_(scopeBody, elementsList, currentTokenHandle))
                 {
                     Log_e(TAG, "Failed to parse at variable intialization simple line expression");
                     return ERROR;
@@ -147,20 +168,37 @@ bool BodyParser_parseScope(LocalScopeObjectHandle_t scopeBody, TokenHandler_t**
             {
                 (*currentTokenHandle)++;
 
-                if(!parseReturnStatement_(scopeBody, currentTokenHandle))
+                if(!parseReturnStatement_(scopeBody, elementsList, currentTokenHandle))
                 {
                     Log_e(TAG, "Failed to parse return value");
                     return ERROR;
                 }
             }break;
 
+            case LOOP_WHEN:
+            {
+                (*currentTokenHandle)++;
+
+                TokenHandler_t* startConditionPtr = (*currentTokenHandle);
+                ParserUtils_skipUntil(currentTokenHandle, (TokenType_t[]){SEMICOLON, BRACKET_END, BRACKET_START}, 3);
+                TokenHandler_t* endConditionPtr = (*currentTokenHandle);
+
+                (*currentTokenHandle) = startConditionPtr;
+
+                if(!parseLoop_(scopeBody, elementsList, currentTokenHandle, endConditionPtr, WHEN_LOOP))
+                {
+                    Log_e(TAG, "Failed to parse when loop");
+                    return ERROR;
+                }
+            }break;
+
             case NAMING:
             case NUMBER_VALUE:
             case BRACKET_ROUND_START: 
             // case THIS:
             case OPERATOR_NOT:
             {
-                if(!parseSimpleLine_(scopeBody, currentTokenHandle))
+                if(!parseSimpleLine_(scopeBody, elementsList, currentTokenHandle))
                 {
                     Log_e(TAG, "Failed to parse simple line");
                     return ERROR;
@@ -181,8 +219,83 @@ bool BodyParser_parseScope(LocalScopeObjectHandle_t scopeBody, TokenHandler_t**
     return SUCCESS;
 }
 
+/**
+ * @brief Parses loop from its condition (when) or count (~>) up to closing bracket of its body
+ *
+ * @param[in/out] scopeBody             method scope holding variables
+ * @param[out] elementsList             list where loop is appended
+ * @param[in/out] currentTokenHandle    token pointer at condition start, left at closing bracket of body
+ * @param[in] conditionEndToken         token after condition or count
+ * @param[in] loopType                  WHEN_LOOP or REPEAT_LOOP
+ *
+ * @return                              Success state
+ */
+static bool parseLoop_(LocalScopeObjectHandle_t scopeBody, VectorHandler_t elementsList, TokenHandler_t** currentTokenHandle, TokenHandler_t* conditionEndToken, const ExpType_t loopType)
+{
+    // Repeat count is followed by ~> and only then by body
+    TokenHandler_t* bodyStartToken = (loopType == REPEAT_LOOP) ? (conditionEndToken + 2) : conditionEndToken;
+    InitialSettings_t initialSettingBody;
+
+    ExpHandle_t loop = Expression_createDynamic(loopType);
+
+    NULL_GUARD(loop, ERROR, Log_e(TAG, "Failed to create / allocate loop expression"));
+
+    initialSettingBody.containsVectors = true;
+    initialSettingBody.initialSize = 4;
+    initialSettingBody.expandableConstant = (1.0f / 2.0f);
+
+    ALLOC_CHECK(loop->loopBody, sizeof(Vector_t), ERROR);
+
+    if(!Vector_create(loop->loopBody, &initialSettingBody))
+    {
+        Log_e(TAG, "Failed to initialize loop body vector");
+        return ERROR;
+    }
+
+    if((*bodyStartToken)->tokenType != BRACKET_START)
+    {
+        Shouter_shoutExpectedToken(*bodyStartToken, BRACKET_START);
+
+        // Token is left for scope loop, it may close scope
+        (*currentTokenHandle) = bodyStartToken - 1;
+        return SUCCESS;
+    }
 
-static bool parseReturnStatement_(LocalScopeObjectHandle_t scopeBody, TokenHandler_t** currentTokenHandle)
+    if((*currentTokenHandle) == conditionEndToken)
+    {
+        Shouter_shoutError(cTokenP, "Loop %s is missing", (loopType == REPEAT_LOOP) ? "count before \'~>\'" : "condition after \'when\'");
+    }else if(!parseExpressionLine_(scopeBody, loop, currentTokenHandle, conditionEndToken))
+    {
+        Log_e(TAG, "Failed to parse loop condition");
+        return ERROR;
+    }
+
+    (*currentTokenHandle) = bodyStartToken + 1;
+
+    if(!parseScopeElements_(scopeBody, loop->loopBody, currentTokenHandle))
+    {
+        Log_e(TAG, "Failed to parse loop body");
+        return ERROR;
+    }
+
+    if(cTokenType != BRACKET_END)
+    {
+        Shouter_shoutExpectedToken(cTokenP, BRACKET_END);
+        (*currentTokenHandle)--;
+        return SUCCESS;
+    }
+
+    if(!Vector_append(elementsList, loop))
+    {
+        Log_e(TAG, "Failed to append loop to expression lines list");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+
+static bool parseReturnStatement_(LocalScopeObjectHandle_t scopeBody, VectorHandler_t elementsList, TokenHandler_t** currentTokenHandle)
 {
     ExpHandle_t expression = Expression_createDynamic(RETURN_STATEMENT);
 
@@ -211,7 +324,7 @@ static bool parseReturnStatement_(LocalScopeObjectHandle_t scopeBody, TokenHandl
         (*currentTokenHandle)--;
     }else
     {
-        if(!Vector_append(&scopeBody->scopeElementsList, expression))
+        if(!Vector_append(elementsList, expression))
         {
             Log_e(TAG, "Failed to append expression line to expression lines list");
             return ERROR;
@@ -222,7 +335,7 @@ static bool parseReturnStatement_(LocalScopeObjectHandle_t scopeBody, TokenHandl
 }
 
 
-static bool parseSimpleLine_(LocalScopeObjectHandle_t scopeBody, TokenHandler_t** currentTokenHandle)
+static bool parseSimpleLine_(LocalScopeObjectHandle_t scopeBody, VectorHandler_t elementsList, TokenHandler_t** currentTokenHandle)
 {
     TokenHandler_t* startExpressionPtr = (*currentTokenHandle);
     ParserUtils_skipUntil(currentTokenHandle, (TokenType_t[]){SEMICOLON, BRACKET_END, BRACKET_START}, 3);
@@ -233,6 +346,14 @@ static bool parseSimpleLine_(LocalScopeObjectHandle_t scopeBody, TokenHandler_t*
         return SUCCESS;
     }
 
+    // Repeat loop: count expression followed by ~> and body
+    if((cTokenType == BRACKET_START) && ((endExpressionPtr - startExpressionPtr) >= 2) &&
+       (tokenOffset(-2)->tokenType == OPERATOR_NOT) && (tokenOffset(-1)->tokenType == ARROW_RIGHT))
+    {
+        (*currentTokenHandle) = startExpressionPtr;
+        return parseLoop_(scopeBody, elementsList, currentTokenHandle, endExpressionPtr - 2, REPEAT_LOOP);
+    }
+
     ExpHandle_t expression = Expression_createDynamic(SIMPLE_LINE);
 
     NULL_GUARD(expression, ERROR, Log_e(TAG, "Failed to create / allocate expression Vector"));
@@ -251,7 +372,7 @@ static bool parseSimpleLine_(LocalScopeObjectHandle_t scopeBody, TokenHandler_t*
         (*currentTokenHandle)--;
     }else
     {
-        if(!Vector_append(&scopeBody->scopeElementsList, expression))
+        if(!Vector_append(elementsList, expression))
         {
             Log_e(TAG, "Failed to append expression line to expression lines list");
             return ERROR;
@@ -264,6 +385,24 @@ static bool parseSimpleLine_(LocalScopeObjectHandle_t scopeBody, TokenHandler_t*
 static inline bool parseVariableInstance_(LocalScopeObjectHandle_t scopeBody, TokenHandler_t** currentTokenHandle)
 {
     VariableObjectHandle_t variable;
+    VariableAllocation_t allocation = ALLOCATION_STATIC_STACK;
+    const TokenHandler_t allocationToken = cTokenP;
+
+    // Placement keyword goes before type, without it object stays in packed region of scope
+    if(cTokenType != BIT_TYPE)
+    {
+        allocation = (cTokenType == ALLOC_DYNAMIC_HEAP) ? ALLOCATION_DYNAMIC_HEAP :
+                     (cTokenType == ALLOC_DYNAMIC_STACK) ? ALLOCATION_DYNAMIC_STACK : ALLOCATION_STATIC_STACK;
+
+        (*currentTokenHandle)++;
+
+        if(cTokenType != BIT_TYPE)
+        {
+            Shouter_shoutExpectedToken(cTokenP, BIT_TYPE);
+            ParserUtils_skipUntil(currentTokenHandle, (TokenType_t[]){SEMICOLON}, 1);
+            return SUCCESS;
+        }
+    }
 
     ALLOC_CHECK(variable, sizeof(VariableObject_t), ERROR);
 
@@ -272,6 +411,14 @@ static inline bool parseVariableInstance_(LocalScopeObjectHandle_t scopeBody, To
         return ERROR;
     }
 
+    if((allocation != ALLOCATION_STATIC_STACK) && (variable->castedFile == NULL))
+    {
+        Shouter_shoutError(allocationToken, "Only object variables can be placed with \'%s\'", allocationToken->valueString);
+    }else
+    {
+        variable->allocation = allocation;
+    }
+
     // assigning object / class local variables array scope
     variable->scopeName = LOCAL_VAR_REGION_NAME;
     
@@ -279,6 +426,16 @@ static inline bool parseVariableInstance_(LocalScopeObjectHandle_t scopeBody, To
 
     (*currentTokenHandle)++;
 
+    if(cTokenType == BRACKET_SQUARE_START)
+    {
+        if(!VarParser_parseArrayLength(currentTokenHandle, variable))
+        {
+            return ERROR;
+        }
+
+        (*currentTokenHandle)++;
+    }
+
     if(cTokenType == SEMICOLON)
     {
         if(Hashmap_set(&scopeBody->localVariables, variable->objectName, variable))
@@ -287,6 +444,12 @@ static inline bool parseVariableInstance_(LocalScopeObjectHandle_t scopeBody, To
             return ERROR;
         }
         
+    }else if((cTokenType == EQUAL) && (variable->arrayLength > 0))
+    {
+        // Initializer line would start at name, where array size is not part of expression
+        Shouter_shoutError(cTokenP, "Array \'%s\' can not be initialized in declaration, assign it separately", variable->objectName);
+        ParserUtils_skipUntil(currentTokenHandle, (TokenType_t[]){SEMICOLON}, 1);
+
     }else if(cTokenType == EQUAL)
     {
         // it is insta initialized
@@ -688,6 +851,16 @@ static bool handleNaming_(LocalScopeObjectHandle_t localScopeBody, ExpElementHan
                     Shouter_shoutError(cTokenP, "Expecting function call after dot");
                 }
             }
+            else if(tokenOffset(1)->tokenType == BRACKET_SQUARE_START)
+            {
+                (*currentTokenHandle)++;
+
+                if(!handleArrayElement_(symbol, currentTokenHandle, foundVariableCorresponding))
+                {
+                    Log_e(TAG, "Failed to handle array element parsing");
+                    return ERROR;
+                }
+            }
             else
             {
                 if(!ExpElement_set(symbol, EXP_VARIABLE, foundVariableCorresponding))
@@ -713,6 +886,84 @@ static bool handleNaming_(LocalScopeObjectHandle_t localScopeBody, ExpElementHan
     return SUCCESS;
 }
 
+/**
+ * @brief Element of packed array is expression variable of its own, it views one lane of array.
+ * Group and position of element are known only after array gets its place, so view keeps index
+ *
+ * @param[out] symbol               expression element to fill
+ * @param[in/out] currentTokenHandle token pointer at '[', left at ']' or last token of element
+ * @param[in] array                 variable which is indexed
+ *
+ * @return                          Success state
+ */
+static bool handleArrayElement_(ExpElementHandle_t symbol, TokenHandler_t** currentTokenHandle, const VariableObjectHandle_t array)
+{
+    VariableObjectHandle_t element;
+    uint32_t elementIdx = 0;
+
+    (*currentTokenHandle)++;
+
+    if(cTokenType == NUMBER_VALUE)
+    {
+        elementIdx = atoll(cTokenP->valueString);
+    }else
+    {
+        Shouter_shoutError(cTokenP, "Array \'%s\' index must be constant number", array->objectName);
+
+        if(cTokenType == BRACKET_SQUARE_END)
+        {
+            return ExpElement_set(symbol, EXP_VARIABLE, array);
+        }
+
+        // Token may end expression, so it is left for expression loop
+        if(cTokenType != NAMING)
+        {
+            (*currentTokenHandle)--;
+            return ExpElement_set(symbol, EXP_VARIABLE, array);
+        }
+    }
+
+    if(tokenOffset(1)->tokenType == BRACKET_SQUARE_END)
+    {
+        (*currentTokenHandle)++;
+    }else
+    {
+        Shouter_shoutExpectedToken(tokenOffset(1), BRACKET_SQUARE_END);
+    }
+
+    if((array->arrayLength == 0) || (elementIdx >= array->arrayLength))
+    {
+        if(array->arrayLength == 0)
+        {
+            Shouter_shoutError(cTokenP, "Variable \'%s\' is not array", array->objectName);
+        }else
+        {
+            Shouter_shoutError(cTokenP, "Index %u is out of array \'%s\' of %u elements", elementIdx, array->objectName, array->arrayLength);
+        }
+
+        // Compilation fails anyway, array itself stands in for element
+        return ExpElement_set(symbol, EXP_VARIABLE, array);
+    }
+
+    ALLOC_CHECK(element, sizeof(VariableObject_t), ERROR);
+
+    *element = *array;
+
+    element->arrayLength = 0;
+    element->arrayIndex = elementIdx;
+    element->arrayOwner = array;
+    element->readCount = 0;
+    element->writeCount = 0;
+
+    if(!ExpElement_set(symbol, EXP_VARIABLE, element))
+    {
+        Log_e(TAG, "Failed to add exp array element to expression element");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
 static VariableObjectHandle_t createUnknownVar_(char* notFoundVarName)
 {
     VariableObjectHandle_t unknownVar;
@@ -725,6 +976,12 @@ static VariableObjectHandle_t createUnknownVar_(char* notFoundVarName)
     unknownVar->posBit = 0;
     unknownVar->scopeName = NULL;
     unknownVar->objectName = notFoundVarName;
+    unknownVar->readCount = 0;
+    unknownVar->writeCount = 0;
+    unknownVar->arrayLength = 0;
+    unknownVar->arrayIndex = 0;
+    unknownVar->arrayOwner = NULL;
+    unknownVar->allocation = ALLOCATION_STATIC_STACK;
 
     return unknownVar;
 }
@@ -42,7 +42,7 @@ static bool postParsingJobsMethod_(MethodObjectHandle_t method);
 // IMPLEMENTATION
 
 // TODO: make parser contain currentTokenHandle to prevent it always pass through parameters
-inline bool MethodParser_parseMethod(TokenHandler_t** currentTokenHandle, const VariableObjectHandle_t returnVariable, ParserHandle_t parser, MainFrameHandle_t root, const Accessibility_t notation)
+inline bool MethodParser_parseMethod(TokenHandler_t** currentTokenHandle, const VariableObjectHandle_t returnVariable, ParserHandle_t parser, MainFrameHandle_t root, const Accessibility_t notation, const bool isInline)
 {
     MethodObjectHandle_t methodHandle;
 
@@ -50,6 +50,7 @@ inline bool MethodParser_parseMethod(TokenHandler_t** currentTokenHandle, const
     methodHandle->accessType = notation;
     methodHandle->containsBody = false;
     methodHandle->hasInfinityParams = false;
+    methodHandle->isInline = isInline;
     
     // setting up method name and return variables which already parsed
     methodHandle->returnVariable = returnVariable;
@@ -148,6 +149,13 @@ static bool parseMethodParameters_(TokenHandler_t** currentTokenHandle, MethodOb
             parameter->scopeName = PARAMS_VAR_REGION_NAME;
             
             cTokenIncrement;
+
+            // Params are packed per call, arrays live only in object and locals
+            if(cTokenType == BRACKET_SQUARE_START)
+            {
+                Shouter_shoutError(cTokenP, "Parameter \'%s\' can not be array", parameter->objectName);
+                ParserUtils_skipUntil(currentTokenHandle, (TokenType_t[]){COMMA, BRACKET_ROUND_END}, 2);
+            }
             
             if(VarParser_searchVariableInVectorByName(methodHandle->parameters, parameter->objectName) == NULL)
             {
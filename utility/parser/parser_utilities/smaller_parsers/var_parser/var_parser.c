@@ -13,6 +13,8 @@
 
 #include "var_parser.h"
 #include "../../global_parser_utility.h"
+#include "../../post_parsing_utility/object_sizes.h"
+#include <compiler_options.h>
 
 ////////////////////////////////
 // DEFINES
@@ -39,6 +41,12 @@ bool VarParser_parseVariable(TokenHandler_t** currentTokenHandle, VariableObject
     variableHolder->castedFile = NULL;
     variableHolder->objectName = NULL;
     variableHolder->bitpack = 0;
+    variableHolder->readCount = 0;
+    variableHolder->writeCount = 0;
+    variableHolder->arrayLength = 0;
+    variableHolder->arrayIndex = 0;
+    variableHolder->arrayOwner = NULL;
+    variableHolder->allocation = ALLOCATION_STATIC_STACK;
 
     if(!ParserUtils_tryParseSequence(currentTokenHandle, PATTERN_VAR_TYPE, PATTERN_VAR_TYPE_SIZE))
     {
@@ -73,6 +81,13 @@ bool VarParser_parseVariable(TokenHandler_t** currentTokenHandle, VariableObject
         }else if(cTokenType == NAMING)
         {
             variableHolder->castedFile = cTokenP->valueString;
+
+            if(!ObjectSizes_addUse(cTokenP, variableHolder->bitpack))
+            {
+                Log_e(TAG, "Failed to remember declaration of %s", cTokenP->valueString);
+                return ERROR;
+            }
+
             cTokenIncrement;
 
             if (cTokenType != ARROW_RIGHT)
@@ -114,6 +129,53 @@ bool VarParser_parseVariable(TokenHandler_t** currentTokenHandle, VariableObject
 }
 
 
+/**
+ * @brief Parses elements count of packed array declaration, current token is '[' after variable name.
+ * Elements never cross word boundary, so element can not be wider than word
+ *
+ * @param[in/out] currentTokenHandle    token pointer, left at ']'
+ * @param[out] variableHolder           declared variable, gets array length
+ *
+ * @return                              Success state
+ */
+bool VarParser_parseArrayLength(TokenHandler_t** currentTokenHandle, VariableObjectHandle_t variableHolder)
+{
+    uint32_t arrayLength;
+
+    cTokenIncrement;
+
+    if(cTokenType != NUMBER_VALUE)
+    {
+        Shouter_shoutError(cTokenP, "Array \'%s\' length must be constant number", variableHolder->objectName);
+        return SUCCESS;
+    }
+
+    arrayLength = atoll(cTokenP->valueString);
+
+    cTokenIncrement;
+
+    // Invalid declaration stays scalar, so layout never sees broken array
+    if(cTokenType != BRACKET_SQUARE_END)
+    {
+        Shouter_shoutExpectedToken(cTokenP, BRACKET_SQUARE_END);
+    }else if(arrayLength == 0)
+    {
+        Shouter_shoutError(cTokenP, "Array \'%s\' must have at least one element", variableHolder->objectName);
+    }else if(variableHolder->castedFile != NULL)
+    {
+        Shouter_shoutError(cTokenP, "Array \'%s\' elements can not be objects", variableHolder->objectName);
+    }else if((variableHolder->bitpack == 0) || (variableHolder->bitpack > CompilerOptions_get()->wordBits))
+    {
+        Shouter_shoutError(cTokenP, "Array \'%s\' element must be 1 to %u bits wide", variableHolder->objectName, CompilerOptions_get()->wordBits);
+    }else
+    {
+        variableHolder->arrayLength = arrayLength;
+    }
+
+    return SUCCESS;
+}
+
+
 VariableObjectHandle_t VarParser_searchVariableInVectorByName(const VectorHandler_t vectorHandle, const char* name)
 {
     for(uint32_t variableIndex = 0; variableIndex < vectorHandle->currentSize; variableIndex++)
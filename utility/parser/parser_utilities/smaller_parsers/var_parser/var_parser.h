@@ -21,5 +21,6 @@
 
 void VarParser_printVarsInVector(const VectorHandler_t vectorHandle, const char* name);
 bool VarParser_parseVariable(TokenHandler_t** currentToken, VariableObjectHandle_t variableHolder);
+bool VarParser_parseArrayLength(TokenHandler_t** currentToken, VariableObjectHandle_t variableHolder);
 VariableObjectHandle_t VarParser_searchVariableInVectorByName(const VectorHandler_t vectorHandle, const char* name);
 #endif // UTILITY_PARSER_PARSER_UTILITIES_SMALLER_PARSERS_VAR_PARSER_H_
\ No newline at end of file
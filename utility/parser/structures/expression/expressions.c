@@ -136,6 +136,7 @@ bool Expression_create(ExpHandle_t expression, const ExpType_t expressionType)
     NULL_GUARD(expression, ERROR, Log_e(TAG, "Expression_create Expression passed as NULL"));
 
     expression->expType = expressionType;
+    expression->loopBody = NULL;
 
     InitialSettings_t settingsVector;
 
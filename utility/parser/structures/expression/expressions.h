@@ -72,6 +72,9 @@ typedef struct
 {
     ExpType_t expType;
     Vector_t expressionElementVector;
+
+    // Statements repeated by loop, its own elements are loop count or condition. NULL for other types
+    VectorHandler_t loopBody;
 }Exp_t;
 
 typedef Exp_t* ExpHandle_t;
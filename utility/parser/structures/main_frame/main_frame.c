@@ -46,6 +46,9 @@ static const char* TAG = "MAIN_FRAME";
  */
 bool MainFrame_init(MainFrameHandle_t handle)
 {
+    handle->objectSizeBits = 0;
+    handle->hotSizeBits = 0;
+    handle->isHotColdSplit = false;
 
     if(!Hashmap_new(&handle->classVariables, 10))
     {
@@ -22,6 +22,8 @@ typedef struct
 {
     char iguanaObjectName[MAX_FILENAME_LENGTH];
     BitpackSize_t objectSizeBits;
+    BitpackSize_t hotSizeBits;
+    bool isHotColdSplit;
     Hashmap_t classVariables;
     Hashmap_t methods;
 }MainFrame_t;
@@ -18,7 +18,15 @@
 #include <stdbool.h>
 #include <platform_specific.h>
 
-typedef struct
+// Where object typed variable words are kept, selected by ss / ds / dh keyword of declaration
+typedef enum
+{
+    ALLOCATION_STATIC_STACK,                // inside packed region of its scope, default
+    ALLOCATION_DYNAMIC_STACK,               // own words on stack of method, taken at method entry
+    ALLOCATION_DYNAMIC_HEAP                 // words from heap pool, given back at method exit
+}VariableAllocation_t;
+
+typedef struct VariableObject
 {
     char* objectName;
     char* castedFile;
@@ -26,6 +34,12 @@ typedef struct
     BitpackSize_t bitpack;
     GroupID_t belongToGroup;
     BitpackPos_t posBit;
+    uint32_t readCount;
+    uint32_t writeCount;
+    uint32_t arrayLength;                   // elements count of packed array, 0 for scalar variable
+    uint32_t arrayIndex;                    // element index, when variable is view of array element
+    struct VariableObject* arrayOwner;      // array which element is viewed, NULL for others
+    VariableAllocation_t allocation;        // placement of object typed variable words
 }VariableObject_t;
 
 typedef VariableObject_t* VariableObjectHandle_t;
@@ -0,0 +1,110 @@
+/**
+ * @file runner.c
+ *
+ * Runs compiled program straight from memory, executable image never touches disk.
+ *
+ * Image is anonymous memory file. Linker inherits its descriptor and writes executable through
+ * /proc/self/fd path of it, afterwards compiler process is replaced by program with fexecve.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-06
+ */
+
+#define _GNU_SOURCE
+
+#include "runner.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "../misc/safety_macros.h"
+
+////////////////////////////////
+// DEFINES
+
+#define RUNNER_IMAGE_NAME           "iguana-run"
+#define RUNNER_IMAGE_PATH_FORMAT    "/proc/self/fd/%d"
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+static const char* TAG = "RUNNER";
+
+extern char** environ;
+
+////////////////////////////////
+// PRIVATE TYPES
+
+////////////////////////////////
+// PRIVATE METHODS
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for creating in memory file for executable, linker writes it through path
+ *
+ * @param[out] imagePath    path for linker output, RUNNER_IMAGE_PATH_LENGTH bytes
+ * @param[in] pathSize      imagePath buffer size
+ *
+ * @return                  Image descriptor, -1 on failure
+ */
+int Runner_createImage(char* imagePath, const size_t pathSize)
+{
+    // Not closed on exec, so linker started by compiler can open it
+    const int imageFd = memfd_create(RUNNER_IMAGE_NAME, 0);
+
+    if(imageFd < 0)
+    {
+        Log_e(TAG, "Failed to create memory file for executable: %s", strerror(errno));
+        return -1;
+    }
+
+    snprintf(imagePath, pathSize, RUNNER_IMAGE_PATH_FORMAT, imageFd);
+
+    return imageFd;
+}
+
+/**
+ * @brief Public method for replacing compiler process with program linked into image
+ *
+ * @param[in] imageFd       image descriptor, closed by this method
+ * @param[in] programName   program name given to it as argv[0]
+ *
+ * @return                  Returns only on failure
+ */
+bool Runner_execute(const int imageFd, const char* programName)
+{
+    char imagePath[RUNNER_IMAGE_PATH_LENGTH];
+    char* const argv[] = {(char*) programName, NULL};
+    int executableFd;
+
+    // File open for writing cannot be executed, so image is reopened read only
+    snprintf(imagePath, sizeof(imagePath), RUNNER_IMAGE_PATH_FORMAT, imageFd);
+    executableFd = open(imagePath, O_RDONLY | O_CLOEXEC);
+    close(imageFd);
+
+    if(executableFd < 0)
+    {
+        Log_e(TAG, "Failed to reopen executable image: %s", strerror(errno));
+        return ERROR;
+    }
+
+    // Buffered compiler output has to come before program output
+    Logger_flush();
+    fflush(stdout);
+    fflush(stderr);
+
+    fexecve(executableFd, argv, environ);
+
+    Log_e(TAG, "Failed to execute %s: %s", programName, strerror(errno));
+    close(executableFd);
+
+    return ERROR;
+}
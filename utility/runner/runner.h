@@ -0,0 +1,29 @@
+/**
+ * @file runner.h
+ *
+ * Runs compiled program straight from memory, executable image never touches disk
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-08-06
+ */
+
+#ifndef UTILITY_RUNNER_RUNNER_H_
+#define UTILITY_RUNNER_RUNNER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// First positional argument switching compiler to compile and run mode
+#define RUNNER_COMMAND              "run"
+
+// Fits "/proc/self/fd/" and any descriptor number
+#define RUNNER_IMAGE_PATH_LENGTH    32
+
+int Runner_createImage(char* imagePath, const size_t pathSize);
+bool Runner_execute(const int imageFd, const char* programName);
+
+#endif // UTILITY_RUNNER_RUNNER_H_
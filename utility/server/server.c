@@ -0,0 +1,677 @@
+/**
+ * @file server.c
+ *
+ * Resident compile server on Unix domain socket and thin client submitting jobs to it.
+ *
+ * Client sends its stdout and stderr descriptors with request header, then working directory
+ * and arguments as null terminated strings. Every client is served by own process forked from
+ * server, so jobs run side by side and crashing one does not take server down. Job process
+ * inherits caches of server and writes what it adds to them into result pipe, server merges
+ * it once job ends and answers client with job exit status.
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-07-21
+ */
+
+#define _GNU_SOURCE
+
+#include "server.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include "../misc/safety_macros.h"
+#include "../misc/platform_specific.h"
+
+////////////////////////////////
+// DEFINES
+
+#define SERVER_BACKLOG              64
+#define REQUEST_MAX_LENGTH          (1024 * 1024)
+#define PASSED_DESCRIPTORS_COUNT    2       // stdout, stderr
+#define SERVER_MAX_JOBS             16      // more clients wait in listen backlog
+#define RESULT_CHUNK_SIZE           65536
+
+////////////////////////////////
+// PRIVATE CONSTANTS
+
+static const char* TAG = "SERVER";
+
+////////////////////////////////
+// PRIVATE TYPES
+
+typedef struct
+{
+    uint32_t payloadLength;
+    uint32_t argc;
+}RequestHeader_t;
+
+typedef struct
+{
+    pid_t pid;
+    int clientFd;
+    int resultFd;
+    char* result;
+    size_t resultLength;
+    size_t resultCapacity;
+}Job_t;
+
+////////////////////////////////
+// PRIVATE METHODS
+
+static bool openSocket_(const char* socketPath, struct sockaddr_un* address, int* socketFd);
+static bool removeStaleSocket_(const char* socketPath);
+static bool isPeerTrusted_(const int clientFd);
+static bool startJob_(const int serverFd, const int clientFd, const ServerJob_t job, Job_t* startedJob);
+static bool collectResult_(Job_t* runningJob);
+static void finishJob_(Job_t* endedJob, const ServerResult_t result);
+static int serveClient_(const int clientFd, const ServerJob_t job, const int resultFd);
+static int runJob_(const int* descriptors, char* payload, const uint32_t payloadLength, const uint32_t argc, const ServerJob_t job, const int resultFd);
+static bool readAll_(const int fd, void* buffer, size_t length);
+static bool writeAll_(const int fd, const void* buffer, size_t length);
+
+////////////////////////////////
+// IMPLEMENTATION
+
+/**
+ * @brief Public method for serving compile jobs until process is killed, every job runs in own
+ * forked process and passes back what it added to compiler caches
+ *
+ * @param[in] socketPath        Unix socket path, existing socket is replaced, other files are not touched
+ * @param[in] job               compile routine
+ * @param[in] result            routine merging result of ended job into server state
+ *
+ * @return                      Success state, returns only on failure
+ */
+bool Server_run(const char* socketPath, const ServerJob_t job, const ServerResult_t result)
+{
+    struct sockaddr_un address;
+    int serverFd;
+    Job_t jobs[SERVER_MAX_JOBS];
+    struct pollfd pollFds[SERVER_MAX_JOBS + 1];
+    size_t jobCount = 0;
+
+    if(!openSocket_(socketPath, &address, &serverFd))
+    {
+        return ERROR;
+    }
+
+    if(!removeStaleSocket_(socketPath))
+    {
+        close(serverFd);
+        return ERROR;
+    }
+
+    if(bind(serverFd, (struct sockaddr*) &address, sizeof(address)) || listen(serverFd, SERVER_BACKLOG))
+    {
+        Log_e(TAG, "Failed to listen on %s", socketPath);
+        close(serverFd);
+        return ERROR;
+    }
+
+    // Client leaving early should not take server down
+    signal(SIGPIPE, SIG_IGN);
+
+    Log_i(TAG, "Listening on %s", socketPath);
+
+    while(true)
+    {
+        // Full server stops accepting, clients wait in backlog until some job ends
+        const bool isAccepting = jobCount < SERVER_MAX_JOBS;
+        const size_t jobsPollOffset = isAccepting ? 1 : 0;
+        int clientFd;
+
+        pollFds[0].fd = serverFd;
+        pollFds[0].events = POLLIN;
+
+        for(size_t jobIdx = 0; jobIdx < jobCount; jobIdx++)
+        {
+            pollFds[jobsPollOffset + jobIdx].fd = jobs[jobIdx].resultFd;
+            pollFds[jobsPollOffset + jobIdx].events = POLLIN;
+        }
+
+        if(poll(pollFds, jobsPollOffset + jobCount, -1) < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            Log_e(TAG, "Failed to wait for clients and jobs");
+            break;
+        }
+
+        // Going backwards, so ended job can be replaced by last one which is already handled
+        for(size_t jobIdx = jobCount; jobIdx-- > 0;)
+        {
+            if((pollFds[jobsPollOffset + jobIdx].revents != 0) && !collectResult_(&jobs[jobIdx]))
+            {
+                finishJob_(&jobs[jobIdx], result);
+                jobs[jobIdx] = jobs[--jobCount];
+            }
+        }
+
+        if(!isAccepting || ((pollFds[0].revents & POLLIN) == 0))
+        {
+            continue;
+        }
+
+        clientFd = accept4(serverFd, NULL, NULL, SOCK_CLOEXEC);
+
+        if(clientFd < 0)
+        {
+            Log_w(TAG, "Failed to accept client");
+            continue;
+        }
+
+        // Client options end up in shell commands run in client directory, so only owner may submit jobs
+        if(!isPeerTrusted_(clientFd))
+        {
+            Log_w(TAG, "Rejected client of other user");
+            close(clientFd);
+            continue;
+        }
+
+        if(!startJob_(serverFd, clientFd, job, &jobs[jobCount]))
+        {
+            Log_w(TAG, "Failed to start job of client");
+            close(clientFd);
+            continue;
+        }
+
+        jobCount++;
+    }
+
+    close(serverFd);
+
+    return ERROR;
+}
+
+/**
+ * @brief Public method for submitting command line to running server
+ *
+ * @param[in] socketPath        Unix socket path of server
+ * @param[in] argc              arguments count
+ * @param[in] argv              arguments, first one is program name
+ *
+ * @return                      Exit status of job, negative if server is not reachable
+ */
+int Server_submit(const char* socketPath, const int argc, char** argv)
+{
+    struct sockaddr_un address;
+    int clientFd;
+    char cwd[PATH_MAX_LENGTH];
+    RequestHeader_t header;
+    int32_t exitStatus;
+
+    struct msghdr message = {0};
+    struct iovec headerVector;
+    const int descriptors[PASSED_DESCRIPTORS_COUNT] = {STDOUT_FILENO, STDERR_FILENO};
+    char control[CMSG_SPACE(sizeof(descriptors))] = {0};
+    struct cmsghdr* controlMessage;
+
+    if((getcwd(cwd, sizeof(cwd)) == NULL) || !openSocket_(socketPath, &address, &clientFd))
+    {
+        return -1;
+    }
+
+    if(connect(clientFd, (struct sockaddr*) &address, sizeof(address)))
+    {
+        close(clientFd);
+        return -1;
+    }
+
+    header.argc = (uint32_t) argc;
+    header.payloadLength = (uint32_t) strlen(cwd) + 1;
+
+    for(int argIdx = 0; argIdx < argc; argIdx++)
+    {
+        header.payloadLength += (uint32_t) strlen(argv[argIdx]) + 1;
+    }
+
+    headerVector.iov_base = &header;
+    headerVector.iov_len = sizeof(header);
+
+    message.msg_iov = &headerVector;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    controlMessage = CMSG_FIRSTHDR(&message);
+    controlMessage->cmsg_level = SOL_SOCKET;
+    controlMessage->cmsg_type = SCM_RIGHTS;
+    controlMessage->cmsg_len = CMSG_LEN(sizeof(descriptors));
+    memcpy(CMSG_DATA(controlMessage), descriptors, sizeof(descriptors));
+
+    if(sendmsg(clientFd, &message, MSG_NOSIGNAL) != sizeof(header) || !writeAll_(clientFd, cwd, strlen(cwd) + 1))
+    {
+        close(clientFd);
+        return -1;
+    }
+
+    for(int argIdx = 0; argIdx < argc; argIdx++)
+    {
+        if(!writeAll_(clientFd, argv[argIdx], strlen(argv[argIdx]) + 1))
+        {
+            close(clientFd);
+            return -1;
+        }
+    }
+
+    // Request is already taken, losing answer means job outcome is unknown
+    if(!readAll_(clientFd, &exitStatus, sizeof(exitStatus)))
+    {
+        fprintf(stderr, "Error: compile server %s did not answer\n", socketPath);
+        exitStatus = EXIT_FAILURE;
+    }
+
+    close(clientFd);
+
+    return exitStatus;
+}
+
+/**
+ * @brief Private method for creating stream socket and its address
+ *
+ * @param[in] socketPath        Unix socket path
+ * @param[out] address          filled socket address
+ * @param[out] socketFd         created socket
+ *
+ * @return                      Success state
+ */
+static bool openSocket_(const char* socketPath, struct sockaddr_un* address, int* socketFd)
+{
+    if(strlen(socketPath) >= sizeof(address->sun_path))
+    {
+        Log_e(TAG, "Socket path too long: %s", socketPath);
+        return ERROR;
+    }
+
+    memset(address, 0, sizeof(struct sockaddr_un));
+    address->sun_family = AF_UNIX;
+    strcpy(address->sun_path, socketPath);
+
+    *socketFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if(*socketFd < 0)
+    {
+        Log_e(TAG, "Failed to create socket");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Private method for removing socket left by previous server on same path
+ *
+ * @param[in] socketPath        Unix socket path
+ *
+ * @return                      Success state, false if path is taken by something else than socket
+ */
+static bool removeStaleSocket_(const char* socketPath)
+{
+    struct stat pathStat;
+
+    if(lstat(socketPath, &pathStat))
+    {
+        return SUCCESS;
+    }
+
+    if(!S_ISSOCK(pathStat.st_mode))
+    {
+        Log_e(TAG, "%s exists and is not a socket, refusing to replace it", socketPath);
+        return ERROR;
+    }
+
+    if(unlink(socketPath))
+    {
+        Log_e(TAG, "Failed to remove old socket %s", socketPath);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Private method for checking that connected client runs as same user as server
+ *
+ * @param[in] clientFd          connected client
+ *
+ * @return                      true if peer credentials are known and user matches
+ */
+static bool isPeerTrusted_(const int clientFd)
+{
+    struct ucred peer;
+    socklen_t peerLength = sizeof(peer);
+
+    if(getsockopt(clientFd, SOL_SOCKET, SO_PEERCRED, &peer, &peerLength) || (peerLength != sizeof(peer)))
+    {
+        return false;
+    }
+
+    return peer.uid == geteuid();
+}
+
+/**
+ * @brief Private method for forking process serving client, server keeps reading end of its result pipe
+ *
+ * @param[in] serverFd          listening socket, closed in job process
+ * @param[in] clientFd          connected client, job process reads request from it
+ * @param[in] job               compile routine
+ * @param[out] startedJob       started job state
+ *
+ * @return                      Success state
+ */
+static bool startJob_(const int serverFd, const int clientFd, const ServerJob_t job, Job_t* startedJob)
+{
+    int resultPipe[2];
+
+    if(pipe2(resultPipe, O_CLOEXEC))
+    {
+        return ERROR;
+    }
+
+    // Buffered output would be written by both processes otherwise
+    Logger_flush();
+    fflush(stdout);
+    fflush(stderr);
+
+    startedJob->pid = fork();
+
+    if(startedJob->pid < 0)
+    {
+        close(resultPipe[0]);
+        close(resultPipe[1]);
+        return ERROR;
+    }
+
+    if(startedJob->pid == 0)
+    {
+        int exitStatus;
+
+        close(serverFd);
+        close(resultPipe[0]);
+
+        exitStatus = serveClient_(clientFd, job, resultPipe[1]);
+
+        Logger_flush();
+        fflush(stdout);
+        fflush(stderr);
+        _exit(exitStatus);
+    }
+
+    close(resultPipe[1]);
+
+    startedJob->clientFd = clientFd;
+    startedJob->resultFd = resultPipe[0];
+    startedJob->result = NULL;
+    startedJob->resultLength = 0;
+    startedJob->resultCapacity = 0;
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Private method for reading available result of running job
+ *
+ * @param[in,out] runningJob    job, its result buffer grows
+ *
+ * @return                      true while job may write more, false once result pipe is closed or broken
+ */
+static bool collectResult_(Job_t* runningJob)
+{
+    ssize_t received;
+
+    if(runningJob->resultCapacity - runningJob->resultLength < RESULT_CHUNK_SIZE)
+    {
+        char* grown = realloc(runningJob->result, runningJob->resultCapacity + RESULT_CHUNK_SIZE);
+
+        if(grown == NULL)
+        {
+            Log_e(TAG, "Realloc failed for some reason, heap issue");
+            return false;
+        }
+
+        runningJob->result = grown;
+        runningJob->resultCapacity += RESULT_CHUNK_SIZE;
+    }
+
+    received = read(runningJob->resultFd, runningJob->result + runningJob->resultLength, RESULT_CHUNK_SIZE);
+
+    if(received < 0)
+    {
+        return errno == EINTR;
+    }
+
+    runningJob->resultLength += (size_t) received;
+
+    return received > 0;
+}
+
+/**
+ * @brief Private method for reaping ended job, merging its result and answering its client
+ *
+ * @param[in,out] endedJob      job whose result pipe is closed, its resources are released
+ * @param[in] result            routine merging result into server state
+ */
+static void finishJob_(Job_t* endedJob, const ServerResult_t result)
+{
+    int waitStatus;
+    int32_t exitStatus = EXIT_FAILURE;
+
+    close(endedJob->resultFd);
+
+    while((waitpid(endedJob->pid, &waitStatus, 0) < 0) && (errno == EINTR));
+
+    if(WIFEXITED(waitStatus))
+    {
+        exitStatus = WEXITSTATUS(waitStatus);
+
+        // Result of crashed job may be cut in the middle, so only finished jobs are merged
+        result(endedJob->result, endedJob->resultLength);
+
+    }else if(WIFSIGNALED(waitStatus))
+    {
+        Log_w(TAG, "Job %d was killed by signal %d", (int) endedJob->pid, WTERMSIG(waitStatus));
+        exitStatus = 128 + WTERMSIG(waitStatus);
+    }
+
+    if(!writeAll_(endedJob->clientFd, &exitStatus, sizeof(exitStatus)))
+    {
+        Log_w(TAG, "Client of job %d left before answer", (int) endedJob->pid);
+    }
+
+    close(endedJob->clientFd);
+    free(endedJob->result);
+}
+
+/**
+ * @brief Private method for receiving one request and running it, called in job process
+ *
+ * @param[in] clientFd          connected client
+ * @param[in] job               compile routine
+ * @param[in] resultFd          result pipe passed to job
+ *
+ * @return                      Job exit status
+ */
+static int serveClient_(const int clientFd, const ServerJob_t job, const int resultFd)
+{
+    RequestHeader_t header;
+    int descriptors[PASSED_DESCRIPTORS_COUNT] = {-1, -1};
+    char control[CMSG_SPACE(sizeof(descriptors))];
+    struct iovec headerVector = {&header, sizeof(header)};
+    struct msghdr message = {0};
+    struct cmsghdr* controlMessage;
+    char* payload;
+    int exitStatus = EXIT_FAILURE;
+
+    message.msg_iov = &headerVector;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    if(recvmsg(clientFd, &message, MSG_CMSG_CLOEXEC) != sizeof(header))
+    {
+        return EXIT_FAILURE;
+    }
+
+    controlMessage = CMSG_FIRSTHDR(&message);
+
+    if((controlMessage == NULL) || (controlMessage->cmsg_type != SCM_RIGHTS) || (controlMessage->cmsg_len != CMSG_LEN(sizeof(descriptors))))
+    {
+        Log_e(TAG, "Request came without output descriptors");
+        return EXIT_FAILURE;
+    }
+
+    memcpy(descriptors, CMSG_DATA(controlMessage), sizeof(descriptors));
+
+    if((header.payloadLength == 0) || (header.payloadLength > REQUEST_MAX_LENGTH) || (header.argc == 0))
+    {
+        Log_e(TAG, "Malformed request of %u bytes", header.payloadLength);
+        close(descriptors[0]);
+        close(descriptors[1]);
+        return EXIT_FAILURE;
+    }
+
+    ALLOC_CHECK(payload, header.payloadLength, EXIT_FAILURE);
+
+    if(readAll_(clientFd, payload, header.payloadLength) && (payload[header.payloadLength - 1] == '\0'))
+    {
+        exitStatus = runJob_(descriptors, payload, header.payloadLength, header.argc, job, resultFd);
+    }
+
+    free(payload);
+    close(descriptors[0]);
+    close(descriptors[1]);
+
+    return exitStatus;
+}
+
+/**
+ * @brief Private method for running job with client output and working directory, job process
+ * ends afterwards so server ones are not restored
+ *
+ * @param[in] descriptors       client stdout and stderr
+ * @param[in] payload           working directory and arguments
+ * @param[in] payloadLength     payload length, last byte is null terminator
+ * @param[in] argc              arguments count in payload
+ * @param[in] job               compile routine
+ * @param[in] resultFd          result pipe passed to job
+ *
+ * @return                      Job exit status
+ */
+static int runJob_(const int* descriptors, char* payload, const uint32_t payloadLength, const uint32_t argc, const ServerJob_t job, const int resultFd)
+{
+    char** argv;
+    char* cursor = payload;
+    const char* const payloadEnd = payload + payloadLength;
+    const char* cwd = payload;
+    int exitStatus;
+
+    ALLOC_CHECK(argv, (argc + 1) * sizeof(char*), EXIT_FAILURE);
+
+    cursor += strlen(cwd) + 1;
+
+    for(uint32_t argIdx = 0; argIdx < argc; argIdx++)
+    {
+        if(cursor >= payloadEnd)
+        {
+            Log_e(TAG, "Request has less arguments than declared");
+            free(argv);
+            return EXIT_FAILURE;
+        }
+
+        argv[argIdx] = cursor;
+        cursor += strlen(cursor) + 1;
+    }
+
+    argv[argc] = NULL;
+
+    if(chdir(cwd))
+    {
+        Log_e(TAG, "Failed to enter client directory %s", cwd);
+        free(argv);
+        return EXIT_FAILURE;
+    }
+
+    dup2(descriptors[0], STDOUT_FILENO);
+    dup2(descriptors[1], STDERR_FILENO);
+
+    exitStatus = job((int) argc, argv, resultFd);
+
+    free(argv);
+
+    return exitStatus;
+}
+
+/**
+ * @brief Private method for reading exact bytes count from stream
+ *
+ * @param[in] fd                stream descriptor
+ * @param[out] buffer           destination
+ * @param[in] length            bytes count
+ *
+ * @return                      Success state, false on error or early end of stream
+ */
+static bool readAll_(const int fd, void* buffer, size_t length)
+{
+    char* cursor = buffer;
+
+    while(length > 0)
+    {
+        const ssize_t received = read(fd, cursor, length);
+
+        if(received <= 0)
+        {
+            return ERROR;
+        }
+
+        cursor += received;
+        length -= (size_t) received;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Private method for writing exact bytes count to socket, closed peer is reported as error instead of SIGPIPE
+ *
+ * @param[in] fd                stream descriptor
+ * @param[in] buffer            source
+ * @param[in] length            bytes count
+ *
+ * @return                      Success state
+ */
+static bool writeAll_(const int fd, const void* buffer, size_t length)
+{
+    const char* cursor = buffer;
+
+    while(length > 0)
+    {
+        const ssize_t sent = send(fd, cursor, length, MSG_NOSIGNAL);
+
+        if(sent <= 0)
+        {
+            return ERROR;
+        }
+
+        cursor += sent;
+        length -= (size_t) sent;
+    }
+
+    return SUCCESS;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file server.h
+ *
+ * Resident compile server on Unix domain socket and thin client submitting jobs to it
+ *
+ * @copyright This file is a part of the project Iguana and is distributed under MIT license which
+ * should have been included with the project. If not see: https://choosealicense.com/licenses/mit/
+ *
+ * @author Markas Vielavičius (markas.vielavicius@bytewall.com)
+ *
+ * @date 2025-07-21
+ */
+
+#ifndef UTILITY_SERVER_SERVER_H_
+#define UTILITY_SERVER_SERVER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Environment variable naming server socket, compiler invocations become clients when it is set
+#define SERVER_SOCKET_ENV           "IGUANA_SERVER"
+
+// Job gets command line of client, working directory and standard output are already switched to client ones.
+// It runs in own process, state worth keeping for later jobs is written to resultFd
+typedef int (*ServerJob_t)(int argc, char** argv, int resultFd);
+
+// Server gets everything job wrote to resultFd once job process exited
+typedef void (*ServerResult_t)(const char* result, size_t length);
+
+bool Server_run(const char* socketPath, const ServerJob_t job, const ServerResult_t result);
+int Server_submit(const char* socketPath, const int argc, char** argv);
+
+#endif // UTILITY_SERVER_SERVER_H_
@@ -62,7 +62,10 @@ static const BindingType_t bindingsTable_[] =
         [ALLOC_DYNAMIC_STACK] = DECLARE_TYPE("ds", ALLOC_DYNAMIC_STACK),
         [ALLOC_DYNAMIC_HEAP] = DECLARE_TYPE("dh", ALLOC_DYNAMIC_HEAP),
         [RETURN] = DECLARE_TYPE("ret", RETURN),
-        [NONE] = DECLARE_TYPE("none", NONE)
+        [NONE] = DECLARE_TYPE("none", NONE),
+        [INLINE] = DECLARE_TYPE("inline", INLINE),
+        [BRACKET_SQUARE_START] = DECLARE_TYPE("[", BRACKET_SQUARE_START),
+        [BRACKET_SQUARE_END] = DECLARE_TYPE("]", BRACKET_SQUARE_END)
     };
 
 #endif // UTILITY_TOKENIZER_TOKEN_TOKEN_DATABASE_TOKEN_BINDINGS_H_
\ No newline at end of file
@@ -54,6 +54,9 @@ typedef enum TokenType
     ALLOC_DYNAMIC_HEAP,  // dh
     RETURN,              // ret
     NONE,                // none
+    INLINE,              // inline
+    BRACKET_SQUARE_START,// [
+    BRACKET_SQUARE_END,  // ]
 
     END_FILE
 } TokenType_t;